@@ -8,6 +8,7 @@ CREATE TABLE `tags` (
 DROP TABLE IF EXISTS `reduceDB`;
 CREATE TABLE `reduceDB` (
   `runID` bigint(20) NOT NULL,
+  `threadID` int(20) NOT NULL,
   `simplifications` int(20) NOT NULL,
   `restarts` bigint(20) NOT NULL,
   `conflicts` bigint(20) NOT NULL,
@@ -32,6 +33,7 @@ CREATE TABLE `reduceDB` (
 DROP TABLE IF EXISTS `restart`;
 CREATE TABLE `restart` (
   `runID` bigint(20) NOT NULL,
+  `threadID` int(20) NOT NULL,
   `simplifications` int(20) NOT NULL,
   `restarts` bigint(20) NOT NULL,
   `conflicts` bigint(20) NOT NULL,
@@ -103,6 +105,7 @@ CREATE TABLE `restart` (
 DROP TABLE IF EXISTS `timepassed`;
 CREATE TABLE `timepassed` (
   `runID` bigint(20) NOT NULL,
+  `threadID` int(20) NOT NULL,
   `simplifications` bigint(20) NOT NULL,
   `conflicts` bigint(20) NOT NULL,
   `runtime` float NOT NULL,
@@ -115,6 +118,7 @@ CREATE TABLE `timepassed` (
 DROP TABLE IF EXISTS `memused`;
 CREATE TABLE `memused` (
   `runID` bigint(20) NOT NULL,
+  `threadID` int(20) NOT NULL,
   `simplifications` bigint(20) NOT NULL,
   `conflicts` bigint(20) NOT NULL,
   `runtime` float NOT NULL,
@@ -145,6 +149,7 @@ CREATE TABLE `finishup` (
 DROP TABLE IF EXISTS `clauseStats`;
 CREATE TABLE `clauseStats` (
   `runID` bigint(20) NOT NULL,
+  `threadID` int(20) NOT NULL,
   `simplifications` int(20) NOT NULL,
   `restarts` bigint(20) NOT NULL,
   `prev_restart` bigint(20) NOT NULL,
@@ -228,6 +233,7 @@ CREATE TABLE `clauseStats` (
 DROP TABLE IF EXISTS `features`;
 CREATE TABLE `features` (
   `runID` bigint(20) NOT NULL,
+  `threadID` int(20) NOT NULL,
   `simplifications` int(20) NOT NULL,
   `restarts` bigint(20) NOT NULL,
   `conflicts` bigint(20) NOT NULL,
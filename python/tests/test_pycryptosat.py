@@ -223,10 +223,38 @@ class TestSolve(unittest.TestCase):
         res, solution = self.solver.solve()
         self.assertEqual(res, False)
 
+    def test_add_clauses_many(self):
+        self.solver.add_clauses([[1, 2], [-1], (-2, 3)])
+        res, solution = self.solver.solve()
+        self.assertEqual(res, True)
+        self.assertEqual(solution, (None, False, True, True))
+
     def test_add_clauses_array_unterminated(self):
         cls = array('i', [1, 2, 0, 1, 2])
         self.assertRaises(ValueError, self.solver.add_clause, cls)
 
+    @unittest.skipIf(sys.version_info[0] < 3, "needs the Python 3 buffer protocol")
+    def test_add_clauses_buffer(self):
+        cls = memoryview(array('q', [1, 2, 0, -1, 0, -2, 3, 0]))
+        self.solver.add_clauses(cls)
+        res, solution = self.solver.solve()
+        self.assertEqual(res, True)
+        self.assertEqual(solution, (None, False, True, True))
+
+    @unittest.skipIf(sys.version_info[0] < 3, "needs the Python 3 buffer protocol")
+    def test_add_clauses_buffer_wrong_format(self):
+        self.assertRaises(ValueError, self.solver.add_clauses, b'\x01\x00')
+        self.assertRaises(
+            ValueError, self.solver.add_clauses, array('d', [1.0, 0.0]))
+
+    @unittest.skipIf(sys.version_info[0] < 3, "needs the Python 3 buffer protocol")
+    def test_get_model_view(self):
+        self.solver.add_clauses([[1, 2], [-1], (-2, 3)])
+        self.assertEqual(self.solver.is_satisfiable(), True)
+        model = self.solver.get_model_view()
+        self.assertEqual(model.format, 'b')
+        self.assertEqual(model.tolist(), [0, -1, 1, 1])
+
     def test_bad_iter(self):
         class Liar:
 
@@ -293,6 +321,27 @@ class TestSolve(unittest.TestCase):
         res, _ = self.solver.solve()
         self.assertEqual(res, True)
 
+
+class TestMsolve(unittest.TestCase):
+
+    def setUp(self):
+        self.solver = Solver()
+
+    def test_all(self):
+        self.solver.add_clause([1, 2, 3, 4])
+        self.solver.add_clause([-1, 5])
+        solutions = self.solver.msolve_selected(100, [1, 2, 3, 4])
+        self.assertEqual(len(solutions), 15)
+        self.assertEqual(len(set(sol[:4] for sol in solutions)), 15)
+        for sol in solutions:
+            self.assertTrue(-1 in sol or 5 in sol)
+
+    def test_max(self):
+        self.solver.add_clause([1, 2, 3, 4])
+        solutions = self.solver.msolve_selected(5, [1, 2, 3, 4], raw=False)
+        self.assertEqual(len(solutions), 5)
+        self.assertEqual(len(set(solutions)), 5)
+
 # ------------------------------------------------------------------------
 
 
@@ -308,6 +357,7 @@ def run():
     suite.addTest(unittest.makeSuite(InitTester))
     suite.addTest(unittest.makeSuite(TestSolve))
     suite.addTest(unittest.makeSuite(TestDump))
+    suite.addTest(unittest.makeSuite(TestMsolve))
 
     runner = unittest.TextTestRunner(verbosity=2)
     result = runner.run(suite)
@@ -70,6 +70,11 @@ extern "C" {
     fn cmsat_free(this: *mut SATSolver);
     fn cmsat_nvars(this: *const SATSolver) -> u32;
     fn cmsat_add_clause(this: *mut SATSolver, lits: *const Lit, num_lits: size_t) -> bool;
+    fn cmsat_add_clauses(this: *mut SATSolver,
+                         lits: *const Lit,
+                         offsets: *const size_t,
+                         num_clauses: size_t)
+                         -> bool;
     fn cmsat_add_xor_clause(this: *mut SATSolver,
                             vars: *const u32,
                             num_vars: size_t,
@@ -105,6 +110,18 @@ impl Solver {
     pub fn add_clause(&mut self, lits: &[Lit]) -> bool {
         unsafe { cmsat_add_clause(self.0, lits.as_ptr(), lits.len()) }
     }
+    /// Add many clauses at once. Clause i is lits[offsets[i]..offsets[i+1]],
+    /// so offsets has one more element than the number of clauses.
+    pub fn add_clauses(&mut self, lits: &[Lit], offsets: &[size_t]) -> bool {
+        if offsets.is_empty() {
+            return true;
+        }
+        assert!(offsets.windows(2).all(|w| w[0] <= w[1]));
+        assert!(offsets[offsets.len() - 1] <= lits.len());
+        unsafe {
+            cmsat_add_clauses(self.0, lits.as_ptr(), offsets.as_ptr(), offsets.len() - 1)
+        }
+    }
     /// Add a xor clause, which enforces that the xor of the unnegated variables equals rhs.
     /// It is generally more convienent to use add_xor_literal_clause() instead.
     pub fn add_xor_clause(&mut self, vars: &[u32], rhs: bool) -> bool {
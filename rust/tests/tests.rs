@@ -100,6 +100,23 @@ fn sugared_readme_code() {
     assert!(s.is_true(z));
 }
 
+#[test]
+fn add_clauses_code() {
+    let mut s = Solver::new();
+    let x = s.new_var();
+    let y = s.new_var();
+    let z = s.new_var();
+
+    let lits = [x, !y, !x, y, z];
+    let offsets = [0, 1, 2, 5];
+    assert!(s.add_clauses(&lits, &offsets));
+
+    assert!(s.solve() == Lbool::True);
+    assert!(s.is_true(x));
+    assert!(s.is_true(!y));
+    assert!(s.is_true(z));
+}
+
 #[test]
 fn sugared_xor_code() {
     let mut s = Solver::new();
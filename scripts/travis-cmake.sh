@@ -231,6 +231,22 @@ case $CMS_CONFIG in
                    "${SOURCE_DIR}"
     ;;
 
+    INLINE_TERNARY)
+        if [[ "$TRAVIS_OS_NAME" == "linux" ]]; then sudo apt-get install libboost-program-options-dev; fi
+        eval cmake -DENABLE_TESTING:BOOL=ON \
+                   -DINLINE_TERNARY:BOOL=ON \
+                   ${PATH_PREFIX_ADD} \
+                   "${SOURCE_DIR}"
+    ;;
+
+    CLAUSE_STATS_SIDE_TABLE)
+        if [[ "$TRAVIS_OS_NAME" == "linux" ]]; then sudo apt-get install libboost-program-options-dev; fi
+        eval cmake -DENABLE_TESTING:BOOL=ON \
+                   -DCLAUSE_STATS_SIDE_TABLE:BOOL=ON \
+                   ${PATH_PREFIX_ADD} \
+                   "${SOURCE_DIR}"
+    ;;
+
     M4RI)
         if [[ "$TRAVIS_OS_NAME" == "linux" ]]; then sudo apt-get install libboost-program-options-dev; fi
         wget https://bitbucket.org/malb/m4ri/downloads/m4ri-20140914.tar.gz
@@ -107,23 +107,77 @@ EGaussian::EGaussian(Solver* _solver, const GaussConf& _config, const uint32_t _
 
 EGaussian::~EGaussian() {
     delete_gauss_watch_this_matrix();
-    for (uint32_t i = 0; i < clauses_toclear.size(); i++) {
-        solver->cl_alloc.clauseFree(clauses_toclear[i].first);
-    }
 }
 
 void EGaussian::canceling(const uint32_t sublevel) {
-    uint32_t a = 0;
-    for (int i = (int)clauses_toclear.size() - 1; i >= 0 && clauses_toclear[i].second > sublevel; i--) {
-        solver->cl_alloc.clauseFree(clauses_toclear[i].first);
-        a++;
+    // forget the reasons of everything that is unassigned
+    while (num_xor_reasons > 0 && xor_reasons[num_xor_reasons-1].trail_at >= sublevel) {
+        num_xor_reasons--;
+        const XorReason& r = xor_reasons[num_xor_reasons];
+        if (r.must_build) {
+            assert(row_to_xor_reason[r.row] == num_xor_reasons);
+            row_to_xor_reason[r.row] = std::numeric_limits<uint32_t>::max();
+        }
     }
-    clauses_toclear.resize(clauses_toclear.size() - a);
 
     PackedMatrix::iterator rowIt = clause_state.beginMatrix();
     (*rowIt).setZero(); //forget state
 }
 
+PropBy EGaussian::add_xor_reason(const uint32_t row, const Lit propagated) {
+    build_xor_reason_of_row(row);
+    if (num_xor_reasons == xor_reasons.size()) {
+        xor_reasons.push_back(XorReason());
+    }
+    XorReason& r = xor_reasons[num_xor_reasons];
+    r.propagated = propagated;
+    r.row = row;
+    r.trail_at = solver->trail.size();
+    r.must_build = true;
+    row_to_xor_reason[row] = num_xor_reasons;
+
+    return PropBy(matrix_no, num_xor_reasons++);
+}
+
+PropBy EGaussian::add_conflict_reason(const vector<Lit>& conflict) {
+    if (num_xor_reasons == xor_reasons.size()) {
+        xor_reasons.push_back(XorReason());
+    }
+    XorReason& r = xor_reasons[num_xor_reasons];
+    r.propagated = lit_Undef;
+    r.row = std::numeric_limits<uint32_t>::max();
+    r.trail_at = solver->trail.size(); // gone with the next backtrack
+    r.must_build = false;
+    r.reason = conflict;
+
+    return PropBy(matrix_no, num_xor_reasons++);
+}
+
+void EGaussian::build_xor_reason(XorReason& r) {
+    assert(r.must_build);
+    matrix.matrix.getMatrixAt(r.row).get_reason(
+        r.reason, solver->assigns, matrix.col_to_var, r.propagated);
+    r.must_build = false;
+    row_to_xor_reason[r.row] = std::numeric_limits<uint32_t>::max();
+}
+
+// must be called before changing the row
+inline void EGaussian::build_xor_reason_of_row(const uint32_t row) {
+    const uint32_t at = row_to_xor_reason[row];
+    if (at != std::numeric_limits<uint32_t>::max()) {
+        build_xor_reason(xor_reasons[at]);
+    }
+}
+
+const vector<Lit>& EGaussian::get_reason(const uint32_t reason_num) {
+    assert(reason_num < num_xor_reasons);
+    XorReason& r = xor_reasons[reason_num];
+    if (r.must_build) {
+        build_xor_reason(r);
+    }
+    return r.reason;
+}
+
 struct HeapSorter {
     explicit HeapSorter(vector<double>& _activities) : activities(_activities) {
     }
@@ -313,6 +367,9 @@ bool EGaussian::full_init(bool& created) {
         }
     }
 
+    num_xor_reasons = 0;
+    row_to_xor_reason.assign(matrix.num_rows, std::numeric_limits<uint32_t>::max());
+
     if (solver->conf.verbosity >= 2) {
         cout << "c [gauss] initialised matrix " << matrix_no << endl;
     }
@@ -577,6 +634,7 @@ bool EGaussian::find_truths2(const GaussWatched* i, GaussWatched*& j, uint32_t p
                 GasVar_state[tmp_clause[1].var()] = non_basic_var;
                 matrix.nb_rows[row_n] =
                     std::numeric_limits<uint32_t>::max(); // delete non basic value in this row
+                build_xor_reason_of_row(row_n);
                 (*rowIt).setZero();                       // reset this row all zero
 
                 conflict_twoclause(gqd.confl);            // get two conflict  clause
@@ -641,19 +699,8 @@ bool EGaussian::find_truths2(const GaussWatched* i, GaussWatched*& j, uint32_t p
                 if (tmp_clause.size() == 2) {
                     propagation_twoclause();
                 } else {
-                    Clause* cla = solver->cl_alloc.Clause_new(
-                        tmp_clause,
-                        solver->sumConflicts
-                        #ifdef STATS_NEEDED
-                        , solver->clauseID++
-                        #endif
-                    );
-                    cla->set_gauss_temp_cl();
-                    const ClOffset offs = solver->cl_alloc.get_offset(cla);
-                    clauses_toclear.push_back(std::make_pair(offs, solver->trail.size() - 1));
-                    assert(!cla->freed());
-                    assert(solver->value((*cla)[0].var()) == l_Undef);
-                    solver->enqueue((*cla)[0], PropBy(offs));
+                    assert(solver->value(tmp_clause[0].var()) == l_Undef);
+                    solver->enqueue(tmp_clause[0], add_xor_reason(row_n, tmp_clause[0]));
                 }
                 gqd.ret_gauss = 2; // gaussian matrix is  propagation
             }
@@ -741,6 +788,7 @@ void EGaussian::eliminate_col2(uint32_t p, GaussQData& gqd) {
             ori_nb_col = var_to_col[ori_nb];
             assert((*rowI)[ori_nb_col]);
 
+            build_xor_reason_of_row(num_row);
             (*rowI).xorBoth(*this_row); // xor eliminate
 
             if (!(*rowI)[ori_nb_col]) { // orignal non basic value is eliminate
@@ -831,19 +879,8 @@ void EGaussian::eliminate_col2(uint32_t p, GaussQData& gqd) {
                             if (tmp_clause.size() == 2) {
                                 propagation_twoclause();
                             } else {
-                                Clause* cla = solver->cl_alloc.Clause_new(
-                                    tmp_clause,
-                                    solver->sumConflicts
-                                    #ifdef STATS_NEEDED
-                                    , solver->clauseID++
-                                    #endif
-                                );
-                                cla->set_gauss_temp_cl();
-                                const ClOffset offs = solver->cl_alloc.get_offset(cla);
-                                clauses_toclear.push_back(std::make_pair(offs, solver->trail.size() - 1));
-                                assert(!cla->freed());
-                                assert(solver->value((*cla)[0].var()) == l_Undef);
-                                solver->enqueue((*cla)[0], PropBy(offs));
+                                assert(solver->value(tmp_clause[0].var()) == l_Undef);
+                                solver->enqueue(tmp_clause[0], add_xor_reason(num_row, tmp_clause[0]));
                             }
                             gqd.ret_gauss = 2;
                             (*clauseIt).setBit(num_row); // this clause arleady sat
@@ -892,9 +929,10 @@ void EGaussian::print_matrix(matrixset& m) const {
 }
 
 void EGaussian::Debug_funtion() {
-    for (int i = clauses_toclear.size() - 1; i >= 0; i--) {
-        ClOffset offs = clauses_toclear[i].first;
-        Clause* cl = solver->cl_alloc.ptr(offs);
-        assert(!cl->freed());
+    for (uint32_t i = 0; i < num_xor_reasons; i++) {
+        const XorReason& r = xor_reasons[i];
+        if (r.must_build) {
+            assert(row_to_xor_reason[r.row] == i);
+        }
     }
 }
@@ -58,6 +58,9 @@ class Solver;
 
 class EGaussian {
   protected:
+    #ifdef CMS_BENCH_ENABLED
+    friend struct BenchAccess;
+    #endif
     Solver* solver;   // orignal sat solver
     const GaussConf& config;  // gauss some configure
     const uint32_t matrix_no;            // matrix index
@@ -100,12 +103,28 @@ class EGaussian {
     inline void propagation_twoclause();
     inline void conflict_twoclause(PropBy& confl);
 
+    // Reasons of the propagations and conflicts of this matrix, in trail
+    // order. A propagation only records its row, the clause is built if
+    // conflict analysis asks for it, or just before the row is changed.
+    struct XorReason {
+        Lit propagated;
+        uint32_t row;
+        uint32_t trail_at;
+        bool must_build;
+        vector<Lit> reason;
+    };
+    vector<XorReason> xor_reasons; // entries are reused, never shrinks
+    uint32_t num_xor_reasons = 0;
+    vector<uint32_t> row_to_xor_reason; // unbuilt reason that needs the row
+    PropBy add_xor_reason(const uint32_t row, const Lit propagated);
+    void build_xor_reason(XorReason& r);
+    inline void build_xor_reason_of_row(const uint32_t row);
+
     void print_matrix(matrixset& m) const;
 
   public:
     // variable
     vector<Xor> xorclauses;   // xorclauses
-    vector<pair<ClOffset, uint32_t> > clauses_toclear; // use to delete propagate clause
 
 
     EGaussian(
@@ -138,6 +157,11 @@ class EGaussian {
         GaussQData& gqd
     );
 
+    // Clause of a PropBy of type xor_t, the 1st literal is the propagated
+    // one. Valid until the next backtrack.
+    const vector<Lit>& get_reason(const uint32_t reason_num);
+    PropBy add_conflict_reason(const vector<Lit>& conflict);
+
     void Debug_funtion(); // used to debug
 };
 
@@ -551,7 +551,7 @@ bool BVA::add_longer_clause(const Lit new_lit, const OccurClause& cl)
             Clause* newCl = solver->add_clause_int(
                 lits, //lits to add
                 false, //redundant?
-                orig_cl.stats,
+                solver->cl_alloc.stats(orig_cl),
                 false, //attach?
                 &lits, //put back final lits here
                 true, //DRAT
@@ -0,0 +1,233 @@
+/******************************************
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "checkpoint.h"
+#include "solvertypes.h"
+#include <chrono>
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#if !defined(_MSC_VER)
+#include <unistd.h>
+#endif
+
+using namespace CMSat;
+using std::cout;
+using std::endl;
+
+//Header: magic, version, payload length, checksum of payload
+static const uint32_t checkpoint_magic = 0x4b534d43; //"CMSK"
+static const size_t checkpoint_header_size = 4+4+8+8;
+
+static uint64_t checkpoint_hash(const vector<char>& data)
+{
+    //FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for(const char c: data) {
+        hash ^= (unsigned char)c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+CheckpointWriter::CheckpointWriter(const string& _fname) :
+    fname(_fname)
+{
+    writer = std::thread(&CheckpointWriter::write_loop, this);
+}
+
+CheckpointWriter::~CheckpointWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        stop = true;
+    }
+    cond_todo.notify_one();
+    writer.join();
+}
+
+void CheckpointWriter::submit(vector<char>& payload)
+{
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        todo.swap(payload);
+        have_todo = true;
+    }
+    payload.clear();
+    cond_todo.notify_one();
+}
+
+bool CheckpointWriter::busy()
+{
+    std::lock_guard<std::mutex> lock(mu);
+    return have_todo || writing;
+}
+
+void CheckpointWriter::wait_all_written()
+{
+    std::unique_lock<std::mutex> lock(mu);
+    cond_done.wait(lock, [this]{return !have_todo && !writing;});
+}
+
+CheckpointWriter::Stats CheckpointWriter::get_stats()
+{
+    std::lock_guard<std::mutex> lock(mu);
+    return stats;
+}
+
+void CheckpointWriter::write_loop()
+{
+    vector<char> payload;
+    std::unique_lock<std::mutex> lock(mu);
+    while(true) {
+        //Pending checkpoint is written even if we are asked to stop
+        cond_todo.wait(lock, [this]{return stop || have_todo;});
+        if (!have_todo) {
+            assert(stop);
+            break;
+        }
+
+        payload.swap(todo);
+        have_todo = false;
+        writing = true;
+        lock.unlock();
+
+        const auto start = std::chrono::steady_clock::now();
+        const bool ok = write_file(payload);
+        const std::chrono::duration<double> took =
+            std::chrono::steady_clock::now() - start;
+
+        lock.lock();
+        writing = false;
+        if (ok) {
+            stats.written++;
+            stats.bytes_written += payload.size() + checkpoint_header_size;
+        } else {
+            stats.failed++;
+        }
+        stats.write_time += took.count();
+        cond_done.notify_all();
+    }
+}
+
+bool CheckpointWriter::write_file(const vector<char>& payload)
+{
+    const string tmp_fname = fname + ".tmp";
+    FILE* f = fopen(tmp_fname.c_str(), "wb");
+    if (f == NULL) {
+        std::cerr << "c WARNING: could not open checkpoint file '"
+        << tmp_fname << "' for writing: " << strerror(errno) << endl;
+        return false;
+    }
+
+    const uint64_t payload_size = payload.size();
+    const uint64_t hash = checkpoint_hash(payload);
+    bool ok = fwrite(&checkpoint_magic, 4, 1, f) == 1
+        && fwrite(&checkpoint_version, 4, 1, f) == 1
+        && fwrite(&payload_size, 8, 1, f) == 1
+        && fwrite(&hash, 8, 1, f) == 1
+        && (payload.empty() || fwrite(payload.data(), payload.size(), 1, f) == 1)
+        && fflush(f) == 0;
+    #if !defined(_MSC_VER)
+    ok = ok && fsync(fileno(f)) == 0;
+    #endif
+    ok = (fclose(f) == 0) && ok;
+
+    #if defined(_MSC_VER)
+    //rename() does not overwrite on Windows
+    if (ok) {
+        std::remove(fname.c_str());
+    }
+    #endif
+    if (!ok || std::rename(tmp_fname.c_str(), fname.c_str()) != 0) {
+        std::cerr << "c WARNING: could not write checkpoint file '"
+        << fname << "': " << strerror(errno) << endl;
+        std::remove(tmp_fname.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+void CheckpointWriter::Stats::print() const
+{
+    cout << "c ------- CHECKPOINT WRITER STATS ---------" << endl;
+    print_stats_line("c checkpoints written", written);
+    print_stats_line("c checkpoints failed", failed);
+    print_stats_line("c checkpoint MB written"
+        , (double)bytes_written/(1024.0*1024.0)
+        , "MB"
+    );
+    print_stats_line("c checkpoint write time", write_time, "s");
+}
+
+bool CMSat::read_checkpoint_file(
+    const string& fname
+    , vector<char>& payload
+    , string& err
+) {
+    payload.clear();
+    FILE* f = fopen(fname.c_str(), "rb");
+    if (f == NULL) {
+        err = "cannot open file";
+        return false;
+    }
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t payload_size = 0;
+    uint64_t hash = 0;
+    bool ok = fread(&magic, 4, 1, f) == 1
+        && fread(&version, 4, 1, f) == 1
+        && fread(&payload_size, 8, 1, f) == 1
+        && fread(&hash, 8, 1, f) == 1;
+    if (!ok || magic != checkpoint_magic) {
+        err = "not a checkpoint file";
+        ok = false;
+    } else if (version != checkpoint_version) {
+        err = "checkpoint is of version " + std::to_string(version)
+            + " but this solver writes version " + std::to_string(checkpoint_version);
+        ok = false;
+    } else {
+        //Don't trust payload_size before having checked the file size
+        const long at = ftell(f);
+        ok = fseek(f, 0, SEEK_END) == 0;
+        const long end = ftell(f);
+        ok = ok && at >= 0 && end >= at
+            && (uint64_t)(end - at) == payload_size
+            && fseek(f, at, SEEK_SET) == 0;
+        if (ok) {
+            payload.resize(payload_size);
+            ok = payload.empty() || fread(payload.data(), payload.size(), 1, f) == 1;
+        }
+        if (!ok || checkpoint_hash(payload) != hash) {
+            err = "checkpoint is truncated or corrupted";
+            ok = false;
+        }
+    }
+    fclose(f);
+
+    if (!ok) {
+        payload.clear();
+    }
+    return ok;
+}
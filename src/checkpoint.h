@@ -0,0 +1,96 @@
+/******************************************
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef __CHECKPOINT_H__
+#define __CHECKPOINT_H__
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+namespace CMSat {
+
+using std::string;
+using std::vector;
+
+//Bump when the layout of the payload changes. Checkpoints of other versions
+//are ignored.
+static const uint32_t checkpoint_version = 1;
+
+//Writes checkpoints from a background thread. The solver serializes its
+//state into memory and hands it over, the file is written to "fname.tmp",
+//synced and then renamed over "fname". So a kill at any point leaves the
+//previous checkpoint intact. Only the latest submitted checkpoint is kept
+//if the writer falls behind.
+class CheckpointWriter
+{
+public:
+    explicit CheckpointWriter(const string& fname);
+    ~CheckpointWriter();
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    //Takes over the contents of "payload"
+    void submit(vector<char>& payload);
+    bool busy();
+    void wait_all_written();
+
+    struct Stats
+    {
+        uint64_t written = 0;
+        uint64_t failed = 0;
+        uint64_t bytes_written = 0;
+        double write_time = 0;
+
+        void print() const;
+    };
+    Stats get_stats();
+
+private:
+    void write_loop();
+    bool write_file(const vector<char>& payload);
+
+    const string fname;
+    vector<char> todo;
+    bool have_todo = false;
+    bool writing = false;
+    bool stop = false;
+    Stats stats;
+
+    std::mutex mu;
+    std::condition_variable cond_todo;
+    std::condition_variable cond_done;
+    std::thread writer;
+};
+
+//Reads the checkpoint written by CheckpointWriter and checks its header and
+//checksum. Returns false with "err" set if it is missing or unusable.
+bool read_checkpoint_file(
+    const string& fname
+    , vector<char>& payload
+    , string& err
+);
+
+}
+
+#endif //__CHECKPOINT_H__
@@ -199,6 +199,12 @@ Literals are allocated by an external allocator that allocates enough space
 for the class that it can hold the literals as well. I.e. it malloc()-s
     sizeof(Clause)+LENGHT*sizeof(Lit)
 to hold the clause.
+
+The ClauseStats and the abstraction of the clause are reached through the
+allocator (see ClauseAllocator::stats() and ClauseAllocator::abst()). With
+CLAUSE_STATS_SIDE_TABLE they are not stored here, but in a side table of the
+allocator, at stats_idx. Propagation only needs the size and the literals, so
+this keeps the header small.
 */
 class Clause
 {
@@ -211,7 +217,6 @@ public:
     uint16_t occurLinked:1;
     uint16_t must_recalc_abst:1;
     uint16_t _used_in_xor:1;
-    uint16_t _gauss_temp_cl:1; ///Used ONLY by Gaussian elimination to incicate where a proagation is coming from
     uint16_t reloced:1;
 
 
@@ -226,26 +231,20 @@ public:
     }
 
 public:
+    #ifdef CLAUSE_STATS_SIDE_TABLE
+    uint32_t stats_idx; ///<Index of the ClauseStats and abst in the allocator's side table
+    #else
     cl_abst_type abst;
     ClauseStats stats;
+    #endif
     uint32_t mySize;
 
+    ///The ClauseStats (and stats_idx) are set up by ClauseAllocator::Clause_new()
     template<class V>
-    Clause(const V& ps, const uint32_t _introduced_at_conflict
-        #ifdef STATS_NEEDED
-        , const int64_t _ID
-        #endif
-        )
+    explicit Clause(const V& ps)
     {
         //assert(ps.size() > 2);
 
-        stats.last_touched = _introduced_at_conflict;
-        #ifdef STATS_NEEDED
-        stats.introduced_at_conflict = _introduced_at_conflict;
-        stats.ID = _ID;
-        assert(_ID >= 0);
-        #endif
-        stats.glue = std::min<uint32_t>(stats.glue, ps.size());
         isFreed = false;
         mySize = ps.size();
         isRed = false;
@@ -254,7 +253,6 @@ public:
         is_ternary_resolved = false;
         must_recalc_abst = true;
         _used_in_xor = false;
-        _gauss_temp_cl = false;
         reloced = false;
 
         for (uint32_t i = 0; i < ps.size(); i++) {
@@ -270,16 +268,6 @@ public:
         return mySize;
     }
 
-    bool gauss_temp_cl() const
-    {
-        return _gauss_temp_cl;
-    }
-
-    void set_gauss_temp_cl()
-    {
-        _gauss_temp_cl = true;
-    }
-
     bool used_in_xor() const
     {
         return _used_in_xor;
@@ -316,12 +304,6 @@ public:
         return isFreed;
     }
 
-    void reCalcAbstraction()
-    {
-        abst = calcAbstraction(*this);
-        must_recalc_abst = false;
-    }
-
     void setStrenghtened()
     {
         must_recalc_abst = true;
@@ -329,13 +311,6 @@ public:
         //is_distilled = false; //TODO?
     }
 
-    void recalc_abst_if_needed()
-    {
-        if (must_recalc_abst) {
-            reCalcAbstraction();
-        }
-    }
-
     Lit& operator [] (const uint32_t i)
     {
         return *(getData() + i);
@@ -346,19 +321,16 @@ public:
         return *(getData() + i);
     }
 
+    ///The ClauseStats::ID must be reset by the caller
     void makeIrred()
     {
         assert(isRed);
-        #if STATS_NEEDED
-        stats.ID = 0;
-        #endif
         isRed = false;
     }
 
-    void makeRed(const uint32_t newGlue, const double init_activity = 1.0)
+    ///The glue and activity in the ClauseStats must be set by the caller
+    void makeRed()
     {
-        stats.glue = newGlue;
-        stats.activity = init_activity;
         isRed = true;
     }
 
@@ -423,11 +395,6 @@ public:
         isFreed = true;
     }
 
-    void combineStats(const ClauseStats& other)
-    {
-        stats = ClauseStats::combineStats(stats, other);
-    }
-
     void set_distilled(bool distilled)
     {
         is_distilled = distilled;
@@ -448,7 +415,7 @@ public:
         occurLinked = toset;
     }
 
-    void print_extra_stats() const
+    void print_extra_stats(const ClauseStats& stats) const
     {
         cout
         << "Clause size " << std::setw(4) << size();
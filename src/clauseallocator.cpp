@@ -34,15 +34,18 @@ THE SOFTWARE.
 #include "searcher.h"
 #include "time_mem.h"
 #include "sqlstats.h"
-#ifdef USE_GAUSS
-#include "EGaussian.h"
-#endif
 
 #ifdef USE_VALGRIND
 #include "valgrind/valgrind.h"
 #include "valgrind/memcheck.h"
 #endif
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#define CL_ALLOC_MMAP
+#endif
+
 using namespace CMSat;
 
 using std::pair;
@@ -61,6 +64,18 @@ using std::endl;
 
 #define MAXSIZE ((1ULL << (EFFECTIVELY_USEABLE_BITS))-1)
 
+//Freed clauses of at most this many datapieces are kept for reuse
+#define MAX_REUSE_SIZE 256
+
+//Address space reserved up front for the stack, at most
+#define MAX_RESERVE_BYTES (1ULL << 40)
+#define RESERVE_ALIGN (2ULL*1024ULL*1024ULL)
+
+//Size of a region for incremental consolidation, in datapieces
+#define REGION_ELEMS (1ULL << 20)
+//Only regions with less used than this are evacuated
+#define REGION_MAX_USED_RATIO 0.5
+
 ClauseAllocator::ClauseAllocator() :
     dataStart(NULL)
     , size(0)
@@ -75,18 +90,103 @@ ClauseAllocator::ClauseAllocator() :
 */
 ClauseAllocator::~ClauseAllocator()
 {
-    free(dataStart);
+    arena_release(dataStart, reserved);
+}
+
+uint64_t ClauseAllocator::elems_needed(const uint32_t num_lits)
+{
+    uint64_t neededbytes = sizeof(Clause) + sizeof(Lit)*num_lits;
+    return neededbytes/sizeof(BASE_DATA_TYPE) + (bool)(neededbytes % sizeof(BASE_DATA_TYPE));
 }
 
 void* ClauseAllocator::allocEnough(
     uint32_t num_lits
 ) {
-    //Try to quickly find a place at the end of a dataStart
-    uint64_t neededbytes = sizeof(Clause) + sizeof(Lit)*num_lits;
-    uint64_t needed
-        = neededbytes/sizeof(BASE_DATA_TYPE) + (bool)(neededbytes % sizeof(BASE_DATA_TYPE));
+    //May move dataStart
+    const ClOffset offset = alloc_elems(elems_needed(num_lits));
+    return dataStart + offset;
+}
+
+#ifdef CLAUSE_STATS_SIDE_TABLE
+uint32_t ClauseAllocator::new_stats_idx()
+{
+    uint32_t idx;
+    if (!free_stats_idx.empty()) {
+        idx = free_stats_idx.back();
+        free_stats_idx.pop_back();
+        cl_stats[idx] = ClauseStats();
+    } else {
+        idx = cl_stats.size();
+        cl_stats.push_back(ClauseStats());
+        cl_abst.push_back(0);
+    }
+
+    return idx;
+}
+#endif
+
+ClOffset ClauseAllocator::alloc_elems(const uint64_t needed)
+{
+    ClOffset offset;
+
+    if (needed < free_lists.size() && !free_lists[needed].empty()) {
+        //Reuse the place of a freed clause of the same size
+        offset = free_lists[needed].back();
+        free_lists[needed].pop_back();
+        free_list_size -= needed;
+        num_reused++;
+    } else if (hole_at + needed <= hole_end) {
+        //Continue in the evacuated region
+        offset = hole_at;
+        hole_at += needed;
+    } else if (!free_regions.empty() && needed <= REGION_ELEMS) {
+        //Start on a new evacuated region
+        const uint32_t r = free_regions.back();
+        free_regions.pop_back();
+        region_free[r] = false;
+        offset = (uint64_t)r*REGION_ELEMS;
+        hole_at = offset + needed;
+        hole_end = offset + REGION_ELEMS;
+    } else {
+        //Try to quickly find a place at the end of a dataStart
+        if (size + needed > capacity) {
+            grow(needed);
+        }
+        offset = size;
+        size += needed;
+    }
+
+    currentlyUsedSize += needed;
+    account(offset, needed, true);
 
-    if (size + needed > capacity) {
+    return offset;
+}
+
+///Adds or removes the datapieces at offset to the use of the regions they are in
+void ClauseAllocator::account(const ClOffset offset, const uint64_t elems, const bool add)
+{
+    const uint64_t end = (uint64_t)offset + elems;
+    if (region_used.size() < (end + REGION_ELEMS - 1)/REGION_ELEMS) {
+        region_used.resize((end + REGION_ELEMS - 1)/REGION_ELEMS, 0);
+        region_free.resize(region_used.size(), false);
+    }
+
+    for(uint64_t at = offset; at < end; ) {
+        const uint64_t r = at/REGION_ELEMS;
+        const uint64_t num = std::min<uint64_t>(end, (r+1)*REGION_ELEMS) - at;
+        if (add) {
+            region_used[r] += num;
+        } else {
+            //Freed size is an estimate, don't underflow
+            region_used[r] -= std::min(region_used[r], num);
+        }
+        at += num;
+    }
+}
+
+void ClauseAllocator::grow(const uint64_t needed)
+{
+    {
         //Grow by default, but don't go under or over the limits
         uint64_t newcapacity = capacity * ALLOC_GROW_MULT;
         newcapacity = std::max<size_t>(newcapacity, MIN_LIST_SIZE);
@@ -120,6 +220,23 @@ void* ClauseAllocator::allocEnough(
             throw std::bad_alloc();
         }
 
+        #ifdef CL_ALLOC_MMAP
+        if (newcapacity > reserved) {
+            //Only happens if the address space could not be reserved up front
+            uint64_t new_reserved;
+            BASE_DATA_TYPE* new_dataStart = arena_reserve(newcapacity, new_reserved);
+            arena_commit(new_dataStart, newcapacity);
+            if (size > 0) {
+                memcpy(new_dataStart, dataStart, size*sizeof(BASE_DATA_TYPE));
+            }
+            arena_release(dataStart, reserved);
+            dataStart = new_dataStart;
+            reserved = new_reserved;
+        } else {
+            //Grow in place
+            arena_commit(dataStart, newcapacity);
+        }
+        #else
         //Reallocate data
         BASE_DATA_TYPE* new_dataStart;
         new_dataStart = (BASE_DATA_TYPE*)realloc(
@@ -136,17 +253,104 @@ void* ClauseAllocator::allocEnough(
             throw std::bad_alloc();
         }
         dataStart = new_dataStart;
+        #endif
 
         //Update capacity to reflect the update
         capacity = newcapacity;
     }
+}
 
-    //Add clause to the set
-    Clause* pointer = (Clause*)(dataStart + size);
-    size += needed;
-    currentlyUsedSize += needed;
+/**
+@brief Reserves address space for at least min_elems datapieces
+
+Nothing is usable until arena_commit(). Reserves as much as the offsets can
+address (but at most MAX_RESERVE_BYTES), so the stack can later grow in place.
+*/
+BASE_DATA_TYPE* ClauseAllocator::arena_reserve(
+    const uint64_t min_elems
+    , uint64_t& reserved_elems
+) const {
+    #ifdef CL_ALLOC_MMAP
+    const uint64_t min_bytes =
+        (min_elems*sizeof(BASE_DATA_TYPE) + RESERVE_ALIGN - 1) & ~(RESERVE_ALIGN - 1);
+    uint64_t bytes = std::min<uint64_t>(MAXSIZE, MAX_RESERVE_BYTES/sizeof(BASE_DATA_TYPE))
+        * sizeof(BASE_DATA_TYPE);
+    bytes = std::max<uint64_t>(bytes & ~(RESERVE_ALIGN - 1), min_bytes);
+
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    #ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+    #endif
+    while(true) {
+        //Over-reserve, so the start can be aligned for huge pages
+        void* mem = mmap(NULL, bytes + RESERVE_ALIGN, PROT_NONE, flags, -1, 0);
+        if (mem != MAP_FAILED) {
+            const uintptr_t start = (uintptr_t)mem;
+            const uintptr_t aligned = (start + RESERVE_ALIGN - 1) & ~(uintptr_t)(RESERVE_ALIGN - 1);
+            if (aligned != start) {
+                munmap(mem, aligned - start);
+            }
+            munmap((void*)(aligned + bytes), RESERVE_ALIGN - (aligned - start));
+
+            #ifdef MADV_HUGEPAGE
+            if (huge_pages) {
+                madvise((void*)aligned, bytes, MADV_HUGEPAGE);
+            }
+            #endif
+
+            reserved_elems = bytes/sizeof(BASE_DATA_TYPE);
+            return (BASE_DATA_TYPE*)aligned;
+        }
+
+        //E.g. address space limit (ulimit -v), try with less
+        if (bytes/2 < min_bytes) {
+            std::cerr
+            << "ERROR: while reserving clause space"
+            << endl;
+
+            throw std::bad_alloc();
+        }
+        bytes = std::max<uint64_t>((bytes/2) & ~(RESERVE_ALIGN - 1), min_bytes);
+    }
+    #else
+    BASE_DATA_TYPE* mem = (BASE_DATA_TYPE*)malloc(min_elems*sizeof(BASE_DATA_TYPE));
+    if (mem == NULL) {
+        throw std::bad_alloc();
+    }
+    reserved_elems = min_elems;
+    return mem;
+    #endif
+}
+
+///Makes the first elems datapieces of a reserved range usable
+void ClauseAllocator::arena_commit(BASE_DATA_TYPE* start, const uint64_t elems) const
+{
+    #ifdef CL_ALLOC_MMAP
+    const uint64_t page = sysconf(_SC_PAGESIZE);
+    const uint64_t bytes = (elems*sizeof(BASE_DATA_TYPE) + page - 1) & ~(page - 1);
+    if (mprotect(start, bytes, PROT_READ | PROT_WRITE) != 0) {
+        std::cerr
+        << "ERROR: while committing clause space"
+        << endl;
 
-    return pointer;
+        throw std::bad_alloc();
+    }
+    #else
+    (void)start;
+    (void)elems;
+    #endif
+}
+
+void ClauseAllocator::arena_release(BASE_DATA_TYPE* start, const uint64_t reserved_elems) const
+{
+    #ifdef CL_ALLOC_MMAP
+    if (start != NULL) {
+        munmap(start, reserved_elems*sizeof(BASE_DATA_TYPE));
+    }
+    #else
+    (void)reserved_elems;
+    free(start);
+    #endif
 }
 
 /**
@@ -177,28 +381,21 @@ void ClauseAllocator::clauseFree(Clause* cl)
 {
     assert(!cl->freed());
 
-    bool quick_freed = false;
-    #ifdef USE_GAUSS
-    if (cl->gauss_temp_cl()) {
-        uint64_t neededbytes = (sizeof(Clause) + sizeof(Lit)*cl->size());
-        uint64_t needed
-            = neededbytes/sizeof(BASE_DATA_TYPE) + (bool)(neededbytes % sizeof(BASE_DATA_TYPE));
-
-        if (((BASE_DATA_TYPE*)cl + needed) == (dataStart + size)) {
-            size -= needed;
-            currentlyUsedSize -= needed;
-            quick_freed = true;
-        }
-    }
+    cl->setFreed();
+    #ifdef CLAUSE_STATS_SIDE_TABLE
+    stats_idx_pending.push_back(cl->stats_idx);
     #endif
-
-    if (!quick_freed) {
-        cl->setFreed();
-        uint64_t est_num_cl = cl->size();
-        est_num_cl = std::max(est_num_cl, (uint64_t)3); //we sometimes allow gauss to allocate 3-long clauses
-        uint64_t bytes_freed = sizeof(Clause) + est_num_cl*sizeof(Lit);
-        uint64_t elems_freed = bytes_freed/sizeof(BASE_DATA_TYPE) + (bool)(bytes_freed % sizeof(BASE_DATA_TYPE));
-        currentlyUsedSize -= elems_freed;
+    uint64_t bytes_freed = sizeof(Clause) + cl->size()*sizeof(Lit);
+    uint64_t elems_freed = bytes_freed/sizeof(BASE_DATA_TYPE) + (bool)(bytes_freed % sizeof(BASE_DATA_TYPE));
+    currentlyUsedSize -= elems_freed;
+    account(get_offset(cl), elems_freed, false);
+
+    //Only when the freed amount is exactly what the size class will hold
+    if (reuse
+        && cl->size() >= 3
+        && elems_freed <= MAX_REUSE_SIZE
+    ) {
+        freed_pending.push_back(get_offset(cl));
     }
 
     #ifdef VALGRIND_MAKE_MEM_UNDEFINED
@@ -212,6 +409,40 @@ void ClauseAllocator::clauseFree(ClOffset offset)
     clauseFree(cl);
 }
 
+void ClauseAllocator::release_freed()
+{
+    for(const ClOffset offset: freed_pending) {
+        const uint64_t needed = elems_needed(ptr(offset)->size());
+        if (free_lists.size() <= needed) {
+            free_lists.resize(needed+1);
+        }
+        free_lists[needed].push_back(offset);
+        free_list_size += needed;
+    }
+    freed_pending.clear();
+
+    #ifdef CLAUSE_STATS_SIDE_TABLE
+    free_stats_idx.insert(free_stats_idx.end()
+        , stats_idx_pending.begin(), stats_idx_pending.end());
+    stats_idx_pending.clear();
+    #endif
+}
+
+///Must also only be called when no offset of a freed clause is held anywhere
+void ClauseAllocator::clear_free_lists()
+{
+    freed_pending.clear();
+    #ifdef CLAUSE_STATS_SIDE_TABLE
+    free_stats_idx.insert(free_stats_idx.end()
+        , stats_idx_pending.begin(), stats_idx_pending.end());
+    stats_idx_pending.clear();
+    #endif
+    for(auto& fl: free_lists) {
+        fl.clear();
+    }
+    free_list_size = 0;
+}
+
 ClOffset ClauseAllocator::move_cl(
     ClOffset* newDataStart
     , ClOffset*& new_ptr
@@ -239,17 +470,16 @@ void ClauseAllocator::move_one_watchlist(
         if (w.isClause()) {
             Clause* old = ptr(w.get_offset());
             assert(!old->freed());
-            Lit blocked = w.getBlockedLit();
+            ClOffset new_offset;
             if (old->reloced) {
-                ClOffset new_offset = (*old)[0].toInt();
+                new_offset = (*old)[0].toInt();
                 #ifdef LARGE_OFFSETS
                 new_offset += ((uint64_t)(*old)[1].toInt())<<32;
                 #endif
-                w = Watched(new_offset, blocked);
             } else {
-                ClOffset new_offset = move_cl(newDataStart, new_ptr, old);
-                w = Watched(new_offset, blocked);
+                new_offset = move_cl(newDataStart, new_ptr, old);
             }
+            w.set_offset(new_offset);
         }
     }
 }
@@ -272,8 +502,13 @@ void ClauseAllocator::consolidate(
     //1) There is too much memory allocated. Re-allocation will save space
     //   Avoiding segfault (max is 16 outerOffsets, more than 10 is near)
     //2) There is too much empty, unused space (>30%)
+    //Space in the free lists will be reused, so it's only counted as empty
+    //when there is a lot of it. Evacuated regions are not counted at all.
+    const uint64_t span = size - unused_in_regions();
     if (!force
-        && (float_div(currentlyUsedSize, size) > 0.8 || currentlyUsedSize < (100ULL*1000ULL))
+        && ((float_div(currentlyUsedSize + free_list_size, span) > 0.8
+                && float_div(currentlyUsedSize, span) > 0.5)
+            || currentlyUsedSize < (100ULL*1000ULL))
     ) {
         if (solver->conf.verbosity >= 3
             || (lower_verb && solver->conf.verbosity)
@@ -282,10 +517,16 @@ void ClauseAllocator::consolidate(
         }
         return;
     }
+    if (!force && solver->conf.cl_compact_incremental) {
+        compact(solver, lower_verb);
+        return;
+    }
     const double myTime = cpuTime();
 
     //Pointers that will be moved along
-    BASE_DATA_TYPE * const newDataStart = (BASE_DATA_TYPE*)malloc(currentlyUsedSize*sizeof(BASE_DATA_TYPE));
+    uint64_t new_reserved;
+    BASE_DATA_TYPE * const newDataStart = arena_reserve(currentlyUsedSize, new_reserved);
+    arena_commit(newDataStart, currentlyUsedSize);
     BASE_DATA_TYPE * new_ptr = newDataStart;
 
     assert(sizeof(BASE_DATA_TYPE) % sizeof(Lit) == 0);
@@ -315,29 +556,6 @@ void ClauseAllocator::consolidate(
         }
     }
 
-    #ifdef USE_GAUSS
-    for (EGaussian* gauss : solver->gmatrixes) {
-        if (gauss == NULL) {
-            continue;
-        }
-
-        for(auto& gcl: gauss->clauses_toclear) {
-            Clause* old = ptr(gcl.first);
-            if (old->reloced) {
-                ClOffset new_offset = (*old)[0].toInt();
-                #ifdef LARGE_OFFSETS
-                new_offset += ((uint64_t)(*old)[1].toInt())<<32;
-                #endif
-                gcl.first = new_offset;
-            } else {
-                ClOffset new_offset = move_cl(newDataStart, new_ptr, old);
-                gcl.first = new_offset;
-            }
-            assert(!old->freed());
-        }
-    }
-    #endif //USE_GAUSS
-
     update_offsets(solver->longIrredCls);
     for(auto& lredcls: solver->longRedCls) {
         update_offsets(lredcls);
@@ -370,8 +588,11 @@ void ClauseAllocator::consolidate(
     size = new_ptr-newDataStart;
     capacity = currentlyUsedSize;
     currentlyUsedSize = size;
-    free(dataStart);
+    arena_release(dataStart, reserved);
     dataStart = newDataStart;
+    reserved = new_reserved;
+    clear_free_lists();
+    reset_regions();
 
     const double time_used = cpuTime() - myTime;
     if (solver->conf.verbosity >= 2
@@ -386,6 +607,7 @@ void ClauseAllocator::consolidate(
         cout << " old-sz: "; print_value_kilo_mega(old_size*sizeof(BASE_DATA_TYPE));
         cout << " new-sz: "; print_value_kilo_mega(size*sizeof(BASE_DATA_TYPE));
         cout << " new bits offs: " << std::fixed << std::setprecision(2) << log_2_size;
+        cout << " reused: " << num_reused;
         cout << solver->conf.print_times(time_used)
         << endl;
     }
@@ -416,6 +638,247 @@ size_t ClauseAllocator::mem_used() const
 {
     uint64_t mem = 0;
     mem += capacity*sizeof(BASE_DATA_TYPE);
+    #ifdef CLAUSE_STATS_SIDE_TABLE
+    mem += cl_stats.capacity()*sizeof(ClauseStats);
+    mem += cl_abst.capacity()*sizeof(cl_abst_type);
+    mem += (free_stats_idx.capacity() + stats_idx_pending.capacity())*sizeof(uint32_t);
+    #endif
+    #ifdef CL_ALLOC_MMAP
+    //Evacuated regions are given back to the OS
+    mem -= free_regions.size()*REGION_ELEMS*sizeof(BASE_DATA_TYPE);
+    #endif
 
     return mem;
 }
+
+///After a full consolidation, the clauses are packed from the start
+void ClauseAllocator::reset_regions()
+{
+    region_used.assign((size + REGION_ELEMS - 1)/REGION_ELEMS, REGION_ELEMS);
+    if (size % REGION_ELEMS != 0) {
+        region_used.back() = size % REGION_ELEMS;
+    }
+    region_free.assign(region_used.size(), false);
+    free_regions.clear();
+    hole_at = 0;
+    hole_end = 0;
+}
+
+///Datapieces below the top of the stack that are free for new clauses
+uint64_t ClauseAllocator::unused_in_regions() const
+{
+    return free_regions.size()*REGION_ELEMS + (hole_end - hole_at);
+}
+
+ClOffset ClauseAllocator::forwarded(const Clause* cl) const
+{
+    assert(cl->reloced);
+    ClOffset new_offset = (*cl)[0].toInt();
+    #ifdef LARGE_OFFSETS
+    new_offset += ((uint64_t)(*cl)[1].toInt())<<32;
+    #endif
+    return new_offset;
+}
+
+/**
+@brief Moves the clause out of the evacuated regions, if it's in one
+
+Leaves the new offset in the old place, the same way as move_cl()
+*/
+ClOffset ClauseAllocator::evacuate_cl(
+    const ClOffset offset
+    , const vector<char>& evac
+    , vector<char>& moved_from
+) {
+    const Clause* cl = ptr(offset);
+    if (cl->reloced) {
+        return forwarded(cl);
+    }
+
+    const uint64_t needed = elems_needed(cl->size());
+    bool inside = false;
+    for(uint64_t r = offset/REGION_ELEMS; r <= (offset+needed-1)/REGION_ELEMS; r++) {
+        inside |= evac[r];
+    }
+    if (!inside) {
+        return offset;
+    }
+
+    //May grow the stack, so the clause is only accessed afterwards
+    const ClOffset new_offset = alloc_elems(needed);
+    Clause* old = ptr(offset);
+    memcpy(dataStart + new_offset, old, needed*sizeof(BASE_DATA_TYPE));
+    (*old)[0] = Lit::toLit(new_offset & 0xFFFFFFFF);
+    #ifdef LARGE_OFFSETS
+    (*old)[1] = Lit::toLit((new_offset>>32) & 0xFFFFFFFF);
+    #endif
+    old->reloced = true;
+
+    currentlyUsedSize -= needed;
+    account(offset, needed, false);
+    moved_from[offset/REGION_ELEMS] = true;
+    compact_stats.bytes_moved += needed*sizeof(BASE_DATA_TYPE);
+
+    return new_offset;
+}
+
+void ClauseAllocator::forward_offsets(
+    vector<ClOffset>& offsets
+    , const vector<char>& evac
+    , vector<char>& moved_from
+) {
+    for(ClOffset& offs: offsets) {
+        offs = evacuate_cl(offs, evac, moved_from);
+    }
+}
+
+/**
+@brief Evacuates the sparsest regions of the stack
+
+Only the clauses in the chosen regions are moved, and the amount of memory
+moved is limited, so unlike a full consolidation, this does not pause for long.
+The watchlists still have to be walked to update the offsets, but only the
+clauses that start in regions clauses were moved from are accessed.
+*/
+void ClauseAllocator::compact(Solver* solver, bool lower_verb)
+{
+    const double myTime = cpuTime();
+    const uint64_t max_moved =
+        (uint64_t)solver->conf.cl_compact_max_mb*1024ULL*1024ULL/sizeof(BASE_DATA_TYPE);
+
+    //Only full regions below the top, and not the one being allocated from
+    const uint64_t num_full = size/REGION_ELEMS;
+    const uint64_t hole_region = (hole_at < hole_end) ? (hole_end-1)/REGION_ELEMS : num_full;
+    vector<std::pair<uint64_t, uint32_t> > cands;
+    for(uint64_t r = 0; r < num_full; r++) {
+        if (!region_free[r]
+            && r != hole_region
+            && region_used[r] < REGION_ELEMS*REGION_MAX_USED_RATIO
+        ) {
+            cands.push_back(std::make_pair(region_used[r], (uint32_t)r));
+        }
+    }
+    std::sort(cands.begin(), cands.end());
+
+    vector<char> evac(region_used.size(), false);
+    uint64_t to_move = 0;
+    uint64_t num_evac = 0;
+    for(const auto& c: cands) {
+        if (num_evac > 0 && to_move + c.first > max_moved) {
+            break;
+        }
+        evac[c.second] = true;
+        to_move += c.first;
+        num_evac++;
+    }
+    if (num_evac == 0) {
+        if (solver->conf.verbosity >= 3
+            || (lower_verb && solver->conf.verbosity)
+        ) {
+            cout << "c Not consolidating memory, no sparse regions." << endl;
+        }
+        return;
+    }
+
+    //Free lists may point into the evacuated regions
+    clear_free_lists();
+    const uint64_t bytes_moved_before = compact_stats.bytes_moved;
+    vector<char> moved_from(region_used.size(), false);
+
+    forward_offsets(solver->longIrredCls, evac, moved_from);
+    for(auto& lredcls: solver->longRedCls) {
+        forward_offsets(lredcls, evac, moved_from);
+    }
+
+    for(auto& ws: solver->watches) {
+        for(Watched& w: ws) {
+            if (w.isClause() && moved_from[w.get_offset()/REGION_ELEMS]) {
+                const Clause* cl = ptr(w.get_offset());
+                assert(!cl->freed());
+                if (cl->reloced) {
+                    w.set_offset(forwarded(cl));
+                }
+            }
+        }
+    }
+
+    //Fix up propBy
+    for (size_t i = 0; i < solver->nVars(); i++) {
+        VarData& vdata = solver->varData[i];
+        if (vdata.reason.isClause()) {
+            if (vdata.removed == Removed::none
+                && solver->decisionLevel() >= vdata.level
+                && vdata.level != 0
+                && solver->value(i) != l_Undef
+            ) {
+                const Clause* cl = ptr(vdata.reason.get_offset());
+                if (cl->reloced) {
+                    vdata.reason = PropBy(forwarded(cl));
+                }
+            } else {
+                vdata.reason = PropBy();
+            }
+        }
+    }
+
+    //The evacuated regions can now be used for new clauses
+    for(uint32_t r = 0; r < evac.size(); r++) {
+        if (!evac[r]) {
+            continue;
+        }
+        region_used[r] = 0;
+        region_free[r] = true;
+        free_regions.push_back(r);
+        #if defined(CL_ALLOC_MMAP) && defined(MADV_DONTNEED)
+        madvise(dataStart + (uint64_t)r*REGION_ELEMS
+            , REGION_ELEMS*sizeof(BASE_DATA_TYPE), MADV_DONTNEED);
+        #endif
+    }
+
+    const double time_used = cpuTime() - myTime;
+    compact_stats.calls++;
+    compact_stats.regions += num_evac;
+    compact_stats.time_total += time_used;
+    compact_stats.time_max = std::max(compact_stats.time_max, time_used);
+
+    if (solver->conf.verbosity >= 2
+        || (lower_verb && solver->conf.verbosity)
+    ) {
+        cout << "c [mem] compact"
+        << " regions: " << num_evac
+        << " moved: "; print_value_kilo_mega(compact_stats.bytes_moved - bytes_moved_before);
+        cout << " free regions: " << free_regions.size()
+        << " reused: " << num_reused
+        << solver->conf.print_times(time_used)
+        << endl;
+    }
+    if (solver->sqlStats) {
+        solver->sqlStats->time_passed_min(
+            solver
+            , "compact"
+            , time_used
+        );
+    }
+}
+
+void ClauseAllocator::CompactStats::print(const double cpu_time) const
+{
+    print_stats_line("c compact time"
+        , time_total
+        , stats_line_percent(time_total, cpu_time)
+        , "% time"
+    );
+    print_stats_line("c compact max pause"
+        , time_max
+        , "s"
+    );
+    print_stats_line("c compact calls"
+        , calls
+        , float_div(regions, calls)
+        , "regions/call"
+    );
+    print_stats_line("c compact moved"
+        , bytes_moved/(1024UL*1024UL)
+        , "MB"
+    );
+}
@@ -51,6 +51,18 @@ needed. When instructed, it consolidates the unused space (i.e. clauses free()-e
 Essentially, it is a stack-like allocator for clauses. It is useful to have
 this, because this way, we can address clauses according to their number,
 which is 32-bit, instead of their address, which might be 64-bit
+
+Where mmap() is available, the stack is a large reserved address range that is
+made usable as needed, so it grows in place instead of being realloc()-ed.
+
+The space of freed clauses can be reused for new clauses of the same size, but
+only after release_freed() has been called: until then, offsets of freed
+clauses may still be checked via Clause::freed()
+
+For the accounting of consolidation, the stack is split into fixed-size
+regions. A non-forced consolidation only evacuates the sparsest regions (up to
+a limit of moved memory), and the evacuated regions are then used for new
+clauses
 */
 class ClauseAllocator {
     public:
@@ -68,17 +80,85 @@ class ClauseAllocator {
             }
 
             void* mem = allocEnough(ps.size());
-            Clause* real = new (mem) Clause(ps, conflictNum
+            Clause* real = new (mem) Clause(ps);
+            #ifdef CLAUSE_STATS_SIDE_TABLE
+            real->stats_idx = new_stats_idx();
+            #endif
+
+            ClauseStats& s = stats(real);
+            s.last_touched = conflictNum;
             #ifdef STATS_NEEDED
-            , ID
+            s.introduced_at_conflict = conflictNum;
+            s.ID = ID;
+            assert(ID >= 0);
             #endif
-            );
+            s.glue = std::min<uint32_t>(s.glue, ps.size());
 
             return real;
         }
 
         ClOffset get_offset(const Clause* ptr) const;
 
+        #ifdef CLAUSE_STATS_SIDE_TABLE
+        ///The returned reference is only valid until the next Clause_new()
+        ClauseStats& stats(const Clause* cl)
+        {
+            return cl_stats[cl->stats_idx];
+        }
+        const ClauseStats& stats(const Clause* cl) const
+        {
+            return cl_stats[cl->stats_idx];
+        }
+        cl_abst_type abst(const Clause* cl) const
+        {
+            return cl_abst[cl->stats_idx];
+        }
+        void recalc_abst_if_needed(Clause* cl)
+        {
+            if (cl->must_recalc_abst) {
+                cl_abst[cl->stats_idx] = calcAbstraction(*cl);
+                cl->must_recalc_abst = false;
+            }
+        }
+        #else
+        ClauseStats& stats(const Clause* cl)
+        {
+            //As with the side table, the stats can be changed through a const Clause
+            return const_cast<Clause*>(cl)->stats;
+        }
+        const ClauseStats& stats(const Clause* cl) const
+        {
+            return cl->stats;
+        }
+        cl_abst_type abst(const Clause* cl) const
+        {
+            return cl->abst;
+        }
+        void recalc_abst_if_needed(Clause* cl)
+        {
+            if (cl->must_recalc_abst) {
+                cl->abst = calcAbstraction(*cl);
+                cl->must_recalc_abst = false;
+            }
+        }
+        #endif
+        ClauseStats& stats(const Clause& cl)
+        {
+            return stats(&cl);
+        }
+        const ClauseStats& stats(const Clause& cl) const
+        {
+            return stats(&cl);
+        }
+        cl_abst_type abst(const Clause& cl) const
+        {
+            return abst(&cl);
+        }
+        void recalc_abst_if_needed(Clause& cl)
+        {
+            recalc_abst_if_needed(&cl);
+        }
+
         inline Clause* ptr(const ClOffset offset) const
         {
             return (Clause*)(&dataStart[offset]);
@@ -87,6 +167,12 @@ class ClauseAllocator {
         void clauseFree(Clause* c); ///Frees memory and associated clause number
         void clauseFree(ClOffset offset);
 
+        ///Makes the space (and stats) of the clauses freed so far reusable. Call only
+        ///when no offset of a freed clause is held anywhere
+        void release_freed();
+        void set_huge_pages(const bool huge);
+        void set_reuse(const bool reuse);
+
         void consolidate(
             Solver* solver
             , const bool force = false
@@ -95,6 +181,18 @@ class ClauseAllocator {
 
         size_t mem_used() const;
 
+        struct CompactStats
+        {
+            uint64_t calls = 0;
+            uint64_t regions = 0; ///<Regions evacuated
+            uint64_t bytes_moved = 0;
+            double time_total = 0;
+            double time_max = 0; ///<Longest pause
+
+            void print(const double cpu_time) const;
+        };
+        const CompactStats& get_compact_stats() const;
+
     private:
         void update_offsets(vector<ClOffset>& offsets);
         void move_one_watchlist(
@@ -123,10 +221,69 @@ class ClauseAllocator {
         overestimation almost all the time
         */
         uint64_t currentlyUsedSize;
+        uint64_t reserved = 0; ///<The number of BASE_DATA_TYPE datapieces of address space at dataStart
+        bool huge_pages = true;
 
         void* allocEnough(const uint32_t num_lits);
+        #ifdef CLAUSE_STATS_SIDE_TABLE
+        uint32_t new_stats_idx();
+        #endif
+        ClOffset alloc_elems(const uint64_t needed);
+        static uint64_t elems_needed(const uint32_t num_lits);
+        void grow(const uint64_t needed);
+
+        //Backing memory of the stack
+        BASE_DATA_TYPE* arena_reserve(const uint64_t min_elems, uint64_t& reserved_elems) const;
+        void arena_commit(BASE_DATA_TYPE* start, const uint64_t elems) const;
+        void arena_release(BASE_DATA_TYPE* start, const uint64_t reserved_elems) const;
+
+        //Reuse of freed clauses' space
+        bool reuse = true;
+        vector<ClOffset> freed_pending; ///<Freed, but the offsets may still be around
+        vector<vector<ClOffset> > free_lists; ///<free_lists[N]: free places of N datapieces
+        uint64_t free_list_size = 0; ///<Sum of the datapieces in free_lists
+        uint64_t num_reused = 0;
+        void clear_free_lists();
+
+        #ifdef CLAUSE_STATS_SIDE_TABLE
+        //Side table of the clauses' stats and abstractions, see Clause::stats_idx
+        vector<ClauseStats> cl_stats;
+        vector<cl_abst_type> cl_abst;
+        vector<uint32_t> free_stats_idx;
+        vector<uint32_t> stats_idx_pending; ///<Of freed clauses, not yet reusable
+        #endif
+
+        //Regions, for incremental consolidation
+        vector<uint64_t> region_used; ///<Estimated datapieces used in each region
+        vector<char> region_free; ///<Evacuated, not used for anything
+        vector<uint32_t> free_regions;
+        uint64_t hole_at = 0; ///<Allocation point within an evacuated region
+        uint64_t hole_end = 0;
+        CompactStats compact_stats;
+        void account(const ClOffset offset, const uint64_t elems, const bool add);
+        void reset_regions();
+        uint64_t unused_in_regions() const;
+        void compact(Solver* solver, bool lower_verb);
+        ClOffset evacuate_cl(const ClOffset offset, const vector<char>& evac, vector<char>& moved_from);
+        void forward_offsets(vector<ClOffset>& offsets, const vector<char>& evac, vector<char>& moved_from);
+        ClOffset forwarded(const Clause* cl) const;
 };
 
+inline const ClauseAllocator::CompactStats& ClauseAllocator::get_compact_stats() const
+{
+    return compact_stats;
+}
+
+inline void ClauseAllocator::set_huge_pages(const bool huge)
+{
+    huge_pages = huge;
+}
+
+inline void ClauseAllocator::set_reuse(const bool _reuse)
+{
+    reuse = _reuse;
+}
+
 } //end namespace
 
 #endif //CLAUSEALLOCATOR_H
@@ -154,12 +154,20 @@ void ClauseCleaner::clean_clauses_inter(vector<ClOffset>& cs)
 
         const Lit origLit1 = cl[0];
         const Lit origLit2 = cl[1];
+        #ifdef INLINE_TERNARY
+        const Lit origLit3 = cl[2];
+        #endif
         const auto origSize = cl.size();
         const bool red = cl.red();
 
         if (clean_clause(cl)) {
             solver->watches.smudge(origLit1);
             solver->watches.smudge(origLit2);
+            #ifdef INLINE_TERNARY
+            if (origSize == 3) {
+                solver->watches.smudge(origLit3);
+            }
+            #endif
             cl.setRemoved();
             if (red) {
                 solver->litStats.redLits -= origSize;
@@ -185,6 +193,12 @@ inline bool ClauseCleaner::clean_clause(Clause& cl)
     Lit l2 = cl[1];
     num_false_begin += solver->value(cl[0]) == l_False;
     num_false_begin += solver->value(cl[1]) == l_False;
+    #ifdef INLINE_TERNARY
+    //watched in all 3 literals, any of them can be false
+    if (cl.size() == 3) {
+        num_false_begin = 0;
+    }
+    #endif
     #endif
 
     Lit *i, *j, *end;
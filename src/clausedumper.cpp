@@ -51,6 +51,67 @@ void ClauseDumper::dump_irred_clauses(std::ostream *out) {
     }
 }
 
+/**
+@brief Same clauses as dump_irred_clauses(), into buf in outer numbering
+
+Each clause is preceded by lit_Undef, as in the SATSolver clause buffer, so
+the result can be added to another solver to get an equivalent problem.
+*/
+void ClauseDumper::dump_irred_clauses(vector<Lit>& buf)
+{
+    assert(solver->get_num_bva_vars() == 0);
+    assert(solver->decisionLevel() == 0);
+    if (!solver->okay()) {
+        buf.push_back(lit_Undef);
+        return;
+    }
+
+    for(const Lit lit: solver->get_zero_assigned_lits()) {
+        buf.push_back(lit_Undef);
+        buf.push_back(lit);
+    }
+
+    size_t wsLit = 0;
+    for (watch_array::const_iterator
+        it = solver->watches.begin(), end = solver->watches.end()
+        ; it != end
+        ; ++it, wsLit++
+    ) {
+        const Lit lit = Lit::toLit(wsLit);
+        for (const Watched& w: *it) {
+            if (w.isBin() && !w.red() && lit < w.lit2()) {
+                buf.push_back(lit_Undef);
+                buf.push_back(solver->map_inter_to_outer(lit));
+                buf.push_back(solver->map_inter_to_outer(w.lit2()));
+            }
+        }
+    }
+
+    for(const ClOffset offs: solver->longIrredCls) {
+        const Clause* cl = solver->cl_alloc.ptr(offs);
+        buf.push_back(lit_Undef);
+        for(const Lit lit: *cl) {
+            buf.push_back(solver->map_inter_to_outer(lit));
+        }
+    }
+
+    for(const std::pair<Lit, Lit>& eq: solver->varReplacer->get_all_binary_xors_outer()) {
+        buf.push_back(lit_Undef);
+        buf.push_back(~eq.first);
+        buf.push_back(eq.second);
+        buf.push_back(lit_Undef);
+        buf.push_back(eq.first);
+        buf.push_back(~eq.second);
+    }
+
+    if (solver->conf.perform_occur_based_simp) {
+        solver->occsimplifier->dump_blocked_clauses(buf);
+    }
+    if (solver->compHandler) {
+        solver->compHandler->dump_removed_clauses(buf);
+    }
+}
+
 void ClauseDumper::open_file_and_dump_irred_clauses(const string& irredDumpFname)
 {
     open_dump_file(irredDumpFname);
@@ -53,6 +53,7 @@ public:
     void dump_irred_clauses_preprocessor(std::ostream *out);
     void dump_irred_clauses(std::ostream *out);
     void dump_red_clauses(std::ostream *out);
+    void dump_irred_clauses(vector<Lit>& buf);
 
     void open_file_and_write_unsat(const std::string& fname);
     void open_file_and_dump_irred_clauses_preprocessor(const std::string& fname);
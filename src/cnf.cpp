@@ -23,6 +23,7 @@ THE SOFTWARE.
 #include "cnf.h"
 
 #include <stdexcept>
+#include <iostream>
 
 #include "vardata.h"
 #include "solvertypes.h"
@@ -435,6 +436,12 @@ bool CNF::normClauseIsAttached(const ClOffset offset) const
     attached &= findWCl(watches[cl[1]], offset);
 
     bool satisfied = satisfied_cl(cl);
+    #ifdef INLINE_TERNARY
+    //Watched in all 3 literals, the first two need not be the non-false ones
+    if (cl.size() == 3 && findWCl(watches[cl[2]], offset)) {
+        satisfied = true;
+    }
+    #endif
     uint32_t num_false2 = 0;
     num_false2 += value(cl[0]) == l_False;
     num_false2 += value(cl[1]) == l_False;
@@ -490,6 +497,9 @@ void CNF::find_all_attach() const
             //Assert watch correctness
             if ((*cl)[0] != lit
                 && (*cl)[1] != lit
+                #ifdef INLINE_TERNARY
+                && !(w.isTernary() && (*cl)[2] == lit)
+                #endif
             ) {
                 std::cerr
                 << "ERROR! Clause " << (*cl)
@@ -693,13 +703,13 @@ bool CNF::no_marked_clauses() const
 {
     for(ClOffset offset: longIrredCls) {
         Clause* cl = cl_alloc.ptr(offset);
-        assert(!cl->stats.marked_clause);
+        assert(!cl_alloc.stats(cl).marked_clause);
     }
 
     for(auto& lredcls: longRedCls) {
         for(ClOffset offset: lredcls) {
             Clause* cl = cl_alloc.ptr(offset);
-            assert(!cl->stats.marked_clause);
+            assert(!cl_alloc.stats(cl).marked_clause);
         }
     }
 
@@ -710,10 +720,16 @@ void CNF::add_drat(std::ostream* os, bool add_ID) {
     if (drat)
         delete drat;
 
+    //A single buffer cannot be handed over, need at least two. A background
+    //writer on cout would interleave with everything else printed there.
+    uint32_t async_bufs = conf.drat_async_bufs == 1 ? 2 : conf.drat_async_bufs;
+    if (os == &std::cout) {
+        async_bufs = 0;
+    }
     if (add_ID) {
-        drat = new DratFile<true>(interToOuterMain);
+        drat = new DratFile<true>(interToOuterMain, cl_alloc, async_bufs);
     } else {
-        drat = new DratFile<false>(interToOuterMain);
+        drat = new DratFile<false>(interToOuterMain, cl_alloc, async_bufs);
     }
     drat->setFile(os);
 }
@@ -75,6 +75,8 @@ public:
         if (_conf != NULL) {
             conf = *_conf;
         }
+        cl_alloc.set_huge_pages(conf.cl_alloc_huge_pages);
+        cl_alloc.set_reuse(conf.cl_alloc_reuse);
         drat = new Drat;
         assert(_must_interrupt_inter != NULL);
         must_interrupt_inter = _must_interrupt_inter;
@@ -99,6 +101,7 @@ public:
     #endif
     vector<VarData> varData;
     bool VSIDS = true;
+    bool VMTF = false; ///<Branch on the VMTF queue instead of the VSIDS heap
     vector<uint32_t> depth;
     Stamp stamp;
     ImplCache implCache;
@@ -460,7 +463,7 @@ inline void CNF::unmark_all_irred_clauses()
 {
     for(ClOffset offset: longIrredCls) {
         Clause* cl = cl_alloc.ptr(offset);
-        cl->stats.marked_clause = false;
+        cl_alloc.stats(cl).marked_clause = false;
     }
 }
 
@@ -468,7 +471,7 @@ inline void CNF::unmark_all_red1_clauses()
 {
     for(ClOffset offset: longRedCls[1]) {
         Clause* cl = cl_alloc.ptr(offset);
-        cl->stats.marked_clause = false;
+        cl_alloc.stats(cl).marked_clause = false;
     }
 }
 
@@ -20,10 +20,10 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ***********************************************/
 
-#include <set>
 #include <map>
 #include <iomanip>
 #include <iostream>
+#include <thread>
 #include "compfinder.h"
 #include "time_mem.h"
 #include "cloffset.h"
@@ -35,7 +35,6 @@ THE SOFTWARE.
 
 using namespace CMSat;
 
-using std::set;
 using std::map;
 using std::cout;
 using std::endl;
@@ -47,8 +46,9 @@ using std::endl;
 //#define PART_FINDING
 
 CompFinder::CompFinder(Solver* _solver) :
-    timedout(false)
-    , seen(_solver->seen)
+    bogoprops_remain(0)
+    , orig_bogoprops(0)
+    , timedout(false)
     , solver(_solver)
 {
 }
@@ -104,239 +104,221 @@ void CompFinder::find_components()
     const double myTime = cpuTime();
 
     table.clear();
-    table.resize(solver->nVars(), std::numeric_limits<uint32_t>::max());
     reverseTable.clear();
-    comp_no = 0;
-    used_comp_no = 0;
 
     solver->clauseCleaner->remove_and_clean_all();
 
-    //Add the clauses to the sets
     bogoprops_remain =
         solver->conf.comp_find_time_limitM*1000ULL*1000ULL
         *solver->conf.global_timeout_multiplier;
     orig_bogoprops = bogoprops_remain;
     timedout = false;
-    add_clauses_to_component(solver->longIrredCls);
-    addToCompImplicits();
-    if (timedout) {
-        reverseTable.clear();
+
+    root_of = vector<std::atomic<uint32_t> >(solver->nVars());
+    for(uint32_t i = 0; i < solver->nVars(); i++) {
+        root_of[i].store(i, std::memory_order_relaxed);
+    }
+
+    run_in_chunks(solver->longIrredCls.size(), 16*1024
+        , &CompFinder::unite_long_clauses);
+    run_in_chunks(solver->nVars(), 16*1024
+        , &CompFinder::unite_implicit_clauses);
+    if (!timedout) {
+        build_tables();
     }
+    root_of.clear();
+    root_of.shrink_to_fit();
     print_and_add_to_sql_result(myTime);
 
     assert(solver->okay());
 }
 
-void CompFinder::print_and_add_to_sql_result(const double myTime) const
+uint32_t CompFinder::find_root(uint32_t var)
 {
-    const double time_used = cpuTime() - myTime;
-    const double time_remain = float_div(bogoprops_remain, orig_bogoprops);
-
-    assert(reverse_table_is_correct());
+    //Path halving. Only non-roots are changed here, and only ever to point
+    //to one of their ancestors, so it's safe with other threads uniting
+    uint32_t parent = root_of[var].load(std::memory_order_relaxed);
+    while(parent != var) {
+        const uint32_t grandparent = root_of[parent].load(std::memory_order_relaxed);
+        if (grandparent != parent) {
+            root_of[var].store(grandparent, std::memory_order_relaxed);
+        }
+        var = parent;
+        parent = grandparent;
+    }
+    return var;
+}
 
-    if (solver->conf.verbosity) {
-        cout
-        << "c [comp] Found component(s): " <<  reverseTable.size()
-        << " BP: "
-        << std::setprecision(2) << std::fixed
-        << (double)(orig_bogoprops-bogoprops_remain)/(1000.0*1000.0)<< "M"
-        << solver->conf.print_times(time_used, timedout, time_remain)
-        << endl;
+void CompFinder::unite(uint32_t a, uint32_t b)
+{
+    while(true) {
+        a = find_root(a);
+        b = find_root(b);
+        if (a == b) {
+            return;
+        }
 
-        if (reverseTable.size() > 1) {
-            print_found_components();
+        //Always link the larger root under the smaller one. The CAS fails if
+        //another thread has linked 'a' in the meantime -- then retry
+        if (a < b) {
+            std::swap(a, b);
+        }
+        uint32_t expected = a;
+        if (root_of[a].compare_exchange_weak(expected, b)) {
+            return;
         }
     }
-
-    if (solver->sqlStats) {
-        solver->sqlStats->time_passed(
-            solver
-            , "compfinder"
-            , time_used
-            , timedout
-            , time_remain
-        );
-     }
 }
 
-void CompFinder::add_clauses_to_component(const vector<ClOffset>& cs)
-{
-    for (ClOffset offset: cs) {
-        if (bogoprops_remain <= 0) {
-            timedout = true;
-            break;
+/**
+@brief Calls func on [0, num) cut into chunks, on conf.comp_find_threads threads
+
+Sets timedout if the time budget runs out. Chunks are only taken while there
+is budget left, so with multiple threads it may be overshot by a few chunks.
+*/
+void CompFinder::run_in_chunks(
+    const size_t num
+    , const size_t chunk_size
+    , void (CompFinder::*func)(size_t, size_t)
+) {
+    const size_t num_chunks = (num + chunk_size - 1)/chunk_size;
+    std::atomic<size_t> next_chunk(0);
+    std::atomic<bool> out_of_time(false);
+    auto do_chunks = [&]() {
+        while(true) {
+            if (bogoprops_remain <= 0) {
+                out_of_time = true;
+                return;
+            }
+            const size_t chunk = next_chunk++;
+            if (chunk >= num_chunks) {
+                return;
+            }
+            const size_t start = chunk*chunk_size;
+            (this->*func)(start, std::min(start + chunk_size, num));
         }
-        bogoprops_remain -= 10;
-        Clause* cl = solver->cl_alloc.ptr(offset);
-        add_clause_to_component(*cl);
+    };
+
+    const size_t num_threads = std::max<size_t>(1,
+        std::min<size_t>(solver->conf.comp_find_threads, num_chunks));
+    vector<std::thread> threads;
+    for(size_t i = 1; i < num_threads; i++) {
+        threads.push_back(std::thread(do_chunks));
+    }
+    do_chunks();
+    for(std::thread& t: threads) {
+        t.join();
     }
+    timedout |= out_of_time;
 }
 
-void CompFinder::addToCompImplicits()
+void CompFinder::unite_long_clauses(const size_t start, const size_t end)
 {
-    vector<Lit> lits;
-
-    for (size_t var = 0; var < solver->nVars(); var++) {
-        if (bogoprops_remain <= 0) {
-            timedout = true;
-            break;
+    long long cost = 0;
+    for (size_t i = start; i < end; i++) {
+        const Clause& cl = *solver->cl_alloc.ptr(solver->longIrredCls[i]);
+        assert(cl.size() > 1);
+        cost += (long long)cl.size() + 2;
+        for (const Lit l: cl) {
+            unite(cl[0].var(), l.var());
         }
+    }
+    bogoprops_remain -= cost;
+}
 
-        bogoprops_remain -= 2;
-        Lit lit(var, false);
-        lits.clear();
-        lits.push_back(lit);
+void CompFinder::unite_implicit_clauses(const size_t start, const size_t end)
+{
+    long long cost = 0;
+    for (size_t var = start; var < end; var++) {
+        cost += 2;
         for(int sign = 0; sign < 2; sign++) {
-            lit = Lit(var, sign);
-            watch_subarray ws = solver->watches[lit];
-
-            //If empty, skip
-            if (ws.empty())
-                continue;
-
-            bogoprops_remain -= (int64_t)ws.size() + 10;
-            for(const Watched *it2 = ws.begin(), *end2 = ws.end()
-                ; it2 != end2
-                ; it2++
-            ) {
-                if (it2->isBin()
+            const Lit lit = Lit(var, sign);
+            watch_subarray_const ws = solver->watches[lit];
+            cost += (long long)ws.size();
+            for(const Watched& w: ws) {
+                if (w.isBin()
                     //Only irred
-                    && !it2->red()
+                    && !w.red()
                     //Only do each binary once
-                    && lit < it2->lit2()
+                    && lit < w.lit2()
                 ) {
-                    if (!seen[it2->lit2().var()]) {
-                        lits.push_back(it2->lit2());
-                        seen[it2->lit2().var()] = 1;
-                    }
+                    unite(var, w.lit2().var());
                 }
             }
         }
-
-        if (lits.size() > 1) {
-            //Clear seen
-            for(vector<Lit>::const_iterator
-                it = lits.begin(), end = lits.end()
-                ; it != end
-                ; ++it
-            ) {
-                seen[it->var()] = 0;
-            }
-
-            add_clause_to_component(lits);
-        }
-
     }
+    bogoprops_remain -= cost;
 }
 
-template<class T>
-bool CompFinder::belong_to_same_component(const T& cl)
-{
-    if (table[cl[0].var()] != std::numeric_limits<uint32_t>::max()) {
-        bogoprops_remain -= (int64_t)cl.size()/2 + 1;
-        const uint32_t comp = table[cl[0].var()];
+/**
+@brief Numbers the union-find sets that contain at least one clause
 
-        for (const Lit l: cl) {
-            if (table[l.var()] != comp) {
-                return false;
-            }
+Variables in no clause are left out, their table entry is uint32_t max.
+Components are numbered by their smallest variable.
+*/
+void CompFinder::build_tables()
+{
+    const uint32_t none = std::numeric_limits<uint32_t>::max();
+    table.resize(solver->nVars(), none);
+
+    //A variable is in a clause iff its set has more than one element
+    vector<uint32_t> comp_of_root(solver->nVars(), none);
+    for (uint32_t var = 0; var < solver->nVars(); var++) {
+        const uint32_t root = find_root(var);
+        if (root != var) {
+            comp_of_root[root] = 0;
         }
-
-        return true;
     }
 
-    return false;
-}
-
-template<class T>
-void CompFinder::fill_newset_and_tomerge(const T& cl)
-{
-    bogoprops_remain -= (int64_t)cl.size()*2;
-
-    for (const Lit lit: cl) {
-        if (table[lit.var()] != std::numeric_limits<uint32_t>::max()
-        ) {
-            if (!seen[table[lit.var()]]) {
-                tomerge.push_back(table[lit.var()]);
-                seen[table[lit.var()]] = 1;
+    uint32_t num_comps = 0;
+    vector<vector<uint32_t> > comp_vars;
+    for (uint32_t var = 0; var < solver->nVars(); var++) {
+        const uint32_t root = find_root(var);
+        if (root == var) {
+            if (comp_of_root[var] == none) {
+                continue;
             }
-        } else {
-            newSet.push_back(lit.var());
+            comp_of_root[var] = num_comps++;
+            comp_vars.push_back(vector<uint32_t>());
         }
+        table[var] = comp_of_root[root];
+        comp_vars[table[var]].push_back(var);
     }
-}
 
-void CompFinder::merge_newset_into_single_component()
-{
-    const uint32_t into = tomerge[0];
-    seen[into] = 0;
-    map<uint32_t, vector<uint32_t> >::iterator intoReverse
-        = reverseTable.find(into);
-
-    //Put the new lits into this set
-    for (const uint32_t v: newSet) {
-        intoReverse->second.push_back(v);
-        table[v] = into;
+    for (uint32_t comp = 0; comp < num_comps; comp++) {
+        reverseTable.insert(reverseTable.end()
+            , std::make_pair(comp, std::move(comp_vars[comp])));
     }
 }
 
-template<class T>
-void CompFinder::add_clause_to_component(const T& cl)
+void CompFinder::print_and_add_to_sql_result(const double myTime) const
 {
-    assert(cl.size() > 1);
-    tomerge.clear();
-    newSet.clear();
+    const double time_used = cpuTime() - myTime;
+    const double time_remain = float_div(bogoprops_remain.load(), orig_bogoprops);
 
-    if (belong_to_same_component(cl)) {
-        return;
-    }
+    assert(reverse_table_is_correct());
 
-    fill_newset_and_tomerge(cl);
+    if (solver->conf.verbosity) {
+        cout
+        << "c [comp] Found component(s): " <<  reverseTable.size()
+        << " BP: "
+        << std::setprecision(2) << std::fixed
+        << (double)(orig_bogoprops-bogoprops_remain.load())/(1000.0*1000.0)<< "M"
+        << solver->conf.print_times(time_used, timedout, time_remain)
+        << endl;
 
-    //no sets to merge, only merge the clause into one tree
-    if (tomerge.size() == 1) {
-        merge_newset_into_single_component();
-        return;
+        if (reverseTable.size() > 1) {
+            print_found_components();
+        }
     }
 
-    //Expensive merging coming up
-    bogoprops_remain -= 20;
-
-    //Delete tables to merge and put their elements into newSet
-    for (const uint32_t merge: tomerge) {
-        //Clear seen
-        seen[merge] = 0;
-
-        //Find in reverseTable
-        bogoprops_remain -= (int64_t)reverseTable.size()*2;
-        map<uint32_t, vector<uint32_t> >::iterator it2 = reverseTable.find(merge);
-        assert(it2 != reverseTable.end());
-
-        //Add them all
-        bogoprops_remain -= (int64_t)it2->second.size();
-        newSet.insert(
-            newSet.end()
-            , it2->second.begin()
-            , it2->second.end()
+    if (solver->sqlStats) {
+        solver->sqlStats->time_passed(
+            solver
+            , "compfinder"
+            , time_used
+            , timedout
+            , time_remain
         );
-
-        //Delete this comp
-        bogoprops_remain -= (int64_t)reverseTable.size();
-        reverseTable.erase(it2);
-        used_comp_no--;
-    }
-
-    //No literals lie outside of already seen components
-    if (newSet.empty())
-        return;
-
-    //Mark all lits not belonging to seen components as belonging to comp_no
-    bogoprops_remain -= (int64_t)newSet.size();
-    for (const uint32_t v: newSet) {
-        table[v] = comp_no;
-    }
-
-    reverseTable[comp_no] = newSet;
-    comp_no++;
-    used_comp_no++;
+     }
 }
@@ -25,6 +25,7 @@ THE SOFTWARE.
 
 #include <vector>
 #include <map>
+#include <atomic>
 #include "constants.h"
 #include "solvertypes.h"
 #include "cloffset.h"
@@ -52,50 +53,37 @@ class CompFinder {
         uint32_t getNumComps() const;
 
     private:
-        void addToCompImplicits();
-        void add_clauses_to_component(const vector<ClOffset>& cs);
-        template<class T>
-        void add_clause_to_component(const T& cl);
-        template<class T>
-        bool belong_to_same_component(const T& cl);
-        template<class T>
-        void fill_newset_and_tomerge(const T& cl);
-        void merge_newset_into_single_component();
+        //Union-find over the variables. Roots are always the smallest
+        //variable of the set, so the result doesn't depend on the order
+        //(or the number of threads) in which the clauses are added.
+        vector<std::atomic<uint32_t> > root_of;
+        uint32_t find_root(uint32_t var);
+        void unite(uint32_t a, uint32_t b);
+
+        void unite_long_clauses(const size_t start, const size_t end);
+        void unite_implicit_clauses(const size_t start, const size_t end);
+        void run_in_chunks(
+            const size_t num
+            , const size_t chunk_size
+            , void (CompFinder::*func)(size_t, size_t)
+        );
+        void build_tables();
 
         void print_found_components() const;
         bool reverse_table_is_correct() const;
         void print_and_add_to_sql_result(const double myTime) const;
 
-        struct MySorter
-        {
-            bool operator () (
-                const pair<uint32_t, uint32_t>& left
-                , const pair<uint32_t, uint32_t>& right
-            ) {
-                return left.second < right.second;
-            }
-        };
-
         //comp -> vars
         map<uint32_t, vector<uint32_t> > reverseTable;
 
         //var -> comp
         vector<uint32_t> table;
 
-        //The comp counter
-        uint32_t comp_no;
-        uint32_t used_comp_no;
-
-        //Temporary
-        vector<uint32_t> newSet;
-        vector<uint32_t> tomerge;
-
         //Keep track of time
-        long long bogoprops_remain;
+        std::atomic<long long> bogoprops_remain;
         long long orig_bogoprops;
         bool timedout;
 
-        vector<uint16_t>& seen;
         Solver* solver;
 };
 
@@ -31,6 +31,12 @@ THE SOFTWARE.
 #include <iostream>
 #include <cassert>
 #include <iomanip>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
+#include <chrono>
 #include "cryptominisat5/cryptominisat.h"
 #include "sqlstats.h"
 
@@ -135,7 +141,10 @@ bool CompHandler::handle()
 {
     assert(solver->conf.sampling_vars == NULL && "Cannot handle components when sampling vars is set");
     assert(solver->okay());
-    double myTime = cpuTime();
+
+    //The sub-solver threads' time must also be counted
+    const bool parallel = solver->conf.comp_threads > 1;
+    double myTime = parallel ? cpuTimeTotal() : cpuTime();
 
     delete compFinder;
     compFinder = new CompFinder(solver);
@@ -171,15 +180,20 @@ bool CompHandler::handle()
 
     size_t num_comps_solved = 0;
     size_t vars_solved = 0;
-    for (uint32_t it = 0; it < sizes.size()-1; ++it) {
-        const uint32_t comp = sizes[it].first;
-        vector<uint32_t>& vars = reverseTable[comp];
-        const bool ok = try_to_solve_component(it, comp, vars, num_comps);
-        if (!ok) {
-            break;
+    if (parallel) {
+        solve_components_parallel(
+            sizes, reverseTable, num_comps, num_comps_solved, vars_solved);
+    } else {
+        for (uint32_t it = 0; it < sizes.size()-1; ++it) {
+            const uint32_t comp = sizes[it].first;
+            vector<uint32_t>& vars = reverseTable[comp];
+            const bool ok = try_to_solve_component(it, comp, vars, num_comps);
+            if (!ok) {
+                break;
+            }
+            num_comps_solved++;
+            vars_solved += vars.size();
         }
-        num_comps_solved++;
-        vars_solved += vars.size();
     }
 
     if (!solver->okay()) {
@@ -189,7 +203,7 @@ bool CompHandler::handle()
         return solver->okay();
     }
 
-    const double time_used = cpuTime() - myTime;
+    const double time_used = (parallel ? cpuTimeTotal() : cpuTime()) - myTime;
     if (solver->conf.verbosity  >= 1) {
         cout
         << "c [comp] Coming back to original instance, solved "
@@ -312,6 +326,248 @@ bool CompHandler::solve_component(
     return true;
 }
 
+/**
+@brief Solves the components on conf.comp_threads threads
+
+The calling thread is the only one that touches the main solver: it moves
+each component into its own sub-solver and queues it, and it merges the
+results back into savedState as they come in. The worker threads only call
+solve() on the queued sub-solvers, taking whichever one is next, so a long
+component does not hold up the small ones behind it.
+
+Sub-solvers hold their clauses until they are merged, so no new component
+is set up while the estimated memory of the unmerged ones is over
+conf.comp_threads_max_memMB.
+
+The sub-solvers of one call share their own interrupt flag, stop_jobs. Once a
+component comes back UNSAT or l_Undef, the results of the others are of no
+use, so stop_jobs is raised to stop the ones still running. The parent's
+interrupt flag is mirrored into it. The calling thread re-raises it while it
+waits, as every SATSolver::solve() clears its interrupt flag when starting.
+*/
+bool CompHandler::solve_components_parallel(
+    const vector<pair<uint32_t, uint32_t> >& sizes
+    , map<uint32_t, vector<uint32_t> >& reverseTable
+    , const size_t num_comps
+    , size_t& num_comps_solved
+    , size_t& vars_solved
+) {
+    const size_t num_threads = std::min<size_t>(
+        solver->conf.comp_threads, sizes.size()-1);
+    const size_t max_mem = solver->conf.comp_threads_max_memMB*1024ULL*1024ULL;
+
+    std::mutex mu;
+    std::condition_variable cv;
+    std::deque<CompJob*> todo;
+    vector<CompJob*> done;
+    bool no_more_jobs = false;
+    std::atomic<bool> abort(false);
+    std::atomic<bool> stop_jobs(false);
+    auto stop_jobs_if_needed = [&]() {
+        if (abort || solver->must_interrupt_asap()) {
+            stop_jobs.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    auto worker = [&]() {
+        std::unique_lock<std::mutex> lock(mu);
+        while(true) {
+            cv.wait(lock, [&]{ return !todo.empty() || no_more_jobs; });
+            if (todo.empty()) {
+                return;
+            }
+            CompJob* job = todo.front();
+            todo.pop_front();
+            lock.unlock();
+
+            if (!stop_jobs) {
+                job->status = job->newSolver->solve();
+            }
+
+            lock.lock();
+            done.push_back(job);
+            cv.notify_all();
+        }
+    };
+    vector<std::thread> threads;
+    for(size_t i = 0; i < num_threads; i++) {
+        threads.push_back(std::thread(worker));
+    }
+
+    size_t mem_in_flight = 0;
+    size_t num_jobs = 0;
+    size_t num_merged = 0;
+    bool undef = false;
+    vector<CompJob*> to_merge;
+    auto merge_done = [&](const bool wait) {
+        {
+            std::unique_lock<std::mutex> lock(mu);
+            if (wait) {
+                while(!cv.wait_for(lock, std::chrono::milliseconds(100)
+                    , [&]{ return !done.empty(); })
+                ) {
+                    stop_jobs_if_needed();
+                }
+            }
+            to_merge.swap(done);
+        }
+        for(CompJob* job: to_merge) {
+            if (!abort) {
+                const lbool ret = merge_component_job(job, num_comps);
+                if (ret == l_True) {
+                    num_comps_solved++;
+                    vars_solved += job->vars.size();
+                } else {
+                    undef |= (ret == l_Undef);
+                    abort = true;
+                }
+            }
+            stop_jobs_if_needed();
+            mem_in_flight -= job->mem;
+            num_merged++;
+            delete job->newSolver;
+            delete job->conf;
+            delete job;
+        }
+        to_merge.clear();
+    };
+
+    for (uint32_t it = 0; it < sizes.size()-1 && !abort; ++it) {
+        const uint32_t comp = sizes[it].first;
+        const vector<uint32_t>& vars = reverseTable[comp];
+        for(const uint32_t var: vars) {
+            assert(solver->value(var) == l_Undef);
+        }
+
+        //Same limits as in try_to_solve_component()
+        if (vars.size() > 100ULL*1000ULL*solver->conf.var_and_mem_out_mult
+            || assumpsInsideComponent(vars)
+        ) {
+            continue;
+        }
+
+        merge_done(false);
+        while(mem_in_flight > max_mem && !abort) {
+            merge_done(true);
+        }
+        if (abort) {
+            break;
+        }
+
+        CompJob* job = build_component_job(it, comp, vars, &stop_jobs);
+        mem_in_flight += job->mem;
+        num_jobs++;
+        {
+            std::lock_guard<std::mutex> lock(mu);
+            todo.push_back(job);
+        }
+        cv.notify_one();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        no_more_jobs = true;
+    }
+    cv.notify_all();
+    while(num_merged < num_jobs) {
+        merge_done(true);
+    }
+    for(std::thread& t: threads) {
+        t.join();
+    }
+    assert(mem_in_flight == 0);
+
+    if (solver->okay() && undef) {
+        if (solver->conf.verbosity) {
+            cout
+            << "c [comp] subcomponent returned l_Undef -- timeout or interrupt."
+            << endl;
+        }
+        readdRemovedClauses();
+    }
+
+    return solver->okay() && !abort;
+}
+
+/**
+@brief Moves a component to a new sub-solver, without solving it
+
+The sub-solver is set to verbosity 0 so that the output of the concurrently
+running sub-solvers doesn't get mixed up.
+*/
+CompHandler::CompJob* CompHandler::build_component_job(
+    const uint32_t comp_at
+    , const uint32_t comp
+    , const vector<uint32_t>& vars_orig
+    , std::atomic<bool>* stop_jobs
+) {
+    assert(! (solver->drat->enabled() || solver->conf.simulate_drat) );
+    CompJob* job = new CompJob;
+    job->comp_at = comp_at;
+    job->comp = comp;
+    job->vars = vars_orig;
+    components_solved++;
+
+    std::sort(job->vars.begin(), job->vars.end());
+    createRenumbering(job->vars);
+
+    job->conf = new SolverConf(configureNewSolver(job->vars.size()));
+    job->conf->verbosity = 0;
+    job->newSolver = new SATSolver((void*)job->conf, stop_jobs);
+    moveVariablesBetweenSolvers(job->newSolver, job->vars, comp);
+
+    moved_lits = 0;
+    moveClausesImplicit(job->newSolver, comp, job->vars);
+    moveClausesLong(solver->longIrredCls, job->newSolver, comp);
+    for(auto& lredcls: solver->longRedCls) {
+        moveClausesLong(lredcls, job->newSolver, comp);
+    }
+
+    //Rough guess: per-variable data, plus the clauses along with their
+    //watches and the clauses that will be learnt from them
+    job->mem = 1024ULL*1024ULL
+        + job->vars.size()*200ULL
+        + moved_lits*sizeof(Lit)*10ULL;
+
+    return job;
+}
+
+/**
+@brief Merges a solved sub-solver back into the main solver
+
+@return l_True if merged, l_False if the component (and so the problem) is
+UNSAT, l_Undef if the sub-solver ran out of time or was interrupted
+*/
+lbool CompHandler::merge_component_job(CompJob* job, const size_t num_comps)
+{
+    if (job->status == l_Undef) {
+        return l_Undef;
+    }
+
+    if (job->status == l_False) {
+        solver->ok = false;
+        if (solver->conf.verbosity) {
+            cout
+            << "c [comp] The component is UNSAT -> problem is UNSAT"
+            << endl;
+        }
+        return l_False;
+    }
+
+    createRenumbering(job->vars);
+    check_solution_is_unassigned_in_main_solver(job->newSolver, job->vars);
+    save_solution_to_savedstate(job->newSolver, job->vars, job->comp);
+    move_decision_level_zero_vars_here(job->newSolver);
+
+    if (solver->conf.verbosity && num_comps < 20) {
+        cout
+        << "c [comp] Solved component " << job->comp_at
+        << " num vars: " << job->vars.size()
+        << endl;
+    }
+    return l_True;
+}
+
 void CompHandler::check_local_vardata_sanity()
 {
     //Checking that all variables that are not in the remaining comp have
@@ -512,12 +768,13 @@ void CompHandler::moveClausesLong(
         //Add 'tmp' to the new solver
         if (cl.red()) {
             #ifdef STATS_NEEDED
-            cl.stats.introduced_at_conflict = 0;
+            solver->cl_alloc.stats(cl).introduced_at_conflict = 0;
             #endif
-            //newSolver->addRedClause(tmp, cl.stats);
+            //newSolver->addRedClause(tmp, solver->cl_alloc.stats(cl));
         } else {
             saveClause(cl);
             newSolver->add_clause(tmp);
+            moved_lits += tmp.size();
         }
 
         //Remove from here
@@ -582,6 +839,7 @@ void CompHandler::move_binary_clause(
             saveClause(vector<Lit>{lit, lit2});
 
             newSolver->add_clause(tmp_lits);
+            moved_lits += 2;
             numRemovedHalfIrred++;
         }
     } else {
@@ -773,3 +1031,16 @@ uint32_t CompHandler::dump_removed_clauses(std::ostream* outfile) const
     }
     return num_cls;
 }
+
+//Each clause is preceded by lit_Undef, as in the SATSolver clause buffer
+void CompHandler::dump_removed_clauses(vector<Lit>& buf) const
+{
+    size_t at = 0;
+    for (uint32_t size: removedClauses.sizes) {
+        buf.push_back(lit_Undef);
+        for(size_t i = at; i < at + size; ++i) {
+            buf.push_back(removedClauses.lits[i]);
+        }
+        at += size;
+    }
+}
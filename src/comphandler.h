@@ -27,6 +27,7 @@ THE SOFTWARE.
 #include "cloffset.h"
 #include <map>
 #include <vector>
+#include <atomic>
 
 namespace CMSat {
 
@@ -36,6 +37,7 @@ using std::pair;
 
 class SATSolver;
 class Solver;
+class SolverConf;
 class CompFinder;
 class Watched;
 
@@ -67,6 +69,7 @@ class CompHandler
         void readdRemovedClauses();
         const RemovedClauses& getRemovedClauses() const;
         uint32_t dump_removed_clauses(std::ostream* outfile) const;
+        void dump_removed_clauses(vector<Lit>& buf) const;
         size_t get_num_vars_removed() const;
         size_t get_num_components_solved() const;
         size_t mem_used() const;
@@ -81,6 +84,32 @@ class CompHandler
             }
         };
         bool assumpsInsideComponent(const vector<uint32_t>& vars);
+
+        //Solving components in parallel
+        struct CompJob {
+            uint32_t comp_at;
+            uint32_t comp;
+            vector<uint32_t> vars;
+            SolverConf* conf = NULL;
+            SATSolver* newSolver = NULL;
+            size_t mem = 0;
+            lbool status = l_Undef;
+        };
+        bool solve_components_parallel(
+            const vector<pair<uint32_t, uint32_t> >& sizes
+            , map<uint32_t, vector<uint32_t> >& reverseTable
+            , const size_t num_comps
+            , size_t& num_comps_solved
+            , size_t& vars_solved
+        );
+        CompJob* build_component_job(
+            const uint32_t comp_at
+            , const uint32_t comp
+            , const vector<uint32_t>& vars_orig
+            , std::atomic<bool>* stop_jobs
+        );
+        lbool merge_component_job(CompJob* job, const size_t num_comps);
+        size_t moved_lits = 0;
         void move_decision_level_zero_vars_here(
             const SATSolver* newSolver
         );
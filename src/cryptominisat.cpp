@@ -83,6 +83,7 @@ namespace CMSat {
         int sql = 0;
         double timeout = std::numeric_limits<double>::max();
         bool interrupted = false;
+        bool first_calc_done = false;
 
         uint64_t previous_sum_conflicts = 0;
         uint64_t previous_sum_propagations = 0;
@@ -111,8 +112,9 @@ struct DataForThread
     }
     vector<Solver*>& solvers;
     vector<double>& cpu_times;
-    vector<Lit> *lits_to_add;
+    const vector<Lit> *lits_to_add;
     uint32_t vars_to_add;
+    size_t first_tid_to_add = 0;
     const vector<Lit> *assumptions;
     std::mutex* update_mutex;
     int *which_solved;
@@ -142,14 +144,8 @@ DLL_PUBLIC SATSolver::~SATSolver()
     delete data;
 }
 
-void update_config(SolverConf& conf, unsigned thread_num)
+static void set_portfolio_slot(SolverConf& conf, unsigned thread_num)
 {
-    //Don't accidentally reconfigure everything to a specific value!
-    if (thread_num > 0) {
-        conf.reconfigure_val = 0;
-    }
-    conf.origSeed += thread_num;
-
     switch(thread_num % 23) {
         case 0: {
             //default setup
@@ -370,6 +366,40 @@ void update_config(SolverConf& conf, unsigned thread_num)
     }
 }
 
+//VMTF replaces VSIDS, so it only makes a difference on threads that search
+//with VSIDS alone
+static bool vsids_only_slot(const SolverConf& conf, unsigned thread_num)
+{
+    SolverConf c = conf;
+    set_portfolio_slot(c, thread_num);
+    return !c.maple;
+}
+
+void update_config(SolverConf& conf, unsigned thread_num)
+{
+    //Don't accidentally reconfigure everything to a specific value!
+    if (thread_num > 0) {
+        conf.reconfigure_val = 0;
+
+        //Only the first thread checkpoints and resumes
+        conf.checkpoint_file.clear();
+    }
+    conf.origSeed += thread_num;
+
+    set_portfolio_slot(conf, thread_num);
+
+    //The first vmtf_threads VSIDS-only helper threads branch with VMTF
+    if (thread_num > 0 && conf.vmtf_threads > 0 && !conf.maple) {
+        unsigned before = 0;
+        for(unsigned i = 1; i < thread_num; i++) {
+            before += vsids_only_slot(conf, i);
+        }
+        if (before < conf.vmtf_threads) {
+            conf.vmtf = 1;
+        }
+    }
+}
+
 DLL_PUBLIC void SATSolver::set_num_threads(unsigned num)
 {
     if (num <= 0) {
@@ -404,7 +434,9 @@ DLL_PUBLIC void SATSolver::set_num_threads(unsigned num)
     }
 
     //set shared data
-    data->shared_data = new SharedData(data->solvers.size());
+    data->shared_data = new SharedData(
+        data->solvers.size()
+        , data->solvers[0]->getConf().sync_bin_ring_size_log2);
     for(unsigned i = 0; i < num; i++) {
         SolverConf conf = data->solvers[i]->getConf();
         if (i >= 1) {
@@ -412,7 +444,10 @@ DLL_PUBLIC void SATSolver::set_num_threads(unsigned num)
             conf.doFindXors = 0;
         }
         data->solvers[i]->setConf(conf);
-        data->solvers[i]->set_shared_data((SharedData*)data->shared_data);
+        data->solvers[i]->set_shared_data((SharedData*)data->shared_data, i);
+        if (i >= 1 && data->sql) {
+            data->solvers[i]->share_sqlite(data->solvers[0], i);
+        }
     }
 }
 
@@ -426,6 +461,9 @@ struct OneThreadAddCls
 
     void operator()()
     {
+        if (tid < data_for_thread.first_tid_to_add) {
+            return;
+        }
         Solver& solver = *data_for_thread.solvers[tid];
         solver.new_external_vars(data_for_thread.vars_to_add);
 
@@ -474,17 +512,28 @@ struct OneThreadAddCls
     const size_t tid;
 };
 
+//Before the first solve() with --presimponce only the first thread gets the
+//clauses, the others get its simplified copy, see simplify_once_for_threads()
+static bool add_to_first_thread_only(const CMSatPrivateData* data)
+{
+    return data->solvers.size() > 1
+        && data->solvers[0]->conf.simplify_once_for_threads
+        && !data->first_calc_done;
+}
+
 static bool actually_add_clauses_to_threads(CMSatPrivateData* data)
 {
     DataForThread data_for_thread(data);
     std::vector<std::thread> thds;
-    for(size_t i = 0; i < data->solvers.size(); i++) {
+    const size_t num_threads =
+        add_to_first_thread_only(data) ? 1 : data->solvers.size();
+    for(size_t i = 0; i < num_threads; i++) {
         thds.push_back(thread(OneThreadAddCls(data_for_thread, i)));
     }
     for(std::thread& thread : thds){
         thread.join();
     }
-    bool ret = (*data_for_thread.ret == l_True);
+    bool ret = (*data_for_thread.ret != l_False);
 
     //clear what has been added
     data->cls_lits.clear();
@@ -654,6 +703,93 @@ DLL_PUBLIC bool SATSolver::add_clause(const vector< Lit >& lits)
     return ret;
 }
 
+struct OneThreadAddClsBatch
+{
+    OneThreadAddClsBatch(
+        Solver* _solver
+        , const Lit* _lits
+        , const size_t* _offsets
+        , const size_t _num_clauses
+        , char* _ret
+    ) :
+        solver(_solver)
+        , lits(_lits)
+        , offsets(_offsets)
+        , num_clauses(_num_clauses)
+        , ret(_ret)
+    {
+    }
+
+    void operator()()
+    {
+        *ret = solver->add_clauses_outer(lits, offsets, num_clauses);
+    }
+
+    Solver* solver;
+    const Lit* lits;
+    const size_t* offsets;
+    const size_t num_clauses;
+    char* ret;
+};
+
+DLL_PUBLIC bool SATSolver::add_clauses(
+    const Lit* lits
+    , const size_t* offsets
+    , size_t num_clauses
+) {
+    if (data->log) {
+        for(size_t i = 0; i < num_clauses; i++) {
+            for(size_t at = offsets[i]; at < offsets[i+1]; at++) {
+                (*data->log) << lits[at] << " ";
+            }
+            (*data->log) << "0" << endl;
+        }
+    }
+
+    bool ret = true;
+    if (data->solvers.size() > 1) {
+        //Whatever has been cached must go in first. Then every thread reads
+        //the caller's buffer directly, no copy into cls_lits
+        if (!data->cls_lits.empty() || data->vars_to_add > 0) {
+            ret = actually_add_clauses_to_threads(data);
+        }
+
+        const size_t num_threads =
+            add_to_first_thread_only(data) ? 1 : data->solvers.size();
+        vector<char> rets(num_threads, true);
+        std::vector<std::thread> thds;
+        for(size_t i = 0; i < num_threads; i++) {
+            thds.push_back(thread(OneThreadAddClsBatch(
+                data->solvers[i], lits, offsets, num_clauses, &rets[i])));
+        }
+        for(std::thread& thread : thds){
+            thread.join();
+        }
+        for(char r: rets) {
+            ret &= (bool)r;
+        }
+    } else {
+        data->solvers[0]->new_vars(data->vars_to_add);
+        data->vars_to_add = 0;
+
+        ret = data->solvers[0]->add_clauses_outer(lits, offsets, num_clauses);
+    }
+    data->cls += num_clauses;
+
+    return ret;
+}
+
+DLL_PUBLIC bool SATSolver::add_clauses(
+    const std::vector<Lit>& lits
+    , const std::vector<size_t>& offsets
+) {
+    if (offsets.empty()) {
+        return okay();
+    }
+    assert(offsets.back() <= lits.size());
+    return add_clauses(lits.data(), offsets.data(), offsets.size()-1);
+}
+
 void add_xor_clause_to_log(const std::vector<unsigned>& vars, bool rhs, std::ofstream* file)
 {
     if (vars.size() == 0) {
@@ -761,6 +897,51 @@ struct OneThreadCalc
     bool only_sampling_solution;
 };
 
+/**
+@brief Adds the buffered clauses to the first solver and simplifies it
+
+Until now, the clauses have only been added to the first solver, see
+add_to_first_thread_only(). The simplified problem is dumped into
+'simplified' and the other threads add that instead of doing the same startup
+simplification each. The dump also holds the clauses of eliminated vars and
+of solved components, so it is equivalent to the original problem, whatever
+is added or assumed later.
+
+BVA is switched off for this one simplification: the vars it introduces
+would only exist in the first solver.
+*/
+static void simplify_once_for_threads(
+    CMSatPrivateData* data
+    , const vector<Lit>* assumptions
+    , vector<Lit>& simplified
+) {
+    Solver& s = *data->solvers[0];
+    DataForThread data_for_thread(data);
+    OneThreadAddCls cls_adder(data_for_thread, 0);
+    cls_adder();
+    data->vars_to_add = 0;
+
+    const int backup_bva = s.conf.do_bva;
+    s.conf.do_bva = false;
+    s.simplify_with_assumptions(assumptions, true);
+    s.conf.do_bva = backup_bva;
+    assert(s.get_num_bva_vars() == 0);
+
+    //Free the original clauses before making the copy
+    vector<Lit>().swap(data->cls_lits);
+    s.dump_irred_clauses(simplified);
+    for(size_t i = 1; i < data->solvers.size(); i++) {
+        Solver& other = *data->solvers[i];
+        other.new_external_vars(s.nVarsOutside() - other.nVarsOutside());
+        other.conf.simplify_at_startup = false;
+    }
+    if (s.conf.verbosity) {
+        cout << "c [simp-once] copying simplified problem to the other threads, lits:";
+        print_value_kilo_mega(simplified.size());
+        cout << endl;
+    }
+}
+
 lbool calc(
     const vector< Lit >* assumptions,
     bool solve, CMSatPrivateData *data,
@@ -787,13 +968,6 @@ lbool calc(
         (*data->log) << " )" << endl;
     }
 
-    if (data->solvers.size() > 1 && data->sql > 0) {
-        std::cerr
-        << "Multithreaded solving and SQL cannot be specified at the same time"
-        << endl;
-        exit(-1);
-    }
-
     if (data->solvers.size() == 1) {
         data->solvers[0]->new_vars(data->vars_to_add);
         data->vars_to_add = 0;
@@ -810,7 +984,19 @@ lbool calc(
     }
 
     //Multi-thread from now on.
+    vector<Lit> simplified;
+    const bool simplify_once = add_to_first_thread_only(data);
+    if (simplify_once) {
+        simplify_once_for_threads(data, assumptions, simplified);
+    }
+    data->first_calc_done = true;
+
     DataForThread data_for_thread(data, assumptions);
+    if (simplify_once) {
+        data_for_thread.lits_to_add = &simplified;
+        data_for_thread.first_tid_to_add = 1;
+    }
+
     std::vector<std::thread> thds;
     for(size_t i = 0
         ; i < data->solvers.size()
@@ -843,6 +1029,76 @@ DLL_PUBLIC lbool SATSolver::solve(const vector< Lit >* assumptions, bool only_sa
     return calc(assumptions, true, data, only_sampling_solution);
 }
 
+/**
+@brief Enumeration for multiple threads: solve, block the model, solve again
+*/
+static lbool enumerate_models_by_blocking(
+    SATSolver* solver
+    , CMSatPrivateData* data
+    , bool (*model_cb)(void* state, const std::vector<lbool>& values)
+    , void* state
+    , bool only_indep_solution
+) {
+    vector<uint32_t> all_vars;
+    const vector<uint32_t>* vars = data->solvers[0]->conf.sampling_vars;
+    if (vars == NULL) {
+        for(uint32_t i = 0; i < solver->nVars(); i++) {
+            all_vars.push_back(i);
+        }
+        vars = &all_vars;
+    }
+
+    vector<lbool> values;
+    vector<Lit> ban;
+    while(true) {
+        const lbool ret = solver->solve(NULL, only_indep_solution);
+        if (ret != l_True) {
+            return ret;
+        }
+
+        values.clear();
+        ban.clear();
+        for(const uint32_t var: *vars) {
+            const lbool val = solver->get_model()[var];
+            values.push_back(val);
+            if (val != l_Undef) {
+                ban.push_back(Lit(var, val == l_True));
+            }
+        }
+        if (!model_cb(state, values)) {
+            return l_True;
+        }
+        if (!solver->add_clause(ban)) {
+            return l_False;
+        }
+    }
+}
+
+DLL_PUBLIC lbool SATSolver::enumerate_models(
+    bool (*model_cb)(void* state, const std::vector<lbool>& values)
+    , void* state
+    , bool with_model
+    , bool only_indep_solution
+) {
+    if (data->solvers.size() > 1) {
+        return enumerate_models_by_blocking(
+            this, data, model_cb, state, only_indep_solution);
+    }
+
+    data->previous_sum_conflicts = get_sum_conflicts();
+    data->previous_sum_propagations = get_sum_propagations();
+    data->previous_sum_decisions = get_sum_decisions();
+
+    //The projection defaults to all vars, so they must all exist by now
+    Solver& s = *data->solvers[0];
+    s.new_vars(data->vars_to_add);
+    data->vars_to_add = 0;
+    s.set_model_enumeration(model_cb, state, with_model, only_indep_solution);
+    const lbool ret = calc(NULL, true, data, only_indep_solution);
+    s.set_model_enumeration(NULL, NULL, false, false);
+    return ret;
+}
+
 DLL_PUBLIC lbool SATSolver::simplify(const vector< Lit >* assumptions)
 {
     //set information data (props, confl, dec)
@@ -983,6 +1239,25 @@ DLL_PUBLIC void SATSolver::interrupt_asap()
     data->must_interrupt->store(true, std::memory_order_relaxed);
 }
 
+DLL_PUBLIC void SATSolver::set_terminate_callback(
+    int (*terminate)(void* state)
+    , void* state
+) {
+    for(Solver* s: data->solvers) {
+        s->set_terminate_callback(terminate, state);
+    }
+}
+
+DLL_PUBLIC void SATSolver::set_learn_callback(
+    void (*learn)(void* state, const std::vector<Lit>& clause)
+    , void* state
+    , unsigned max_len
+) {
+    for(Solver* s: data->solvers) {
+        s->set_learn_callback(learn, state, max_len);
+    }
+}
+
 void DLL_PUBLIC SATSolver::add_in_partial_solving_stats()
 {
     data->solvers[data->which_solved]->add_in_partial_solving_stats();
@@ -1030,6 +1305,12 @@ DLL_PUBLIC std::vector<std::pair<Lit, Lit> > SATSolver::get_all_binary_xors() co
     return data->solvers[0]->get_all_binary_xors();
 }
 
+DLL_PUBLIC uint64_t SATSolver::get_num_irred_cls(unsigned thread_num) const
+{
+    const Solver& s = *data->solvers.at(thread_num);
+    return s.longIrredCls.size() + s.binTri.irredBins;
+}
+
 DLL_PUBLIC vector<std::pair<vector<uint32_t>, bool> >
 SATSolver::get_recovered_xors(bool elongate) const
 {
@@ -1048,14 +1329,11 @@ SATSolver::get_recovered_xors(bool elongate) const
 
 DLL_PUBLIC void SATSolver::set_sqlite(std::string filename)
 {
-    if (data->solvers.size() > 1) {
-        std::cerr
-        << "Multithreaded solving and SQL cannot be specified at the same time"
-        << endl;
-        exit(-1);
-    }
     data->sql = 1;
     data->solvers[0]->set_sqlite(filename);
+    for(size_t i = 1; i < data->solvers.size(); i++) {
+        data->solvers[i]->share_sqlite(data->solvers[0], i);
+    }
 }
 
 DLL_PUBLIC uint64_t SATSolver::get_sum_conflicts()
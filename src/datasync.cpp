@@ -28,32 +28,24 @@ THE SOFTWARE.
 
 using namespace CMSat;
 
-DataSync::DataSync(Solver* _solver, SharedData* _sharedData) :
+DataSync::DataSync(Solver* _solver, SharedData* _sharedData, uint32_t _thread_num) :
     solver(_solver)
     , sharedData(_sharedData)
+    , thread_num(_thread_num)
     , seen(solver->seen)
     , toClear(solver->toClear)
-{}
-
-void DataSync::new_var(const bool bva)
 {
-    if (!enabled())
-        return;
-
-    if (!bva) {
-        syncFinish.push_back(0);
-        syncFinish.push_back(0);
+    if (sharedData) {
+        binSyncFinish.resize(sharedData->bin_rings.size(), 0);
     }
-    assert(solver->nVarsOutside()*2 == syncFinish.size());
 }
 
-void DataSync::new_vars(size_t n)
+void DataSync::new_var(const bool)
 {
-    if (!enabled())
-        return;
+}
 
-    syncFinish.insert(syncFinish.end(), 2*n, 0);
-    assert(solver->nVarsOutside()*2 == syncFinish.size());
+void DataSync::new_vars(size_t)
+{
 }
 
 void DataSync::save_on_var_memory()
@@ -93,11 +85,12 @@ bool DataSync::syncData()
     sharedData->unit_mutex.unlock();
     if (!ok) return false;
 
-    sharedData->bin_mutex.lock();
-    extend_bins_if_needed();
-    clear_set_binary_values();
     ok = shareBinData();
-    sharedData->bin_mutex.unlock();
+    if (!ok) return false;
+
+    sharedData->long_mutex.lock();
+    ok = shareLongData();
+    sharedData->long_mutex.unlock();
     if (!ok) return false;
 
     lastSyncConf = solver->sumConflicts;
@@ -105,34 +98,14 @@ bool DataSync::syncData()
     return true;
 }
 
-void DataSync::clear_set_binary_values()
-{
-    for(size_t i = 0; i < solver->nVarsOutside()*2; i++) {
-        Lit lit1 = Lit::toLit(i);
-        lit1 = solver->map_to_with_bva(lit1);
-        lit1 = solver->varReplacer->get_lit_replaced_with_outer(lit1);
-        lit1 = solver->map_outer_to_inter(lit1);
-        if (solver->value(lit1) != l_Undef) {
-            sharedData->bins[i].clear();
-        }
-    }
-}
-
-void DataSync::extend_bins_if_needed()
-{
-    assert(sharedData->bins.size() <= (solver->nVarsOutside())*2);
-    if (sharedData->bins.size() == (solver->nVarsOutside())*2)
-        return;
-
-    sharedData->bins.resize(solver->nVarsOutside()*2);
-}
-
 bool DataSync::shareBinData()
 {
     uint32_t oldRecvBinData = stats.recvBinData;
     uint32_t oldSentBinData = stats.sentBinData;
 
-    syncBinFromOthers();
+    if (!syncBinFromOthers()) {
+        return false;
+    }
     syncBinToOthers();
     size_t mem = sharedData->calc_memory_use_bins();
 
@@ -140,6 +113,7 @@ bool DataSync::shareBinData()
         cout
         << "c [sync] got bins " << (stats.recvBinData - oldRecvBinData)
         << " sent bins " << (stats.sentBinData - oldSentBinData)
+        << " lost bins " << stats.lostBinData
         << " mem use: " << mem/(1024*1024) << " M"
         << endl;
     }
@@ -149,46 +123,83 @@ bool DataSync::shareBinData()
 
 bool DataSync::syncBinFromOthers()
 {
-    for (uint32_t wsLit = 0; wsLit < sharedData->bins.size(); wsLit++) {
-        if (sharedData->bins[wsLit].data == NULL) {
+    assert(binSyncFinish.size() == sharedData->bin_rings.size());
+    assert(toAdd.empty());
+    for(uint32_t th = 0; th < sharedData->bin_rings.size(); th++) {
+        if (th == thread_num) {
             continue;
         }
 
-        Lit lit1 = Lit::toLit(wsLit);
-        lit1 = solver->map_to_with_bva(lit1);
-        lit1 = solver->varReplacer->get_lit_replaced_with_outer(lit1);
-        lit1 = solver->map_outer_to_inter(lit1);
-        if (solver->varData[lit1.var()].removed != Removed::none
-            || solver->value(lit1.var()) != l_Undef
-        ) {
-            continue;
+        const SharedData::BinRing& ring = *sharedData->bin_rings[th];
+        const uint64_t head = ring.head.load(std::memory_order_acquire);
+        uint64_t at = binSyncFinish[th];
+        if (head - at > ring.size()) {
+            //Overwritten before we could read them
+            stats.lostBinData += head - ring.size() - at;
+            at = head - ring.size();
         }
+        for(; at < head; at++) {
+            const uint64_t packed = ring.get(at);
+            Lit lit1 = map_outside_to_inter(SharedData::BinRing::unpack_first(packed));
+            Lit lit2 = map_outside_to_inter(SharedData::BinRing::unpack_second(packed));
+            if (lit1 == lit_Undef || lit2 == lit_Undef) {
+                continue;
+            }
+            if (lit2 < lit1) {
+                std::swap(lit1, lit2);
+            }
+            toAdd.push_back(std::make_pair(lit1, lit2));
+        }
+        binSyncFinish[th] = head;
+    }
 
-        vector<Lit>& bins = *sharedData->bins[wsLit].data;
-        watch_subarray ws = solver->watches[lit1];
-
-        assert(syncFinish.size() > wsLit);
-        if (bins.size() > syncFinish[wsLit]
-            && !syncBinFromOthers(lit1, bins, syncFinish[wsLit], ws)
-        ) {
-            return false;
+    //Group by first literal so existing binaries can be marked once per group
+    std::sort(toAdd.begin(), toAdd.end());
+    bool ret = true;
+    size_t i = 0;
+    while(i < toAdd.size()) {
+        size_t j = i;
+        while(j < toAdd.size() && toAdd[j].first == toAdd[i].first) {
+            j++;
         }
+        if (!syncBinFromOthers(toAdd[i].first, i, j)) {
+            ret = false;
+            break;
+        }
+        i = j;
     }
+    toAdd.clear();
 
-    return true;
+    return ret;
+}
+
+Lit DataSync::map_outside_to_inter(Lit lit) const
+{
+    if (lit.var() >= solver->nVarsOutside()) {
+        return lit_Undef;
+    }
+    lit = solver->map_to_with_bva(lit);
+    lit = solver->varReplacer->get_lit_replaced_with_outer(lit);
+    lit = solver->map_outer_to_inter(lit);
+    if (solver->varData[lit.var()].removed != Removed::none
+        || solver->value(lit) != l_Undef
+    ) {
+        return lit_Undef;
+    }
+
+    return lit;
 }
 
 bool DataSync::syncBinFromOthers(
     const Lit lit
-    , const vector<Lit>& bins
-    , uint32_t& finished
-    , watch_subarray ws
+    , const size_t from
+    , const size_t to
 ) {
     assert(solver->varReplacer->get_lit_replaced_with(lit) == lit);
     assert(solver->varData[lit.var()].removed == Removed::none);
 
     assert(toClear.empty());
-    for (const Watched& w: ws) {
+    for (const Watched& w: solver->watches[lit]) {
         if (w.isBin()) {
             toClear.push_back(w.lit2());
             assert(seen.size() > w.lit2().toInt());
@@ -197,18 +208,15 @@ bool DataSync::syncBinFromOthers(
     }
 
     vector<Lit> lits(2);
-    for (uint32_t i = finished; i < bins.size(); i++) {
-        Lit otherLit = bins[i];
-        otherLit = solver->map_to_with_bva(otherLit);
-        otherLit = solver->varReplacer->get_lit_replaced_with_outer(otherLit);
-        otherLit = solver->map_outer_to_inter(otherLit);
-        if (solver->varData[otherLit.var()].removed != Removed::none
+    for (size_t i = from; i < to; i++) {
+        const Lit otherLit = toAdd[i].second;
+        if (solver->value(lit) != l_Undef
             || solver->value(otherLit) != l_Undef
         ) {
             continue;
         }
         assert(seen.size() > otherLit.toInt());
-        if (!seen[otherLit.toInt()]) {
+        if (!seen[otherLit.toInt()] && otherLit != lit) {
             stats.recvBinData++;
             lits[0] = lit;
             lits[1] = otherLit;
@@ -218,9 +226,10 @@ bool DataSync::syncBinFromOthers(
             if (!solver->ok) {
                 goto end;
             }
+            toClear.push_back(otherLit);
+            seen[otherLit.toInt()] = true;
         }
     }
-    finished = bins.size();
 
     end:
     for (const Lit l: toClear) {
@@ -233,28 +242,153 @@ bool DataSync::syncBinFromOthers(
 
 void DataSync::syncBinToOthers()
 {
+    SharedData::BinRing& ring = *sharedData->bin_rings[thread_num];
     for(const std::pair<Lit, Lit>& bin: newBinClauses) {
-        addOneBinToOthers(bin.first, bin.second);
+        ring.push(bin.first, bin.second);
+        stats.sentBinData++;
     }
 
     newBinClauses.clear();
 }
 
-void DataSync::addOneBinToOthers(Lit lit1, Lit lit2)
+bool DataSync::shareLongData()
 {
-    assert(lit1 < lit2);
-    if (sharedData->bins[lit1.toInt()].data == NULL) {
+    uint32_t oldRecvLongData = stats.recvLongData;
+    uint32_t oldSentLongData = stats.sentLongData;
+
+    if (!syncLongFromOthers()) {
+        return false;
+    }
+    syncLongToOthers();
+
+    if (solver->conf.verbosity >= 3) {
+        cout
+        << "c [sync] got longs " << (stats.recvLongData - oldRecvLongData)
+        << " sent longs " << (stats.sentLongData - oldSentLongData)
+        << " mem use: " << sharedData->calc_memory_use_longs()/(1024*1024) << " M"
+        << endl;
+    }
+
+    return true;
+}
+
+bool DataSync::syncLongFromOthers()
+{
+    const SharedData& shared = *sharedData;
+    if (longSyncFinish < shared.long_base) {
+        //Some were dropped before we could read them
+        longSyncFinish = shared.long_base;
+    }
+
+    for(size_t i = longSyncFinish - shared.long_base; i < shared.longs.size(); i++) {
+        const SharedData::LongCl& c = shared.longs[i];
+        if (c.thread == thread_num) {
+            continue;
+        }
+
+        if (!add_one_long_from_others(
+            shared.long_lits.data() + c.start, c.size, c.glue)
+        ) {
+            return false;
+        }
+    }
+    longSyncFinish = shared.long_base + shared.longs.size();
+
+    return true;
+}
+
+bool DataSync::add_one_long_from_others(
+    const Lit* lits
+    , const uint32_t size
+    , const uint32_t glue
+) {
+    vector<Lit>& cl = tmpLongCl;
+    cl.clear();
+    for(uint32_t i = 0; i < size; i++) {
+        Lit lit = lits[i];
+        lit = solver->map_to_with_bva(lit);
+        lit = solver->varReplacer->get_lit_replaced_with_outer(lit);
+        lit = solver->map_outer_to_inter(lit);
+        if (solver->varData[lit.var()].removed != Removed::none
+            || solver->value(lit) == l_True
+        ) {
+            return true;
+        }
+        cl.push_back(lit);
+    }
+    stats.recvLongData++;
+
+    ClauseStats cl_stats;
+    cl_stats.glue = std::min<uint32_t>(glue, size);
+    cl_stats.last_touched = solver->sumConflicts;
+
+    //Don't add DRAT: it would add to the thread data, too
+    Clause* c = solver->add_clause_int(cl, true, cl_stats, true, NULL, false);
+    if (c != NULL) {
+        solver->cl_alloc.stats(c).which_red_array = 2;
+        if (solver->cl_alloc.stats(c).glue <= solver->conf.glue_put_lev0_if_below_or_eq) {
+            solver->cl_alloc.stats(c).which_red_array = 0;
+        } else if (solver->cl_alloc.stats(c).glue <= solver->conf.glue_put_lev1_if_below_or_eq
+            && solver->conf.glue_put_lev1_if_below_or_eq != 0
+        ) {
+            solver->cl_alloc.stats(c).which_red_array = 1;
+        }
+        solver->longRedCls[solver->cl_alloc.stats(c).which_red_array].push_back(
+            solver->cl_alloc.get_offset(c));
+    }
+
+    return solver->okay();
+}
+
+void DataSync::syncLongToOthers()
+{
+    SharedData& shared = *sharedData;
+    size_t at = 0;
+    for(const auto& sz_glue: newLongs) {
+        shared.longs.push_back(SharedData::LongCl(
+            shared.long_lits.size(), sz_glue.first, sz_glue.second, thread_num));
+        shared.long_lits.insert(shared.long_lits.end()
+            , newLongLits.begin() + at
+            , newLongLits.begin() + at + sz_glue.first);
+        at += sz_glue.first;
+        stats.sentLongData++;
+    }
+    newLongs.clear();
+    newLongLits.clear();
+
+    //We have just read everything, what we wrote we don't need to read back
+    longSyncFinish = shared.long_base + shared.longs.size();
+
+    if (shared.longs.size() > solver->conf.sync_long_max_buffered) {
+        shared.shrink_longs();
+    }
+}
+
+void DataSync::add_long_clause_outer(const vector<Lit>& cl, const uint32_t glue)
+{
+    if (glue > solver->conf.sync_long_max_glue
+        || cl.size() > solver->conf.sync_long_max_size
+    ) {
         return;
     }
 
-    vector<Lit>& bins = *sharedData->bins[lit1.toInt()].data;
-    for (const Lit lit : bins) {
-        if (lit == lit2)
+    if (must_rebuild_bva_map) {
+        outer_to_without_bva_map = solver->build_outer_to_without_bva_map();
+        must_rebuild_bva_map = false;
+    }
+
+    for(const Lit lit: cl) {
+        if (solver->varData[lit.var()].is_bva) {
             return;
+        }
     }
 
-    bins.push_back(lit2);
-    stats.sentBinData++;
+    for(Lit lit: cl) {
+        lit = solver->map_inter_to_outer(lit);
+        lit = map_outside_without_bva(lit);
+        newLongLits.push_back(lit);
+    }
+    newLongs.push_back(std::make_pair((uint32_t)cl.size(), glue));
 }
 
 bool DataSync::shareUnitData()
@@ -31,7 +31,7 @@ class Solver;
 class DataSync
 {
     public:
-        DataSync(Solver* solver, SharedData* sharedData);
+        DataSync(Solver* solver, SharedData* sharedData, uint32_t thread_num = 0);
         bool enabled();
         void new_var(const bool bva);
         void new_vars(const size_t n);
@@ -45,6 +45,7 @@ class DataSync
 
         template <class T> void signalNewBinClause(T& ps);
         void signalNewBinClause(Lit lit1, Lit lit2);
+        void signal_new_long_clause(const vector<Lit>& cl, uint32_t glue);
 
         struct Stats
         {
@@ -52,31 +53,43 @@ class DataSync
             uint32_t recvUnitData = 0;
             uint32_t sentBinData = 0;
             uint32_t recvBinData = 0;
+            uint64_t lostBinData = 0;
+            uint32_t sentLongData = 0;
+            uint32_t recvLongData = 0;
         };
         const Stats& get_stats() const;
 
     private:
-        void extend_bins_if_needed();
         Lit map_outside_without_bva(Lit lit) const;
+        Lit map_outside_to_inter(Lit lit) const;
         bool shareUnitData();
         bool syncBinFromOthers();
-        bool syncBinFromOthers(const Lit lit, const vector<Lit>& bins, uint32_t& finished, watch_subarray ws);
+        bool syncBinFromOthers(const Lit lit, const size_t from, const size_t to);
         void syncBinToOthers();
-        void clear_set_binary_values();
-        void addOneBinToOthers(const Lit lit1, const Lit lit2);
         bool shareBinData();
+        bool shareLongData();
+        bool syncLongFromOthers();
+        bool add_one_long_from_others(const Lit* lits, uint32_t size, uint32_t glue);
+        void syncLongToOthers();
+        void add_long_clause_outer(const vector<Lit>& cl, uint32_t glue);
 
         //stuff to sync
         vector<std::pair<Lit, Lit> > newBinClauses;
+        vector<std::pair<Lit, Lit> > toAdd;
+        vector<Lit> newLongLits;
+        vector<std::pair<uint32_t, uint32_t> > newLongs; //size, glue
+        vector<Lit> tmpLongCl;
 
         //stats
         uint64_t lastSyncConf = 0;
-        vector<uint32_t> syncFinish;
+        vector<uint64_t> binSyncFinish; //per-thread read cursor into bin_rings
+        uint64_t longSyncFinish = 0;
         Stats stats;
 
         //Other systems
         Solver* solver;
         SharedData* sharedData;
+        const uint32_t thread_num;
 
         //misc
         vector<uint16_t>& seen;
@@ -100,6 +113,14 @@ inline void DataSync::signalNewBinClause(T& ps)
     signalNewBinClause(ps[0], ps[1]);
 }
 
+inline void DataSync::signal_new_long_clause(const vector<Lit>& cl, const uint32_t glue)
+{
+    if (sharedData == NULL) {
+        return;
+    }
+    add_long_clause_outer(cl, glue);
+}
+
 inline Lit DataSync::map_outside_without_bva(const Lit lit) const
 {
     return Lit(outer_to_without_bva_map[lit.var()], lit.sign());
@@ -179,7 +179,7 @@ bool DimacsParser<C>::readClause(C& in)
         }
 
         lits.push_back( (parsed_lit > 0) ? Lit(var, false) : Lit(var, true) );
-        if (*in != ' ') {
+        if (*in != ' ' && *in != '\t' && *in != '\r') {
             std::cerr
             << "ERROR! "
             << "After last element on the line must be 0" << endl
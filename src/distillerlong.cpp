@@ -166,7 +166,7 @@ bool DistillerLong::go_through_clauses(
         offset2 = try_distill_clause_and_return_new(
             offset
             , cl.red()
-            , cl.stats
+            , solver->cl_alloc.stats(cl)
         );
 
         #ifdef USE_GAUSS
@@ -252,7 +252,7 @@ bool DistillerLong::distill_long_cls_all(
 /*ClOffset DistillerLong::try_distill_clause_and_return_new(
     ClOffset offset
     , const bool red
-    , const ClauseStats& stats
+    , const ClauseStats stats
 ) {
     #ifdef DRAT_DEBUG
     if (solver->conf.verbosity >= 6) {
@@ -348,7 +348,7 @@ bool DistillerLong::distill_long_cls_all(
 ClOffset DistillerLong::try_distill_clause_and_return_new(
     ClOffset offset
     , const bool red
-    , const ClauseStats& stats
+    , const ClauseStats stats
 ) {
     #ifdef DRAT_DEBUG
     if (solver->conf.verbosity >= 6) {
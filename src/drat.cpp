@@ -19,7 +19,117 @@ THE SOFTWARE.
 ***********************************************/
 
 #include "drat.h"
+#include <chrono>
+
+using namespace CMSat;
 
 namespace CMSat {
     void Drat::flush() {}
 }
+
+DratAsyncWriter::DratAsyncWriter(
+    std::ostream* _file
+    , const uint32_t num_bufs
+    , const size_t buf_size
+) :
+    file(_file)
+{
+    assert(num_bufs >= 2);
+    for(uint32_t i = 0; i < num_bufs; i++) {
+        unsigned char* buf = new unsigned char[buf_size];
+        memset(buf, 0, buf_size);
+        all_bufs.push_back(buf);
+        free_bufs.push_back(buf);
+    }
+    writer = std::thread(&DratAsyncWriter::write_loop, this);
+}
+
+DratAsyncWriter::~DratAsyncWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        stop = true;
+    }
+    cond_todo.notify_one();
+    writer.join();
+
+    for(unsigned char* buf: all_bufs) {
+        delete[] buf;
+    }
+}
+
+unsigned char* DratAsyncWriter::get_free_buf()
+{
+    std::unique_lock<std::mutex> lock(mu);
+    if (free_bufs.empty()) {
+        stats.stalls++;
+        const auto start = std::chrono::steady_clock::now();
+        cond_free.wait(lock, [this]{return !free_bufs.empty();});
+        const std::chrono::duration<double> waited =
+            std::chrono::steady_clock::now() - start;
+        stats.stall_time += waited.count();
+    }
+    unsigned char* buf = free_bufs.back();
+    free_bufs.pop_back();
+
+    return buf;
+}
+
+void DratAsyncWriter::submit(unsigned char* buf, const size_t len)
+{
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        todo.push_back(std::make_pair(buf, len));
+    }
+    cond_todo.notify_one();
+}
+
+void DratAsyncWriter::wait_all_written()
+{
+    std::unique_lock<std::mutex> lock(mu);
+    cond_free.wait(lock, [this]{return todo.empty() && !writing;});
+}
+
+void DratAsyncWriter::write_loop()
+{
+    std::unique_lock<std::mutex> lock(mu);
+    while(true) {
+        cond_todo.wait(lock, [this]{return stop || !todo.empty();});
+        if (todo.empty()) {
+            assert(stop);
+            break;
+        }
+
+        const std::pair<unsigned char*, size_t> job = todo.front();
+        todo.pop_front();
+        writing = true;
+        lock.unlock();
+
+        file->write((const char*)job.first, job.second);
+
+        lock.lock();
+        writing = false;
+        stats.bufs_written++;
+        stats.bytes_written += job.second;
+        free_bufs.push_back(job.first);
+        if (todo.empty()) {
+            file->flush();
+        }
+        cond_free.notify_all();
+    }
+}
+
+void DratAsyncWriter::Stats::print() const
+{
+    cout << "c ------- DRAT WRITER STATS ---------" << endl;
+    print_stats_line("c DRAT bufs written", bufs_written);
+    print_stats_line("c DRAT MB written"
+        , (double)bytes_written/(1024.0*1024.0)
+        , "MB"
+    );
+    print_stats_line("c DRAT writer stalls"
+        , stalls
+        , stall_time
+        , "s waited"
+    );
+}
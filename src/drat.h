@@ -24,8 +24,13 @@ THE SOFTWARE.
 #define __DRAT_H__
 
 #include "clause.h"
+#include "clauseallocator.h"
 #include <vector>
+#include <deque>
 #include <iostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 using std::vector;
 //#define DEBUG_DRAT
@@ -34,6 +39,53 @@ namespace CMSat {
 
 enum DratFlag{fin, deldelay, del, findelay, add};
 
+//Owns all file I/O of a DratFile. Filled buffers are handed over through a
+//bounded queue and written by a background thread. When all buffers are in
+//flight, the solver thread waits for one to be written (back-pressure).
+class DratAsyncWriter
+{
+public:
+    DratAsyncWriter(std::ostream* file, uint32_t num_bufs, size_t buf_size);
+    ~DratAsyncWriter();
+    DratAsyncWriter(const DratAsyncWriter&) = delete;
+    DratAsyncWriter& operator=(const DratAsyncWriter&) = delete;
+
+    unsigned char* get_free_buf();
+    void submit(unsigned char* buf, size_t len);
+    void wait_all_written();
+
+    struct Stats
+    {
+        uint64_t bufs_written = 0;
+        uint64_t bytes_written = 0;
+        uint64_t stalls = 0;
+        double stall_time = 0;
+
+        void print() const;
+    };
+    Stats get_stats() const
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        return stats;
+    }
+
+private:
+    void write_loop();
+
+    std::ostream* file;
+    vector<unsigned char*> all_bufs;
+    vector<unsigned char*> free_bufs;
+    std::deque<std::pair<unsigned char*, size_t> > todo;
+    bool writing = false;
+    bool stop = false;
+    Stats stats;
+
+    mutable std::mutex mu;
+    std::condition_variable cond_todo;
+    std::condition_variable cond_free;
+    std::thread writer;
+};
+
 struct Drat
 {
     Drat()
@@ -95,6 +147,10 @@ struct Drat
 
     virtual void flush();
 
+    virtual void print_stats() const
+    {
+    }
+
     int buf_len;
     unsigned char* drup_buf = 0;
     unsigned char* buf_ptr;
@@ -103,13 +159,21 @@ struct Drat
 template<bool add_ID>
 struct DratFile: public Drat
 {
-    DratFile(vector<uint32_t>& _interToOuterMain) :
+    DratFile(
+        vector<uint32_t>& _interToOuterMain
+        , const ClauseAllocator& _cl_alloc
+        , const uint32_t _async_bufs = 0
+    ) :
         interToOuterMain(_interToOuterMain)
+        , cl_alloc(_cl_alloc)
+        , async_bufs(_async_bufs)
     {
-        drup_buf = new unsigned char[2 * 1024 * 1024];
+        if (async_bufs == 0) {
+            drup_buf = new unsigned char[2 * 1024 * 1024];
+            memset(drup_buf, 0, 2 * 1024 * 1024);
+        }
         buf_ptr = drup_buf;
         buf_len = 0;
-        memset(drup_buf, 0, 2 * 1024 * 1024);
 
         del_buf = new unsigned char[2 * 1024 * 1024];
         del_ptr = del_buf;
@@ -118,7 +182,12 @@ struct DratFile: public Drat
 
     virtual ~DratFile()
     {
-        delete[] drup_buf;
+        if (async_writer) {
+            //The buffer belongs to the writer
+            delete async_writer;
+        } else {
+            delete[] drup_buf;
+        }
         delete[] del_buf;
     }
 
@@ -182,10 +251,18 @@ struct DratFile: public Drat
     void flush() override
     {
         binDRUP_flush();
+        if (async_writer) {
+            async_writer->wait_all_written();
+        }
     }
 
     void binDRUP_flush() {
-        drup_file->write((const char*)drup_buf, buf_len);
+        if (async_writer) {
+            async_writer->submit(drup_buf, buf_len);
+            drup_buf = async_writer->get_free_buf();
+        } else {
+            drup_file->write((const char*)drup_buf, buf_len);
+        }
         buf_ptr = drup_buf;
         buf_len = 0;
     }
@@ -193,6 +270,20 @@ struct DratFile: public Drat
     void setFile(std::ostream* _file) override
     {
         drup_file = _file;
+        if (async_bufs > 0) {
+            assert(async_writer == NULL);
+            async_writer = new DratAsyncWriter(drup_file, async_bufs, 2 * 1024 * 1024);
+            drup_buf = async_writer->get_free_buf();
+            buf_ptr = drup_buf;
+            buf_len = 0;
+        }
+    }
+
+    void print_stats() const override
+    {
+        if (async_writer) {
+            async_writer->get_stats().print();
+        }
     }
 
     bool get_conf_id() override {
@@ -256,7 +347,7 @@ struct DratFile: public Drat
             #ifdef STATS_NEEDED
             id_set = true;
             if (is_add && add_ID) {
-                ID = cl.stats.ID;
+                ID = cl_alloc.stats(cl).ID;
 
                 // actually... for on-the-fly subsumed irred clauses can have an ID.
                 //assert(!(ID != 0 && !cl.red()));
@@ -374,6 +465,9 @@ struct DratFile: public Drat
 
     std::ostream* drup_file = NULL;
     vector<uint32_t>& interToOuterMain;
+    const ClauseAllocator& cl_alloc;
+    const uint32_t async_bufs;
+    DratAsyncWriter* async_writer = NULL;
     #ifdef STATS_NEEDED
     int64_t ID = 0;
     int64_t sumConflicts = std::numeric_limits<int64_t>::max();
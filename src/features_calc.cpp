@@ -295,9 +295,9 @@ void SolveFeaturesCalc::calculate_cl_distributions(
     {
         const Clause& cl = *solver->cl_alloc.ptr(off);
         size_mean += cl.size();
-        glue_mean += cl.stats.glue;
+        glue_mean += solver->cl_alloc.stats(cl).glue;
         if (cl.red()) {
-            activity_mean += (double)cl.stats.activity/cla_inc;
+            activity_mean += (double)solver->cl_alloc.stats(cl).activity/cla_inc;
         }
     }
     size_mean /= clauses.size();
@@ -309,8 +309,8 @@ void SolveFeaturesCalc::calculate_cl_distributions(
     {
         const Clause& cl = *solver->cl_alloc.ptr(off);
         size_var += std::pow(size_mean-cl.size(), 2);
-        glue_var += std::pow(glue_mean-cl.stats.glue, 2);
-        activity_var += std::pow(activity_mean-(double)cl.stats.activity/cla_inc, 2);
+        glue_var += std::pow(glue_mean-solver->cl_alloc.stats(cl).glue, 2);
+        activity_var += std::pow(activity_mean-(double)solver->cl_alloc.stats(cl).activity/cla_inc, 2);
     }
     size_var /= clauses.size();
     glue_var /= clauses.size();
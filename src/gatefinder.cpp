@@ -458,7 +458,7 @@ bool GateFinder::shortenWithOrGate(const OrGate& gate)
 
         //Future clause's stat
         const bool red = cl.red();
-        const ClauseStats stats = cl.stats;
+        const ClauseStats stats = solver->cl_alloc.stats(cl);
 
         //Free the old clause and allocate new one
         (*solver->drat) << deldelay << cl << fin;
@@ -863,7 +863,7 @@ void GateFinder::treatAndGateClause(
     //Calculate learnt & glue
     const Clause& other_cl = *solver->cl_alloc.ptr(other_cl_offset);
     const bool red = other_cl.red() && this_cl.red();
-    ClauseStats stats = ClauseStats::combineStats(this_cl.stats, other_cl.stats);
+    ClauseStats stats = ClauseStats::combineStats(solver->cl_alloc.stats(this_cl), solver->cl_alloc.stats(other_cl));
 
     if (solver->conf.verbosity >= 6) {
         cout << "gate new clause:" << lits << endl;
@@ -898,7 +898,7 @@ ClOffset GateFinder::findAndGateOtherCl(
             continue;
 
         //abstraction must match
-        if (cl.abst != abst)
+        if (solver->cl_alloc.abst(cl) != abst)
             continue;
 
         *(simplifier->limit_to_decrease) -= cl.size()/2+5;
@@ -791,6 +791,16 @@ Lit HyperEngine::analyzeFail(const PropBy propBy)
             break;
         }
 
+        case ternary_t: {
+            const Lit lits[3] = {failBinLit, propBy.lit2(), propBy.lit3()};
+            for(const Lit lit: lits) {
+                if (varData[lit.var()].level != 0)
+                    currAncestors.push_back(~lit);
+            }
+            break;
+        }
+
+        case xor_t:
         case null_clause_t:
             assert(false);
             break;
@@ -993,12 +1003,19 @@ PropResult HyperEngine::prop_normal_cl_with_ancestor_info(
         return PROP_NOTHING;
     }
 
+    #ifdef INLINE_TERNARY
+    if (i->isTernary()) {
+        *j++ = *i;
+        return prop_ternary_with_ancestor_info(*i, p, confl);
+    }
+    #endif
+
     //Dereference pointer
     propStats.bogoProps += 4;
     const ClOffset offset = i->get_offset();
     Clause& c = *cl_alloc.ptr(offset);
     #ifdef STATS_NEEDED
-    c.stats.clause_looked_at++;
+    cl_alloc.stats(c).clause_looked_at++;
     #endif
 
     PropResult ret = prop_normal_helper(c, offset, j, p);
@@ -1013,7 +1030,7 @@ PropResult HyperEngine::prop_normal_cl_with_ancestor_info(
 
     //Update stats
     #ifdef STATS_NEEDED
-    c.stats.propagations_made++;
+    cl_alloc.stats(c).propagations_made++;
     if (c.red())
         propStats.propsLongRed++;
     else
@@ -1025,6 +1042,57 @@ PropResult HyperEngine::prop_normal_cl_with_ancestor_info(
     return PROP_SOMETHING;
 }
 
+#ifdef INLINE_TERNARY
+PropResult HyperEngine::prop_ternary_with_ancestor_info(
+    const Watched& w
+    , const Lit p
+    , PropBy& confl
+) {
+    const Lit lit2 = w.getBlockedLit();
+    const Lit lit3 = w.getLit3();
+    const lbool val2 = value(lit2);
+    const lbool val3 = value(lit3);
+    if (val2 == l_True
+        || val3 == l_True
+        || (val2 == l_Undef && val3 == l_Undef)
+    ) {
+        return PROP_NOTHING;
+    }
+
+    if (val2 == l_False && val3 == l_False) {
+        #ifdef STATS_NEEDED
+        if (w.red_ternary())
+            lastConflictCausedBy = ConflCausedBy::longred;
+        else
+            lastConflictCausedBy = ConflCausedBy::longirred;
+        #endif
+
+        confl = PropBy(lit2, lit3, w.red_ternary());
+        failBinLit = ~p;
+        qhead = trail.size();
+        return PROP_FAIL;
+    }
+
+    #ifdef STATS_NEEDED
+    if (w.red_ternary())
+        propStats.propsLongRed++;
+    else
+        propStats.propsLongIrred++;
+    #endif
+
+    const Lit toprop = val2 == l_Undef ? lit2 : lit3;
+    const Lit other_false = val2 == l_Undef ? lit3 : lit2;
+    currAncestors.clear();
+    if (varData[p.var()].level != 0)
+        currAncestors.push_back(p);
+    if (varData[other_false.var()].level != 0)
+        currAncestors.push_back(~other_false);
+    add_hyper_bin(toprop);
+
+    return PROP_SOMETHING;
+}
+#endif
+
 size_t HyperEngine::mem_used() const
 {
     size_t mem = 0;
@@ -92,6 +92,13 @@ private:
         , const Lit p
         , PropBy& confl
     );
+    #ifdef INLINE_TERNARY
+    PropResult prop_ternary_with_ancestor_info(
+        const Watched& w
+        , const Lit p
+        , PropBy& confl
+    );
+    #endif
     Lit prop_red_bin_dfs(
         StampType stampType
         , PropBy& confl
@@ -57,10 +57,6 @@ bool InTree::replace_until_fixedpoint(bool& aborted)
             return false;
         }
 
-        if (solver->varReplacer->get_scc_depth_warning_triggered()) {
-            aborted = true;
-            return solver->okay();
-        }
         this_replace = solver->varReplacer->get_num_replaced_vars();
 
         if (bogoprops > time_limit) {
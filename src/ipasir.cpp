@@ -48,8 +48,24 @@ struct MySolver {
     SATSolver* solver;
     vector<Lit> clause;
     vector<Lit> assumptions;
+
+    //For ipasir_set_learn
+    void* learn_state = NULL;
+    void (*learn)(void* state, int* clause) = NULL;
+    vector<int> learnt;
 };
 
+static void learn_to_ipasir(void* state, const vector<Lit>& clause)
+{
+    MySolver* s = (MySolver*)state;
+    s->learnt.clear();
+    for(const Lit l: clause) {
+        s->learnt.push_back(l.sign() ? -(int)(l.var()+1) : (int)(l.var()+1));
+    }
+    s->learnt.push_back(0);
+    s->learn(s->learn_state, s->learnt.data());
+}
+
 extern "C" {
 
 DLL_PUBLIC const char * ipasir_signature ()
@@ -225,14 +241,29 @@ DLL_PUBLIC int ipasir_failed (void * solver, int lit)
  * Required state: INPUT or SAT or UNSAT
  * State after: INPUT or SAT or UNSAT
  */
-DLL_PUBLIC void ipasir_set_terminate (void * /*solver*/, void * /*state*/, int (* /*terminate*/)(void * state))
+DLL_PUBLIC void ipasir_set_terminate (void * solver, void * state, int (*terminate)(void * state))
 {
-    //this is complicated.
+    MySolver* s = (MySolver*)solver;
+    s->solver->set_terminate_callback(terminate, state);
 }
 
+/**
+ * Set a callback function used to extract learned clauses up to a given length
+ * from the solver. See ipasir.h.
+ *
+ * Required state: INPUT or SAT or UNSAT
+ * State after: INPUT or SAT or UNSAT
+ */
+DLL_PUBLIC void ipasir_set_learn (void * solver, void * state, int max_length, void (*learn)(void * state, int * clause))
+{
+    MySolver* s = (MySolver*)solver;
+    s->learn = learn;
+    s->learn_state = state;
+    if (learn == NULL || max_length < 0) {
+        s->solver->set_learn_callback(NULL, NULL, 0);
+    } else {
+        s->solver->set_learn_callback(learn_to_ipasir, s, max_length);
+    }
 }
 
-DLL_PUBLIC void ipasir_set_learn (void * /*solver*/, void * /*state*/, int /*max_length*/, void (* /*learn*/)(void * state, int * clause))
-{
-    //this is complicated
 }
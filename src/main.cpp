@@ -49,6 +49,7 @@ THE SOFTWARE.
 #include "main_common.h"
 #include "time_mem.h"
 #include "dimacsparser.h"
+#include "mmapdimacsparser.h"
 #include "cryptominisat5/cryptominisat.h"
 #include "signalcode.h"
 
@@ -108,29 +109,13 @@ void Main::readInAFile(SATSolver* solver2, const string& filename)
     if (conf.verbosity) {
         cout << "c Reading file '" << filename << "'" << endl;
     }
-    #ifndef USE_ZLIB
-    FILE * in = fopen(filename.c_str(), "rb");
-    DimacsParser<StreamBuffer<FILE*, FN> > parser(solver2, &debugLib, conf.verbosity);
-    #else
-    gzFile in = gzopen(filename.c_str(), "rb");
-    DimacsParser<StreamBuffer<gzFile, GZ> > parser(solver2, &debugLib, conf.verbosity);
-    #endif
-
-    if (in == NULL) {
-        std::cerr
-        << "ERROR! Could not open file '"
-        << filename
-        << "' for reading: " << strerror(errno) << endl;
-
-        std::exit(1);
-    }
 
-    bool strict_header = conf.preprocess;
-    if (!parser.parse_DIMACS(in, strict_header)) {
-        exit(-1);
+    vector<uint32_t> parsed_sampling_vars;
+    if (!readInAFileMmap(solver2, filename, parsed_sampling_vars)) {
+        readInAFileStream(solver2, filename, parsed_sampling_vars);
     }
 
-    if (!sampling_vars_str.empty() && !parser.sampling_vars.empty()) {
+    if (!sampling_vars_str.empty() && !parsed_sampling_vars.empty()) {
         cerr << "ERROR! Sampling vars set in console but also in CNF." << endl;
         exit(-1);
     }
@@ -149,7 +134,7 @@ void Main::readInAFile(SATSolver* solver2, const string& filename)
                 ss.ignore();
         }
     } else {
-        sampling_vars.swap(parser.sampling_vars);
+        sampling_vars.swap(parsed_sampling_vars);
     }
 
     if (sampling_vars.empty()) {
@@ -176,6 +161,64 @@ void Main::readInAFile(SATSolver* solver2, const string& filename)
         }
     }
     call_after_parse();
+}
+
+bool Main::readInAFileMmap(
+    SATSolver* solver2
+    , const string& filename
+    , vector<uint32_t>& parsed_sampling_vars
+) {
+    #ifdef MMAP_DIMACS_AVAILABLE
+    if (!mmap_parse || !debugLib.empty()) {
+        return false;
+    }
+
+    MmapDimacsParser parser(solver2, conf.verbosity, parse_threads);
+    if (!parser.open(filename)) {
+        return false;
+    }
+
+    bool strict_header = conf.preprocess;
+    if (!parser.parse_DIMACS(strict_header)) {
+        exit(-1);
+    }
+    parsed_sampling_vars.swap(parser.sampling_vars);
+    return true;
+    #else
+    (void)solver2;
+    (void)filename;
+    (void)parsed_sampling_vars;
+    return false;
+    #endif
+}
+
+void Main::readInAFileStream(
+    SATSolver* solver2
+    , const string& filename
+    , vector<uint32_t>& parsed_sampling_vars
+) {
+    #ifndef USE_ZLIB
+    FILE * in = fopen(filename.c_str(), "rb");
+    DimacsParser<StreamBuffer<FILE*, FN> > parser(solver2, &debugLib, conf.verbosity);
+    #else
+    gzFile in = gzopen(filename.c_str(), "rb");
+    DimacsParser<StreamBuffer<gzFile, GZ> > parser(solver2, &debugLib, conf.verbosity);
+    #endif
+
+    if (in == NULL) {
+        std::cerr
+        << "ERROR! Could not open file '"
+        << filename
+        << "' for reading: " << strerror(errno) << endl;
+
+        std::exit(1);
+    }
+
+    bool strict_header = conf.preprocess;
+    if (!parser.parse_DIMACS(in, strict_header)) {
+        exit(-1);
+    }
+    parsed_sampling_vars.swap(parser.sampling_vars);
 
     #ifndef USE_ZLIB
         fclose(in);
@@ -432,6 +475,10 @@ void Main::add_supported_options()
         , "Use maple N-1 of N rounds. Normally, N is 2, so used every other round. Set to 3 so it will use maple 2/3rds of the time.")
     ("maplemorebump", po::value(&conf.more_maple_bump_high_glue)->default_value(conf.more_maple_bump_high_glue)
         , "Bump variable usefulness more when glue is HIGH")
+    ("vmtf", po::value(&conf.vmtf)->default_value(conf.vmtf)
+        , "Branch on a variable-move-to-front queue instead of the VSIDS heap in the non-maple rounds")
+    ("vmtfthreads", po::value(&conf.vmtf_threads)->default_value(conf.vmtf_threads)
+        , "With multiple threads, this many of the helper threads that never use maple branch with VMTF")
     ;
 
 
@@ -489,6 +536,8 @@ void Main::add_supported_options()
         , "Perform simplification at the very start")
     ("allpresimp", po::value(&conf.simplify_at_every_startup)->default_value(conf.simplify_at_every_startup)
         , "Perform simplification at EVERY start -- only matters in library mode")
+    ("presimponce", po::value(&conf.simplify_once_for_threads)->default_value(conf.simplify_once_for_threads)
+        , "With multiple threads, simplify at the very start in one thread only, then copy the simplified problem to the others")
     ("nonstop,n", po::value(&conf.never_stop_search)->default_value(conf.never_stop_search)
         , "Never stop the search() process in class SATSolver")
     ("maxnumsimppersolve", po::value(&conf.max_num_simplify_per_solve_call)->default_value(conf.max_num_simplify_per_solve_call)
@@ -515,6 +564,8 @@ void Main::add_supported_options()
         , "Perform Ternary resolution'")
     ("terntimelim", po::value(&conf.ternary_res_time_limitM)->default_value(conf.ternary_res_time_limitM)
         , "Time-out in bogoprops M of ternary resolution as per paper 'Look-Ahead Versus Look-Back for Satisfiability Problems'")
+    ("ternthreads", po::value(&conf.ternary_res_threads)->default_value(conf.ternary_res_threads)
+        , "Number of threads finding ternary resolvents. The result does not depend on the number of threads as long as it's more than 1")
     ;
 
     po::options_description occ_mem_limits("Occ-based simplification memory limits");
@@ -535,6 +586,8 @@ void Main::add_supported_options()
         , "Time-out in bogoprops M of subsumption of long clauses with long clauses, after computing occur")
     ("strstimelim", po::value(&conf.strengthening_time_limitM)->default_value(conf.strengthening_time_limitM)
         , "Time-out in bogoprops M of strengthening of long clauses with long clauses, after computing occur")
+    ("substrthreads", po::value(&conf.sub_str_threads)->default_value(conf.sub_str_threads)
+        , "Number of threads searching the occur lists during subsumption and strengthening of long clauses with long clauses. The result does not depend on the number of threads as long as it's more than 1")
     ;
 
     po::options_description bva_options("BVA options");
@@ -569,6 +622,8 @@ void Main::add_supported_options()
         , "Skip BVE resolvents in case they belong to a gate")
     ("agrelimtimelim", po::value(&conf.aggressive_elim_time_limitM)->default_value(conf.aggressive_elim_time_limitM)
         , "Time-out in bogoprops M of aggressive(=uses reverse distillation) var-elimination")
+    ("varelimthreads", po::value(&conf.varelim_threads)->default_value(conf.varelim_threads)
+        , "Number of threads computing the resolvents of independent variables during BVE. The result does not depend on the number of threads as long as it's more than 1")
     ;
 
     po::options_description xorOptions("XOR-related options");
@@ -698,7 +753,13 @@ void Main::add_supported_options()
     ("compsvar", po::value(&conf.compVarLimit)->default_value(conf.compVarLimit)
         , "Only use components in case the number of variables is below this limit")
     ("compslimit", po::value(&conf.comp_find_time_limitM)->default_value(conf.comp_find_time_limitM)
-        , "Limit how much time is spent in component-finding");
+        , "Limit how much time is spent in component-finding")
+    ("compsfindthreads", po::value(&conf.comp_find_threads)->default_value(conf.comp_find_threads)
+        , "Number of threads going through the clauses when finding components. The components found do not depend on the number of threads")
+    ("compsthreads", po::value(&conf.comp_threads)->default_value(conf.comp_threads)
+        , "Number of threads solving the components found")
+    ("compsmaxmem", po::value(&conf.comp_threads_max_memMB)->default_value(conf.comp_threads_max_memMB)
+        , "Don't set up more components for the threads while the estimated memory use of the ones not yet finished is above this many MB");
 
     po::options_description distillOptions("Misc options");
     distillOptions.add_options()
@@ -723,6 +784,14 @@ void Main::add_supported_options()
         , "Consolidate watchlists fully once every N conflicts. Scheduled during simplification rounds.")
     ("consolidatestaticorder", po::value(&conf.static_mem_consolidate_order)->default_value(conf.static_mem_consolidate_order)
         , "Consolidate clause memory in static order. If set to 0, it's consolidated in activity order")
+    ("hugepages", po::value(&conf.cl_alloc_huge_pages)->default_value(conf.cl_alloc_huge_pages)
+        , "Ask for transparent huge pages for the clause memory. Only has an effect where the clause memory is mmap()-ed")
+    ("clreuse", po::value(&conf.cl_alloc_reuse)->default_value(conf.cl_alloc_reuse)
+        , "Reuse the memory of deleted clauses for new clauses of the same size, instead of waiting for clause memory consolidation")
+    ("compactincr", po::value(&conf.cl_compact_incremental)->default_value(conf.cl_compact_incremental)
+        , "Consolidate clause memory incrementally, by evacuating only its sparsest regions. Only the forced consolidations rebuild all of it")
+    ("compactmaxmb", po::value(&conf.cl_compact_max_mb)->default_value(conf.cl_compact_max_mb)
+        , "Maximum MB of clauses moved by one incremental clause memory consolidation")
     ;
 
     po::options_description miscOptions("Misc options");
@@ -751,6 +820,14 @@ void Main::add_supported_options()
     hiddenOptions.add_options()
     ("sync", po::value(&conf.sync_every_confl)->default_value(conf.sync_every_confl)
         , "Sync threads every N conflicts")
+    ("syncbinring", po::value(&conf.sync_bin_ring_size_log2)->default_value(conf.sync_bin_ring_size_log2)
+        , "Each thread publishes its learnt binary clauses into a ring of 2^N entries (4 <= N <= 30). Readers that fall further behind lose the oldest ones")
+    ("synclongglue", po::value(&conf.sync_long_max_glue)->default_value(conf.sync_long_max_glue)
+        , "Share learnt long clauses between threads if their glue is at most this. 0 = don't share long clauses")
+    ("synclongsize", po::value(&conf.sync_long_max_size)->default_value(conf.sync_long_max_size)
+        , "Share learnt long clauses between threads only if their size is at most this")
+    ("synclongbuf", po::value(&conf.sync_long_max_buffered)->default_value(conf.sync_long_max_buffered)
+        , "Maximum number of shared long clauses kept for other threads to read")
     ("dratdebug", po::bool_switch(&dratDebug)
         , "Output DRAT verification into the console. Helpful to see where DRAT fails -- use in conjunction with --verb 20")
     ("clearinter", po::value(&need_clean_exit)->default_value(0)
@@ -762,9 +839,19 @@ void Main::add_supported_options()
     ("savedstate", po::value(&conf.saved_state_file)->default_value(conf.saved_state_file)
         , "The file to save the saved state of the solver")
     ("maxsccdepth", po::value(&conf.max_scc_depth)->default_value(conf.max_scc_depth)
-        , "The maximum for scc search depth")
+        , "Deprecated and ignored: SCC search has no depth limit any more")
+    ("checkpoint", po::value(&conf.checkpoint_file)
+        , "Periodically save the search state (learnt clauses, activities, phases, restart state) to this file, and resume from it if it exists. The CNF must be the same when resuming")
+    ("checkpointevery", po::value(&conf.checkpoint_every_secs)->default_value(conf.checkpoint_every_secs)
+        , "Write a checkpoint at the first restart after this many seconds (wall clock) have passed since the last one")
     ("simdrat", po::value(&conf.simulate_drat)->default_value(conf.simulate_drat)
         , "Simulate DRAT")
+    ("dratbufs", po::value(&conf.drat_async_bufs)->default_value(conf.drat_async_bufs)
+        , "Write DRAT from a background thread, with this many 2MB buffers in flight. 0 = write from the solver thread")
+    ("mmapparse", po::value(&mmap_parse)->default_value(mmap_parse)
+        , "Read uncompressed CNF files through mmap, tokenizing them in parallel")
+    ("parsethreads", po::value(&parse_threads)->default_value(parse_threads)
+        , "Number of threads to tokenize the CNF with when using mmap. 0 = number of cores, at most 16")
     ("dumpdecformodel", po::value(&decisions_for_model_fname)->default_value(decisions_for_model_fname)
         , "Decisions for model will be dumped here")
     ("sampling", po::value(&sampling_vars_str)->default_value(sampling_vars_str)
@@ -1048,14 +1135,14 @@ void Main::manually_parse_some_options()
         conf.need_decisions_reaching = true;
     }
 
-    if (max_nr_of_solutions > 1) {
-        conf.need_decisions_reaching = true;
-    }
-
     if (conf.random_var_freq < 0 || conf.random_var_freq > 1) {
         throw WrongParam(lexical_cast<string>(conf.random_var_freq), "Illegal random var frequency ");
     }
 
+    if (conf.sync_bin_ring_size_log2 < 4 || conf.sync_bin_ring_size_log2 > 30) {
+        throw WrongParam("syncbinring", "must be between 4 and 30");
+    }
+
     if (conf.preprocess != 0) {
         conf.simplify_at_startup = 1;
         conf.varelim_time_limitM *= 5;
@@ -1213,6 +1300,34 @@ void Main::manually_parse_some_options()
         handle_drat_option();
     }
 
+    if (max_nr_of_solutions > 1
+        && (vm.count("drat") || conf.simulate_drat)
+    ) {
+        std::cerr << "ERROR: multi-solutions make no sense with DRAT. Exiting." << endl;
+        std::exit(-1);
+    }
+
+    if (!conf.checkpoint_file.empty()) {
+        if (vm.count("drat") || conf.simulate_drat) {
+            std::cerr << "ERROR: Cannot resume a DRAT proof from a checkpoint. Exiting." << endl;
+            std::exit(-1);
+        }
+        if (conf.preprocess != 0) {
+            std::cerr << "ERROR: checkpointing makes no sense with preprocessing. Exiting." << endl;
+            std::exit(-1);
+        }
+        if (max_nr_of_solutions > 1) {
+            std::cerr << "ERROR: checkpointing makes no sense with multi-solutions. Exiting." << endl;
+            std::exit(-1);
+        }
+        if (conf.checkpoint_every_secs <= 0) {
+            throw WrongParam("checkpointevery", "must be larger than 0");
+        }
+
+        //On a signal, stop at the next restart and write a last checkpoint
+        need_clean_exit = 1;
+    }
+
     if (conf.verbosity) {
         cout << "c Outputting solution to console" << endl;
     }
@@ -1397,59 +1512,42 @@ void Main::dump_decisions_for_model()
 
 lbool Main::multi_solutions()
 {
-    unsigned long current_nr_of_solutions = 0;
-    lbool ret = l_True;
-    while(current_nr_of_solutions < max_nr_of_solutions && ret == l_True) {
-        ret = solver->solve(NULL, only_sampling_solution);
-        current_nr_of_solutions++;
+    if (max_nr_of_solutions <= 1) {
+        const lbool ret = solver->solve(NULL, only_sampling_solution);
         if (ret == l_True && !decisions_for_model_fname.empty()) {
             dump_decisions_for_model();
-            assert(max_nr_of_solutions == 1);
         }
+        return ret;
+    }
 
-        if (ret == l_True && current_nr_of_solutions < max_nr_of_solutions) {
-            printResultFunc(&cout, false, ret);
-            if (resultfile) {
-                printResultFunc(resultfile, true, ret);
-            }
+    //The last solution is printed by the caller, like a single one
+    current_nr_of_solutions = 0;
+    return solver->enumerate_models(
+        print_intermediate_solution, this, true, only_sampling_solution);
+}
 
-            if (conf.verbosity) {
-                cout
-                << "c Number of solutions found until now: "
-                << std::setw(6) << current_nr_of_solutions
-                << endl;
-            }
-            #ifdef VERBOSE_DEBUG_RECONSTRUCT
-            solver->print_removed_vars();
-            #endif
+bool Main::print_intermediate_solution(void* state, const vector<lbool>&)
+{
+    Main* m = (Main*)state;
+    m->current_nr_of_solutions++;
+    if (m->current_nr_of_solutions == m->max_nr_of_solutions) {
+        return false;
+    }
 
-            //Banning found solution
-            vector<Lit> lits;
-            if (sampling_vars.empty()) {
-                if (solver->get_decision_reaching_valid()) {
-                    //only decision vars
-                    for (Lit lit: solver->get_decisions_reaching_model()) {
-                      lits.push_back(~lit);
-                    }
-                } else {
-                    //all of the solution
-                    for (uint32_t var = 0; var < solver->nVars(); var++) {
-                        if (solver->get_model()[var] != l_Undef) {
-                            lits.push_back( Lit(var, (solver->get_model()[var] == l_True)? true : false) );
-                        }
-                    }
-                }
-            } else {
-              for (const uint32_t var: sampling_vars) {
-                  if (solver->get_model()[var] != l_Undef) {
-                      lits.push_back( Lit(var, (solver->get_model()[var] == l_True)? true : false) );
-                  }
-              }
-            }
-            solver->add_clause(lits);
-        }
+    m->printResultFunc(&cout, false, l_True);
+    if (m->resultfile) {
+        m->printResultFunc(m->resultfile, true, l_True);
     }
-    return ret;
+    if (m->conf.verbosity) {
+        cout
+        << "c Number of solutions found until now: "
+        << std::setw(6) << m->current_nr_of_solutions
+        << endl;
+    }
+    #ifdef VERBOSE_DEBUG_RECONSTRUCT
+    m->solver->print_removed_vars();
+    #endif
+    return true;
 }
 
 ///////////
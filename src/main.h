@@ -88,6 +88,8 @@ class Main: public MainCommon
 
         //File reading
         void readInAFile(SATSolver* solver2, const string& filename);
+        bool readInAFileMmap(SATSolver* solver2, const string& filename, vector<uint32_t>& parsed_sampling_vars);
+        void readInAFileStream(SATSolver* solver2, const string& filename, vector<uint32_t>& parsed_sampling_vars);
         void readInStandardInput(SATSolver* solver2);
         void parseInAllFiles(SATSolver* solver2);
 
@@ -100,14 +102,18 @@ class Main: public MainCommon
         void printVersionInfo();
         int correctReturnValue(const lbool ret) const;
         lbool multi_solutions();
+        static bool print_intermediate_solution(void* state, const vector<lbool>& values);
         void dump_red_file();
 
         //Config
         std::string resultFilename;
         std::string debugLib;
+        int mmap_parse = true;
+        unsigned parse_threads = 0;
         int printResult = true;
         string commandLine;
         uint32_t max_nr_of_solutions = 1;
+        uint32_t current_nr_of_solutions = 0;
         int sql = 0;
         string sqlite_filename;
         string decisions_for_model_fname;
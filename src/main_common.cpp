@@ -36,6 +36,9 @@ void MainCommon::handle_drat_option()
     if (!conf.simulate_drat) {
         if (dratDebug) {
             dratf = &cout;
+
+            //The proof must interleave with the solver's own output
+            conf.drat_async_bufs = 0;
         } else {
             std::ofstream* dratfTmp = new std::ofstream;
             dratfTmp->open(dratfilname.c_str(), std::ofstream::out | std::ofstream::binary);
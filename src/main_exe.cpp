@@ -43,6 +43,10 @@ int main(int argc, char** argv)
         main.parseCommandLine();
 
         signal(SIGINT, SIGINT_handler);
+        if (!main.conf.checkpoint_file.empty()) {
+            //Preempted jobs get a SIGTERM, write a last checkpoint then
+            signal(SIGTERM, SIGINT_handler);
+        }
         ret = main.solve();
     } catch (CMSat::TooManyVarsError& e) {
         std::cerr << "ERROR! Variable requested is far too large" << std::endl;
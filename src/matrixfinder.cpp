@@ -215,6 +215,9 @@ bool MatrixFinder::findMatrixes(bool simplify_xors)
         << solver->conf.print_times(time_used, time_out)
         << endl;
     }
+    if (solver->conf.verbosity >= 2 && numMatrixes > 0) {
+        cout << "c [matrix] row kernels: " << packedrow_kernels->name << endl;
+    }
     if (solver->sqlStats) {
         solver->sqlStats->time_passed_min(
             solver
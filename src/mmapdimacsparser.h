@@ -0,0 +1,640 @@
+/******************************************
+Copyright (c) 2018, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef MMAPDIMACSPARSER_H
+#define MMAPDIMACSPARSER_H
+
+#ifndef _WIN32
+#define MMAP_DIMACS_AVAILABLE
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <string.h>
+#include <cstdlib>
+#include <cstdint>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <thread>
+#include <limits>
+#include <utility>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include "cryptominisat5/cryptominisat.h"
+
+using namespace CMSat;
+using std::vector;
+
+/**
+@brief Reads uncompressed DIMACS files via mmap, tokenizing in parallel
+
+The file is cut into chunks at line boundaries. A window of chunks is
+tokenized in parallel into flat literal arrays, then the chunks are handed
+to the solver in file order, so the solver sees exactly the same sequence
+of calls as with DimacsParser. Only one window is in memory at any time.
+
+Accepts the same syntax as DimacsParser, except for the debugLib comments.
+Use DimacsParser for those, and for compressed input or pipes.
+*/
+class MmapDimacsParser
+{
+    public:
+        MmapDimacsParser(SATSolver* solver, unsigned verbosity, unsigned num_threads);
+        ~MmapDimacsParser();
+
+        ///False if the file cannot be mapped or is gzip-compressed. Nothing
+        ///has been read in that case
+        bool open(const std::string& fname);
+        bool parse_DIMACS(const bool strict_header);
+
+        uint64_t max_var = std::numeric_limits<uint64_t>::max();
+        vector<uint32_t> sampling_vars;
+        size_t chunk_bytes = 32ULL*1024ULL*1024ULL; ///<cut at the next newline
+        const std::string dimacs_spec = "http://www.satcompetition.org/2009/format-benchmarks2009.html";
+        const std::string please_read_dimacs = "\nPlease read DIMACS specification at http://www.satcompetition.org/2009/format-benchmarks2009.html";
+
+    private:
+        enum class EntryType : uint32_t {clause, xor_clause, header, ind};
+        struct Entry
+        {
+            EntryType type;
+            uint32_t num; ///<number of literals/vars, or index of header
+            uint32_t line; ///<line number within the chunk
+        };
+
+        struct Chunk
+        {
+            void reset(const char* _start, const char* _end)
+            {
+                start = _start;
+                end = _end;
+                lits.clear();
+                ind_vars.clear();
+                entries.clear();
+                headers.clear();
+                empty_lines.clear();
+                lines = 0;
+                ok = true;
+                error.clear();
+            }
+
+            const char* start;
+            const char* end;
+            vector<Lit> lits;
+            vector<uint32_t> ind_vars;
+            vector<Entry> entries;
+            vector<std::pair<int32_t, int32_t> > headers;
+            vector<uint32_t> empty_lines;
+            uint32_t lines;
+
+            bool ok;
+            std::string error;
+        };
+
+        void tokenize(Chunk& ch) const;
+        bool tokenize_clause(const char*& p, Chunk& ch, const bool allow_trailing_ws) const;
+        bool parse_int(const char*& p, const char* end, int32_t& ret, Chunk& ch) const;
+        void skip_ws(const char*& p, const char* end) const;
+        void skip_line(const char*& p, const char* end) const;
+        bool apply(const Chunk& ch);
+        void add_pending_clauses(const Lit* lits);
+        bool apply_header(const int32_t vars, const int32_t cls, const uint64_t line);
+        bool add_needed_vars(const Lit* l, const uint32_t num, const uint64_t line);
+
+        SATSolver* solver;
+        unsigned verbosity;
+        unsigned num_threads;
+
+        //The mapped file
+        int fd = -1;
+        const char* data = NULL;
+        size_t data_size = 0;
+
+        //Lines in the chunks already handed to the solver
+        uint64_t lineNum = 0;
+
+        bool strict_header = false;
+        bool header_found = false;
+        int num_header_vars = 0;
+        int num_header_cls = 0;
+
+        //Consecutive clauses are added with a single add_clauses() call
+        vector<size_t> offsets;
+        vector<uint32_t> vars;
+
+        size_t norm_clauses_added = 0;
+        size_t xor_clauses_added = 0;
+};
+
+inline MmapDimacsParser::MmapDimacsParser(
+    SATSolver* _solver
+    , unsigned _verbosity
+    , unsigned _num_threads
+) :
+    solver(_solver)
+    , verbosity(_verbosity)
+    , num_threads(_num_threads)
+{
+    if (num_threads == 0) {
+        num_threads = std::min(16U, std::max(1U, std::thread::hardware_concurrency()));
+    }
+}
+
+inline MmapDimacsParser::~MmapDimacsParser()
+{
+    if (data != NULL) {
+        munmap((void*)data, data_size);
+    }
+    if (fd != -1) {
+        close(fd);
+    }
+}
+
+inline bool MmapDimacsParser::open(const std::string& fname)
+{
+    fd = ::open(fname.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0
+        || !S_ISREG(st.st_mode)
+        || st.st_size == 0
+    ) {
+        return false;
+    }
+
+    void* mem = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mem == MAP_FAILED) {
+        return false;
+    }
+    data = (const char*)mem;
+    data_size = st.st_size;
+
+    //gzip magic number, leave it to zlib
+    if (data_size >= 2
+        && (unsigned char)data[0] == 0x1f
+        && (unsigned char)data[1] == 0x8b
+    ) {
+        return false;
+    }
+    madvise(mem, data_size, MADV_SEQUENTIAL);
+
+    return true;
+}
+
+inline void MmapDimacsParser::skip_ws(const char*& p, const char* end) const
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+        p++;
+    }
+}
+
+inline void MmapDimacsParser::skip_line(const char*& p, const char* end) const
+{
+    const char* nl = (const char*)memchr(p, '\n', end-p);
+    p = (nl == NULL) ? end : nl+1;
+}
+
+inline bool MmapDimacsParser::parse_int(
+    const char*& p
+    , const char* end
+    , int32_t& ret
+    , Chunk& ch
+) const {
+    skip_ws(p, end);
+    int64_t mult = 1;
+    if (p < end && *p == '-') {
+        mult = -1;
+        p++;
+    } else if (p < end && *p == '+') {
+        p++;
+    }
+
+    if (p == end || *p < '0' || *p > '9') {
+        std::stringstream ss;
+        ss << "PARSE ERROR! Unexpected char (dec: '"
+        << (p == end ? ' ' : *p) << ")"
+        << " we expected a number";
+        ch.error = ss.str();
+        return false;
+    }
+
+    int64_t val = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        val = val*10 + (*p - '0');
+        if (val > std::numeric_limits<int32_t>::max()) {
+            ch.error = "PARSE ERROR! The variable number is to high";
+            return false;
+        }
+        p++;
+    }
+    ret = mult*val;
+    return true;
+}
+
+inline bool MmapDimacsParser::tokenize_clause(
+    const char*& p
+    , Chunk& ch
+    , const bool allow_trailing_ws
+) const {
+    const size_t at = ch.lits.size();
+    int32_t parsed_lit;
+    for (;;) {
+        if (!parse_int(p, ch.end, parsed_lit, ch)) {
+            return false;
+        }
+        if (parsed_lit == 0) {
+            break;
+        }
+
+        const uint32_t var = std::abs(parsed_lit)-1;
+        if (var > max_var) {
+            std::stringstream ss;
+            ss << "ERROR! "
+            << "Variable requested is too large for DIMACS parser parameter: "
+            << var << please_read_dimacs;
+            ch.error = ss.str();
+            return false;
+        }
+        if (var >= (1ULL<<28)) {
+            std::stringstream ss;
+            ss << "ERROR! "
+            << "Variable requested is far too large: " << var + 1
+            << please_read_dimacs;
+            ch.error = ss.str();
+            return false;
+        }
+        ch.lits.push_back(Lit(var, parsed_lit < 0));
+
+        if (p == ch.end || (*p != ' ' && *p != '\t' && *p != '\r')) {
+            ch.error = "ERROR! After last element on the line must be 0" + please_read_dimacs;
+            return false;
+        }
+    }
+
+    if (allow_trailing_ws) {
+        skip_ws(p, ch.end);
+    }
+    while (p < ch.end && *p == '\r') {
+        p++;
+    }
+    if (p < ch.end) {
+        if (*p != '\n') {
+            std::stringstream ss;
+            ss << "PARSE ERROR! Unexpected char (hex: " << std::hex
+            << std::setw(2) << std::setfill('0')
+            << "0x" << (int)*p << std::dec << ")"
+            << " we expected an end of line character (\\n or \\r + \\n)";
+            ch.error = ss.str();
+            return false;
+        }
+        p++;
+    }
+
+    ch.entries.push_back(Entry{
+        allow_trailing_ws ? EntryType::clause : EntryType::xor_clause
+        , (uint32_t)(ch.lits.size() - at)
+        , ch.lines});
+    ch.lines++;
+    return true;
+}
+
+//Runs in parallel, must not touch the solver
+inline void MmapDimacsParser::tokenize(Chunk& ch) const
+{
+    const char* p = ch.start;
+    const char* const end = ch.end;
+    while (ch.ok) {
+        skip_ws(p, end);
+        if (p == end) {
+            break;
+        }
+
+        switch (*p) {
+            case '\n':
+                ch.empty_lines.push_back(ch.lines);
+                p++;
+                ch.lines++;
+                break;
+
+            case 'c':
+            case 'w': {
+                p++;
+                skip_ws(p, end);
+                const char* word = p;
+                while (p < end && *p != ' ' && *p != '\t' && *p != '\r'
+                    && *p != '\n'
+                ) {
+                    p++;
+                }
+                if (p - word == 3 && memcmp(word, "ind", 3) == 0) {
+                    const size_t at = ch.ind_vars.size();
+                    int32_t parsed_lit;
+                    for (;;) {
+                        if (!parse_int(p, end, parsed_lit, ch)) {
+                            ch.ok = false;
+                            return;
+                        }
+                        if (parsed_lit == 0) {
+                            break;
+                        }
+                        ch.ind_vars.push_back(std::abs(parsed_lit)-1);
+                    }
+                    ch.entries.push_back(Entry{EntryType::ind
+                        , (uint32_t)(ch.ind_vars.size() - at), ch.lines});
+                }
+                skip_line(p, end);
+                ch.lines++;
+                break;
+            }
+
+            case 'p': {
+                int32_t vars_in_header;
+                int32_t cls_in_header;
+                if (end - p < 5 || memcmp(p, "p cnf", 5) != 0) {
+                    ch.error = "PARSE ERROR! Unexpected char in the header" + please_read_dimacs;
+                    ch.ok = false;
+                    return;
+                }
+                p += 5;
+                if (!parse_int(p, end, vars_in_header, ch)
+                    || !parse_int(p, end, cls_in_header, ch)
+                ) {
+                    ch.ok = false;
+                    return;
+                }
+                ch.entries.push_back(Entry{EntryType::header
+                    , (uint32_t)ch.headers.size(), ch.lines});
+                ch.headers.push_back(std::make_pair(vars_in_header, cls_in_header));
+                skip_line(p, end);
+                ch.lines++;
+                break;
+            }
+
+            case 'x':
+                p++;
+                if (!tokenize_clause(p, ch, false)) {
+                    ch.ok = false;
+                    return;
+                }
+                break;
+
+            default:
+                if (!tokenize_clause(p, ch, true)) {
+                    ch.ok = false;
+                    return;
+                }
+                break;
+        }
+    }
+}
+
+inline bool MmapDimacsParser::apply_header(
+    const int32_t vars_in_header
+    , const int32_t cls_in_header
+    , const uint64_t line
+) {
+    if (header_found && strict_header) {
+        std::cerr << "ERROR: CNF header ('p cnf vars cls') found twice in file! Exiting." << std::endl;
+        return false;
+    }
+    header_found = true;
+    num_header_vars = vars_in_header;
+    num_header_cls = cls_in_header;
+
+    if (verbosity) {
+        std::cout << "c -- header says num vars:   " << std::setw(12) << num_header_vars << std::endl;
+        std::cout << "c -- header says num clauses:" <<  std::setw(12) << num_header_cls << std::endl;
+    }
+    if (num_header_vars < 0) {
+        std::cerr << "ERROR: Number of variables in header cannot be less than 0"
+        << " (line " << line << ")" << std::endl;
+        return false;
+    }
+    if (num_header_cls < 0) {
+        std::cerr << "ERROR: Number of clauses in header cannot be less than 0"
+        << " (line " << line << ")" << std::endl;
+        return false;
+    }
+
+    if (solver->nVars() < (size_t)num_header_vars) {
+        solver->new_vars(num_header_vars-solver->nVars());
+    }
+    return true;
+}
+
+inline bool MmapDimacsParser::add_needed_vars(
+    const Lit* l
+    , const uint32_t num
+    , const uint64_t line
+) {
+    if (num == 0) {
+        return true;
+    }
+
+    if (strict_header && !header_found) {
+        std::cerr
+        << "ERROR! "
+        << "DIMACS header ('p cnf vars cls') never found!" << std::endl;
+        return false;
+    }
+
+    uint32_t max_in_cl = 0;
+    for (const Lit* it = l, *end = l + num; it != end; ++it) {
+        max_in_cl = std::max(max_in_cl, it->var());
+    }
+
+    if (strict_header && (int)max_in_cl >= num_header_vars) {
+        std::cerr
+        << "ERROR! "
+        << "Variable requested is larger than the header told us." << std::endl
+        << " -> var is : " << max_in_cl + 1 << std::endl
+        << " -> header told us maximum will be : " << num_header_vars << std::endl
+        << " -> At line " << line
+        << std::endl;
+        return false;
+    }
+
+    if (max_in_cl >= solver->nVars()) {
+        assert(!strict_header);
+        solver->new_vars(max_in_cl - solver->nVars() + 1);
+    }
+    return true;
+}
+
+inline void MmapDimacsParser::add_pending_clauses(const Lit* lits)
+{
+    if (offsets.size() > 1) {
+        solver->add_clauses(lits, offsets.data(), offsets.size()-1);
+        norm_clauses_added += offsets.size()-1;
+    }
+    offsets.clear();
+}
+
+//Hands one tokenized chunk to the solver, in file order
+inline bool MmapDimacsParser::apply(const Chunk& ch)
+{
+    for (const uint32_t line: ch.empty_lines) {
+        std::cerr
+        << "c WARNING: Empty line at line number " << lineNum + line + 1
+        << " -- this is not part of the DIMACS specifications ("
+        << dimacs_spec << "). Ignoring."
+        << std::endl;
+    }
+
+    const Lit* const lits = ch.lits.data();
+    const Lit* l = lits;
+    const uint32_t* ind = ch.ind_vars.data();
+    offsets.clear();
+    for (const Entry& e: ch.entries) {
+        const uint64_t line = lineNum + e.line + 1;
+        if (e.type == EntryType::clause) {
+            if (!add_needed_vars(l, e.num, line)) {
+                add_pending_clauses(lits);
+                return false;
+            }
+            if (offsets.empty()) {
+                offsets.push_back(l - lits);
+            }
+            l += e.num;
+            offsets.push_back(l - lits);
+            continue;
+        }
+        add_pending_clauses(lits);
+
+        switch (e.type) {
+            case EntryType::header:
+                if (!apply_header(ch.headers[e.num].first, ch.headers[e.num].second, line)) {
+                    return false;
+                }
+                break;
+
+            case EntryType::clause:
+                assert(false);
+                break;
+
+            case EntryType::xor_clause: {
+                if (!add_needed_vars(l, e.num, line)) {
+                    return false;
+                }
+                if (e.num == 0) {
+                    break;
+                }
+                bool rhs = true;
+                vars.clear();
+                for (const Lit* it = l, *end = l + e.num; it != end; ++it) {
+                    vars.push_back(it->var());
+                    if (it->sign()) {
+                        rhs ^= true;
+                    }
+                }
+                solver->add_xor_clause(vars, rhs);
+                xor_clauses_added++;
+                l += e.num;
+                break;
+            }
+
+            case EntryType::ind:
+                sampling_vars.insert(sampling_vars.end(), ind, ind + e.num);
+                ind += e.num;
+                break;
+        }
+    }
+    add_pending_clauses(lits);
+
+    if (!ch.ok) {
+        std::cerr << ch.error << std::endl
+        << "--> At line " << lineNum + ch.lines + 1 << std::endl;
+        return false;
+    }
+    return true;
+}
+
+inline bool MmapDimacsParser::parse_DIMACS(const bool _strict_header)
+{
+    strict_header = _strict_header;
+    const uint32_t origNumVars = solver->nVars();
+
+    vector<Chunk> chunks(num_threads);
+    size_t pos = 0;
+    while (pos < data_size) {
+        //Cut a window of chunks at line boundaries
+        const size_t window_start = pos;
+        size_t num_chunks = 0;
+        for (; num_chunks < num_threads && pos < data_size; num_chunks++) {
+            size_t chunk_end = std::min(pos + chunk_bytes, data_size);
+            if (chunk_end < data_size) {
+                const char* nl = (const char*)memchr(
+                    data + chunk_end, '\n', data_size - chunk_end);
+                chunk_end = (nl == NULL) ? data_size : (nl - data) + 1;
+            }
+            chunks[num_chunks].reset(data + pos, data + chunk_end);
+            pos = chunk_end;
+        }
+
+        //Chunk 0 is done by this thread, then the chunks are added in order
+        //as their threads finish
+        vector<std::thread> thds;
+        for (size_t i = 1; i < num_chunks; i++) {
+            thds.push_back(std::thread(
+                &MmapDimacsParser::tokenize, this, std::ref(chunks[i])));
+        }
+        tokenize(chunks[0]);
+
+        bool ok = true;
+        for (size_t i = 0; i < num_chunks; i++) {
+            if (i > 0) {
+                thds[i-1].join();
+            }
+            if (ok) {
+                ok = apply(chunks[i]);
+                lineNum += chunks[i].lines;
+            }
+        }
+        if (!ok) {
+            return false;
+        }
+        madvise((void*)(data + (window_start & ~(size_t)(getpagesize()-1)))
+            , pos - (window_start & ~(size_t)(getpagesize()-1))
+            , MADV_DONTNEED);
+    }
+
+    if (verbosity) {
+        std::cout
+        << "c -- clauses added: " << norm_clauses_added << std::endl
+        << "c -- xor clauses added: " << xor_clauses_added << std::endl
+        << "c -- vars added " << (solver->nVars() - origNumVars)
+        << std::endl;
+    }
+
+    return true;
+}
+
+#endif //_WIN32
+#endif //MMAPDIMACSPARSER_H
@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include <limits>
 #include <cmath>
 #include <functional>
+#include <thread>
 
 
 #include "popcnt.h"
@@ -210,6 +211,30 @@ uint32_t OccSimplifier::dump_blocked_clauses(std::ostream* outfile) const
     return num_cls;
 }
 
+//Each clause is preceded by lit_Undef, as in the SATSolver clause buffer
+void OccSimplifier::dump_blocked_clauses(vector<Lit>& buf) const
+{
+    for (const BlockedClauses& blocked: blockedClauses) {
+        if (blocked.toRemove)
+            continue;
+
+        //It's blocked on the var at 0
+        bool new_cl = true;
+        for (size_t i = 1; i < blocked.size(); i++) {
+            const Lit l = blocked.at(i, blkcls);
+            if (l == lit_Undef) {
+                new_cl = true;
+                continue;
+            }
+            if (new_cl) {
+                buf.push_back(lit_Undef);
+                new_cl = false;
+            }
+            buf.push_back(l);
+        }
+    }
+}
+
 void OccSimplifier::extend_model(SolutionExtender* extender)
 {
     //Either a variable is not eliminated, or its value is undef
@@ -356,7 +381,7 @@ lbool OccSimplifier::clean_clause(ClOffset offset)
         }
     }
     cl.shrink(i-j);
-    cl.recalc_abst_if_needed();
+    solver->cl_alloc.recalc_abst_if_needed(cl);
 
     //Update lits stat
     if (cl.red()) {
@@ -412,7 +437,7 @@ lbool OccSimplifier::clean_clause(ClOffset offset)
         }
         default:
             cl.setStrenghtened();
-            cl.recalc_abst_if_needed();
+            solver->cl_alloc.recalc_abst_if_needed(cl);
             if (!cl.red()) {
                 added_long_cl.push_back(offset);
             }
@@ -449,7 +474,7 @@ bool OccSimplifier::complete_clean_clause(Clause& cl)
         }
     }
     cl.shrink(i-j);
-    cl.recalc_abst_if_needed();
+    solver->cl_alloc.recalc_abst_if_needed(cl);
 
     //Drat
     if (i - j > 0) {
@@ -545,8 +570,8 @@ OccSimplifier::LinkInData OccSimplifier::link_in_clauses(
     LinkInData link_in_data;
     for (const ClOffset offs: toAdd) {
         Clause* cl = solver->cl_alloc.ptr(offs);
-        cl->recalc_abst_if_needed();
-        assert(cl->abst == calcAbstraction(*cl));
+        solver->cl_alloc.recalc_abst_if_needed(cl);
+        assert(solver->cl_alloc.abst(cl) == calcAbstraction(*cl));
 
         if (alsoOccur
             && cl->size() < max_size
@@ -633,16 +658,16 @@ void OccSimplifier::add_back_to_solver()
         if (complete_clean_clause(*cl)) {
             solver->attachClause(*cl);
             if (cl->red()) {
-                assert(cl->stats.which_red_array < solver->longRedCls.size());
-                if (cl->stats.glue <= solver->conf.glue_put_lev0_if_below_or_eq) {
-                    cl->stats.which_red_array = 0;
+                assert(solver->cl_alloc.stats(cl).which_red_array < solver->longRedCls.size());
+                if (solver->cl_alloc.stats(cl).glue <= solver->conf.glue_put_lev0_if_below_or_eq) {
+                    solver->cl_alloc.stats(cl).which_red_array = 0;
                 } else if (
-                    cl->stats.glue <= solver->conf.glue_put_lev1_if_below_or_eq
+                    solver->cl_alloc.stats(cl).glue <= solver->conf.glue_put_lev1_if_below_or_eq
                     && solver->conf.glue_put_lev1_if_below_or_eq != 0
                 ) {
-                    cl->stats.which_red_array = 1;
+                    solver->cl_alloc.stats(cl).which_red_array = 1;
                 }
-                solver->longRedCls[cl->stats.which_red_array].push_back(offs);
+                solver->longRedCls[solver->cl_alloc.stats(cl).which_red_array].push_back(offs);
             } else {
                 solver->longIrredCls.push_back(offs);
             }
@@ -862,10 +887,10 @@ bool OccSimplifier::deal_with_added_cl_to_var_lit(const Lit lit)
             Clause* cl = solver->cl_alloc.ptr(offs);
 
             //Has already been removed or added to "added_long_cl"
-            if (cl->freed() || cl->getRemoved() || cl->stats.marked_clause)
+            if (cl->freed() || cl->getRemoved() || solver->cl_alloc.stats(cl).marked_clause)
                 continue;
 
-            cl->stats.marked_clause = 1;
+            solver->cl_alloc.stats(cl).marked_clause = 1;
             added_long_cl.push_back(offs);
         }
     }
@@ -952,6 +977,7 @@ bool OccSimplifier::eliminate_vars()
     assert(solver->watches.get_smudged_list().empty());
     bvestats.clear();
     bvestats.numCalls = 1;
+    size_elim_scratch(1);
 
     //Go through the ordered list of variables to eliminate
     int64_t last_elimed = 1;
@@ -1011,46 +1037,51 @@ bool OccSimplifier::eliminate_vars()
             && !solver->must_interrupt_asap()
         ) {
             removed_cl_with_var.clear();
-            while(!velim_order.empty()
-                && *limit_to_decrease > 0
-                && varelim_num_limit > 0
-                && varelim_linkin_limit_bytes > 0
-                && !solver->must_interrupt_asap()
-            ) {
-                assert(limit_to_decrease == &norm_varelim_time_limit);
-                uint32_t var = velim_order.removeMin();
-
-                //Stats
-                *limit_to_decrease -= 20;
-                wenThrough++;
+            if (solver->conf.varelim_threads > 1) {
+                if (!eliminate_vars_par(wenThrough, vars_elimed, last_elimed))
+                    goto end;
+            } else {
+                while(!velim_order.empty()
+                    && *limit_to_decrease > 0
+                    && varelim_num_limit > 0
+                    && varelim_linkin_limit_bytes > 0
+                    && !solver->must_interrupt_asap()
+                ) {
+                    assert(limit_to_decrease == &norm_varelim_time_limit);
+                    uint32_t var = velim_order.removeMin();
 
-                if (!can_eliminate_var(var))
-                    continue;
+                    //Stats
+                    *limit_to_decrease -= 20;
+                    wenThrough++;
 
-                //Try to eliminate
-                elim_calc_need_update.clear();
-                if (maybe_eliminate(var)) {
-                    vars_elimed++;
-                    varelim_num_limit--;
-                    last_elimed++;
-                }
-                if (!solver->ok)
-                    goto end;
+                    if (!can_eliminate_var(var))
+                        continue;
 
-                //SUB and STR for long and short
-                limit_to_decrease = &varelim_sub_str_limit;
-                if (!deal_with_added_long_and_bin(false)) {
+                    //Try to eliminate
+                    elim_calc_need_update.clear();
+                    if (maybe_eliminate(var)) {
+                        vars_elimed++;
+                        varelim_num_limit--;
+                        last_elimed++;
+                    }
+                    if (!solver->ok)
+                        goto end;
+
+                    //SUB and STR for long and short
+                    limit_to_decrease = &varelim_sub_str_limit;
+                    if (!deal_with_added_long_and_bin(false)) {
+                        limit_to_decrease = &norm_varelim_time_limit;
+                        goto end;
+                    }
                     limit_to_decrease = &norm_varelim_time_limit;
-                    goto end;
-                }
-                limit_to_decrease = &norm_varelim_time_limit;
 
-                solver->ok = solver->propagate_occur();
-                if (!solver->okay()) {
-                    goto end;
-                }
+                    solver->ok = solver->propagate_occur();
+                    if (!solver->okay()) {
+                        goto end;
+                    }
 
-                update_varelim_complexity_heap();
+                    update_varelim_complexity_heap();
+                }
             }
 
             //Clean clauses that have vars that have been set
@@ -1285,7 +1316,7 @@ void OccSimplifier::sort_occurs_and_set_abst()
                 } else if (cl->size() >solver->conf.maxXorToFind) {
                     w.setBlockedLit(lit_Undef);
                 } else {
-                    w.setBlockedLit(Lit::toLit(cl->abst));
+                    w.setBlockedLit(Lit::toLit(solver->cl_alloc.abst(cl)));
                 }
             }
         }
@@ -1361,7 +1392,7 @@ bool OccSimplifier::execute_simplifier_strategy(const string& strategy)
                 sort_occurs_and_set_abst();
                 for(ClOffset offset: clauses) {
                     Clause* cl = solver->cl_alloc.ptr(offset);
-                    cl->stats.marked_clause = false;
+                    solver->cl_alloc.stats(cl).marked_clause = false;
                 }
             }
         } else if (token == "occ-clean-implicit") {
@@ -1512,21 +1543,25 @@ bool OccSimplifier::ternary_res()
 
     //NOTE: the "clauses" here will change in size as we add resolvents
     size_t at = solver->mtrand.randInt(clauses.size()-1);
-    for(size_t i = 0; i < clauses.size(); i++) {
-        ClOffset offs = clauses[(at+i) % clauses.size()];
-        Clause * cl = solver->cl_alloc.ptr(offs);
-        *limit_to_decrease -= 10;
-        if (!cl->freed()
-            && !cl->getRemoved()
-            && !cl->is_ternary_resolved
-            && cl->size() == 3
-            && !cl->red()
-            && *limit_to_decrease > 0
-            && ternary_res_cls_limit > 0
-        ) {
-            cl->is_ternary_resolved = true;
-            if (!perform_ternary(cl, offs))
-                break;
+    if (solver->conf.ternary_res_threads > 1) {
+        ternary_res_par(at);
+    } else {
+        for(size_t i = 0; i < clauses.size(); i++) {
+            ClOffset offs = clauses[(at+i) % clauses.size()];
+            Clause * cl = solver->cl_alloc.ptr(offs);
+            *limit_to_decrease -= 10;
+            if (!cl->freed()
+                && !cl->getRemoved()
+                && !cl->is_ternary_resolved
+                && cl->size() == 3
+                && !cl->red()
+                && *limit_to_decrease > 0
+                && ternary_res_cls_limit > 0
+            ) {
+                cl->is_ternary_resolved = true;
+                if (!perform_ternary(cl, offs))
+                    break;
+            }
         }
     }
 
@@ -1557,9 +1592,26 @@ bool OccSimplifier::ternary_res()
 bool OccSimplifier::perform_ternary(Clause* cl, ClOffset offs)
 {
     assert(cl_to_add_ternary.empty());
-    *limit_to_decrease -= 3;
+    find_ternary(cl, offs, seen, cl_to_add_ternary, *limit_to_decrease);
+
+    return add_ternary_resolvents(cl_to_add_ternary);
+}
+
+/**
+@brief Finds the ternary resolvents of cl into found
+
+Only reads the occur lists and the clauses, using seen_tern as scratch.
+*/
+void OccSimplifier::find_ternary(
+    const Clause* cl
+    , ClOffset offs
+    , vector<uint16_t>& seen_tern
+    , vector<vector<Lit>>& found
+    , int64_t& limit
+) {
+    limit -= 3;
     for(const Lit l: *cl) {
-        seen[l.toInt()] = 1;
+        seen_tern[l.toInt()] = 1;
     }
 
     size_t largest = 0;
@@ -1576,17 +1628,21 @@ bool OccSimplifier::perform_ternary(Clause* cl, ClOffset offs)
         if (l == dont_check) {
             continue;
         }
-        check_ternary_cl(cl, offs, solver->watches[l]);
-        check_ternary_cl(cl, offs, solver->watches[~l]);
+        check_ternary_cl(cl, offs, solver->watches[l], seen_tern, found, limit);
+        check_ternary_cl(cl, offs, solver->watches[~l], seen_tern, found, limit);
     }
 
     //clean up
     for(const Lit l: *cl) {
-        seen[l.toInt()] = 0;
+        seen_tern[l.toInt()] = 0;
     }
+}
 
+bool OccSimplifier::add_ternary_resolvents(vector<vector<Lit>>& found)
+{
     //Add new ternary resolvents
-    for(vector<Lit>& newcl: cl_to_add_ternary) {
+    for(vector<Lit>& newcl: found) {
+        runStats.ternary_added++;
         Clause* newCl = solver->add_clause_int(
             newcl //Literals in new clause
             , true //Is the new clause redundant?
@@ -1600,28 +1656,34 @@ bool OccSimplifier::perform_ternary(Clause* cl, ClOffset offs)
             break;
 
         if (newCl != NULL) {
-            newCl->stats.glue = 3;
-            newCl->stats.which_red_array = 1;
+            solver->cl_alloc.stats(newCl).glue = 3;
+            solver->cl_alloc.stats(newCl).which_red_array = 1;
             linkInClause(*newCl);
             ClOffset offset = solver->cl_alloc.get_offset(newCl);
             clauses.push_back(offset);
         }
     }
-    cl_to_add_ternary.clear();
+    found.clear();
 
     return solver->okay();
 }
 
-void OccSimplifier::check_ternary_cl(Clause* cl, ClOffset offs, watch_subarray ws)
-{
-    *limit_to_decrease -= ws.size()*2;
-    for (Watched& w: ws) {
+void OccSimplifier::check_ternary_cl(
+    const Clause* cl
+    , ClOffset offs
+    , watch_subarray_const ws
+    , const vector<uint16_t>& seen_tern
+    , vector<vector<Lit>>& found
+    , int64_t& limit
+) {
+    limit -= ws.size()*2;
+    for (const Watched& w: ws) {
         if (!w.isClause() || w.get_offset() == offs)
             continue;
 
         ClOffset offs2 = w.get_offset();
-        Clause * cl2 = solver->cl_alloc.ptr(offs2);
-        *limit_to_decrease -= 10;
+        const Clause * cl2 = solver->cl_alloc.ptr(offs2);
+        limit -= 10;
         if (!cl2->freed()
             && !cl2->getRemoved()
             && cl2->size() == 3
@@ -1631,9 +1693,9 @@ void OccSimplifier::check_ternary_cl(Clause* cl, ClOffset offs, watch_subarray w
             uint32_t num_vars = 3;
             Lit lit_clash = lit_Undef;
             for(Lit l2: *cl2) {
-                num_vars += !(seen[l2.toInt()] | seen[(~l2).toInt()]);
-                num_lits += !seen[l2.toInt()];
-                if (seen[(~l2).toInt()]) {
+                num_vars += !(seen_tern[l2.toInt()] | seen_tern[(~l2).toInt()]);
+                num_lits += !seen_tern[l2.toInt()];
+                if (seen_tern[(~l2).toInt()]) {
                     lit_clash = l2;
 
                     //It's symmetric so only do it one way
@@ -1655,19 +1717,103 @@ void OccSimplifier::check_ternary_cl(Clause* cl, ClOffset offs, watch_subarray w
             }
             for(Lit l: *cl2) {
                 if (l.var() != lit_clash.var()
-                    && !seen[l.toInt()]
+                    && !seen_tern[l.toInt()]
                 ) {
                     newcl.push_back(l);
                 }
             }
-            cl_to_add_ternary.push_back(newcl);
-            *limit_to_decrease-=20;
-            runStats.ternary_added++;
+            found.push_back(newcl);
+            limit-=20;
             //cout << "tri: " << *cl << " , " << *cl2 << " Resolve on: " << lit_clash << endl;
         }
     }
 }
 
+//Number of clauses searched by the threads before the resolvents are added
+static const size_t par_tern_window = 16*1024;
+
+/**
+@brief Same walk over the clauses as ternary_res, in windows
+
+The resolvents of every clause in the window are found on
+conf.ternary_res_threads threads, then added on the calling thread in walk
+order. Adding them cannot change what the rest of the window finds: only
+irredundant clauses are resolved, and the resolvents are redundant. The search
+cost is charged in walk order, so the result is the same regardless of the
+number of threads.
+*/
+void OccSimplifier::ternary_res_par(const size_t at)
+{
+    size_elim_scratch(solver->conf.ternary_res_threads);
+
+    //NOTE: the "clauses" here will change in size as we add resolvents
+    size_t i = 0;
+    while(i < clauses.size()
+        && *limit_to_decrease > 0
+        && ternary_res_cls_limit > 0
+    ) {
+        par_tern_todo.clear();
+        for(; par_tern_todo.size() < par_tern_window && i < clauses.size(); i++) {
+            par_tern_todo.push_back(clauses[(at+i) % clauses.size()]);
+        }
+        if (par_tern_found.size() < par_tern_todo.size()) {
+            par_tern_found.resize(par_tern_todo.size());
+        }
+        const size_t num_threads = std::max<size_t>(1,
+            std::min<size_t>(solver->conf.ternary_res_threads, par_tern_todo.size()));
+
+        auto find_some = [&](const size_t thread_num) {
+            vector<uint16_t>& seen_tern = elim_scratch[thread_num].seen;
+            for(size_t j = thread_num; j < par_tern_todo.size(); j += num_threads) {
+                ParTernary& f = par_tern_found[j];
+                f.found.clear();
+                f.cost = 0;
+
+                const Clause* cl = solver->cl_alloc.ptr(par_tern_todo[j]);
+                if (!cl->freed()
+                    && !cl->getRemoved()
+                    && !cl->is_ternary_resolved
+                    && cl->size() == 3
+                    && !cl->red()
+                ) {
+                    find_ternary(cl, par_tern_todo[j], seen_tern, f.found, f.cost);
+                }
+            }
+        };
+
+        vector<std::thread> threads;
+        for(size_t t = 1; t < num_threads; t++) {
+            threads.push_back(std::thread(find_some, t));
+        }
+        find_some(0);
+        for(std::thread& t: threads) {
+            t.join();
+        }
+
+        //Add in walk order
+        for(size_t j = 0; j < par_tern_todo.size(); j++) {
+            Clause * cl = solver->cl_alloc.ptr(par_tern_todo[j]);
+            *limit_to_decrease -= 10;
+            if (!cl->freed()
+                && !cl->getRemoved()
+                && !cl->is_ternary_resolved
+                && cl->size() == 3
+                && !cl->red()
+                && *limit_to_decrease > 0
+                && ternary_res_cls_limit > 0
+            ) {
+                cl->is_ternary_resolved = true;
+                *limit_to_decrease += par_tern_found[j].cost;
+                if (!add_ternary_resolvents(par_tern_found[j].found))
+                    return;
+            }
+        }
+
+        if (solver->must_interrupt_asap())
+            break;
+    }
+}
+
 bool OccSimplifier::backward_sub_str()
 {
     limit_to_decrease = &subsumption_time_limit;
@@ -2209,12 +2355,13 @@ void OccSimplifier::find_gate(
     Lit elim_lit
     , watch_subarray_const a
     , watch_subarray_const b
+    , ElimScratch& sc
 ) {
-    assert(toClear.empty());
+    assert(sc.toClear.empty());
     for(const Watched w: a) {
         if (w.isBin() && !w.red()) {
-            seen[(~w.lit2()).toInt()] = 1;
-            toClear.push_back(~w.lit2());
+            sc.seen[(~w.lit2()).toInt()] = 1;
+            sc.toClear.push_back(~w.lit2());
         }
     }
 
@@ -2235,7 +2382,7 @@ void OccSimplifier::find_gate(
                 bool OK = true;
                 for(const Lit lit: *cl) {
                     if (lit != ~elim_lit) {
-                        if (!seen[lit.toInt()]) {
+                        if (!sc.seen[lit.toInt()]) {
                             OK = false;
                             break;
                         }
@@ -2244,36 +2391,37 @@ void OccSimplifier::find_gate(
 
                 //Found all lits inside
                 if (OK) {
-                    cl->stats.marked_clause = true;
-                    gate_varelim_clause = cl;
+                    solver->cl_alloc.stats(cl).marked_clause = true;
+                    sc.gate_varelim_clause = cl;
                     break;
                 }
             }
         }
     }
 
-    for(Lit l: toClear) {
-        seen[l.toInt()] = 0;
+    for(Lit l: sc.toClear) {
+        sc.seen[l.toInt()] = 0;
     }
-    toClear.clear();
+    sc.toClear.clear();
 }
 
 void OccSimplifier::mark_gate_in_poss_negs(
     Lit elim_lit
     , watch_subarray_const poss
     , watch_subarray_const negs
+    , ElimScratch& sc
 ) {
     //Either of the two is OK. Let's just find ONE, not the biggest one.
     //We could find the biggest one, but it's expensive.
     bool found_pos = false;
-    gate_varelim_clause = NULL;
-    find_gate(elim_lit, poss, negs);
-    if (gate_varelim_clause == NULL) {
-        find_gate(~elim_lit, negs, poss);
+    sc.gate_varelim_clause = NULL;
+    find_gate(elim_lit, poss, negs, sc);
+    if (sc.gate_varelim_clause == NULL) {
+        find_gate(~elim_lit, negs, poss, sc);
         found_pos = true;
     }
 
-    if (gate_varelim_clause != NULL && solver->conf.verbosity >= 10) {
+    if (sc.gate_varelim_clause != NULL && solver->conf.verbosity >= 10) {
         cout
         << "Lit: " << elim_lit
         << " gate_found_elim_pos:" << found_pos
@@ -2281,8 +2429,19 @@ void OccSimplifier::mark_gate_in_poss_negs(
     }
 }
 
-int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
-{
+/**
+@brief Computes the resolvents of eliminating var into sc.resolvents
+
+Apart from sorting the occur lists of var and (un)marking its gate clause, it
+only reads, so it can run on several threads at once for variables that share
+no clause.
+
+@return >0 if the variable should not be eliminated
+*/
+int OccSimplifier::test_elim_and_fill_resolvents(
+    const uint32_t var
+    , ElimScratch& sc
+) {
     assert(solver->ok);
     assert(solver->varData[var].removed == Removed::none);
     assert(solver->value(var) == l_Undef);
@@ -2306,7 +2465,7 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
     const uint32_t neg = n_occurs[Lit(var, true).toInt()];
 
     //Heuristic calculation took too much time
-    if (*limit_to_decrease < 0) {
+    if (*sc.limit < 0) {
         return std::numeric_limits<int>::max();
     }
 
@@ -2316,7 +2475,7 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
     watch_subarray negs = solver->watches[~lit];
     std::sort(poss.begin(), poss.end(), watch_sort_smallest_first());
     std::sort(negs.begin(), negs.end(), watch_sort_smallest_first());
-    resolvents.clear();
+    sc.resolvents.clear();
 
     //Pure literal, no resolvents
     //we look at "pos" and "neg" (and not poss&negs) because we don't care about redundant clauses
@@ -2331,9 +2490,9 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
         return std::numeric_limits<int>::max();
     }
 
-    gate_varelim_clause = NULL;
+    sc.gate_varelim_clause = NULL;
     if (solver->conf.skip_some_bve_resolvents) {
-        mark_gate_in_poss_negs(lit, poss, negs);
+        mark_gate_in_poss_negs(lit, poss, negs, sc);
     }
 
     // Count clauses/literals after elimination
@@ -2345,7 +2504,7 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
         ; it != end
         ; ++it, at_poss++
     ) {
-        *limit_to_decrease -= 3;
+        *sc.limit -= 3;
         if (solver->redundant_or_removed(*it))
             continue;
 
@@ -2354,22 +2513,22 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
             ; it2 != end2
             ; it2++, at_negs++
         ) {
-            *limit_to_decrease -= 3;
+            *sc.limit -= 3;
             if (solver->redundant_or_removed(*it2))
                 continue;
 
             //Resolve the two clauses
-            bool tautological = resolve_clauses(*it, *it2, lit);
+            bool tautological = resolve_clauses(*it, *it2, lit, sc);
             if (tautological) {
                 continue;
             }
 
-            if (solver->satisfied_cl(dummy)) {
+            if (solver->satisfied_cl(sc.dummy)) {
                 continue;
             }
 
             #ifdef VERBOSE_DEBUG_VARELIM
-            cout << "Adding new clause due to varelim: " << dummy << endl;
+            cout << "Adding new clause due to varelim: " << sc.dummy << endl;
             #endif
 
             after_clauses++;
@@ -2377,13 +2536,13 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
             if (after_clauses > (before_clauses + grow)
                 //Too long resolvent
                 || (solver->conf.velim_resolvent_too_large != -1
-                    && ((int)dummy.size() > solver->conf.velim_resolvent_too_large))
+                    && ((int)sc.dummy.size() > solver->conf.velim_resolvent_too_large))
                 //Over-time
-                || *limit_to_decrease < -10LL*1000LL
+                || *sc.limit < -10LL*1000LL
 
             ) {
-                if (gate_varelim_clause) {
-                    gate_varelim_clause->stats.marked_clause = false;
+                if (sc.gate_varelim_clause) {
+                    solver->cl_alloc.stats(sc.gate_varelim_clause).marked_clause = false;
                 }
                 return std::numeric_limits<int>::max();
             }
@@ -2394,28 +2553,28 @@ int OccSimplifier::test_elim_and_fill_resolvents(const uint32_t var)
             #if defined(USE_GAUSS) || defined(STATS_NEEDED)
             if (it->isBin() && it2->isClause()) {
                 Clause* c = solver->cl_alloc.ptr(it2->get_offset());
-                stats = c->stats;
+                stats = solver->cl_alloc.stats(c);
                 is_xor |= c->used_in_xor();
             } else if (it2->isBin() && it->isClause()) {
                 Clause* c = solver->cl_alloc.ptr(it->get_offset());
-                stats = c->stats;
+                stats = solver->cl_alloc.stats(c);
                 is_xor |= c->used_in_xor();
             } else if (it2->isClause() && it->isClause()) {
                 Clause* c1 = solver->cl_alloc.ptr(it->get_offset());
                 Clause* c2 = solver->cl_alloc.ptr(it2->get_offset());
-                stats = ClauseStats::combineStats(c1->stats, c2->stats);
+                stats = ClauseStats::combineStats(solver->cl_alloc.stats(c1), solver->cl_alloc.stats(c2));
                 is_xor |= c1->used_in_xor();
                 is_xor |= c2->used_in_xor();
             }
             #endif
             //must clear marking that has been set due to gate
             stats.marked_clause = 0;
-            resolvents.add_resolvent(dummy, stats, is_xor);
+            sc.resolvents.add_resolvent(sc.dummy, stats, is_xor);
         }
     }
 
-    if (gate_varelim_clause) {
-        gate_varelim_clause->stats.marked_clause = false;
+    if (sc.gate_varelim_clause) {
+        solver->cl_alloc.stats(sc.gate_varelim_clause).marked_clause = false;
     }
 
     return -1;
@@ -2607,14 +2766,25 @@ bool OccSimplifier::maybe_eliminate(const uint32_t var)
     assert(solver->ok);
     print_var_elim_complexity_stats(var);
     bvestats.testedToElimVars++;
-    const Lit lit = Lit(var, false);
 
     //Heuristic says no, or we ran out of time
-    if (test_elim_and_fill_resolvents(var) > 0
+    ElimScratch& sc = elim_scratch[0];
+    sc.limit = limit_to_decrease;
+    if (test_elim_and_fill_resolvents(var, sc) > 0
         || *limit_to_decrease < 0
     ) {
         return false;  //didn't eliminate :(
     }
+    elim_var_with_resolvents(var, sc.resolvents);
+
+    return true; //eliminated!
+}
+
+void OccSimplifier::elim_var_with_resolvents(
+    const uint32_t var
+    , Resolvents& resolvents
+) {
+    const Lit lit = Lit(var, false);
     bvestats.triedToElimVars++;
 
     print_var_eliminate_stat(lit);
@@ -2637,29 +2807,260 @@ bool OccSimplifier::maybe_eliminate(const uint32_t var)
 
 end:
     set_var_as_eliminated(var, lit);
+}
 
-    return true; //eliminated!
+void OccSimplifier::size_elim_scratch(const size_t num)
+{
+    if (elim_scratch.size() < num) {
+        elim_scratch.resize(num);
+    }
+    for(ElimScratch& sc: elim_scratch) {
+        if (sc.seen.size() < solver->nVars()*2) {
+            sc.seen.resize(solver->nVars()*2, 0);
+        }
+    }
+}
+
+//Variables taken out of velim_order per parallel BVE batch at most
+static const size_t par_elim_max_popped = 4*1024;
+
+//Variables tested in parallel per batch at most
+static const size_t par_elim_max_picked = 1024;
+
+/**
+@brief Same as the serial loop in eliminate_vars, in batches
+
+Each batch is a set of variables, taken from velim_order, such that no two of
+them appear in the same clause -- i.e. an independent set of the occurrence
+graph. The resolvents of the batch are computed by par_test_elim(), then the
+variables are eliminated on the calling thread in the order they were taken.
+Eliminating one of them can neither remove nor change the clauses of the
+others, so the computed resolvents are still correct when they are added.
+
+The test cost is charged to the time limit in batch order and every test
+starts from the limit at the start of the batch, so the result is the same
+regardless of the number of threads.
+*/
+bool OccSimplifier::eliminate_vars_par(
+    size_t& wenThrough
+    , size_t& vars_elimed
+    , int64_t& last_elimed
+) {
+    size_elim_scratch(solver->conf.varelim_threads);
+    par_elim_taken.resize(solver->nVars(), 0);
+
+    while(!velim_order.empty()
+        && *limit_to_decrease > 0
+        && varelim_num_limit > 0
+        && varelim_linkin_limit_bytes > 0
+        && !solver->must_interrupt_asap()
+    ) {
+        assert(limit_to_decrease == &norm_varelim_time_limit);
+        const size_t num = pick_indep_vars(wenThrough);
+        par_test_elim(num);
+
+        //Eliminate in the order they were taken
+        elim_calc_need_update.clear();
+        size_t i = 0;
+        for(; i < num
+            && *limit_to_decrease > 0
+            && varelim_num_limit > 0
+            && varelim_linkin_limit_bytes > 0
+            ; i++
+        ) {
+            ParElim& e = par_elim[i];
+            *limit_to_decrease += e.cost;
+
+            //May have been set by a unit resolvent of an earlier variable
+            if (!can_eliminate_var(e.var))
+                continue;
+
+            print_var_elim_complexity_stats(e.var);
+            bvestats.testedToElimVars++;
+
+            //Heuristic says no, or we ran out of time
+            if (e.ret > 0 || *limit_to_decrease < 0)
+                continue;
+
+            elim_var_with_resolvents(e.var, e.resolvents);
+            vars_elimed++;
+            varelim_num_limit--;
+            last_elimed++;
+            if (!solver->ok)
+                return false;
+        }
+
+        //Out of limits, leave the rest for later
+        for(; i < num; i++) {
+            velim_order.insert(par_elim[i].var);
+        }
+
+        //SUB and STR for long and short
+        limit_to_decrease = &varelim_sub_str_limit;
+        if (!deal_with_added_long_and_bin(false)) {
+            limit_to_decrease = &norm_varelim_time_limit;
+            return false;
+        }
+        limit_to_decrease = &norm_varelim_time_limit;
+
+        solver->ok = solver->propagate_occur();
+        if (!solver->okay()) {
+            return false;
+        }
+
+        update_varelim_complexity_heap();
+    }
+
+    return true;
+}
+
+/**
+@brief Takes the next batch of variables that share no clause from velim_order
+
+Variables that share a clause with an earlier variable of the batch are put
+back into velim_order. The first variable that can be eliminated is always
+taken, so every batch makes progress.
+
+@return The number of variables taken, stored in par_elim
+*/
+size_t OccSimplifier::pick_indep_vars(size_t& wenThrough)
+{
+    size_t num = 0;
+    par_elim_skipped.clear();
+    for(size_t popped = 0
+        ; popped < par_elim_max_popped
+        && num < par_elim_max_picked
+        && (int64_t)num < varelim_num_limit
+        && !velim_order.empty()
+        ; popped++
+    ) {
+        const uint32_t var = velim_order.removeMin();
+        if (can_eliminate_var(var) && !take_indep_var(var)) {
+            par_elim_skipped.push_back(var);
+            continue;
+        }
+
+        //Stats
+        *limit_to_decrease -= 20;
+        wenThrough++;
+
+        if (!can_eliminate_var(var))
+            continue;
+
+        if (par_elim.size() <= num) {
+            par_elim.resize(num+1);
+        }
+        par_elim[num++].var = var;
+    }
+
+    for(const uint32_t var: par_elim_skipped) {
+        velim_order.insert(var);
+    }
+    for(const uint32_t var: par_elim_taken_vars) {
+        par_elim_taken[var] = 0;
+    }
+    par_elim_taken_vars.clear();
+
+    return num;
+}
+
+/**
+@brief Takes var into the batch unless it shares a clause with a taken variable
+
+Marks var and every variable it shares a clause with, redundant or not.
+*/
+bool OccSimplifier::take_indep_var(const uint32_t var)
+{
+    if (par_elim_taken[var]) {
+        return false;
+    }
+
+    auto mark = [&](const uint32_t v) {
+        if (!par_elim_taken[v]) {
+            par_elim_taken[v] = 1;
+            par_elim_taken_vars.push_back(v);
+        }
+    };
+
+    mark(var);
+    for(const Lit lit: {Lit(var, false), Lit(var, true)}) {
+        watch_subarray_const ws = solver->watches[lit];
+        *limit_to_decrease -= (long)ws.size();
+        for(const Watched& w: ws) {
+            if (w.isBin()) {
+                mark(w.lit2().var());
+            } else if (w.isClause()) {
+                const Clause& cl = *solver->cl_alloc.ptr(w.get_offset());
+                if (cl.getRemoved())
+                    continue;
+
+                *limit_to_decrease -= (long)cl.size()/2;
+                for(const Lit l: cl) {
+                    mark(l.var());
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+@brief Computes the resolvents of the first num variables of par_elim on conf.varelim_threads threads
+
+The variables share no clause, so the threads work on disjoint occur lists
+and clauses and need no locking. Every variable is tested against the limit
+at the start of the batch and its cost is returned in ParElim::cost.
+*/
+void OccSimplifier::par_test_elim(const size_t num)
+{
+    const int64_t start_limit = *limit_to_decrease;
+    const size_t num_threads = std::max<size_t>(1,
+        std::min<size_t>(solver->conf.varelim_threads, num));
+
+    auto test_some = [&](const size_t thread_num) {
+        ElimScratch& sc = elim_scratch[thread_num];
+        for(size_t i = thread_num; i < num; i += num_threads) {
+            ParElim& e = par_elim[i];
+            int64_t limit = start_limit;
+            sc.limit = &limit;
+            sc.resolvents.clear();
+            e.ret = test_elim_and_fill_resolvents(e.var, sc);
+            e.cost = limit - start_limit;
+            std::swap(e.resolvents, sc.resolvents);
+        }
+    };
+
+    vector<std::thread> threads;
+    for(size_t i = 1; i < num_threads; i++) {
+        threads.push_back(std::thread(test_some, i));
+    }
+    test_some(0);
+    for(std::thread& t: threads) {
+        t.join();
+    }
 }
 
 void OccSimplifier::add_pos_lits_to_dummy_and_seen(
     const Watched ps
     , const Lit posLit
+    , ElimScratch& sc
 ) {
     if (ps.isBin()) {
-        *limit_to_decrease -= 1;
+        *sc.limit -= 1;
         assert(ps.lit2() != posLit);
 
-        seen[ps.lit2().toInt()] = 1;
-        dummy.push_back(ps.lit2());
+        sc.seen[ps.lit2().toInt()] = 1;
+        sc.dummy.push_back(ps.lit2());
     }
 
     if (ps.isClause()) {
         Clause& cl = *solver->cl_alloc.ptr(ps.get_offset());
-        *limit_to_decrease -= (long)cl.size()/2;
+        *sc.limit -= (long)cl.size()/2;
         for (const Lit lit : cl){
             if (lit != posLit) {
-                seen[lit.toInt()] = 1;
-                dummy.push_back(lit);
+                sc.seen[lit.toInt()] = 1;
+                sc.dummy.push_back(lit);
             }
         }
     }
@@ -2668,34 +3069,35 @@ void OccSimplifier::add_pos_lits_to_dummy_and_seen(
 bool OccSimplifier::add_neg_lits_to_dummy_and_seen(
     const Watched qs
     , const Lit posLit
+    , ElimScratch& sc
 ) {
     if (qs.isBin()) {
-        *limit_to_decrease -= 1;
+        *sc.limit -= 1;
         assert(qs.lit2() != ~posLit);
 
-        if (seen[(~qs.lit2()).toInt()]) {
+        if (sc.seen[(~qs.lit2()).toInt()]) {
             return true;
         }
-        if (!seen[qs.lit2().toInt()]) {
-            dummy.push_back(qs.lit2());
-            seen[qs.lit2().toInt()] = 1;
+        if (!sc.seen[qs.lit2().toInt()]) {
+            sc.dummy.push_back(qs.lit2());
+            sc.seen[qs.lit2().toInt()] = 1;
         }
     }
 
     if (qs.isClause()) {
         Clause& cl = *solver->cl_alloc.ptr(qs.get_offset());
-        *limit_to_decrease -= (long)cl.size()/2;
+        *sc.limit -= (long)cl.size()/2;
         for (const Lit lit: cl) {
             if (lit == ~posLit)
                 continue;
 
-            if (seen[(~lit).toInt()]) {
+            if (sc.seen[(~lit).toInt()]) {
                 return true;
             }
 
-            if (!seen[lit.toInt()]) {
-                dummy.push_back(lit);
-                seen[lit.toInt()] = 1;
+            if (!sc.seen[lit.toInt()]) {
+                sc.dummy.push_back(lit);
+                sc.seen[lit.toInt()] = 1;
             }
         }
     }
@@ -2707,6 +3109,7 @@ bool OccSimplifier::resolve_clauses(
     const Watched ps
     , const Watched qs
     , const Lit posLit
+    , ElimScratch& sc
 ) {
     //If clause has already been freed, skip
     Clause *cl1 = NULL;
@@ -2724,10 +3127,10 @@ bool OccSimplifier::resolve_clauses(
             return true;
         }
     }
-    if (gate_varelim_clause
+    if (sc.gate_varelim_clause
         && cl1 && cl2
-        && !cl1->stats.marked_clause
-        && !cl2->stats.marked_clause
+        && !solver->cl_alloc.stats(cl1).marked_clause
+        && !solver->cl_alloc.stats(cl2).marked_clause
     ) {
         //for G (U) R, we only neede to resolve to
         // (Gx * R!x) (U) (G!x * Rx)
@@ -2739,13 +3142,13 @@ bool OccSimplifier::resolve_clauses(
         return true;
     }
 
-    dummy.clear();
-    add_pos_lits_to_dummy_and_seen(ps, posLit);
-    bool tautological = add_neg_lits_to_dummy_and_seen(qs, posLit);
+    sc.dummy.clear();
+    add_pos_lits_to_dummy_and_seen(ps, posLit, sc);
+    bool tautological = add_neg_lits_to_dummy_and_seen(qs, posLit, sc);
 
-    *limit_to_decrease -= (long)dummy.size()/2 + 1;
-    for (const Lit lit: dummy) {
-        seen[lit.toInt()] = 0;
+    *sc.limit -= (long)sc.dummy.size()/2 + 1;
+    for (const Lit lit: sc.dummy) {
+        sc.seen[lit.toInt()] = 0;
     }
 
     return tautological;
@@ -3069,7 +3472,10 @@ void OccSimplifier::check_elimed_vars_are_unassignedAndStats() const
 size_t OccSimplifier::mem_used() const
 {
     size_t b = 0;
-    b += dummy.capacity()*sizeof(char);
+    for(const ElimScratch& sc: elim_scratch) {
+        b += sc.seen.capacity()*sizeof(uint16_t);
+        b += sc.dummy.capacity()*sizeof(Lit);
+    }
     b += added_long_cl.capacity()*sizeof(ClOffset);
     b += sub_str->mem_used();
     b += blockedClauses.capacity()*sizeof(BlockedClauses);
@@ -3104,19 +3510,19 @@ void OccSimplifier::linkInClause(Clause& cl)
 {
     assert(cl.size() > 2);
     ClOffset offset = solver->cl_alloc.get_offset(&cl);
-    cl.recalc_abst_if_needed();
+    solver->cl_alloc.recalc_abst_if_needed(cl);
     if (!cl.red()) {
         for(const Lit l: cl){
             n_occurs[l.toInt()]++;
             added_cl_to_var.touch(l.var());
         }
     }
-    assert(cl.stats.marked_clause == 0 && "marks must always be zero at linkin");
+    assert(solver->cl_alloc.stats(cl).marked_clause == 0 && "marks must always be zero at linkin");
 
     std::sort(cl.begin(), cl.end());
     for (const Lit lit: cl) {
         watch_subarray ws = solver->watches[lit];
-        ws.push(Watched(offset, cl.abst));
+        ws.push(Watched(offset, solver->cl_alloc.abst(cl)));
     }
     cl.setOccurLinked(true);
 }
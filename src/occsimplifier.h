@@ -220,6 +220,7 @@ public:
     size_t mem_used_bva() const;
     void print_gatefinder_stats() const;
     uint32_t dump_blocked_clauses(std::ostream* outfile) const;
+    void dump_blocked_clauses(vector<Lit>& buf) const;
 
     //UnElimination
     void print_blocked_clauses_reverse() const;
@@ -295,9 +296,33 @@ private:
 
     //Ternary resolution
     bool perform_ternary(Clause* cl, ClOffset offs);
-    void check_ternary_cl(Clause* cl, ClOffset offs, watch_subarray ws);
+    void find_ternary(
+        const Clause* cl
+        , ClOffset offs
+        , vector<uint16_t>& seen_tern
+        , vector<vector<Lit>>& found
+        , int64_t& limit
+    );
+    void check_ternary_cl(
+        const Clause* cl
+        , ClOffset offs
+        , watch_subarray_const ws
+        , const vector<uint16_t>& seen_tern
+        , vector<vector<Lit>>& found
+        , int64_t& limit
+    );
+    bool add_ternary_resolvents(vector<vector<Lit>>& found);
     vector<vector<Lit>> cl_to_add_ternary;
 
+    //Multi-threaded find, single-threaded add (see conf.ternary_res_threads)
+    struct ParTernary {
+        vector<vector<Lit>> found;
+        int64_t cost = 0;
+    };
+    void ternary_res_par(size_t at);
+    vector<ClOffset> par_tern_todo;
+    vector<ParTernary> par_tern_found;
+
     //debug
     bool subsetReverse(const Clause& B) const;
 
@@ -308,9 +333,6 @@ private:
     vector<Lit>& toClear;
     vector<bool> sampling_vars_occsimp;
 
-    //Temporaries
-    vector<Lit>     dummy;       ///<Used by merge()
-
     //Time Limits
     uint64_t clause_lits_added;
     int64_t  strengthening_time_limit;              ///<Max. number self-subsuming resolution tries to do this run
@@ -428,9 +450,6 @@ private:
     bool        prop_and_clean_long_and_impl_clauses();
     vector<Lit> tmp_bin_cl;
     void        create_dummy_blocked_clause(const Lit lit);
-    int         test_elim_and_fill_resolvents(uint32_t var);
-    void        mark_gate_in_poss_negs(Lit elim_lit, watch_subarray_const poss, watch_subarray_const negs);
-    void        find_gate(Lit elim_lit, watch_subarray_const a, watch_subarray_const b);
     void        print_var_eliminate_stat(Lit lit) const;
     bool        add_varelim_resolvent(vector<Lit>& finalLits, const ClauseStats& stats, bool is_xor);
     void        update_varelim_complexity_heap();
@@ -488,8 +507,41 @@ private:
             return at;
         }
     };
-    Resolvents resolvents;
-    Clause* gate_varelim_clause;
+
+    ///Scratch of testing the elimination of a variable. Index 0 is used by
+    ///the calling thread, the rest by the extra threads of parallel BVE.
+    ///Ternary resolution uses the seen of the same scratch.
+    struct ElimScratch {
+        vector<uint16_t> seen;
+        vector<Lit> toClear;
+        vector<Lit> dummy; ///<Used by resolve_clauses()
+        Resolvents resolvents;
+        Clause* gate_varelim_clause = NULL;
+        int64_t* limit = NULL;
+    };
+    vector<ElimScratch> elim_scratch;
+    void        size_elim_scratch(size_t num);
+    int         test_elim_and_fill_resolvents(uint32_t var, ElimScratch& sc);
+    void        mark_gate_in_poss_negs(Lit elim_lit, watch_subarray_const poss, watch_subarray_const negs, ElimScratch& sc);
+    void        find_gate(Lit elim_lit, watch_subarray_const a, watch_subarray_const b, ElimScratch& sc);
+    void        elim_var_with_resolvents(const uint32_t var, Resolvents& resolvents);
+
+    //Parallel BVE over variables that share no clause (see conf.varelim_threads)
+    struct ParElim {
+        uint32_t var;
+        int ret = 0;
+        int64_t cost = 0;
+        Resolvents resolvents;
+    };
+    bool        eliminate_vars_par(size_t& wenThrough, size_t& vars_elimed, int64_t& last_elimed);
+    size_t      pick_indep_vars(size_t& wenThrough);
+    bool        take_indep_var(const uint32_t var);
+    void        par_test_elim(size_t num);
+    vector<ParElim> par_elim;
+    vector<uint8_t> par_elim_taken;
+    vector<uint32_t> par_elim_taken_vars;
+    vector<uint32_t> par_elim_skipped;
+
     uint32_t calc_data_for_heuristic(const Lit lit);
     uint64_t time_spent_on_calc_otf_update;
     uint64_t num_otf_update_until_now;
@@ -512,14 +564,17 @@ private:
         const Watched ps
         , const Watched qs
         , const Lit noPosLit
+        , ElimScratch& sc
     );
     void add_pos_lits_to_dummy_and_seen(
         const Watched ps
         , const Lit posLit
+        , ElimScratch& sc
     );
     bool add_neg_lits_to_dummy_and_seen(
         const Watched qs
         , const Lit posLit
+        , ElimScratch& sc
     );
     bool eliminate_vars();
     void eliminate_empty_resolvent_vars();
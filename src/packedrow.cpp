@@ -29,8 +29,294 @@ THE SOFTWARE.
 
 #include "packedrow.h"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PACKEDROW_X86_DISPATCH
+#include <immintrin.h>
+#if (defined(__clang__) && __clang_major__ >= 7) \
+    || (!defined(__clang__) && __GNUC__ >= 8)
+#define PACKEDROW_AVX512
+#endif
+#endif
+
 using namespace CMSat;
 
+//////////////////
+// Plain C++ kernels
+//////////////////
+
+static void xor_in_scalar(
+    uint64_t* __restrict a, const uint64_t* __restrict b, const uint32_t num)
+{
+    for (uint32_t i = 0; i != num; i++) {
+        a[i] ^= b[i];
+    }
+}
+
+static uint32_t popcnt_scalar(const uint64_t* a, const uint32_t num)
+{
+    uint32_t ret = 0;
+    for (uint32_t i = 0; i != num; i++) {
+        ret += my_popcnt64(a[i]);
+    }
+    return ret;
+}
+
+static uint32_t first_nonzero_scalar(
+    const uint64_t* a, uint32_t from, const uint32_t num)
+{
+    for (; from < num; from++) {
+        if (a[from]) return from;
+    }
+    return num;
+}
+
+static const PackedRowKernels kernels_scalar = {
+    "scalar", xor_in_scalar, popcnt_scalar, first_nonzero_scalar
+};
+
+#ifdef PACKEDROW_X86_DISPATCH
+
+//////////////////
+// SSE2 kernels
+//////////////////
+
+__attribute__((target("sse2")))
+static void xor_in_sse2(
+    uint64_t* __restrict a, const uint64_t* __restrict b, const uint32_t num)
+{
+    uint32_t i = 0;
+    for (; i + 2 <= num; i += 2) {
+        const __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+        const __m128i y = _mm_loadu_si128((const __m128i*)(b + i));
+        _mm_storeu_si128((__m128i*)(a + i), _mm_xor_si128(x, y));
+    }
+    for (; i < num; i++) {
+        a[i] ^= b[i];
+    }
+}
+
+__attribute__((target("popcnt")))
+static uint32_t popcnt_hw(const uint64_t* a, const uint32_t num)
+{
+    uint32_t ret = 0;
+    for (uint32_t i = 0; i != num; i++) {
+        ret += __builtin_popcountll(a[i]);
+    }
+    return ret;
+}
+
+__attribute__((target("sse2")))
+static uint32_t first_nonzero_sse2(
+    const uint64_t* a, uint32_t from, const uint32_t num)
+{
+    const __m128i zero = _mm_setzero_si128();
+    for (; from + 2 <= num; from += 2) {
+        const __m128i x = _mm_loadu_si128((const __m128i*)(a + from));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(x, zero)) != 0xffff) {
+            return a[from] ? from : from + 1;
+        }
+    }
+    return first_nonzero_scalar(a, from, num);
+}
+
+//////////////////
+// AVX2 kernels
+//////////////////
+
+__attribute__((target("avx2")))
+static void xor_in_avx2(
+    uint64_t* __restrict a, const uint64_t* __restrict b, const uint32_t num)
+{
+    uint32_t i = 0;
+    for (; i + 4 <= num; i += 4) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        _mm256_storeu_si256((__m256i*)(a + i), _mm256_xor_si256(x, y));
+    }
+    for (; i < num; i++) {
+        a[i] ^= b[i];
+    }
+}
+
+//Nibble-lookup popcount, summed per 64b lane with SAD
+__attribute__((target("avx2,popcnt")))
+static uint32_t popcnt_avx2(const uint64_t* a, const uint32_t num)
+{
+    const __m256i lookup = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i acc = _mm256_setzero_si256();
+
+    uint32_t i = 0;
+    for (; i + 4 <= num; i += 4) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        const __m256i lo = _mm256_and_si256(x, low_mask);
+        const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), low_mask);
+        const __m256i cnt = _mm256_add_epi8(
+            _mm256_shuffle_epi8(lookup, lo),
+            _mm256_shuffle_epi8(lookup, hi));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, _mm256_setzero_si256()));
+    }
+
+    uint64_t ret = (uint64_t)_mm256_extract_epi64(acc, 0)
+        + (uint64_t)_mm256_extract_epi64(acc, 1)
+        + (uint64_t)_mm256_extract_epi64(acc, 2)
+        + (uint64_t)_mm256_extract_epi64(acc, 3);
+    for (; i < num; i++) {
+        ret += __builtin_popcountll(a[i]);
+    }
+    return ret;
+}
+
+__attribute__((target("avx2")))
+static uint32_t first_nonzero_avx2(
+    const uint64_t* a, uint32_t from, const uint32_t num)
+{
+    for (; from + 4 <= num; from += 4) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(a + from));
+        if (!_mm256_testz_si256(x, x)) {
+            break;
+        }
+    }
+    return first_nonzero_scalar(a, from, num);
+}
+
+#ifdef PACKEDROW_AVX512
+
+//////////////////
+// AVX-512 kernels
+//////////////////
+
+__attribute__((target("avx512f")))
+static void xor_in_avx512(
+    uint64_t* __restrict a, const uint64_t* __restrict b, const uint32_t num)
+{
+    uint32_t i = 0;
+    for (; i + 8 <= num; i += 8) {
+        const __m512i x = _mm512_loadu_si512((const void*)(a + i));
+        const __m512i y = _mm512_loadu_si512((const void*)(b + i));
+        _mm512_storeu_si512((void*)(a + i), _mm512_xor_si512(x, y));
+    }
+    if (i < num) {
+        const __mmask8 m = (__mmask8)((1U << (num - i)) - 1);
+        const __m512i x = _mm512_maskz_loadu_epi64(m, (const void*)(a + i));
+        const __m512i y = _mm512_maskz_loadu_epi64(m, (const void*)(b + i));
+        _mm512_mask_storeu_epi64((void*)(a + i), m, _mm512_xor_si512(x, y));
+    }
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq")))
+static uint32_t popcnt_avx512(const uint64_t* a, const uint32_t num)
+{
+    __m512i acc = _mm512_setzero_si512();
+    uint32_t i = 0;
+    for (; i + 8 <= num; i += 8) {
+        const __m512i x = _mm512_loadu_si512((const void*)(a + i));
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(x));
+    }
+    if (i < num) {
+        const __mmask8 m = (__mmask8)((1U << (num - i)) - 1);
+        const __m512i x = _mm512_maskz_loadu_epi64(m, (const void*)(a + i));
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(x));
+    }
+    uint64_t lanes[8];
+    _mm512_storeu_si512((void*)lanes, acc);
+    uint64_t ret = 0;
+    for (uint32_t l = 0; l != 8; l++) {
+        ret += lanes[l];
+    }
+    return ret;
+}
+
+__attribute__((target("avx512f")))
+static uint32_t first_nonzero_avx512(
+    const uint64_t* a, uint32_t from, const uint32_t num)
+{
+    for (; from + 8 <= num; from += 8) {
+        const __m512i x = _mm512_loadu_si512((const void*)(a + from));
+        const __mmask8 m = _mm512_test_epi64_mask(x, x);
+        if (m) {
+            return from + __builtin_ctz(m);
+        }
+    }
+    return first_nonzero_scalar(a, from, num);
+}
+
+static const PackedRowKernels kernels_avx512 = {
+    "avx512", xor_in_avx512, popcnt_avx512, first_nonzero_avx512
+};
+#endif //PACKEDROW_AVX512
+
+static const PackedRowKernels kernels_avx2 = {
+    "avx2", xor_in_avx2, popcnt_avx2, first_nonzero_avx2
+};
+
+static const PackedRowKernels kernels_sse2 = {
+    "sse2", xor_in_sse2, popcnt_scalar, first_nonzero_sse2
+};
+
+static const PackedRowKernels kernels_sse2_popcnt = {
+    "sse2+popcnt", xor_in_sse2, popcnt_hw, first_nonzero_sse2
+};
+#endif //PACKEDROW_X86_DISPATCH
+
+static const PackedRowKernels* select_packedrow_kernels()
+{
+    #ifdef PACKEDROW_X86_DISPATCH
+    __builtin_cpu_init();
+    #ifdef PACKEDROW_AVX512
+    if (__builtin_cpu_supports("avx512f")
+        && __builtin_cpu_supports("avx512vpopcntdq")
+    ) {
+        return &kernels_avx512;
+    }
+    #endif
+    if (__builtin_cpu_supports("avx2")
+        && __builtin_cpu_supports("popcnt")
+    ) {
+        return &kernels_avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        if (__builtin_cpu_supports("popcnt")) {
+            return &kernels_sse2_popcnt;
+        }
+        return &kernels_sse2;
+    }
+    #endif
+    return &kernels_scalar;
+}
+
+const PackedRowKernels* CMSat::packedrow_kernels = select_packedrow_kernels();
+
+vector<const PackedRowKernels*> CMSat::packedrow_available_kernels()
+{
+    vector<const PackedRowKernels*> ret;
+    ret.push_back(&kernels_scalar);
+    #ifdef PACKEDROW_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) {
+        ret.push_back(&kernels_sse2);
+        if (__builtin_cpu_supports("popcnt")) {
+            ret.push_back(&kernels_sse2_popcnt);
+        }
+    }
+    if (__builtin_cpu_supports("avx2")
+        && __builtin_cpu_supports("popcnt")
+    ) {
+        ret.push_back(&kernels_avx2);
+    }
+    #ifdef PACKEDROW_AVX512
+    if (__builtin_cpu_supports("avx512f")
+        && __builtin_cpu_supports("avx512vpopcntdq")
+    ) {
+        ret.push_back(&kernels_avx512);
+    }
+    #endif
+    #endif
+    return ret;
+}
+
 bool PackedRow::fill(
     vec<Lit>& tmp_clause,
     const vec<lbool>& assigns,
@@ -77,38 +363,27 @@ uint32_t PackedRow::find_watchVar(
     vec<bool> &GasVar_state,
     uint32_t& nb_var
 ) {
-    uint32_t  tmp_var = 0;
     uint32_t popcnt = 0;
     nb_var = std::numeric_limits<uint32_t>::max();
-    uint32_t i;
     tmp_clause.clear();
 
+    //Walk only the set bits, skipping zero words with the kernel
+    for (uint32_t i = packedrow_kernels->first_nonzero(mp, 0, size)
+        ; i < size
+        ; i = packedrow_kernels->first_nonzero(mp, i+1, size)
+    ) {
+        uint64_t tmp = mp[i];
+        while (tmp) {
+            const uint32_t col = i*64 + my_ctz64(tmp);
+            tmp &= tmp - 1;
 
-    for(i = 0; i < size*64; i++) {
-        if (this->operator[](i)){
             popcnt++;
-            tmp_var = col_to_var[i];
+            const uint32_t tmp_var = col_to_var[col];
             tmp_clause.push_back(Lit(tmp_var, false));
-            if( !GasVar_state[tmp_var] ){  //nobasic
+            if (GasVar_state[tmp_var]) { //basic
+                std::swap(tmp_clause[0], tmp_clause.back());
+            } else if (nb_var == std::numeric_limits<uint32_t>::max()) { //first non-basic
                 nb_var = tmp_var;
-                break;
-            }else{  // basic
-                Lit tmp(tmp_clause[0]);
-                tmp_clause[0] = tmp_clause.back();
-                tmp_clause.back() = tmp;
-            }
-        }
-    }
-
-    for( i = i + 1 ; i <  size*64; i++) {
-        if (this->operator[](i)){
-            popcnt++;
-            tmp_var = col_to_var[i];
-            tmp_clause.push_back(Lit(tmp_var, false));
-            if( GasVar_state[tmp_var] ){  //basic
-                Lit tmp(tmp_clause[0]);
-                tmp_clause[0] = tmp_clause.back();
-                tmp_clause.back() = tmp;
             }
         }
     }
@@ -131,11 +406,20 @@ gret PackedRow::propGause(
     nb_var = std::numeric_limits<uint32_t>::max();
     tmp_clause.clear();
 
-    for (uint32_t i = start/64; i != size; i++) if (mp[i]) {
-        uint64_t tmp = mp[i];
-        for (uint32_t i2 = 0 ; i2 < 64; i2++) {
-            if(tmp & 1){
-                const uint32_t var = col_to_var[i * 64  + i2];
+    //From the word of "start" to the end, then wrap around
+    const uint32_t start_word = start/64;
+    for (uint32_t round = 0; round != 2; round++) {
+        const uint32_t from = round == 0 ? start_word : 0;
+        const uint32_t to = round == 0 ? size : start_word;
+        for (uint32_t i = packedrow_kernels->first_nonzero(mp, from, to)
+            ; i < to
+            ; i = packedrow_kernels->first_nonzero(mp, i+1, to)
+        ) {
+            uint64_t tmp = mp[i];
+            while (tmp) {
+                const uint32_t var = col_to_var[i*64 + my_ctz64(tmp)];
+                tmp &= tmp - 1;
+
                 const lbool val = assigns[var];
                 if (val == l_Undef && !GasVar_state[var]) {  // find non basic value
                     nb_var = var;
@@ -148,28 +432,6 @@ gret PackedRow::propGause(
                     std::swap(tmp_clause[0], tmp_clause.back());
                 }
             }
-            tmp >>= 1;
-        }
-    }
-
-    for ( uint32_t i =0; i != start/64; i++) if (likely(mp[i])) {
-        uint64_t tmp = mp[i];
-        for (uint32_t i2 = 0 ; i2 < 64; i2++) {
-            if(tmp & 1){
-                const uint32_t var = col_to_var[i * 64  + i2];
-                const lbool val = assigns[var];
-                if (val == l_Undef &&  !GasVar_state[var] ){  // find non basic value
-                    nb_var = var;
-                    return gret::nothing_fnewwatch;   // nothing
-                }
-                const bool val_bool = val == l_True;
-                final ^= val_bool;
-                tmp_clause.push_back(Lit(var, val_bool));
-                if ( GasVar_state[var] ) {
-                    std::swap(tmp_clause[0], tmp_clause.back());
-                }
-            }
-            tmp >>= 1;
         }
     }
 
@@ -184,6 +446,33 @@ gret PackedRow::propGause(
 
 }
 
+void PackedRow::get_reason(
+    vector<Lit>& tmp_clause,
+    const vector<lbool>& assigns,
+    const vector<uint32_t>& col_to_var,
+    const Lit propagated
+) const {
+    tmp_clause.clear();
+    tmp_clause.push_back(propagated);
+    for (uint32_t i = packedrow_kernels->first_nonzero(mp, 0, size)
+        ; i < size
+        ; i = packedrow_kernels->first_nonzero(mp, i+1, size)
+    ) {
+        uint64_t tmp = mp[i];
+        while (tmp) {
+            const uint32_t var = col_to_var[i*64 + my_ctz64(tmp)];
+            tmp &= tmp - 1;
+            if (var == propagated.var()) {
+                continue;
+            }
+
+            // all were assigned before the propagation, and still are
+            assert(assigns[var] != l_Undef);
+            tmp_clause.push_back(Lit(var, assigns[var] == l_True));
+        }
+    }
+}
+
 
 
 
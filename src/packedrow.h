@@ -44,6 +44,22 @@ using std::vector;
 
 class PackedMatrix;
 
+///Word-level row kernels. Selected once, at startup, based on what the
+///CPU supports: AVX-512 (F+VPOPCNTDQ), AVX2, SSE2 or plain C++
+struct PackedRowKernels
+{
+    const char* name;
+    ///a[i] ^= b[i] for i < num
+    void (*xor_in)(uint64_t* __restrict a, const uint64_t* __restrict b, uint32_t num);
+    ///Number of set bits in a[0..num)
+    uint32_t (*popcnt)(const uint64_t* a, uint32_t num);
+    ///Index of first non-zero word in a[from..num), or num if there is none
+    uint32_t (*first_nonzero)(const uint64_t* a, uint32_t from, uint32_t num);
+};
+extern const PackedRowKernels* packedrow_kernels;
+///All kernel sets this CPU can run, the plain C++ one first
+vector<const PackedRowKernels*> packedrow_available_kernels();
+
 class PackedRow
 {
 public:
@@ -70,11 +86,8 @@ public:
         assert(b.size == size);
         #endif
 
-        for (uint32_t i = 0; i != size; i++) {
-            *(mp + i) ^= *(b.mp + i);
-        }
-
-        rhs_internal ^= b.rhs_internal;
+        //rhs is stored right before the row
+        packedrow_kernels->xor_in(mp-1, b.mp-1, size+1);
         return *this;
     }
 
@@ -86,24 +99,19 @@ public:
         assert(b.size == size);
         #endif
 
-        for (uint32_t i = 0; i != size; i++) {
-            *(mp + i) ^= *(b.mp + i);
-        }
-
-        rhs_internal ^= b.rhs_internal;
+        //rhs is stored right before the row
+        packedrow_kernels->xor_in(mp-1, b.mp-1, size+1);
     }
 
 
     uint32_t popcnt() const;
     bool popcnt_is_one() const
     {
-        int ret = 0;
-        for (uint32_t i = 0; i != size; i++) {
-            ret += my_popcnt(mp[i]&0xffffffff);
-            ret += my_popcnt(mp[i]>>32);
-            if (ret > 1) return false;
+        const uint32_t at = packedrow_kernels->first_nonzero(mp, 0, size);
+        if (at == size || (mp[at] & (mp[at]-1))) {
+            return false;
         }
-        return ret == 1;
+        return packedrow_kernels->first_nonzero(mp, at+1, size) == size;
     }
 
     bool popcnt_is_one(uint32_t from) const
@@ -126,10 +134,7 @@ public:
 
     inline bool isZero() const
     {
-        for (uint32_t i = 0; i != size; i++) {
-            if (mp[i]) return false;
-        }
-        return true;
+        return packedrow_kernels->first_nonzero(mp, 0, size) == size;
     }
 
     inline void setZero()
@@ -206,17 +211,30 @@ public:
     // using find nonbasic value after watch list is enter
     gret propGause(vector<Lit>& tmp_clause,const vector<lbool>& assigns, const vector<uint32_t>& col_to_var, vec<bool> &GasVar_state ,uint32_t& nb_var , uint32_t start);
 
+    // the clause of a propagation done by propGause(), "propagated" first
+    void get_reason(vector<Lit>& tmp_clause, const vector<lbool>& assigns, const vector<uint32_t>& col_to_var, const Lit propagated) const;
+
     inline unsigned long int scan(const unsigned long int var) const
     {
         #ifdef DEBUG_ROW
         assert(size > 0);
         #endif
 
-        for(uint32_t i = var; i != size*64; i++) {
-            if (this->operator[](i)) return i;
+        if (var >= size*64) {
+            return std::numeric_limits<unsigned long int>::max();
         }
 
-        return std::numeric_limits<unsigned long int>::max();
+        //Bits below "var" in its word are masked away
+        uint32_t at = var/64;
+        uint64_t tmp = mp[at] & (~(uint64_t)0 << (var%64));
+        if (!tmp) {
+            at = packedrow_kernels->first_nonzero(mp, at+1, size);
+            if (at == size) {
+                return std::numeric_limits<unsigned long int>::max();
+            }
+            tmp = mp[at];
+        }
+        return at*64 + my_ctz64(tmp);
     }
 
 private:
@@ -269,12 +287,7 @@ inline bool PackedRow::operator !=(const PackedRow& b) const
 
 inline uint32_t PackedRow::popcnt() const
 {
-    int ret = 0;
-    for (uint32_t i = 0; i != size; i++) {
-        ret += my_popcnt(mp[i]&0xffffffff);
-        ret += my_popcnt(mp[i]>>32);
-    }
-    return ret;
+    return packedrow_kernels->popcnt(mp, size);
 }
 
 }
@@ -28,10 +28,40 @@ THE SOFTWARE.
 #include <intrin.h>
 #endif
 
+#include <cstdint>
+
 #if defined (_MSC_VER)
 #define my_popcnt(x) __popcnt(x)
 #else
 #define my_popcnt(x) __builtin_popcount(x)
 #endif
 
+#if defined (_MSC_VER) && defined(_M_X64)
+#define my_popcnt64(x) __popcnt64(x)
+#elif defined (_MSC_VER)
+#define my_popcnt64(x) (__popcnt((uint32_t)(x)) + __popcnt((uint32_t)((x) >> 32)))
+#else
+#define my_popcnt64(x) __builtin_popcountll(x)
+#endif
+
+//Index of lowest set bit. Undefined for x == 0
+static inline uint32_t my_ctz64(const uint64_t x)
+{
+    #if defined (_MSC_VER) && defined(_M_X64)
+    unsigned long idx;
+    _BitScanForward64(&idx, x);
+    return idx;
+    #elif defined (_MSC_VER)
+    unsigned long idx;
+    if ((uint32_t)x) {
+        _BitScanForward(&idx, (uint32_t)x);
+        return idx;
+    }
+    _BitScanForward(&idx, (uint32_t)(x >> 32));
+    return idx + 32;
+    #else
+    return __builtin_ctzll(x);
+    #endif
+}
+
 #endif //POPCNT__H
@@ -33,19 +33,20 @@ THE SOFTWARE.
 
 namespace CMSat {
 
-enum PropByType {null_clause_t = 0, clause_t = 1, binary_t = 2};
+enum PropByType {null_clause_t = 0, clause_t = 1, binary_t = 2, xor_t = 3, ternary_t = 4};
 
 class PropBy
 {
     private:
         uint32_t red_step:1;
         uint32_t data1:31;
-        uint32_t type:2;
+        uint32_t type:3;
         //0: clause, NULL
         //1: clause, non-null
         //2: binary
-        //3: tertiary
-        uint32_t data2:30;
+        //3: row of a Gauss-Jordan matrix
+        //4: 3-long clause, both other literals inline
+        uint32_t data2:29;
 
     public:
         PropBy() :
@@ -77,6 +78,26 @@ class PropBy
         {
         }
 
+        //Propagated or conflicted by a Gauss-Jordan matrix. The clause is
+        //only built when asked for, see EGaussian::get_reason()
+        PropBy(const uint32_t matrix_num, const uint32_t reason_num) :
+            red_step(0)
+            , data1(reason_num)
+            , type(xor_t)
+            , data2(matrix_num)
+        {
+        }
+
+        //3-long clause prop, see INLINE_TERNARY. Literals are at most 2^29,
+        //as variables are limited to 2^28
+        PropBy(const Lit lit2, const Lit lit3, const bool red) :
+            red_step(red)
+            , data1(lit2.toInt())
+            , type(ternary_t)
+            , data2(lit3.toInt())
+        {
+        }
+
         //For hyper-bin, etc.
         PropBy(
             const Lit lit
@@ -149,11 +170,19 @@ class PropBy
         Lit lit2() const
         {
             #ifdef DEBUG_PROPAGATEFROM
-            assert(type == binary_t);
+            assert(type == binary_t || type == ternary_t);
             #endif
             return Lit::toLit(data1);
         }
 
+        Lit lit3() const
+        {
+            #ifdef DEBUG_PROPAGATEFROM
+            assert(type == ternary_t);
+            #endif
+            return Lit::toLit(data2);
+        }
+
         ClOffset get_offset() const
         {
             #ifdef DEBUG_PROPAGATEFROM
@@ -162,6 +191,22 @@ class PropBy
             return data1;
         }
 
+        uint32_t get_matrix_num() const
+        {
+            #ifdef DEBUG_PROPAGATEFROM
+            assert(type == xor_t);
+            #endif
+            return data2;
+        }
+
+        uint32_t get_reason_num() const
+        {
+            #ifdef DEBUG_PROPAGATEFROM
+            assert(type == xor_t);
+            #endif
+            return data1;
+        }
+
         bool isNULL() const
         {
             return type == null_clause_t;
@@ -193,6 +238,15 @@ inline std::ostream& operator<<(std::ostream& os, const PropBy& pb)
             os << " clause, num= " << pb.get_offset();
             break;
 
+        case ternary_t :
+            os << " ternary, other lits= " << pb.lit2() << ", " << pb.lit3();
+            break;
+
+        case xor_t :
+            os << " xor, matrix= " << pb.get_matrix_num()
+            << " reason num= " << pb.get_reason_num();
+            break;
+
         case null_clause_t :
             os << " NULL";
             break;
@@ -53,6 +53,13 @@ class PropByForGraph
                 type = 1;
                 isize = 2;
             }
+            if (orig.getType() == ternary_t) {
+                lits[0] = otherLit;
+                lits[1] = orig.lit2();
+                lits[2] = orig.lit3();
+                type = 2;
+                isize = 3;
+            }
             if (orig.isClause()) {
                 if (orig.isNULL()) {
                     type = 0;
@@ -109,6 +116,11 @@ class PropByForGraph
             return type == 1;
         }
 
+        bool isTri() const
+        {
+            return type == 2;
+        }
+
         const Clause* getClause() const
         {
             return clause;
@@ -139,6 +151,8 @@ inline std::ostream& operator<<(
 
     if (propByFull.isBin()) {
         os << propByFull[0] << " " << propByFull[1];
+    } else if (propByFull.isTri()) {
+        os << propByFull[0] << " " << propByFull[1] << " " << propByFull[2];
     } else if (propByFull.isClause()) {
         if (propByFull.isNULL()) os << "null clause";
         else os << *propByFull.getClause();
@@ -55,6 +55,9 @@ PropEngine::PropEngine(
         , order_heap_maple(VarOrderLt(var_act_maple))
         , qhead(0)
 {
+    for(uint32_t age = 0; age < 1024; age++) {
+        maple_decay_tab.push_back(std::pow(0.95, age));
+    }
 }
 
 PropEngine::~PropEngine()
@@ -104,6 +107,15 @@ void PropEngine::attachClause(
     }
     #endif //DEBUG_ATTACH
 
+    #ifdef INLINE_TERNARY
+    if (c.size() == 3) {
+        watches[c[0]].push(Watched(offset, c[1], c[2], c.red()));
+        watches[c[1]].push(Watched(offset, c[0], c[2], c.red()));
+        watches[c[2]].push(Watched(offset, c[0], c[1], c.red()));
+        return;
+    }
+    #endif
+
     const Lit blocked_lit = c[2];
     watches[c[0]].push(Watched(offset, blocked_lit));
     watches[c[1]].push(Watched(offset, blocked_lit));
@@ -166,6 +178,61 @@ inline bool PropEngine::prop_bin_cl(
     return true;
 }
 
+#ifdef INLINE_TERNARY
+/**
+@brief Propagates a 3-long clause using only its watch
+
+The clause is watched in all three of its literals, so the watch never has
+to move. The reason holds both other literals, conflict analysis does not
+need the clause either. If conflict is found, sets failBinLit
+*/
+template<bool update_bogoprops>
+inline bool PropEngine::prop_ternary(
+    const Watched& w
+    , const Lit p
+    , PropBy& confl
+) {
+    const Lit lit2 = w.getBlockedLit();
+    const Lit lit3 = w.getLit3();
+    const lbool val2 = value(lit2);
+    const lbool val3 = value(lit3);
+    if (val2 == l_True
+        || val3 == l_True
+        || (val2 == l_Undef && val3 == l_Undef)
+    ) {
+        return true;
+    }
+
+    if (val2 == l_False && val3 == l_False) {
+        #ifdef STATS_NEEDED
+        if (w.red_ternary())
+            lastConflictCausedBy = ConflCausedBy::longred;
+        else
+            lastConflictCausedBy = ConflCausedBy::longirred;
+        #endif
+
+        confl = PropBy(lit2, lit3, w.red_ternary());
+        failBinLit = ~p;
+        qhead = trail.size();
+        return false;
+    }
+
+    #ifdef STATS_NEEDED
+    if (w.red_ternary())
+        propStats.propsLongRed++;
+    else
+        propStats.propsLongIrred++;
+    #endif
+    if (val2 == l_Undef) {
+        enqueue<update_bogoprops>(lit2, PropBy(~p, lit3, w.red_ternary()));
+    } else {
+        enqueue<update_bogoprops>(lit3, PropBy(~p, lit2, w.red_ternary()));
+    }
+
+    return true;
+}
+#endif
+
 template<bool update_bogoprops>
 inline
 bool PropEngine::prop_long_cl_any_order(
@@ -179,6 +246,12 @@ bool PropEngine::prop_long_cl_any_order(
         *j++ = *i;
         return true;
     }
+    #ifdef INLINE_TERNARY
+    if (i->isTernary()) {
+        *j++ = *i;
+        return prop_ternary<update_bogoprops>(*i, p, confl);
+    }
+    #endif
     if (update_bogoprops) {
         propStats.bogoProps += 4;
     }
@@ -201,7 +274,7 @@ bool PropEngine::prop_long_cl_any_order(
         return false;
     } else {
         #ifdef STATS_NEEDED
-        c.stats.propagations_made++;
+        cl_alloc.stats(c).propagations_made++;
         if (c.red())
             propStats.propsLongRed++;
         else
@@ -268,6 +341,22 @@ PropBy PropEngine::propagate_any_order_fast()
                 continue;
             }
 
+            #ifdef INLINE_TERNARY
+            //3-long clause, everything needed is in the watch
+            if (i->isTernary()) {
+                *j++ = *i;
+                if (!prop_ternary<false>(*i, p, confl)) {
+                    i++;
+                    while (i < end) {
+                        *j++ = *i++;
+                    }
+                    continue;
+                }
+                i++;
+                continue;
+            }
+            #endif
+
             const ClOffset offset = i->get_offset();
             Clause& c = *cl_alloc.ptr(offset);
             Lit      false_lit = ~p;
@@ -436,6 +525,13 @@ inline void PropEngine::updateWatch(
         }
 
         assert(it->isClause());
+        #ifdef INLINE_TERNARY
+        if (it->isTernary()) {
+            it->setBlockedLit(getUpdatedLit(it->getBlockedLit(), outerToInter));
+            it->setLit3(getUpdatedLit(it->getLit3(), outerToInter));
+            continue;
+        }
+        #endif
         const Clause &cl = *cl_alloc.ptr(it->get_offset());
         Lit blocked_lit = it->getBlockedLit();
         blocked_lit = getUpdatedLit(it->getBlockedLit(), outerToInter);
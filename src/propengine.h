@@ -37,6 +37,7 @@ THE SOFTWARE.
 #include "avgcalc.h"
 #include "propby.h"
 #include "heap.h"
+#include "vmtf.h"
 #include "alg.h"
 #include "clause.h"
 #include "boundedqueue.h"
@@ -107,6 +108,7 @@ public:
     void new_decision_level();
     vector<double> var_act_vsids;
     vector<double> var_act_maple;
+    double maple_decay(const uint32_t age) const;
 
     //Variable activities
     struct VarOrderLt { ///Order variables according to their activities
@@ -125,9 +127,11 @@ public:
     ///NOT VALID WHILE SIMPLIFYING
     Heap<VarOrderLt> order_heap_vsids;
     Heap<VarOrderLt> order_heap_maple;
+    VMTFQueue vmtf_queue; ///<used instead of order_heap_vsids if VMTF is set
 
 protected:
     int64_t simpDB_props = 0;
+    vector<double> maple_decay_tab; ///<maple_decay_tab[age] = 0.95^age
     void new_var(const bool bva, const uint32_t orig_outer) override;
     void new_vars(const size_t n) override;
     void save_on_var_memory();
@@ -148,6 +152,9 @@ protected:
     Lit                 failBinLit;       ///< Used to store which watches[lit] we were looking through when conflict occured
 
     friend class EGaussian;
+    #ifdef CMS_BENCH_ENABLED
+    friend struct BenchAccess;
+    #endif
 
     template<bool update_bogoprops>
     PropBy propagate_any_order();
@@ -244,6 +251,14 @@ private:
         , const Lit p
         , PropBy& confl
     ); ///<Propagate 2-long clause
+    #ifdef INLINE_TERNARY
+    template<bool update_bogoprops>
+    bool prop_ternary(
+        const Watched& w
+        , const Lit p
+        , PropBy& confl
+    ); ///<Propagate 3-long clause from its watch only
+    #endif
     template<bool update_bogoprops>
     bool prop_long_cl_any_order(
         Watched* i
@@ -315,7 +330,7 @@ inline PropResult PropEngine::prop_normal_helper(
     , const Lit p
 ) {
     #ifdef STATS_NEEDED
-    c.stats.clause_looked_at++;
+    cl_alloc.stats(c).clause_looked_at++;
     #endif
 
     // Make sure the false literal is data[1]:
@@ -369,8 +384,8 @@ inline PropResult PropEngine::handle_normal_prop_fail(
 
     //Update stats
     #ifdef STATS_NEEDED
-    c.stats.conflicts_made++;
-    c.stats.sum_of_branch_depth_conflict += decisionLevel() + 1;
+    cl_alloc.stats(c).conflicts_made++;
+    cl_alloc.stats(c).sum_of_branch_depth_conflict += decisionLevel() + 1;
     if (c.red())
         lastConflictCausedBy = ConflCausedBy::longred;
     else
@@ -381,6 +396,14 @@ inline PropResult PropEngine::handle_normal_prop_fail(
     return PROP_FAIL;
 }
 
+inline double PropEngine::maple_decay(const uint32_t age) const
+{
+    if (age < maple_decay_tab.size()) {
+        return maple_decay_tab[age];
+    }
+    return std::pow(0.95, age);
+}
+
 template<bool update_bogoprops>
 void PropEngine::enqueue(const Lit p, const PropBy from)
 {
@@ -407,17 +430,11 @@ void PropEngine::enqueue(const Lit p, const PropBy from)
     }
 
     if (!update_bogoprops && !VSIDS && from != PropBy()) {
+        //The decay for the time it was unassigned is applied, together with
+        //the reward, when it gets unassigned. See Searcher::cancelUntil()
+        assert(sumConflicts >= varData[v].cancelled);
         varData[v].last_picked = sumConflicts;
         varData[v].conflicted = 0;
-
-        assert(sumConflicts >= varData[v].cancelled);
-        uint32_t age = sumConflicts - varData[v].cancelled;
-        if (age > 0) {
-            double decay = std::pow(0.95, age);
-            var_act_maple[v] *= decay;
-            if (order_heap_maple.inHeap(v))
-                order_heap_maple.increase(v);
-        }
     }
 
     const bool sign = p.sign();
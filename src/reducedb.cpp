@@ -25,24 +25,12 @@ THE SOFTWARE.
 #include "solverconf.h"
 #include "sqlstats.h"
 #include <functional>
+#include <algorithm>
+#include <limits>
+#include <string.h>
 
 using namespace CMSat;
 
-struct SortRedClsGlue
-{
-    explicit SortRedClsGlue(ClauseAllocator& _cl_alloc) :
-        cl_alloc(_cl_alloc)
-    {}
-    ClauseAllocator& cl_alloc;
-
-    bool operator () (const ClOffset xOff, const ClOffset yOff) const
-    {
-        const Clause* x = cl_alloc.ptr(xOff);
-        const Clause* y = cl_alloc.ptr(yOff);
-        return x->stats.glue < y->stats.glue;
-    }
-};
-
 struct SortRedClsSize
 {
     explicit SortRedClsSize(ClauseAllocator& _cl_alloc) :
@@ -58,42 +46,29 @@ struct SortRedClsSize
     }
 };
 
-struct SortRedClsAct
-{
-    explicit SortRedClsAct(ClauseAllocator& _cl_alloc) :
-        cl_alloc(_cl_alloc)
-    {}
-    ClauseAllocator& cl_alloc;
-
-    bool operator () (const ClOffset xOff, const ClOffset yOff) const
-    {
-        const Clause* x = cl_alloc.ptr(xOff);
-        const Clause* y = cl_alloc.ptr(yOff);
-        return x->stats.activity > y->stats.activity;
-    }
-};
-
 ReduceDB::ReduceDB(Solver* _solver) :
     solver(_solver)
 {
 }
 
-void ReduceDB::sort_red_cls(ClauseClean clean_type)
+//Smaller is better
+static inline uint32_t clean_key(const ClauseStats& stats, const ClauseClean clean_type)
 {
     switch (clean_type) {
-        case ClauseClean::glue : {
-            std::sort(solver->longRedCls[2].begin(), solver->longRedCls[2].end(), SortRedClsGlue(solver->cl_alloc));
-            break;
-        }
+        case ClauseClean::glue :
+            return stats.glue;
 
         case ClauseClean::activity : {
-            std::sort(solver->longRedCls[2].begin(), solver->longRedCls[2].end(), SortRedClsAct(solver->cl_alloc));
-            break;
+            //Non-negative floats compare the same as their bit patterns
+            assert(stats.activity >= 0);
+            uint32_t bits;
+            memcpy(&bits, &stats.activity, sizeof(bits));
+            return ~bits;
         }
 
-        default: {
+        default:
             assert(false && "Unknown cleaning type");
-        }
+            return 0;
     }
 }
 
@@ -117,8 +92,7 @@ void ReduceDB::handle_lev2()
         if (keep_num == 0) {
             continue;
         }
-        sort_red_cls(static_cast<ClauseClean>(keep_type));
-        mark_top_N_clauses(keep_num);
+        mark_top_N_clauses(keep_num, static_cast<ClauseClean>(keep_type));
     }
     assert(delayed_clause_free.empty());
     cl_marked = 0;
@@ -132,6 +106,9 @@ void ReduceDB::handle_lev2()
     }
     delayed_clause_free.clear();
 
+    //No offsets of freed clauses are held at this point
+    solver->cl_alloc.release_freed();
+
     #ifdef SLOW_DEBUG
     solver->check_no_removed_or_freed_cl_in_watch();
     #endif
@@ -168,15 +145,15 @@ void ReduceDB::dump_sql_cl_data()
             Clause* cl = solver->cl_alloc.ptr(offs);
             assert(!cl->getRemoved());
             assert(!cl->freed());
-            if (cl->stats.dump_number < 50000) {
+            if (solver->cl_alloc.stats(cl).dump_number < 50000) {
                 const bool locked = solver->clause_locked(*cl, offs);
                 solver->sqlStats->reduceDB(
                     solver
                     , locked
                     , cl
                 );
-                cl->stats.dump_number++;
-                cl->stats.reset_rdb_stats();
+                solver->cl_alloc.stats(cl).dump_number++;
+                solver->cl_alloc.stats(cl).reset_rdb_stats();
             }
         }
     }
@@ -198,18 +175,18 @@ void ReduceDB::handle_lev1()
     ) {
         const ClOffset offset = solver->longRedCls[1][i];
         Clause* cl = solver->cl_alloc.ptr(offset);
-        if (cl->stats.which_red_array == 0) {
+        if (solver->cl_alloc.stats(cl).which_red_array == 0) {
             solver->longRedCls[0].push_back(offset);
             moved_w0++;
-        } else if (cl->stats.which_red_array == 2) {
+        } else if (solver->cl_alloc.stats(cl).which_red_array == 2) {
             assert(false && "we should never move up through any other means");
         } else {
             if (!solver->clause_locked(*cl, offset)
-                && cl->stats.last_touched + solver->conf.must_touch_lev1_within < solver->sumConflicts
+                && solver->cl_alloc.stats(cl).last_touched + solver->conf.must_touch_lev1_within < solver->sumConflicts
             ) {
                 solver->longRedCls[2].push_back(offset);
-                cl->stats.which_red_array = 2;
-                cl->stats.activity = 0;
+                solver->cl_alloc.stats(cl).which_red_array = 2;
+                solver->cl_alloc.stats(cl).activity = 0;
                 solver->bump_cl_act<false>(cl);
                 non_recent_use++;
             } else {
@@ -239,29 +216,44 @@ void ReduceDB::handle_lev1()
     total_time += cpuTime()-myTime;
 }
 
-void ReduceDB::mark_top_N_clauses(const uint64_t keep_num)
+/**
+@brief Marks the best keep_num not yet marked clauses of lev2 to be kept
+
+The keys of the candidates are extracted in one pass, then the best ones are
+selected with nth_element(), so the clauses are not accessed while comparing.
+Ties are broken by position, so the result is deterministic.
+*/
+void ReduceDB::mark_top_N_clauses(const uint64_t keep_num, const ClauseClean clean_type)
 {
-    size_t marked = 0;
-    for(size_t i = 0
-        ; i < solver->longRedCls[2].size() && marked < keep_num
-        ; i++
-    ) {
-        const ClOffset offset = solver->longRedCls[2][i];
-        Clause* cl = solver->cl_alloc.ptr(offset);
+    const vector<ClOffset>& lev2 = solver->longRedCls[2];
+    assert(lev2.size() <= std::numeric_limits<uint32_t>::max());
+
+    //key in the top 32 bits, position in lev2 in the bottom 32
+    top_n_keys.clear();
+    for(size_t i = 0; i < lev2.size(); i++) {
+        const ClOffset offset = lev2[i];
+        const Clause* cl = solver->cl_alloc.ptr(offset);
+        const ClauseStats& stats = solver->cl_alloc.stats(cl);
 
         if (cl->used_in_xor()
-            || cl->stats.ttl > 0
+            || stats.ttl > 0
+            || stats.which_red_array != 2
+            || stats.marked_clause
             || solver->clause_locked(*cl, offset)
-            || cl->stats.which_red_array != 2
         ) {
             //no need to mark, skip
             continue;
         }
+        top_n_keys.push_back(((uint64_t)clean_key(stats, clean_type) << 32) | i);
+    }
 
-        if (!cl->stats.marked_clause) {
-            marked++;
-            cl->stats.marked_clause = true;
-        }
+    if (top_n_keys.size() > keep_num) {
+        std::nth_element(top_n_keys.begin(), top_n_keys.begin() + keep_num, top_n_keys.end());
+        top_n_keys.resize(keep_num);
+    }
+    for(const uint64_t k: top_n_keys) {
+        const ClOffset offset = lev2[(uint32_t)k];
+        solver->cl_alloc.stats(solver->cl_alloc.ptr(offset)).marked_clause = true;
     }
 }
 
@@ -269,8 +261,8 @@ bool ReduceDB::cl_needs_removal(const Clause* cl, const ClOffset offset) const
 {
     assert(cl->red());
     return !cl->used_in_xor()
-         && !cl->stats.marked_clause
-         && cl->stats.ttl == 0
+         && !solver->cl_alloc.stats(cl).marked_clause
+         && solver->cl_alloc.stats(cl).ttl == 0
          && !solver->clause_locked(*cl, offset);
 }
 
@@ -285,34 +277,39 @@ void ReduceDB::remove_cl_from_lev2() {
         assert(cl->size() > 2);
 
         //move to another array
-        if (cl->stats.which_red_array < 2) {
-            cl->stats.marked_clause = 0;
-            solver->longRedCls[cl->stats.which_red_array].push_back(offset);
+        if (solver->cl_alloc.stats(cl).which_red_array < 2) {
+            solver->cl_alloc.stats(cl).marked_clause = 0;
+            solver->longRedCls[solver->cl_alloc.stats(cl).which_red_array].push_back(offset);
             continue;
         }
-        assert(cl->stats.which_red_array == 2);
+        assert(solver->cl_alloc.stats(cl).which_red_array == 2);
 
         //Check if locked, or marked or ttl-ed
-        if (cl->stats.marked_clause) {
+        if (solver->cl_alloc.stats(cl).marked_clause) {
             cl_marked++;
-        } else if (cl->stats.ttl != 0) {
+        } else if (solver->cl_alloc.stats(cl).ttl != 0) {
             cl_ttl++;
         } else if (solver->clause_locked(*cl, offset)) {
             cl_locked_solver++;
         }
 
         if (!cl_needs_removal(cl, offset)) {
-            if (cl->stats.ttl > 0) {
-                cl->stats.ttl--;
+            if (solver->cl_alloc.stats(cl).ttl > 0) {
+                solver->cl_alloc.stats(cl).ttl--;
             }
             solver->longRedCls[2][j++] = offset;
-            cl->stats.marked_clause = 0;
+            solver->cl_alloc.stats(cl).marked_clause = 0;
             continue;
         }
 
         //Stats Update
         solver->watches.smudge((*cl)[0]);
         solver->watches.smudge((*cl)[1]);
+        #ifdef INLINE_TERNARY
+        if (cl->size() == 3) {
+            solver->watches.smudge((*cl)[2]);
+        }
+        #endif
         solver->litStats.redLits -= cl->size();
 
         *solver->drat << del << *cl << fin;
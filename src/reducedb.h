@@ -44,6 +44,9 @@ public:
     uint64_t nbReduceDB_lev2 = 0;
 
 private:
+    #ifdef CMS_BENCH_ENABLED
+    friend struct BenchAccess;
+    #endif
     Solver* solver;
     vector<ClOffset> delayed_clause_free;
     double total_time = 0.0;
@@ -59,8 +62,8 @@ private:
     bool cl_needs_removal(const Clause* cl, const ClOffset offset) const;
     void remove_cl_from_lev2();
 
-    void sort_red_cls(ClauseClean clean_type);
-    void mark_top_N_clauses(const uint64_t keep_num);
+    vector<uint64_t> top_n_keys;
+    void mark_top_N_clauses(const uint64_t keep_num, const ClauseClean clean_type);
 };
 
 }
@@ -36,7 +36,9 @@ using std::cout;
 using std::endl;
 
 SCCFinder::SCCFinder(Solver* _solver) :
-    globalIndex(0)
+    globalIndex(1)
+    , componentIndex(std::numeric_limits<uint32_t>::max())
+    , with_trans_cache(false)
     , solver(_solver)
 {}
 
@@ -45,29 +47,30 @@ bool SCCFinder::performSCC(uint64_t* bogoprops_given)
     assert(binxors.empty());
     runStats.clear();
     runStats.numCalls = 1;
-    depth_warning_issued = false;
     const double myTime = cpuTime();
 
-    globalIndex = 0;
-    index.clear();
-    index.resize(solver->nVars()*2, std::numeric_limits<uint32_t>::max());
-    lowlink.clear();
-    lowlink.resize(solver->nVars()*2, std::numeric_limits<uint32_t>::max());
-    stackIndicator.clear();
-    stackIndicator.resize(solver->nVars()*2, false);
+    with_trans_cache = solver->conf.doCache
+        && solver->conf.doExtendedSCC
+        && (!(solver->drat->enabled() || solver->conf.simulate_drat) ||
+            solver->conf.otfHyperbin);
+
+    globalIndex = 1;
+    componentIndex = std::numeric_limits<uint32_t>::max();
+    rindex.clear();
+    rindex.resize(solver->nVars()*2, 0);
     assert(stack.empty());
+    assert(visits.empty());
 
-    depth = 0;
     for (uint32_t vertex = 0; vertex < solver->nVars()*2; vertex++) {
         //Start a DFS at each node we haven't visited yet
         const uint32_t v = vertex>>1;
-        if (solver->value(v) != l_Undef) {
+        if (solver->value(v) != l_Undef
+            || solver->varData[v].removed != Removed::none
+        ) {
             continue;
         }
-        assert(depth == 0);
-        if (index[vertex] == std::numeric_limits<uint32_t>::max()) {
-            tarjan(vertex);
-            depth--;
+        if (rindex[vertex] == 0) {
+            find_sccs_from(vertex);
             assert(stack.empty());
         }
     }
@@ -90,82 +93,114 @@ bool SCCFinder::performSCC(uint64_t* bogoprops_given)
     return solver->okay();
 }
 
-void SCCFinder::tarjan(const uint32_t vertex)
+void SCCFinder::find_sccs_from(const uint32_t root)
 {
-    depth++;
-    if (depth >= (uint32_t)solver->conf.max_scc_depth) {
-        if (solver->conf.verbosity && !depth_warning_issued) {
-            depth_warning_issued = true;
-            cout << "c [scc] WARNING: reached maximum depth of " << solver->conf.max_scc_depth << endl;
+    begin_visit(root);
+    while (!visits.empty()) {
+        Visit& visit = visits.back();
+        const uint32_t vertex = visit.vertex;
+
+        Lit lit;
+        if (next_successor(vertex, visit.at, lit)) {
+            const uint32_t succ = lit.toInt();
+            if (rindex[succ] == 0) {
+                //Descend, "visit" is invalidated here
+                begin_visit(succ);
+            } else if (rindex[succ] < rindex[vertex]) {
+                //On the stack. Finished ones have a higher component index
+                rindex[vertex] = rindex[succ];
+            }
+            continue;
         }
-        return;
-    }
 
-    const Lit vertLit = Lit::toLit(vertex);
-    if (solver->varData[vertLit.var()].removed != Removed::none) {
-        return;
+        //All successors done, return to the parent
+        const uint32_t vertex_index = visit.index;
+        visits.pop_back();
+        finish_visit(vertex, vertex_index);
+        if (!visits.empty()) {
+            const uint32_t parent = visits.back().vertex;
+            rindex[parent] = std::min(rindex[parent], rindex[vertex]);
+        }
     }
+}
 
+void SCCFinder::begin_visit(const uint32_t vertex)
+{
     runStats.bogoprops += 1;
-    index[vertex] = globalIndex;  // Set the depth index for v
-    lowlink[vertex] = globalIndex;
+    rindex[vertex] = globalIndex;
+    visits.push_back(Visit(vertex, globalIndex));
     globalIndex++;
-    stack.push(vertex); // Push v on the stack
-    stackIndicator[vertex] = true;
+    stack.push_back(vertex);
 
-    vector<LitExtra>* transCache = NULL;
-    if (solver->conf.doCache
-        && solver->conf.doExtendedSCC
-        && (!(solver->drat->enabled() || solver->conf.simulate_drat) ||
-            solver->conf.otfHyperbin)
-    ) {
-        transCache = &(solver->implCache[~vertLit].lits);
-        __builtin_prefetch(transCache->data());
+    const Lit vertLit = Lit::toLit(vertex);
+    runStats.bogoprops += solver->watches[~vertLit].size()/4;
+    if (with_trans_cache) {
+        const vector<LitExtra>& transCache = solver->implCache[~vertLit].lits;
+        __builtin_prefetch(transCache.data());
+        runStats.bogoprops += transCache.size()/4;
     }
+}
 
-    //Go through the watch
+//Successors are the binary clauses in the watchlist, then the cache
+bool SCCFinder::next_successor(const uint32_t vertex, uint32_t& at, Lit& lit)
+{
+    const Lit vertLit = Lit::toLit(vertex);
     watch_subarray_const ws = solver->watches[~vertLit];
-    runStats.bogoprops += ws.size()/4;
-    for (const Watched& w: ws) {
+    while (at < ws.size()) {
+        const Watched& w = ws[at++];
+
         //Only binary clauses matter
         if (!w.isBin())
             continue;
 
-        const Lit lit = w.lit2();
-        if (solver->value(lit) != l_Undef) {
+        lit = w.lit2();
+        if (solver->value(lit) != l_Undef
+            || solver->varData[lit.var()].removed != Removed::none
+        ) {
             continue;
         }
-        doit(lit, vertex);
+        return true;
     }
 
-    if (transCache) {
-        runStats.bogoprops += transCache->size()/4;
-        for (const LitExtra& le: *transCache) {
-            Lit lit = le.getLit();
-            if (solver->value(lit) != l_Undef) {
+    if (with_trans_cache) {
+        const vector<LitExtra>& transCache = solver->implCache[~vertLit].lits;
+        while (at - ws.size() < transCache.size()) {
+            lit = transCache[at - ws.size()].getLit();
+            at++;
+            if (solver->value(lit) != l_Undef
+                || solver->varData[lit.var()].removed != Removed::none
+                || lit == ~vertLit
+            ) {
                 continue;
             }
-            if (lit != ~vertLit) {
-                doit(lit, vertex);
-            }
+            return true;
         }
     }
 
+    return false;
+}
+
+void SCCFinder::finish_visit(const uint32_t vertex, const uint32_t vertex_index)
+{
     // Is v the root of an SCC?
-    if (lowlink[vertex] == index[vertex]) {
-        uint32_t vprime;
-        tmp.clear();
-        do {
-            assert(!stack.empty());
-            vprime = stack.top();
-            stack.pop();
-            stackIndicator[vprime] = false;
-            tmp.push_back(vprime);
-        } while (vprime != vertex);
-        if (tmp.size() >= 2) {
-            runStats.bogoprops += 3;
-            add_bin_xor_in_tmp();
-        }
+    if (rindex[vertex] != vertex_index) {
+        return;
+    }
+
+    uint32_t vprime;
+    tmp.clear();
+    do {
+        assert(!stack.empty());
+        vprime = stack.back();
+        stack.pop_back();
+        rindex[vprime] = componentIndex;
+        tmp.push_back(vprime);
+    } while (vprime != vertex);
+    componentIndex--;
+
+    if (tmp.size() >= 2) {
+        runStats.bogoprops += 3;
+        add_bin_xor_in_tmp();
     }
 }
 
@@ -220,10 +255,9 @@ void SCCFinder::Stats::print_short(Solver* solver) const
 size_t SCCFinder::mem_used() const
 {
     size_t mem = 0;
-    mem += index.capacity()*sizeof(uint32_t);
-    mem += lowlink.capacity()*sizeof(uint32_t);
-    mem += stack.size()*sizeof(uint32_t); //TODO under-estimates
-    mem += stackIndicator.capacity()*sizeof(char);
+    mem += rindex.capacity()*sizeof(uint32_t);
+    mem += stack.capacity()*sizeof(uint32_t);
+    mem += visits.capacity()*sizeof(Visit);
     mem += tmp.capacity()*sizeof(uint32_t);
 
     return mem;
@@ -24,7 +24,6 @@ THE SOFTWARE.
 #define SCCFINDER_H
 
 #include "clause.h"
-#include <stack>
 #include <set>
 
 namespace CMSat {
@@ -98,22 +97,38 @@ class SCCFinder {
 
         const Stats& get_stats() const;
         size_t mem_used() const;
-        bool depth_warning_triggered() const;
 
     private:
-        void tarjan(const uint32_t vertex);
-        bool depth_warning_issued;
-        void doit(const Lit lit, const uint32_t vertex);
+        //Iterative version of Tarjan's algorithm with the single rindex
+        //array of Pearce's variant, so there is no limit on DFS depth
+        void find_sccs_from(const uint32_t root);
+        void begin_visit(const uint32_t vertex);
+        bool next_successor(const uint32_t vertex, uint32_t& at, Lit& lit);
+        void finish_visit(const uint32_t vertex, const uint32_t vertex_index);
         void add_bin_xor_in_tmp();
 
+        //DFS stack entry, replaces the frame of a recursive call
+        struct Visit {
+            Visit(const uint32_t _vertex, const uint32_t _index) :
+                vertex(_vertex)
+                , index(_index)
+            {}
+
+            uint32_t vertex;
+            uint32_t index; //index the vertex was discovered with
+            uint32_t at = 0; //next successor to look at
+        };
+
         //temporaries
+        //rindex: 0 if unvisited, the lowest index reachable while on the
+        //stack, and a component number (always above all indexes) when done
         uint32_t globalIndex;
-        vector<uint32_t> index;
-        vector<uint32_t> lowlink;
-        std::stack<uint32_t, vector<uint32_t> > stack;
-        vector<char> stackIndicator;
+        uint32_t componentIndex;
+        bool with_trans_cache;
+        vector<uint32_t> rindex;
+        vector<uint32_t> stack;
+        vector<Visit> visits;
         vector<uint32_t> tmp;
-        uint32_t depth;
 
         Solver* solver;
         std::set<BinaryXor> binxors;
@@ -123,22 +138,6 @@ class SCCFinder {
         Stats globalStats;
 };
 
-inline void SCCFinder::doit(const Lit lit, const uint32_t vertex) {
-    // Was successor v' visited?
-    if (index[lit.toInt()] ==  std::numeric_limits<uint32_t>::max()) {
-        tarjan(lit.toInt());
-        depth--;
-        lowlink[vertex] = std::min(lowlink[vertex], lowlink[lit.toInt()]);
-    } else if (stackIndicator[lit.toInt()])  {
-        lowlink[vertex] = std::min(lowlink[vertex], lowlink[lit.toInt()]);
-    }
-}
-
-inline bool SCCFinder::depth_warning_triggered() const
-{
-    return depth_warning_issued;
-}
-
 inline const SCCFinder::Stats& SCCFinder::get_stats() const
 {
     return globalStats;
@@ -108,6 +108,7 @@ void Searcher::new_var(const bool bva, const uint32_t orig_outer)
 
     var_act_vsids.push_back(0);
     var_act_maple.push_back(0);
+    vmtf_queue.new_var();
     insert_var_order_all((int)nVars()-1);
 }
 
@@ -118,6 +119,7 @@ void Searcher::new_vars(size_t n)
     var_act_vsids.insert(var_act_vsids.end(), n, 0);
     var_act_maple.insert(var_act_maple.end(), n, 0);
     for(int i = n-1; i >= 0; i--) {
+        vmtf_queue.new_var();
         insert_var_order_all((int)nVars()-i-1);
     }
 }
@@ -131,7 +133,7 @@ void Searcher::save_on_var_memory()
 
     var_act_vsids.shrink_to_fit();
     var_act_maple.shrink_to_fit();
-
+    vmtf_queue.shrink(nVars());
 }
 
 void Searcher::updateVars(
@@ -140,6 +142,7 @@ void Searcher::updateVars(
 ) {
     updateArray(var_act_vsids, interToOuter);
     updateArray(var_act_maple, interToOuter);
+    vmtf_queue.renumber(interToOuter);
 
     renumber_assumptions(outerToInter);
 }
@@ -172,7 +175,9 @@ inline void Searcher::add_lit_to_learnt(
 
     if (!update_bogoprops) {
         if (VSIDS) {
-            bump_vsids_var_act<update_bogoprops>(var, 0.5);
+            if (!VMTF) {
+                bump_vsids_var_act<update_bogoprops>(var, 0.5);
+            }
             implied_by_learnts.push_back(var);
         } else {
             varData[var].conflicted++;
@@ -279,7 +284,7 @@ void Searcher::create_otf_subsuming_long_clause(
         << "New smaller clause OTF:" << cl << endl;
     }
     #ifdef STATS_NEEDED
-    cl.stats.ID = clauseID;
+    cl_alloc.stats(cl).ID = clauseID;
     #endif
     *drat << add << cl
     #ifdef STATS_NEEDED
@@ -318,6 +323,9 @@ void Searcher::normalClMinim()
         const PropBy& reason = varData[learnt_clause[i].var()].reason;
         size_t size;
         Clause* cl = NULL;
+        #ifdef USE_GAUSS
+        const vector<Lit>* xcl = NULL;
+        #endif
         PropByType type = reason.getType();
         if (type == null_clause_t) {
             learnt_clause[j++] = learnt_clause[i];
@@ -334,6 +342,17 @@ void Searcher::normalClMinim()
                 size = 1;
                 break;
 
+            case ternary_t:
+                size = 2;
+                break;
+
+            #ifdef USE_GAUSS
+            case xor_t:
+                xcl = &get_xor_reason(reason);
+                size = xcl->size()-1;
+                break;
+            #endif
+
             default:
                 release_assert(false);
                 std::exit(-1);
@@ -350,6 +369,16 @@ void Searcher::normalClMinim()
                     p = reason.lit2();
                     break;
 
+                case ternary_t:
+                    p = (k == 0) ? reason.lit2() : reason.lit3();
+                    break;
+
+                #ifdef USE_GAUSS
+                case xor_t:
+                    p = (*xcl)[k+1];
+                    break;
+                #endif
+
                 default:
                     release_assert(false);
                     std::exit(-1);
@@ -376,6 +405,11 @@ void Searcher::debug_print_resolving_clause(const PropBy confl) const
             break;
         }
 
+        case ternary_t: {
+            cout << "resolv tri: " << confl.lit2() << ", " << confl.lit3() << endl;
+            break;
+        }
+
         case clause_t: {
             Clause* cl = cl_alloc.ptr(confl.get_offset());
             cout << "resolv (long): " << *cl << endl;
@@ -383,9 +417,7 @@ void Searcher::debug_print_resolving_clause(const PropBy confl) const
         }
 
         case xor_t: {
-            //in the future, we'll have XOR clauses. Not yet.
-            assert(false);
-            exit(-1);
+            cout << "resolv (xor): " << confl << endl;
             break;
         }
 
@@ -397,28 +429,35 @@ void Searcher::debug_print_resolving_clause(const PropBy confl) const
 #endif
 }
 
+#ifdef USE_GAUSS
+const vector<Lit>& Searcher::get_xor_reason(const PropBy& reason)
+{
+    return gmatrixes[reason.get_matrix_num()]->get_reason(reason.get_reason_num());
+}
+#endif
+
 void Searcher::update_clause_glue_from_analysis(Clause* cl)
 {
     assert(cl->red());
     const unsigned new_glue = calc_glue(*cl);
 
-    if (new_glue < cl->stats.glue) {
-        if (cl->stats.glue <= conf.protect_cl_if_improved_glue_below_this_glue_for_one_turn) {
-            cl->stats.ttl = 1;
+    if (new_glue < cl_alloc.stats(cl).glue) {
+        if (cl_alloc.stats(cl).glue <= conf.protect_cl_if_improved_glue_below_this_glue_for_one_turn) {
+            cl_alloc.stats(cl).ttl = 1;
         }
-        cl->stats.glue = new_glue;
+        cl_alloc.stats(cl).glue = new_glue;
 
         //move to lev0 if very low glue
         if (new_glue <= conf.glue_put_lev0_if_below_or_eq
-            && cl->stats.which_red_array >= 1
+            && cl_alloc.stats(cl).which_red_array >= 1
         ) {
-            cl->stats.which_red_array = 0;
+            cl_alloc.stats(cl).which_red_array = 0;
         } else {
             //move to lev1 if low glue
             if (new_glue <= conf.glue_put_lev1_if_below_or_eq
                 && solver->conf.glue_put_lev1_if_below_or_eq != 0
             ) {
-                cl->stats.which_red_array = 1;
+                cl_alloc.stats(cl).which_red_array = 1;
             }
         }
      }
@@ -434,6 +473,9 @@ Clause* Searcher::add_literals_from_confl_to_learnt(
     #endif
 
     Clause* cl = NULL;
+    #ifdef USE_GAUSS
+    const vector<Lit>* xcl = NULL;
+    #endif
     switch (confl.getType()) {
         case binary_t : {
             if (confl.isRedStep()) {
@@ -450,15 +492,35 @@ Clause* Searcher::add_literals_from_confl_to_learnt(
             break;
         }
 
+        //Only its 2 other literals are kept, glue and activity can't be
+        //updated. 3-long redundant clauses are rarely removed anyway
+        case ternary_t : {
+            if (confl.isRedStep()) {
+                #ifdef STATS_NEEDED
+                antec_data.longRed++;
+                #endif
+                stats.resolvs.longRed++;
+            } else {
+                #ifdef STATS_NEEDED
+                antec_data.longIrred++;
+                #endif
+                stats.resolvs.longIrred++;
+            }
+            #ifdef STATS_NEEDED
+            antec_data.size_longs.push(3);
+            #endif
+            break;
+        }
+
         case clause_t : {
             cl = cl_alloc.ptr(confl.get_offset());
             if (cl->red()) {
                 stats.resolvs.longRed++;
                 #ifdef STATS_NEEDED
-                antec_data.vsids_of_ants.push(cl->stats.antec_data.vsids_vars.avg());
+                antec_data.vsids_of_ants.push(cl_alloc.stats(cl).antec_data.vsids_vars.avg());
                 antec_data.longRed++;
-                antec_data.age_long_reds.push(sumConflicts - cl->stats.introduced_at_conflict);
-                antec_data.glue_long_reds.push(cl->stats.glue);
+                antec_data.age_long_reds.push(sumConflicts - cl_alloc.stats(cl).introduced_at_conflict);
+                antec_data.glue_long_reds.push(cl_alloc.stats(cl).glue);
                 #endif
             } else {
                 #ifdef STATS_NEEDED
@@ -468,21 +530,21 @@ Clause* Searcher::add_literals_from_confl_to_learnt(
             }
             #ifdef STATS_NEEDED
             antec_data.size_longs.push(cl->size());
-            cl->stats.used_for_uip_creation++;
+            cl_alloc.stats(cl).used_for_uip_creation++;
             #endif
 
             if (!update_bogoprops
                 && cl->red()
-                && cl->stats.which_red_array != 0
+                && cl_alloc.stats(cl).which_red_array != 0
             ) {
                 if (conf.update_glues_on_analyze) {
                     update_clause_glue_from_analysis(cl);
                 }
 
                 //If STATS_NEEDED then bump acitvity of ALL clauses
-                if (cl->stats.which_red_array == 1) {
-                    cl->stats.last_touched = sumConflicts;
-                } else if (cl->stats.which_red_array == 2) {
+                if (cl_alloc.stats(cl).which_red_array == 1) {
+                    cl_alloc.stats(cl).last_touched = sumConflicts;
+                } else if (cl_alloc.stats(cl).which_red_array == 2) {
                     #ifndef STATS_NEEDED
                     bump_cl_act<update_bogoprops>(cl);
                     #endif
@@ -495,6 +557,13 @@ Clause* Searcher::add_literals_from_confl_to_learnt(
             break;
         }
 
+        #ifdef USE_GAUSS
+        case xor_t: {
+            xcl = &get_xor_reason(confl);
+            break;
+        }
+        #endif
+
         case null_clause_t:
         default:
             assert(false && "Error in conflict analysis (otherwise should be UIP)");
@@ -514,6 +583,17 @@ Clause* Searcher::add_literals_from_confl_to_learnt(
                 }
                 break;
 
+            case ternary_t:
+                if (i == 0) {
+                    x = failBinLit;
+                } else if (i == 1) {
+                    x = confl.lit2();
+                } else {
+                    x = confl.lit3();
+                    cont = false;
+                }
+                break;
+
             case clause_t:
                 assert(!cl->getRemoved());
                 x = (*cl)[i];
@@ -521,7 +601,18 @@ Clause* Searcher::add_literals_from_confl_to_learnt(
                     cont = false;
                 }
                 break;
+
+            #ifdef USE_GAUSS
+            case xor_t:
+                x = (*xcl)[i];
+                if (i == xcl->size()-1) {
+                    cont = false;
+                }
+                break;
+            #endif
+
             case null_clause_t:
+            default:
                 assert(false);
         }
         if (p == lit_Undef || i > 0) {
@@ -672,16 +763,14 @@ inline Clause* Searcher::create_learnt_clause(PropBy confl)
             //A long clause
             && last_resolved_cl != NULL
             //Good enough clause to try to minimize
-            && (!last_resolved_cl->red() || last_resolved_cl->stats.glue <= conf.doOTFSubsumeOnlyAtOrBelowGlue)
+            && (!last_resolved_cl->red() || cl_alloc.stats(last_resolved_cl).glue <= conf.doOTFSubsumeOnlyAtOrBelowGlue)
             //Must subsume, so must be smaller
             && last_resolved_cl->size() > tmp_learnt_clause_size
-            //Must not be a temporary clause
-            && !last_resolved_cl->gauss_temp_cl()
             && !last_resolved_cl->used_in_xor()
         ) {
-            last_resolved_cl->recalc_abst_if_needed();
+            cl_alloc.recalc_abst_if_needed(last_resolved_cl);
             //Everything in learnt_cl_2 seems to be also in cl
-            if ((last_resolved_cl->abst & tmp_learnt_clause_abst) ==  tmp_learnt_clause_abst
+            if ((cl_alloc.abst(last_resolved_cl) & tmp_learnt_clause_abst) ==  tmp_learnt_clause_abst
             ) {
                 check_otf_subsume(confl.get_offset(), *last_resolved_cl);
             }
@@ -737,6 +826,34 @@ void Searcher::simple_create_learnt_clause(
                     seen[q.var()] = 1;
                     mypathC++;
                 }
+            } else if (confl.getType() == ternary_t) {
+                if (p == lit_Undef && True_confl == false) {
+                    Lit q = failBinLit;
+                    if (!seen[q.var()]) {
+                        seen[q.var()] = 1;
+                        mypathC++;
+                    }
+                }
+                for (const Lit q: {confl.lit2(), confl.lit3()}) {
+                    if (!seen[q.var()]) {
+                        seen[q.var()] = 1;
+                        mypathC++;
+                    }
+                }
+            #ifdef USE_GAUSS
+            } else if (confl.getType() == xor_t) {
+                const vector<Lit>& c = get_xor_reason(confl);
+                for (uint32_t j = (p == lit_Undef && True_confl == false) ? 0 : 1
+                    ; j < c.size()
+                    ; j++
+                ) {
+                    Lit q = c[j];
+                    if (!seen[q.var()]) {
+                        seen[q.var()] = 1;
+                        mypathC++;
+                    }
+                }
+            #endif
             } else {
                 const Clause& c = *solver->cl_alloc.ptr(confl.get_offset());
 
@@ -874,7 +991,10 @@ Clause* Searcher::analyze_conflict(
 
     out_btlevel = find_backtrack_level_of_learnt();
     if (!update_bogoprops) {
-        if (VSIDS) {
+        if (VMTF) {
+            //Everything seen during analysis is still assigned here
+            vmtf_queue.bump_all(implied_by_learnts);
+        } else if (VSIDS) {
             bump_var_activities_based_on_implied_by_learnts<update_bogoprops>(out_btlevel);
         } else {
             uint32_t bump_by = 2;
@@ -899,6 +1019,25 @@ Clause* Searcher::analyze_conflict(
                             toClear.push_back(l);
                         }
                     }
+                #ifdef USE_GAUSS
+                } else if (varData[v].reason.getType() == xor_t) {
+                    for (const Lit l: get_xor_reason(varData[v].reason)) {
+                        if (!seen[l.var()]) {
+                            seen[l.var()] = true;
+                            varData[l.var()].conflicted+=bump_by;
+                            toClear.push_back(l);
+                        }
+                    }
+                #endif
+                } else if (varData[v].reason.getType() == ternary_t) {
+                    const PropBy& reason = varData[v].reason;
+                    for (const Lit l: {reason.lit2(), reason.lit3(), Lit(v, false)}) {
+                        if (!seen[l.var()]) {
+                            seen[l.var()] = true;
+                            varData[l.var()].conflicted+=bump_by;
+                            toClear.push_back(l);
+                        }
+                    }
                 } else if (varData[v].reason.getType() == binary_t) {
                     Lit l = varData[v].reason.lit2();
                     if (!seen[l.var()]) {
@@ -955,6 +1094,9 @@ bool Searcher::litRedundant(const Lit p, uint32_t abstract_levels)
 
         size_t size;
         Clause* cl = NULL;
+        #ifdef USE_GAUSS
+        const vector<Lit>* xcl = NULL;
+        #endif
         switch (type) {
             case clause_t:
                 cl = cl_alloc.ptr(reason.get_offset());
@@ -965,6 +1107,17 @@ bool Searcher::litRedundant(const Lit p, uint32_t abstract_levels)
                 size = 1;
                 break;
 
+            case ternary_t:
+                size = 2;
+                break;
+
+            #ifdef USE_GAUSS
+            case xor_t:
+                xcl = &get_xor_reason(reason);
+                size = xcl->size()-1;
+                break;
+            #endif
+
             case null_clause_t:
             default:
                 release_assert(false);
@@ -984,6 +1137,16 @@ bool Searcher::litRedundant(const Lit p, uint32_t abstract_levels)
                     p2 = reason.lit2();
                     break;
 
+                case ternary_t:
+                    p2 = (i == 0) ? reason.lit2() : reason.lit3();
+                    break;
+
+                #ifdef USE_GAUSS
+                case xor_t:
+                    p2 = (*xcl)[i+1];
+                    break;
+                #endif
+
                 case null_clause_t:
                 default:
                     release_assert(false);
@@ -1087,6 +1250,28 @@ void Searcher::analyze_final_confl_with_assumptions(const Lit p, vector<Lit>& ou
                         break;
                     }
 
+                    case PropByType::ternary_t: {
+                        for(const Lit lit: {reason.lit2(), reason.lit3()}) {
+                            if (varData[lit.var()].level > 0) {
+                                seen[lit.var()] = 1;
+                            }
+                        }
+                        break;
+                    }
+
+                    #ifdef USE_GAUSS
+                    case PropByType::xor_t: {
+                        const vector<Lit>& cl = get_xor_reason(reason);
+                        assert(value(cl[0]) == l_True);
+                        for(const Lit lit: cl) {
+                            if (varData[lit.var()].level > 0) {
+                                seen[lit.var()] = 1;
+                            }
+                        }
+                        break;
+                    }
+                    #endif
+
                     default:
                         assert(false);
                         break;
@@ -1238,6 +1423,12 @@ lbool Searcher::search()
             }
             reduce_db_if_needed();
             dec_ret = new_decision<update_bogoprops>();
+            if (dec_ret == l_True && enum_cb != NULL && !update_bogoprops) {
+                dec_ret = enum_model_found();
+                if (dec_ret == l_Undef) {
+                    continue;
+                }
+            }
             if (dec_ret != l_Undef) {
                 dump_search_loop_stats(myTime);
                 return dec_ret;
@@ -1349,6 +1540,10 @@ void Searcher::check_need_restart()
             params.needToStopSearch = true;
         }
 
+        if (terminate_cb != NULL && terminate_cb(terminate_cb_state)) {
+            set_must_interrupt_asap();
+        }
+
         if (must_interrupt_asap())  {
             if (conf.verbosity >= 3)
                 cout << "c must_interrupt_asap() is set, restartig as soon as possible!" << endl;
@@ -1422,7 +1617,7 @@ void Searcher::add_otf_subsume_long_clauses()
             if (decisionLevel() == 0) {
                 *drat << add << cl[0]
                 #ifdef STATS_NEEDED
-                << cl.stats.ID
+                << cl_alloc.stats(cl).ID
                 << sumConflicts
                 #endif
                 << fin;
@@ -1549,9 +1744,194 @@ void Searcher::update_history_stats(size_t backtrack_level, uint32_t glue)
     hist.glueHist.push(glue);
 }
 
+void Searcher::set_terminate_callback(int (*terminate)(void* state), void* state)
+{
+    terminate_cb = terminate;
+    terminate_cb_state = state;
+}
+
+void Searcher::set_learn_callback(
+    void (*learn)(void* state, const vector<Lit>& clause)
+    , void* state
+    , uint32_t max_len
+) {
+    learn_cb = learn;
+    learn_cb_state = state;
+    learn_cb_max_len = max_len;
+}
+
+void Searcher::set_enum_callback(
+    bool (*model_found)(void* state, const vector<lbool>& values)
+    , void* state
+    , const vector<uint32_t>* vars
+) {
+    enum_cb = model_found;
+    enum_cb_state = state;
+    enum_vars = vars;
+}
+
+/**
+@brief Maps the projection to the current internal numbering
+
+Must be redone every time solve() is called, simplification in between may
+have renumbered or replaced the variables.
+*/
+void Searcher::enum_setup()
+{
+    enum_proj_lits.clear();
+    enum_proj_vars.clear();
+    enum_is_proj.clear();
+    enum_is_proj.resize(nVarsOuter(), 0);
+    for(const uint32_t outside_var: *enum_vars) {
+        Lit lit = Lit(map_to_with_bva(outside_var), false);
+        lit = solver->varReplacer->get_lit_replaced_with_outer(lit);
+        lit = map_outer_to_inter(lit);
+        assert(varData[lit.var()].removed == Removed::none);
+        enum_proj_lits.push_back(lit);
+
+        //Vars beyond nVars() have been set at level 0
+        if (lit.var() < nVars() && !enum_is_proj[lit.var()]) {
+            enum_is_proj[lit.var()] = 1;
+            enum_proj_vars.push_back(lit.var());
+        }
+    }
+    enum_decide_at = 0;
+    enum_decide_lev = 0;
+}
+
+/**
+@brief Decides on the projected variables before any other
+
+This way every decision up to the level where the last projected variable got
+set is on a projected variable, and their negation blocks the projected model.
+enum_decide_at skips the projected vars that were set at or below
+enum_decide_lev.
+*/
+Lit Searcher::enum_pick_branch_lit()
+{
+    if (decisionLevel() < enum_decide_lev) {
+        enum_decide_at = 0;
+    }
+    enum_decide_lev = decisionLevel();
+
+    for(; enum_decide_at < enum_proj_vars.size(); enum_decide_at++) {
+        const uint32_t var = enum_proj_vars[enum_decide_at];
+        if (value(var) == l_Undef) {
+            return Lit(var, !pick_polarity(var));
+        }
+    }
+    return lit_Undef;
+}
+
+/**
+@brief Reports the projected model and blocks it, continuing the search
+
+@returns l_Undef to carry on searching, l_True if the callback asked to stop
+         and l_False if there are no more models
+*/
+lbool Searcher::enum_model_found()
+{
+    enum_values.clear();
+    uint32_t max_lev = 0;
+    for(const Lit lit: enum_proj_lits) {
+        assert(value(lit) != l_Undef);
+        enum_values.push_back(value(lit));
+        max_lev = std::max(max_lev, varData[lit.var()].level);
+    }
+    if (!enum_cb(enum_cb_state, enum_values)) {
+        return l_True;
+    }
+
+    //All projected vars are set at level 0, this was the only model
+    if (max_lev == 0) {
+        ok = false;
+        return l_False;
+    }
+
+    //The decisions up to max_lev imply the projected values, so their
+    //negation is the shortest blocking clause. Fall back to the negated
+    //projected values if a non-projected var was decided on.
+    enum_blocking.clear();
+    for(uint32_t lev = 0; lev < max_lev; lev++) {
+        const Lit dec = trail[trail_lim[lev]];
+        if (!enum_is_proj[dec.var()]) {
+            enum_blocking.clear();
+            for(const uint32_t var: enum_proj_vars) {
+                if (varData[var].level > 0) {
+                    enum_blocking.push_back(Lit(var, value(var) == l_True));
+                }
+            }
+            break;
+        }
+        enum_blocking.push_back(~dec);
+    }
+    std::sort(enum_blocking.begin(), enum_blocking.end(),
+        [&](const Lit a, const Lit b) {
+            return varData[a.var()].level > varData[b.var()].level;
+    });
+
+    if (enum_blocking.size() == 1) {
+        cancelUntil(0);
+        enqueue(enum_blocking[0]);
+        return l_Undef;
+    }
+
+    //Backjump so that the clause becomes unit, or if the two highest
+    //levels are the same, so that both of them become unassigned
+    const uint32_t lev0 = varData[enum_blocking[0].var()].level;
+    const uint32_t lev1 = varData[enum_blocking[1].var()].level;
+    const bool enq = lev0 > lev1;
+    cancelUntil(enq ? lev1 : lev0-1);
+    if (enum_blocking.size() == 2) {
+        solver->attach_bin_clause(enum_blocking[0], enum_blocking[1], false);
+        if (enq) enqueue(enum_blocking[0], PropBy(enum_blocking[1], false));
+    } else {
+        Clause* cl = cl_alloc.Clause_new(enum_blocking
+        , sumConflicts
+        #ifdef STATS_NEEDED
+        , clauseID++
+        #endif
+        );
+        const ClOffset offset = cl_alloc.get_offset(cl);
+        longIrredCls.push_back(offset);
+        solver->attachClause(*cl);
+        if (enq) enqueue(enum_blocking[0], PropBy(offset));
+    }
+
+    return l_Undef;
+}
+
+/**
+@brief Passes learnt_clause to the learn callback, in outside numbering
+
+Clauses with BVA variables are skipped, the user doesn't know about them.
+*/
+void Searcher::call_learn_cb()
+{
+    //BVA only ever adds new variables, so the map only changes with nVarsOuter
+    if (learn_cb_outer_to_without_bva.size() != nVarsOuter()) {
+        learn_cb_outer_to_without_bva = build_outer_to_without_bva_map();
+    }
+
+    learn_cb_clause.clear();
+    for(const Lit lit: learnt_clause) {
+        if (varData[lit.var()].is_bva) {
+            return;
+        }
+        const Lit outer = map_inter_to_outer(lit);
+        learn_cb_clause.push_back(
+            Lit(learn_cb_outer_to_without_bva[outer.var()], outer.sign()));
+    }
+    learn_cb(learn_cb_state, learn_cb_clause);
+}
+
 template<bool update_bogoprops>
 void Searcher::attach_and_enqueue_learnt_clause(Clause* cl, bool enq)
 {
+    if (learn_cb != NULL && learnt_clause.size() <= learn_cb_max_len) {
+        call_learn_cb();
+    }
+
     switch (learnt_clause.size()) {
         case 0:
             assert(false);
@@ -1581,12 +1961,13 @@ void Searcher::attach_and_enqueue_learnt_clause(Clause* cl, bool enq)
         default:
             //Long learnt
             stats.learntLongs++;
+            solver->datasync->signal_new_long_clause(learnt_clause, cl_alloc.stats(cl).glue);
             solver->attachClause(*cl, enq);
             if (enq) enqueue(learnt_clause[0], PropBy(cl_alloc.get_offset(cl)));
             bump_cl_act<update_bogoprops>(cl);
 
             #ifdef STATS_NEEDED
-            cl->stats.antec_data = antec_data;
+            cl_alloc.stats(cl).antec_data = antec_data;
             propStats.propsLongRed++;
             #endif
 
@@ -1683,7 +2064,6 @@ Clause* Searcher::handle_last_confl_otf_subsumption(
 ) {
     if (learnt_clause.size() <= 2 ||
         cl == NULL ||
-        cl->gauss_temp_cl() ||
         !conf.doOTFSubsume
     ) {
         //Cannot make a non-implicit into an implicit
@@ -1702,7 +2082,8 @@ Clause* Searcher::handle_last_confl_otf_subsumption(
             , clauseID
             #endif
             );
-            cl->makeRed(glue);
+            cl->makeRed();
+            cl_alloc.stats(cl).glue = glue;
             ClOffset offset = cl_alloc.get_offset(cl);
             unsigned which_arr = 2;
 
@@ -1722,15 +2103,15 @@ Clause* Searcher::handle_last_confl_otf_subsumption(
             }
 
             /*if (conf.guess_cl_effectiveness) {
-                unsigned lower_it = guess_clause_array(cl->stats, decisionLevel());
+                unsigned lower_it = guess_clause_array(cl_alloc.stats(cl), decisionLevel());
                 if (lower_it) {
                     stats.guess_different++;
-                    cl->stats.ttl = 1;
+                    cl_alloc.stats(cl).ttl = 1;
                 }
             }*/
 
-            cl->stats.which_red_array = which_arr;
-            solver->longRedCls[cl->stats.which_red_array].push_back(offset);
+            cl_alloc.stats(cl).which_red_array = which_arr;
+            solver->longRedCls[cl_alloc.stats(cl).which_red_array].push_back(offset);
             *drat << add << *cl
             #ifdef STATS_NEEDED
             << sumConflicts
@@ -1752,11 +2133,11 @@ Clause* Searcher::handle_last_confl_otf_subsumption(
         assert(cl->size() == learnt_clause.size());
 
         //Update stats
-        if (cl->red() && cl->stats.glue > glue) {
-            cl->stats.glue = glue;
+        if (cl->red() && cl_alloc.stats(cl).glue > glue) {
+            cl_alloc.stats(cl).glue = glue;
         }
         #ifdef STATS_NEEDED
-        cl->stats.ID = clauseID;
+        cl_alloc.stats(cl).ID = clauseID;
         #endif
 
         *(solver->drat) << add << *cl
@@ -1780,7 +2161,7 @@ Clause* Searcher::handle_last_confl_otf_subsumption(
 
         if (dump_this_many_cldata_in_stream >= 0) {
             if (cl) {
-                cl->stats.dump_number = 0;
+                cl_alloc.stats(cl).dump_number = 0;
             }
             dump_this_many_cldata_in_stream--;
             dump_sql_clause_data(
@@ -1884,7 +2265,7 @@ bool Searcher::handle_conflict(const PropBy confl)
     }
 
     if (!update_bogoprops) {
-        if (VSIDS) {
+        if (VSIDS && !VMTF) {
             varDecayActivity();
         }
         decayClauseAct<update_bogoprops>();
@@ -2123,6 +2504,7 @@ void Searcher::rebuildOrderHeap()
     }
     order_heap_vsids.build(vs);
     order_heap_maple.build(vs);
+    vmtf_queue.reset_search();
 }
 
 inline void Searcher::dump_search_loop_stats(double myTime)
@@ -2203,6 +2585,11 @@ lbool Searcher::solve(
     }
 
     resetStats();
+    if (enum_cb != NULL) {
+        enum_setup();
+    }
+    //Unassignments done while branching on the heaps were not tracked
+    vmtf_queue.reset_search();
     lbool status = l_Undef;
     if (VSIDS) {
         if (conf.restartType == Restart::geom) {
@@ -2267,6 +2654,10 @@ lbool Searcher::solve(
             goto end;
         }
 
+        if (status == l_Undef && !conf.checkpoint_file.empty()) {
+            solver->checkpoint_if_due();
+        }
+
         if (status == l_Undef &&
             solver->conf.do_distill_clauses &&
             sumConflicts > next_distill
@@ -2488,6 +2879,12 @@ Lit Searcher::pickBranchLit()
     #endif
 
     Lit next = lit_Undef;
+    if (enum_cb != NULL) {
+        next = enum_pick_branch_lit();
+        if (next != lit_Undef) {
+            return next;
+        }
+    }
 
     // Random decision:
     Heap<VarOrderLt> &order_heap = VSIDS ? order_heap_vsids : order_heap_maple;
@@ -2506,6 +2903,25 @@ Lit Searcher::pickBranchLit()
         }
     }
 
+    if (next == lit_Undef && VMTF) {
+        const auto skip = [&](const uint32_t var) {
+            return value(var) != l_Undef
+                || varData[var].removed != Removed::none;
+        };
+        uint32_t v = vmtf_queue.pick(skip);
+        if (v == var_Undef) {
+            //Make sure nothing unassigned outside cancelUntil() was missed
+            vmtf_queue.reset_search();
+            v = vmtf_queue.pick(skip);
+        }
+
+        //There is no more to branch on. Satisfying assignment found.
+        if (v == var_Undef) {
+            return lit_Undef;
+        }
+        next = Lit(v, !pick_polarity(v));
+    }
+
     if (next == lit_Undef) {
         uint32_t v = var_Undef;
         while (v == var_Undef || value(v) != l_Undef) {
@@ -2518,8 +2934,7 @@ Lit Searcher::pickBranchLit()
                 uint32_t v2 = order_heap_maple[0];
                 uint32_t age = sumConflicts - varData[v2].cancelled;
                 while (age > 0) {
-                    double decay = pow(0.95, age);
-                    var_act_maple[v2] *= decay;
+                    var_act_maple[v2] *= maple_decay(age);
                     if (order_heap_maple.inHeap(v2)) {
                         order_heap_maple.increase(v2);
                     }
@@ -2806,7 +3221,8 @@ llbool Searcher::Gauss_elimination()
     }
 
     llbool finret = l_Nothing;
-    for (GaussQData& gqd: gqueuedata) {
+    for (size_t g = 0; g < gqueuedata.size(); g++) {
+        GaussQData& gqd = gqueuedata[g];
         if (gqd.enter_matrix) {
             gqueuedata[0].big_gaussnum++;
             sum_EnGauss++;
@@ -2842,20 +3258,10 @@ llbool Searcher::Gauss_elimination()
                 gqd.big_conflict++;
                 sum_Enconflict++;
 
-                Clause* conflPtr = solver->cl_alloc.Clause_new(
-                    gqd.conflict_clause_gauss,
-                    gqd.xorEqualFalse_gauss
-                    #ifdef STATS_NEEDED
-                    , clauseID++
-                    #endif
-                );
-
-                conflPtr->set_gauss_temp_cl();
-                gqd.confl = PropBy(solver->cl_alloc.get_offset(conflPtr));
+                gqd.confl = gmatrixes[g]->add_conflict_reason(gqd.conflict_clause_gauss);
                 gqhead = qhead = trail.size();
 
                 bool ret = handle_conflict<false>(gqd.confl);
-                solver->cl_alloc.clauseFree(gqd.confl.get_offset());
                 if (!ret) return l_False;
                 return l_Continue;
             }
@@ -2984,6 +3390,7 @@ size_t Searcher::mem_used() const
     mem += var_act_maple.capacity()*sizeof(uint32_t);
     mem += order_heap_vsids.mem_used();
     mem += order_heap_maple.mem_used();
+    mem += vmtf_queue.mem_used();
     mem += learnt_clause.capacity()*sizeof(Lit);
     mem += hist.mem_used();
     mem += conflict.capacity()*sizeof(Lit);
@@ -3028,6 +3435,11 @@ size_t Searcher::mem_used() const
         << order_heap_maple.mem_used()
         << endl;
 
+        cout
+        << "c vmtf_queue bytes: "
+        << vmtf_queue.mem_used()
+        << endl;
+
         cout
         << "c learnt clause bytes: "
         << learnt_clause.capacity()*sizeof(Lit)
@@ -3181,7 +3593,7 @@ void Searcher::write_long_cls(
         }
         if (red) {
             assert(cl.red());
-            f.put_struct(cl.stats);
+            f.put_struct(cl_alloc.stats(cl));
         }
     }
 }
@@ -3214,14 +3626,14 @@ void Searcher::read_long_cls(
         #endif
         );
         if (red) {
-            cl->makeRed(cl_stats.glue, cla_inc);
+            cl->makeRed();
         }
-        cl->stats = cl_stats;
+        cl_alloc.stats(cl) = cl_stats;
         attachClause(*cl);
         const ClOffset offs = cl_alloc.get_offset(cl);
         if (red) {
-            assert(cl->stats.which_red_array < longRedCls.size());
-            longRedCls[cl->stats.which_red_array].push_back(offs);
+            assert(cl_alloc.stats(cl).which_red_array < longRedCls.size());
+            longRedCls[cl_alloc.stats(cl).which_red_array].push_back(offs);
             litStats.redLits += cl->size();
         } else {
             longIrredCls.push_back(offs);
@@ -3321,6 +3733,52 @@ void Searcher::load_state(SimpleInFile& f, const lbool status)
     }
 }
 
+//Scalars steering the search: conflict count (that all schedules and clause
+//stats are relative to), activity bumping, DB cleaning schedule and the
+//long-term restart history. Used for checkpoints, per-var and per-clause
+//data is written by Solver in outside numbering.
+void Searcher::save_search_state(SimpleOutFile& f) const
+{
+    f.put_uint64_t(sumConflicts);
+    f.put_struct(var_inc_vsids);
+    f.put_struct(var_decay_vsids);
+    f.put_struct(step_size);
+    f.put_struct(cla_inc);
+    f.put_uint64_t(next_lev1_reduce);
+    f.put_uint64_t(next_lev2_reduce);
+    f.put_uint64_t(next_distill);
+    f.put_uint64_t(luby_loop_num);
+
+    f.put_struct(hist.backtrackLevelHistLT);
+    f.put_struct(hist.trailDepthHistLT);
+    f.put_struct(hist.vsidsVarsAvgLT);
+    f.put_struct(hist.glueHistLTLimited);
+    f.put_struct(hist.glueHistLTAll);
+    f.put_struct(hist.conflSizeHistLT);
+    f.put_struct(hist.numResolutionsHistLT);
+}
+
+void Searcher::load_search_state(SimpleInFile& f)
+{
+    assert(decisionLevel() == 0);
+    sumConflicts = f.get_uint64_t();
+    f.get_struct(var_inc_vsids);
+    f.get_struct(var_decay_vsids);
+    f.get_struct(step_size);
+    f.get_struct(cla_inc);
+    next_lev1_reduce = f.get_uint64_t();
+    next_lev2_reduce = f.get_uint64_t();
+    next_distill = f.get_uint64_t();
+    luby_loop_num = f.get_uint64_t();
+
+    f.get_struct(hist.backtrackLevelHistLT);
+    f.get_struct(hist.trailDepthHistLT);
+    f.get_struct(hist.vsidsVarsAvgLT);
+    f.get_struct(hist.glueHistLTLimited);
+    f.get_struct(hist.glueHistLTAll);
+    f.get_struct(hist.conflSizeHistLT);
+    f.get_struct(hist.numResolutionsHistLT);
+}
 
 //Normal running
 template
@@ -3367,17 +3825,28 @@ void Searcher::cancelUntil(uint32_t level)
             const uint32_t var = trail[sublevel].var();
             assert(value(var) != l_Undef);
 
-             if (!update_bogoprops && !VSIDS) {
+            if (!update_bogoprops && !VSIDS) {
                 assert(sumConflicts >= varData[var].last_picked);
+                const double old_activity = var_act_maple[var];
+                double activity = old_activity;
+
+                //Decay for the time it was unassigned before it got
+                //propagated. Done here so enqueue() needs no heap update
+                if (varData[var].last_picked > varData[var].cancelled) {
+                    activity *= maple_decay(varData[var].last_picked - varData[var].cancelled);
+                }
+
                 uint32_t age = sumConflicts - varData[var].last_picked;
                 if (age > 0) {
                     //adjusted reward -> higher if conflicted more or quicker
                     double adjusted_reward = ((double)(varData[var].conflicted)) / ((double)age);
+                    activity = step_size * adjusted_reward + ((1.0 - step_size) * activity);
+                }
 
-                    double old_activity = var_act_maple[var];
-                    var_act_maple[var] = step_size * adjusted_reward + ((1.0 - step_size) * old_activity);
+                if (activity != old_activity) {
+                    var_act_maple[var] = activity;
                     if (order_heap_maple.inHeap(var)) {
-                        if (var_act_maple[var] > old_activity)
+                        if (activity > old_activity)
                             order_heap_maple.decrease(var);
                         else
                             order_heap_maple.increase(var);
@@ -3388,7 +3857,11 @@ void Searcher::cancelUntil(uint32_t level)
 
             assigns[var] = l_Undef;
             if (do_insert_var_order) {
-                insert_var_order(var);
+                if (VMTF) {
+                    vmtf_queue.unassigned(var);
+                } else {
+                    insert_var_order(var);
+                }
             }
         }
         qhead = trail_lim[level];
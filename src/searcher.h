@@ -190,6 +190,21 @@ class Searcher : public HyperEngine
             bool True_confl
         );
 
+        //Callbacks, see SATSolver::set_terminate_callback() and
+        //SATSolver::set_learn_callback()
+        void set_terminate_callback(int (*terminate)(void* state), void* state);
+        void set_learn_callback(
+            void (*learn)(void* state, const vector<Lit>& clause)
+            , void* state
+            , uint32_t max_len
+        );
+        //Projected model enumeration, see Solver::set_model_enumeration()
+        void set_enum_callback(
+            bool (*model_found)(void* state, const vector<lbool>& values)
+            , void* state
+            , const vector<uint32_t>* vars
+        );
+
     protected:
         void new_var(const bool bva, const uint32_t orig_outer) override;
         void new_vars(const size_t n) override;
@@ -201,6 +216,8 @@ class Searcher : public HyperEngine
         );
         void save_state(SimpleOutFile& f, const lbool status) const;
         void load_state(SimpleInFile& f, const lbool status);
+        void save_search_state(SimpleOutFile& f) const;
+        void load_search_state(SimpleInFile& f);
         void write_long_cls(
             const vector<ClOffset>& clauses
             , SimpleOutFile& f
@@ -362,6 +379,33 @@ class Searcher : public HyperEngine
         double   var_decay_vsids;
 
     private:
+        //////////////
+        // Callbacks
+        int (*terminate_cb)(void* state) = NULL;
+        void* terminate_cb_state = NULL;
+        void (*learn_cb)(void* state, const vector<Lit>& clause) = NULL;
+        void* learn_cb_state = NULL;
+        uint32_t learn_cb_max_len = 0;
+        vector<Lit> learn_cb_clause;
+        vector<uint32_t> learn_cb_outer_to_without_bva;
+        void call_learn_cb();
+
+        //////////////
+        // Projected model enumeration
+        bool (*enum_cb)(void* state, const vector<lbool>& values) = NULL;
+        void* enum_cb_state = NULL;
+        const vector<uint32_t>* enum_vars = NULL; ///<projection, outside numbering
+        vector<Lit> enum_proj_lits; ///<one per var in enum_vars, inter numbering
+        vector<uint32_t> enum_proj_vars; ///<the vars of enum_proj_lits, no duplicates
+        vector<char> enum_is_proj;
+        vector<lbool> enum_values;
+        vector<Lit> enum_blocking;
+        size_t enum_decide_at = 0;
+        uint32_t enum_decide_lev = 0;
+        void enum_setup();
+        Lit enum_pick_branch_lit();
+        lbool enum_model_found();
+
         //////////////
         // Conflict minimisation
         bool litRedundant(Lit p, uint32_t abstract_levels);
@@ -379,6 +423,9 @@ class Searcher : public HyperEngine
         template<bool update_bogoprops>
         Clause* add_literals_from_confl_to_learnt(const PropBy confl, const Lit p);
         void debug_print_resolving_clause(const PropBy confl) const;
+        #ifdef USE_GAUSS
+        const vector<Lit>& get_xor_reason(const PropBy& reason);
+        #endif
         template<bool update_bogoprops>
         void add_lit_to_learnt(Lit lit);
         void analyze_final_confl_with_assumptions(const Lit p, vector<Lit>& out_conflict);
@@ -415,6 +462,9 @@ class Searcher : public HyperEngine
         };
         friend class Gaussian;
         friend class DistillerLong;
+        #ifdef CMS_BENCH_ENABLED
+        friend struct BenchAccess;
+        #endif
         #ifdef CMS_TESTING_ENABLED
         FRIEND_TEST(SearcherTest, pickpolar_rnd);
         FRIEND_TEST(SearcherTest, pickpolar_pos);
@@ -522,6 +572,7 @@ inline void Searcher::insert_var_order_all(const uint32_t x)
 
         order_heap_maple.insert(x);
     }
+    vmtf_queue.unassigned(x);
 }
 
 template<bool update_bogoprops>
@@ -532,18 +583,18 @@ inline void Searcher::bump_cl_act(Clause* cl)
 
     assert(!cl->getRemoved());
 
-    double new_val = cla_inc + (double)cl->stats.activity;
-    cl->stats.activity = (float)new_val;
-    if (cl->stats.activity > 1e20F ) {
+    double new_val = cla_inc + (double)cl_alloc.stats(cl).activity;
+    cl_alloc.stats(cl).activity = (float)new_val;
+    if (cl_alloc.stats(cl).activity > 1e20F ) {
         // Rescale. For STATS_NEEDED we rescale ALL
         #ifndef STATS_NEEDED
         for(ClOffset offs: longRedCls[2]) {
-            cl_alloc.ptr(offs)->stats.activity *= static_cast<float>(1e-20);
+            cl_alloc.stats(cl_alloc.ptr(offs)).activity *= static_cast<float>(1e-20);
         }
         #else
         for(auto& lrcs: longRedCls) {
             for(ClOffset offs: lrcs) {
-                cl_alloc.ptr(offs)->stats.activity *= static_cast<float>(1e-20);
+                cl_alloc.stats(cl_alloc.ptr(offs)).activity *= static_cast<float>(1e-20);
             }
         }
         #endif
@@ -24,9 +24,12 @@ THE SOFTWARE.
 #define SHARED_DATA_H
 
 #include "cryptominisat5/solvertypesmini.h"
+#include "constants.h"
 
 #include <vector>
 #include <mutex>
+#include <atomic>
+#include <limits>
 using std::vector;
 using std::mutex;
 
@@ -35,57 +38,144 @@ namespace CMSat {
 class SharedData
 {
     public:
-        SharedData(const uint32_t _num_threads) :
+        SharedData(const uint32_t _num_threads, const uint32_t bin_ring_size_log2) :
             num_threads(_num_threads)
-        {}
+        {
+            //2^4 entries is the least that's useful, 2^30 is already 8GB per thread
+            release_assert(bin_ring_size_log2 >= 4 && bin_ring_size_log2 <= 30);
+            for(uint32_t i = 0; i < num_threads; i++) {
+                bin_rings.push_back(new BinRing(bin_ring_size_log2));
+            }
+        }
 
-        struct Spec {
-            Spec() :
-                data(new vector<Lit>)
-            {}
+        ~SharedData()
+        {
+            for(BinRing* r: bin_rings) {
+                delete r;
+            }
+        }
+
+        SharedData(const SharedData&) = delete;
+        SharedData& operator=(const SharedData&) = delete;
+
+        //Binary clauses published by one thread, read by all others without
+        //taking a lock. Only the owner thread writes, and it publishes
+        //the new entries by moving "head" forward. Each slot holds both
+        //literals packed into a single atomic word, so a slot can never be
+        //read half-written. If a reader falls more than "size" behind, the
+        //owner has already overwritten the oldest entries -- they are lost
+        //to that reader, which is fine as they are only redundant clauses.
+        struct BinRing {
+            explicit BinRing(const uint32_t size_log2) :
+                mask((1ULL << size_log2)-1)
+                , data(1ULL << size_log2)
+            {
+                for(auto& d: data) {
+                    d.store(empty, std::memory_order_relaxed);
+                }
+            }
+
+            static const uint64_t empty = std::numeric_limits<uint64_t>::max();
+
+            static uint64_t pack(const Lit lit1, const Lit lit2)
+            {
+                return ((uint64_t)lit1.toInt() << 32) | lit2.toInt();
+            }
+
+            static Lit unpack_first(const uint64_t packed)
+            {
+                return Lit::toLit(packed >> 32);
+            }
+
+            static Lit unpack_second(const uint64_t packed)
+            {
+                return Lit::toLit(packed & 0xffffffffULL);
+            }
 
-            Spec(const Spec&) = delete;
-            Spec& operator=(const Spec&) = delete;
-            
-            Spec(Spec&& other)
-            #ifndef _MSC_VER
-            noexcept
-            #endif
-            :
-                data(std::move(other.data))
+            uint64_t size() const
             {
-                other.data = NULL;
+                return mask+1;
             }
-            ~Spec() {
-                clear();
+
+            //Only called by the owner thread
+            void push(const Lit lit1, const Lit lit2)
+            {
+                const uint64_t at = head.load(std::memory_order_relaxed);
+                data[at & mask].store(pack(lit1, lit2), std::memory_order_relaxed);
+                head.store(at+1, std::memory_order_release);
             }
-            vector<Lit>* data = NULL;
 
-            void clear()
+            uint64_t get(const uint64_t at) const
             {
-                delete data;
-                data = NULL;
+                return data[at & mask].load(std::memory_order_relaxed);
             }
+
+            const uint64_t mask;
+            vector<std::atomic<uint64_t> > data;
+            std::atomic<uint64_t> head{0};
         };
+
+        //Learnt long clauses, stored flat in "long_lits". Entries before
+        //"long_base" have been dropped to keep the buffer bounded, so
+        //the absolute index of longs[i] is long_base+i
+        struct LongCl {
+            LongCl(uint32_t _start, uint32_t _size, uint32_t _glue, uint32_t _thread) :
+                start(_start)
+                , size(_size)
+                , glue(_glue)
+                , thread(_thread)
+            {}
+
+            uint32_t start;
+            uint32_t size;
+            uint32_t glue;
+            uint32_t thread;
+        };
+
         vector<lbool> value;
-        vector<Spec> bins;
+        vector<BinRing*> bin_rings;
+        vector<Lit> long_lits;
+        vector<LongCl> longs;
+        uint64_t long_base = 0;
         std::mutex unit_mutex;
-        std::mutex bin_mutex;
+        std::mutex long_mutex;
 
         uint32_t num_threads;
 
         size_t calc_memory_use_bins()
         {
             size_t mem = 0;
-            mem += bins.capacity()*sizeof(Spec);
-            for(size_t i = 0; i < bins.size(); i++) {
-                if (bins[i].data) {
-                    mem += bins[i].data->capacity()*sizeof(Lit);
-                    mem += sizeof(vector<Lit>);
-                }
+            for(const BinRing* r: bin_rings) {
+                mem += r->data.capacity()*sizeof(uint64_t);
             }
             return mem;
         }
+
+        size_t calc_memory_use_longs()
+        {
+            size_t mem = 0;
+            mem += long_lits.capacity()*sizeof(Lit);
+            mem += longs.capacity()*sizeof(LongCl);
+            return mem;
+        }
+
+        //Drop the oldest half of the long clauses. Readers whose cursor
+        //falls before "long_base" simply skip the dropped ones
+        void shrink_longs()
+        {
+            const size_t to_drop = longs.size()/2;
+            if (to_drop == 0) {
+                return;
+            }
+
+            const uint32_t lits_drop = longs[to_drop].start;
+            long_lits.erase(long_lits.begin(), long_lits.begin() + lits_drop);
+            longs.erase(longs.begin(), longs.begin() + to_drop);
+            for(LongCl& c: longs) {
+                c.start -= lits_drop;
+            }
+            long_base += to_drop;
+        }
 };
 
 }
@@ -27,6 +27,9 @@ THE SOFTWARE.
 #include <iostream>
 #include <string>
 #include <cstdint>
+#include <cstring>
+#include <vector>
+#include <stdexcept>
 using std::ios;
 
 #include "solvertypes.h"
@@ -44,6 +47,12 @@ public:
         //outf->rdbuf()->pubsetbuf(&buffer.front(), buffer.size());
     }
 
+    //Append everything to "mem" instead of a file
+    void start(std::vector<char>* _mem)
+    {
+        mem = _mem;
+    }
+
     ~SimpleOutFile()
     {
         delete outf;
@@ -87,10 +96,15 @@ public:
 
 private:
     std::ofstream* outf = NULL;
+    std::vector<char>* mem = NULL;
     //vector<char> buffer;
 
     void put(const void* ptr, size_t num)
     {
+        if (mem) {
+            mem->insert(mem->end(), (const char*)ptr, (const char*)ptr + num);
+            return;
+        }
         outf->write((const char*)ptr, num);
     }
 };
@@ -109,6 +123,13 @@ public:
         }
     }
 
+    //Read from "mem" instead of a file. Reading past its end throws
+    void start(const std::vector<char>* _mem)
+    {
+        mem = _mem;
+        mem_at = 0;
+    }
+
     ~SimpleInFile()
     {
         delete inf;
@@ -117,14 +138,14 @@ public:
     uint32_t get_uint32_t()
     {
         uint32_t val = 0;
-        inf->read((char*)&val, 4);
+        get_raw(&val, 1, 4);
         return val;
     }
 
     uint64_t get_uint64_t()
     {
         uint64_t val = 0;
-        inf->read((char*)&val, 8);
+        get_raw(&val, 1, 8);
         return val;
     }
 
@@ -137,7 +158,7 @@ public:
     lbool get_lbool()
     {
         lbool l;
-        inf->read((char*)&l, sizeof(lbool));
+        get_raw(&l, 1, sizeof(lbool));
         return l;
     }
 
@@ -148,6 +169,9 @@ public:
         uint64_t sz = get_uint64_t();
         if (sz == 0)
             return;
+        if (mem && sz > (mem->size() - mem_at)/sizeof(T)) {
+            throw std::runtime_error("vector past the end of the data");
+        }
 
         d.resize(sz);
         get_raw(&d[0], d.size(), sizeof(T));
@@ -156,14 +180,25 @@ public:
     template<class T>
     void get_struct(T& d)
     {
-        inf->read((char*)&d, sizeof(T));
+        get_raw(&d, 1, sizeof(T));
     }
 
 private:
     std::ifstream* inf = NULL;
+    const std::vector<char>* mem = NULL;
+    size_t mem_at = 0;
 
     void get_raw(void* ptr, size_t num, size_t elem_sz)
     {
+        if (mem) {
+            const size_t len = num*elem_sz;
+            if (len > mem->size() - mem_at) {
+                throw std::runtime_error("read past the end of the data");
+            }
+            memcpy(ptr, mem->data() + mem_at, len);
+            mem_at += len;
+            return;
+        }
         inf->read((char*)ptr, num*elem_sz);
     }
 };
@@ -32,6 +32,8 @@ THE SOFTWARE.
 #include <vector>
 #include <complex>
 #include <locale>
+#include <stdexcept>
+#include <chrono>
 
 #include "varreplacer.h"
 #include "time_mem.h"
@@ -66,6 +68,7 @@ THE SOFTWARE.
 #include "drat.h"
 #include "xorfinder.h"
 #include "sls.h"
+#include "checkpoint.h"
 
 using namespace CMSat;
 using std::cout;
@@ -81,6 +84,12 @@ using std::endl;
 
 //#define DEBUG_IMPLICIT_PAIRS_TRIPLETS
 
+static double wall_time()
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 Solver::Solver(const SolverConf *_conf, std::atomic<bool>* _must_interrupt_inter) :
     Searcher(_conf, this, _must_interrupt_inter)
 {
@@ -130,6 +139,7 @@ Solver::~Solver()
     delete subsumeImplicit;
     delete datasync;
     delete reduceDB;
+    delete checkpoint_writer;
 }
 
 void Solver::set_sqlite(string
@@ -152,10 +162,21 @@ void Solver::set_sqlite(string
     #endif
 }
 
-void Solver::set_shared_data(SharedData* shared_data)
+//Rows written by this thread are tagged with "thread_num"
+void Solver::share_sqlite(const Solver* main_solver, const uint32_t thread_num)
+{
+    assert(main_solver->sqlStats != NULL);
+    delete sqlStats;
+    sqlStats = main_solver->sqlStats->new_for_thread(thread_num);
+    if (!sqlStats->setup(this)) {
+        exit(-1);
+    }
+}
+
+void Solver::set_shared_data(SharedData* shared_data, uint32_t thread_num)
 {
     delete datasync;
-    datasync = new DataSync(this, shared_data);
+    datasync = new DataSync(this, shared_data, thread_num);
 }
 
 bool Solver::add_xor_clause_inter(
@@ -448,11 +469,11 @@ Clause* Solver::add_clause_int(
             #endif
             );
             if (red) {
-                c->makeRed(cl_stats.glue);
+                c->makeRed();
             }
-            c->stats = cl_stats;
+            cl_alloc.stats(c) = cl_stats;
             #ifdef STATS_NEEDED
-            c->stats.introduced_at_conflict = introduced_at_conflict;
+            cl_alloc.stats(c).introduced_at_conflict = introduced_at_conflict;
             #endif
 
             //In class 'OccSimplifier' we don't need to attach normall
@@ -519,6 +540,15 @@ void Solver::detachClause(const Clause& cl, const bool removeDrat)
     }
 
     assert(cl.size() > 2);
+    #ifdef INLINE_TERNARY
+    //Watched in c[2] too, unless it was shrunk to 3 while attached
+    if (cl.size() == 3) {
+        const ClOffset offset = cl_alloc.get_offset(&cl);
+        if (findWCl(watches[cl[2]], offset)) {
+            removeWCl(watches[cl[2]], offset);
+        }
+    }
+    #endif
     detach_modified_clause(cl[0], cl[1], cl.size(), &cl);
 }
 
@@ -643,13 +673,7 @@ bool Solver::addClauseHelper(vector<Lit>& ps)
     return true;
 }
 
-bool Solver::addClause(const vector<Lit>& lits, bool red)
-{
-    vector<Lit> ps = lits;
-    return Solver::addClauseInt(ps, red);
-}
-
-bool Solver::addClauseInt(vector<Lit>& ps, bool red)
+void Solver::check_no_blocked_clauses() const
 {
     if (conf.perform_occur_based_simp && occsimplifier->getAnythingHasBeenBlocked()) {
         std::cerr
@@ -658,6 +682,21 @@ bool Solver::addClauseInt(vector<Lit>& ps, bool red)
         << endl;
         std::exit(-1);
     }
+}
+
+bool Solver::addClause(const vector<Lit>& lits, bool red)
+{
+    vector<Lit> ps = lits;
+    return Solver::addClauseInt(ps, red);
+}
+
+bool Solver::addClauseInt(
+    vector<Lit>& ps
+    , const bool red
+    , const ClauseStats* red_stats
+) {
+    assert(red_stats == NULL || red);
+    check_no_blocked_clauses();
 
     #ifdef VERBOSE_DEBUG
     cout << "Adding clause " << ps << endl;
@@ -678,7 +717,7 @@ bool Solver::addClauseInt(vector<Lit>& ps, bool red)
     Clause *cl = add_clause_int(
         ps
         , red
-        , ClauseStats() //default stats
+        , red_stats ? *red_stats : ClauseStats()
         , true //yes, attach
         , pFinalCl
         , false //add drat?
@@ -714,16 +753,20 @@ bool Solver::addClauseInt(vector<Lit>& ps, bool red)
         ClOffset offset = cl_alloc.get_offset(cl);
         if (!red) {
             longIrredCls.push_back(offset);
+        } else if (red_stats) {
+            //Keep the tier the clause was in
+            assert(cl_alloc.stats(cl).which_red_array < longRedCls.size());
+            longRedCls[cl_alloc.stats(cl).which_red_array].push_back(offset);
         } else {
-            cl->stats.which_red_array = 2;
-            if (cl->stats.glue <= conf.glue_put_lev0_if_below_or_eq) {
-                cl->stats.which_red_array = 0;
-            } else if (cl->stats.glue <= conf.glue_put_lev1_if_below_or_eq
+            cl_alloc.stats(cl).which_red_array = 2;
+            if (cl_alloc.stats(cl).glue <= conf.glue_put_lev0_if_below_or_eq) {
+                cl_alloc.stats(cl).which_red_array = 0;
+            } else if (cl_alloc.stats(cl).glue <= conf.glue_put_lev1_if_below_or_eq
                 && conf.glue_put_lev1_if_below_or_eq != 0
             ) {
-                cl->stats.which_red_array = 1;
+                cl_alloc.stats(cl).which_red_array = 1;
             }
-            longRedCls[cl->stats.which_red_array].push_back(offset);
+            longRedCls[cl_alloc.stats(cl).which_red_array].push_back(offset);
         }
     }
 
@@ -1363,7 +1406,7 @@ void Solver::check_config_parameters() const
     check_xor_cut_config_sanity();
 }
 
-lbool Solver::simplify_problem_outside()
+lbool Solver::simplify_problem_outside(const bool startup)
 {
     #ifdef SLOW_DEBUG
     if (ok) {
@@ -1392,7 +1435,7 @@ lbool Solver::simplify_problem_outside()
     if (nVars() > 0 && conf.do_simplify_problem) {
         bool backup = conf.doSLS;
         conf.doSLS = false;
-        status = simplify_problem(false);
+        status = simplify_problem(startup && !conf.full_simplify_at_startup);
         conf.doSLS = backup;
     }
     unfill_assumptions_set_from(assumptions);
@@ -1426,6 +1469,7 @@ lbool Solver::solve_with_assumptions(
     max_confl_phase = conf.restart_first;
     max_confl_this_phase = max_confl_phase;
     VSIDS = true;
+    VMTF = conf.vmtf;
     var_decay_vsids = conf.var_decay_vsids_start;
     step_size = conf.orig_step_size;
     conf.global_timeout_multiplier = conf.orig_global_timeout_multiplier;
@@ -1456,6 +1500,23 @@ lbool Solver::solve_with_assumptions(
     datasync->rebuild_bva_map();
     set_assumptions();
 
+    if (enum_user_cb != NULL && !enum_undo_removed_sampling_vars()) {
+        status = l_False;
+        goto end;
+    }
+
+    if (!conf.checkpoint_file.empty()) {
+        if (!checkpoint_tried_load && can_checkpoint()) {
+            checkpoint_tried_load = true;
+            load_checkpoint();
+            if (!okay()) {
+                status = l_False;
+                goto end;
+            }
+        }
+        next_checkpoint_time = wall_time() + conf.checkpoint_every_secs;
+    }
+
     if (conf.preprocess == 2) {
         //can't do greedy undef on preproc
         conf.greedy_undef = false;
@@ -1518,6 +1579,11 @@ lbool Solver::solve_with_assumptions(
         << endl;
     }
 
+    //Interrupted or out of budget, save where we are
+    if (status == l_Undef && can_checkpoint()) {
+        write_checkpoint(true);
+    }
+
     handle_found_solution(status, only_sampling_solution);
     unfill_assumptions_set_from(assumptions);
     assumptions.clear();
@@ -1695,10 +1761,99 @@ long Solver::calc_num_confl_to_do_this_iter(const size_t iteration_num) const
     return num_conflicts_of_search;
 }
 
+/**
+@brief Makes solve_with_assumptions() enumerate the projected models
+
+Every model found is passed to model_cb with the values of the sampling vars
+(or of all vars if none are set), then blocked and the search continues from
+there. If with_model is set, get_model() is valid inside model_cb. NULL
+model_cb turns it off again.
+*/
+void Solver::set_model_enumeration(
+    bool (*model_cb)(void* state, const vector<lbool>& values)
+    , void* state
+    , const bool with_model
+    , const bool only_indep_solution
+) {
+    if (model_cb == NULL) {
+        if (enum_user_cb != NULL) {
+            conf.sampling_vars = enum_orig_sampling_vars;
+        }
+        enum_user_cb = NULL;
+        Searcher::set_enum_callback(NULL, NULL, NULL);
+        return;
+    }
+
+    if (drat->enabled() || conf.simulate_drat || conf.preprocess != 0) {
+        const char err[] = "ERROR: Model enumeration cannot be used with DRAT or preprocessing";
+        std::cerr << err << endl;
+        throw std::runtime_error(err);
+    }
+
+    enum_user_cb = model_cb;
+    enum_user_state = state;
+    enum_with_model = with_model;
+    enum_only_indep_solution = only_indep_solution;
+
+    //Projecting to all vars also keeps them from being eliminated
+    enum_orig_sampling_vars = conf.sampling_vars;
+    if (conf.sampling_vars == NULL) {
+        enum_all_vars.clear();
+        for(uint32_t i = 0; i < nVarsOutside(); i++) {
+            enum_all_vars.push_back(i);
+        }
+        conf.sampling_vars = &enum_all_vars;
+    }
+    Searcher::set_enum_callback(enum_model_found_cb, this, conf.sampling_vars);
+}
+
+bool Solver::enum_model_found_cb(void* state, const vector<lbool>& values)
+{
+    Solver* s = (Solver*)state;
+    if (s->enum_with_model) {
+        s->model = s->assigns;
+        s->extend_solution(s->enum_only_indep_solution);
+    }
+    return s->enum_user_cb(s->enum_user_state, values);
+}
+
+/**
+@brief Brings back the projected vars that were decomposed or eliminated
+
+The search can only decide on, and block, vars that are still in the problem.
+*/
+bool Solver::enum_undo_removed_sampling_vars()
+{
+    bool readd = false;
+    for(const uint32_t outside_var: *conf.sampling_vars) {
+        uint32_t outer_var = map_to_with_bva(outside_var);
+        outer_var = varReplacer->get_var_replaced_with_outer(outer_var);
+        const uint32_t int_var = map_outer_to_inter(outer_var);
+        readd |= varData[int_var].removed == Removed::decomposed;
+    }
+    if (readd && compHandler) {
+        compHandler->readdRemovedClauses();
+    }
+
+    for(const uint32_t outside_var: *conf.sampling_vars) {
+        uint32_t outer_var = map_to_with_bva(outside_var);
+        outer_var = varReplacer->get_var_replaced_with_outer(outer_var);
+        const uint32_t int_var = map_outer_to_inter(outer_var);
+        if (varData[int_var].removed == Removed::elimed
+            && !occsimplifier->uneliminate(int_var)
+        ) {
+            return false;
+        }
+    }
+
+    return okay();
+}
+
 lbool Solver::iterate_until_solved()
 {
     size_t iteration_num = 0;
     VSIDS = true;
+    VMTF = conf.vmtf;
 
     lbool status = l_Undef;
     while (status == l_Undef
@@ -1762,6 +1917,7 @@ lbool Solver::iterate_until_solved()
             //so that in case of reconfiguration, VSIDS is correctly set
             VSIDS = true;
         }
+        VMTF = VSIDS && conf.vmtf;
     }
     #ifdef USE_GAUSS
     clearEnGaussMatrixes();
@@ -1914,6 +2070,7 @@ lbool Solver::execute_inprocess_strategy(
         } else if (token == "sls") {
             assert(conf.sls_every_n > 0);
             if (conf.doSLS
+                && enum_user_cb == NULL
                 && solveStats.num_simplify % conf.sls_every_n == (conf.sls_every_n-1)
             ) {
                 SLS sls(this);
@@ -2132,6 +2289,14 @@ void CMSat::Solver::print_stats(const double cpu_time, const double cpu_time_tot
     } else {
         print_min_stats(cpu_time, cpu_time_total);
     }
+
+    if (drat->enabled()) {
+        drat->print_stats();
+    }
+
+    if (checkpoint_writer) {
+        checkpoint_writer->get_stats().print();
+    }
 }
 
 void Solver::print_min_stats(const double cpu_time, const double cpu_time_total) const
@@ -2247,6 +2412,7 @@ void Solver::print_norm_stats(const double cpu_time, const double cpu_time_total
         , stats_line_percent(reduceDB->get_total_time(), cpu_time)
         , "% time"
     );
+    cl_alloc.get_compact_stats().print(cpu_time);
 
     //Failed lit stats
     if (conf.doProbe
@@ -2341,6 +2507,7 @@ void Solver::print_full_restart_stat(const double cpu_time, const double cpu_tim
         , stats_line_percent(zeroLevAssignsByCNF, nVarsOutside())
         , "% vars"
     );
+    cl_alloc.get_compact_stats().print(cpu_time);
 
     //Failed lit stats
     if (conf.doProbe) {
@@ -3037,6 +3204,9 @@ bool Solver::add_clause_outer(const vector<Lit>& lits, bool red)
     if (!ok) {
         return false;
     }
+    if (!conf.checkpoint_file.empty()) {
+        checkpoint_hash_input(lits.data(), lits.size(), red);
+    }
     #ifdef SLOW_DEBUG //we check for this during back-numbering
     check_too_large_variable_number(lits);
     #endif
@@ -3044,6 +3214,203 @@ bool Solver::add_clause_outer(const vector<Lit>& lits, bool red)
     return addClauseInt(back_number_from_outside_to_outer_tmp, red);
 }
 
+/**
+@brief Adds many irredundant clauses, given back-to-back in "lits"
+
+Clause i is lits[offsets[i]] ... lits[offsets[i+1]-1]. The whole batch is
+renumbered in one sweep, var replacement, elimination and decomposition are
+undone once for all of it, then every clause is sorted and cleaned in place
+in the flat buffer. Only then are the clauses attached.
+*/
+bool Solver::add_clauses_outer(
+    const Lit* lits
+    , const size_t* offsets
+    , const size_t num_clauses
+) {
+    if (!ok) {
+        return false;
+    }
+
+    //DRAT needs every clause both as given and as cleaned, one by one
+    if (drat->enabled() || conf.simulate_drat) {
+        for (size_t i = 0; i < num_clauses && ok; i++) {
+            const Lit* start = lits + offsets[i];
+            const size_t size = offsets[i+1] - offsets[i];
+            if (!conf.checkpoint_file.empty()) {
+                checkpoint_hash_input(start, size, false);
+            }
+            back_number_from_outside_to_outer(start, size);
+            addClauseInt(back_number_from_outside_to_outer_tmp, false);
+        }
+        return ok;
+    }
+
+    check_no_blocked_clauses();
+    assert(decisionLevel() == 0);
+    assert(qhead == trail.size());
+    const size_t origTrailSize = trail.size();
+    const size_t base = offsets[0];
+    for (size_t i = 0; i < num_clauses; i++) {
+        const size_t size = offsets[i+1] - offsets[i];
+        if (size > (0x01UL << 28)) {
+            cout << "Too long clause!" << endl;
+            throw CMSat::TooLongClauseError();
+        }
+        if (!conf.checkpoint_file.empty()) {
+            checkpoint_hash_input(lits + offsets[i], size, false);
+        }
+    }
+    #ifdef SLOW_DEBUG //we check for this during back-numbering
+    check_too_large_variable_number(vector<Lit>(lits + base, lits + offsets[num_clauses]));
+    #endif
+
+    //Renumber all of it: outside -> outer -> replaced -> inter
+    vector<Lit>& ps = add_batch_lits;
+    back_number_from_outside_to_outer(lits + base, offsets[num_clauses] - base, ps);
+    for (Lit& lit: ps) {
+        if (lit.var() >= nVarsOuter()) {
+            std::cerr
+            << "ERROR: Variable " << lit.var() + 1
+            << " inserted, but max var is "
+            << nVarsOuter()
+            << endl;
+            assert(false);
+            std::exit(-1);
+        }
+        if (!fresh_solver) {
+            lit = varReplacer->get_lit_replaced_with_outer(lit);
+            if (map_outer_to_inter(lit).var() >= nVars()) {
+                new_var(false, lit.var());
+            }
+        }
+    }
+    if (!fresh_solver) {
+        renumber_outer_to_inter_lits(ps);
+        if (!undo_removed_vars_of_batch(ps)) {
+            return false;
+        }
+    }
+
+    //Sort and clean each clause, compacting the buffer. Satisfied clauses
+    //and tautologies are dropped.
+    add_batch_ends.clear();
+    size_t j = 0;
+    for (size_t i = 0; i < num_clauses; i++) {
+        const size_t start = offsets[i] - base;
+        const size_t end = offsets[i+1] - base;
+        std::sort(ps.begin() + start, ps.begin() + end);
+
+        const size_t cl_start = j;
+        bool drop = false;
+        Lit p = lit_Undef;
+        for (size_t k = start; k < end; k++) {
+            const Lit l = ps[k];
+            if (value(l) == l_True) {
+                drop = true;
+                break;
+            } else if (l == ~p) {
+                const uint32_t var = map_inter_to_outer(p.var());
+                if (undef_must_set_vars.size() < var+1) {
+                    undef_must_set_vars.resize(var+1, false);
+                }
+                undef_must_set_vars[var] = true;
+                drop = true;
+                break;
+            } else if (value(l) != l_False && l != p) {
+                ps[j++] = p = l;
+            }
+        }
+        if (drop) {
+            j = cl_start;
+            continue;
+        }
+        add_batch_ends.push_back(j);
+    }
+
+    //Attach. Units of the batch are propagated as they come, after that
+    //the rest of the clauses need one more pass against the new values.
+    const size_t trail_at_clean = trail.size();
+    vector<Lit>& cl = add_clause_int_tmp_cl;
+    size_t cl_start = 0;
+    for (const uint32_t cl_end: add_batch_ends) {
+        cl.assign(ps.begin() + cl_start, ps.begin() + cl_end);
+        cl_start = cl_end;
+        if (trail.size() != trail_at_clean
+            && !sort_and_clean_clause(cl, cl, false, true)
+        ) {
+            continue;
+        }
+        if (!attach_clean_irred_clause(cl)) {
+            break;
+        }
+    }
+    zeroLevAssignsByCNF += trail.size() - origTrailSize;
+
+    return ok;
+}
+
+//All variables of the batch are put back before any of its clauses is added
+bool Solver::undo_removed_vars_of_batch(const vector<Lit>& ps)
+{
+    if (compHandler) {
+        for (const Lit lit: ps) {
+            if (varData[lit.var()].removed == Removed::decomposed) {
+                compHandler->readdRemovedClauses();
+                break;
+            }
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+
+    if (conf.perform_occur_based_simp) {
+        for (const Lit lit: ps) {
+            if (varData[lit.var()].removed == Removed::elimed
+                && !occsimplifier->uneliminate(lit.var())
+            ) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+//"ps" is sorted, without duplicates, assigned literals or a literal and its
+//negation, same as what sort_and_clean_clause() leaves
+bool Solver::attach_clean_irred_clause(vector<Lit>& ps)
+{
+    switch (ps.size()) {
+        case 0:
+            ok = false;
+            break;
+        case 1:
+            enqueue(ps[0]);
+            #ifdef STATS_NEEDED
+            propStats.propsUnit++;
+            #endif
+            ok = propagate<true>().isNULL();
+            break;
+        case 2:
+            attach_bin_clause(ps[0], ps[1], false);
+            break;
+        default:
+            Clause* c = cl_alloc.Clause_new(ps
+            , sumConflicts
+            #ifdef STATS_NEEDED
+            , 0
+            #endif
+            );
+            cl_alloc.stats(c) = ClauseStats();
+            attachClause(*c);
+            longIrredCls.push_back(cl_alloc.get_offset(c));
+            break;
+    }
+
+    return ok;
+}
+
 bool Solver::add_xor_clause_outer(const vector<uint32_t>& vars, bool rhs)
 {
     if (!ok) {
@@ -3057,6 +3424,9 @@ bool Solver::add_xor_clause_outer(const vector<uint32_t>& vars, bool rhs)
     #ifdef SLOW_DEBUG //we check for this during back-numbering
     check_too_large_variable_number(lits);
     #endif
+    if (!conf.checkpoint_file.empty()) {
+        checkpoint_hash_input(lits.data(), lits.size(), 2 + rhs);
+    }
 
     back_number_from_outside_to_outer(lits);
     addClauseHelper(back_number_from_outside_to_outer_tmp);
@@ -3442,6 +3812,333 @@ lbool Solver::load_state(const string& fname)
     return status;
 }
 
+//Fingerprint of the clauses given to us, a checkpoint is only used with
+//the same input
+void Solver::checkpoint_hash_input(const Lit* lits, size_t num, uint32_t tag)
+{
+    //FNV-1a
+    const uint64_t prime = 1099511628211ULL;
+    for(size_t i = 0; i < num; i++) {
+        checkpoint_input_hash ^= lits[i].toInt();
+        checkpoint_input_hash *= prime;
+    }
+    checkpoint_input_hash ^= 0x80000000U | tag;
+    checkpoint_input_hash *= prime;
+}
+
+bool Solver::can_checkpoint() const
+{
+    //Model enumeration adds blocking clauses that the formula does not imply
+    //and DRAT proofs cannot be resumed
+    return !conf.checkpoint_file.empty()
+        && conf.preprocess == 0
+        && enum_user_cb == NULL
+        && !drat->enabled()
+        && !conf.simulate_drat
+        && okay()
+        && decisionLevel() == 0;
+}
+
+//Called at restarts. Only the serialization happens here, the file is
+//written in the background.
+void Solver::checkpoint_if_due()
+{
+    if (wall_time() < next_checkpoint_time
+        || !can_checkpoint()
+        || (checkpoint_writer && checkpoint_writer->busy())
+    ) {
+        return;
+    }
+
+    write_checkpoint(false);
+}
+
+void Solver::write_checkpoint(const bool wait)
+{
+    assert(can_checkpoint());
+    const double myTime = cpuTime();
+
+    vector<char> payload;
+    SimpleOutFile f;
+    f.start(&payload);
+    save_checkpoint(f);
+    const size_t payload_size = payload.size();
+
+    if (checkpoint_writer == NULL) {
+        checkpoint_writer = new CheckpointWriter(conf.checkpoint_file);
+    }
+    checkpoint_writer->submit(payload);
+    if (wait) {
+        checkpoint_writer->wait_all_written();
+    }
+    next_checkpoint_time = wall_time() + conf.checkpoint_every_secs;
+
+    if (conf.verbosity >= 2) {
+        cout << "c [checkpoint] saved " << payload_size/1024 << " KB"
+        << " at conflict " << sumConflicts
+        << conf.print_times(cpuTime() - myTime)
+        << endl;
+    }
+}
+
+/**
+@brief Serializes what the search has learnt so far, in outside numbering
+
+Irredundant clauses are not saved, the same CNF is given again on resume.
+Units, redundant binaries and redundant long clauses are all implied by it,
+except when they contain a BVA variable, those are skipped.
+*/
+void Solver::save_checkpoint(SimpleOutFile& f) const
+{
+    const vector<uint32_t> outer_to_outside = build_outer_to_without_bva_map();
+    f.put_uint64_t(checkpoint_input_hash);
+    f.put_uint32_t(nVarsOutside());
+    f.put_uint32_t(sizeof(ClauseStats));
+    f.put_uint32_t(longRedCls.size());
+
+    vector<char> search_state;
+    SimpleOutFile search_f;
+    search_f.start(&search_state);
+    Searcher::save_search_state(search_f);
+    f.put_vector(search_state);
+
+    //Outside variables are the outer ones without BVA, in the same order
+    vector<double> act_vsids;
+    vector<double> act_maple;
+    vector<char> polars;
+    for(uint32_t outer = 0; outer < nVarsOuter(); outer++) {
+        if (outer_to_outside[outer] == var_Undef) {
+            continue;
+        }
+        const uint32_t inter = map_outer_to_inter(outer);
+        act_vsids.push_back(inter < var_act_vsids.size() ? var_act_vsids[inter] : 0);
+        act_maple.push_back(inter < var_act_maple.size() ? var_act_maple[inter] : 0);
+        polars.push_back(varData[inter].polarity);
+    }
+    assert(polars.size() == nVarsOutside());
+    f.put_vector(act_vsids);
+    f.put_vector(act_maple);
+    f.put_vector(polars);
+
+    f.put_vector(get_zero_assigned_lits(true));
+
+    vector<Lit> lits;
+    auto to_outside = [&](const Lit lit) -> bool {
+        const Lit outer = map_inter_to_outer(lit);
+        const uint32_t var = outer_to_outside[outer.var()];
+        if (var == var_Undef) {
+            return false;
+        }
+        lits.push_back(Lit(var, outer.sign()));
+        return true;
+    };
+
+    //Redundant binaries, each once
+    for(size_t i = 0; i < watches.size(); i++) {
+        const Lit lit = Lit::toLit(i);
+        for(const Watched& w: watches[lit]) {
+            if (!w.isBin() || !w.red() || w.lit2() < lit) {
+                continue;
+            }
+            const size_t at = lits.size();
+            if (!to_outside(lit) || !to_outside(w.lit2())) {
+                lits.resize(at);
+            }
+        }
+    }
+    f.put_vector(lits);
+
+    //Redundant long clauses. The tier is in the stats, it can be ahead of
+    //the array the clause is in until the next cleaning
+    vector<uint32_t> sizes;
+    vector<ClauseStats> cl_stats;
+    lits.clear();
+    for(const vector<ClOffset>& offsets: longRedCls) {
+        for(const ClOffset offset: offsets) {
+            const Clause& cl = *cl_alloc.ptr(offset);
+            if (cl.getRemoved() || cl.freed()) {
+                continue;
+            }
+
+            const size_t at = lits.size();
+            bool all_outside = true;
+            for(const Lit lit: cl) {
+                if (!to_outside(lit)) {
+                    all_outside = false;
+                    break;
+                }
+            }
+            if (!all_outside) {
+                lits.resize(at);
+                continue;
+            }
+            sizes.push_back(cl.size());
+            cl_stats.push_back(cl_alloc.stats(cl));
+        }
+    }
+    f.put_vector(lits);
+    f.put_vector(sizes);
+    f.put_vector(cl_stats);
+}
+
+/**
+@brief Resumes from conf.checkpoint_file, if there is a usable one
+
+Called at the start of the first solve(), after the CNF has been added. The
+checkpoint is fully parsed and checked before anything is changed, so a
+checkpoint that does not fit is ignored and we start from scratch.
+*/
+void Solver::load_checkpoint()
+{
+    vector<char> payload;
+    string err;
+    if (!read_checkpoint_file(conf.checkpoint_file, payload, err)) {
+        if (conf.verbosity) {
+            cout << "c [checkpoint] not resuming from '" << conf.checkpoint_file
+            << "': " << err << endl;
+        }
+        return;
+    }
+
+    vector<char> search_state;
+    vector<double> act_vsids;
+    vector<double> act_maple;
+    vector<char> polars;
+    vector<Lit> units;
+    vector<Lit> bins;
+    vector<Lit> long_lits;
+    vector<uint32_t> long_sizes;
+    vector<ClauseStats> long_stats;
+    try {
+        SimpleInFile f;
+        f.start(&payload);
+        if (f.get_uint64_t() != checkpoint_input_hash
+            || f.get_uint32_t() != nVarsOutside()
+            || f.get_uint32_t() != sizeof(ClauseStats)
+            || f.get_uint32_t() != longRedCls.size()
+        ) {
+            throw std::runtime_error("it is for a different CNF or solver build");
+        }
+
+        //The search state is of fixed size
+        f.get_vector(search_state);
+        vector<char> current_state;
+        SimpleOutFile state_f;
+        state_f.start(&current_state);
+        Searcher::save_search_state(state_f);
+        if (search_state.size() != current_state.size()) {
+            throw std::runtime_error("search state has the wrong size");
+        }
+
+        f.get_vector(act_vsids);
+        f.get_vector(act_maple);
+        f.get_vector(polars);
+        if (act_vsids.size() != nVarsOutside()
+            || act_maple.size() != nVarsOutside()
+            || polars.size() != nVarsOutside()
+        ) {
+            throw std::runtime_error("wrong number of variables");
+        }
+
+        f.get_vector(units);
+        f.get_vector(bins);
+        if (bins.size() % 2 != 0) {
+            throw std::runtime_error("odd number of binary clause literals");
+        }
+        f.get_vector(long_lits);
+        f.get_vector(long_sizes);
+        f.get_vector(long_stats);
+        size_t total = 0;
+        for(const uint32_t sz: long_sizes) {
+            if (sz < 3) {
+                throw std::runtime_error("long clause is too short");
+            }
+            total += sz;
+        }
+        if (total != long_lits.size()
+            || long_sizes.size() != long_stats.size()
+        ) {
+            throw std::runtime_error("malformed clause data");
+        }
+        for(const ClauseStats& cl_stats: long_stats) {
+            if (cl_stats.which_red_array >= longRedCls.size()) {
+                throw std::runtime_error("clause is in a nonexistent tier");
+            }
+        }
+
+        for(const vector<Lit>* lits: {&units, &bins, &long_lits}) {
+            for(const Lit lit: *lits) {
+                if (lit.var() >= nVarsOutside()) {
+                    throw std::runtime_error("variable out of range");
+                }
+            }
+        }
+    } catch (const std::runtime_error& e) {
+        cout << "c WARNING: ignoring checkpoint '" << conf.checkpoint_file
+        << "': " << e.what() << endl;
+        return;
+    }
+
+    //Everything checked, apply
+    SimpleInFile search_f;
+    search_f.start(&search_state);
+    Searcher::load_search_state(search_f);
+
+    for(uint32_t var = 0; var < nVarsOutside(); var++) {
+        const uint32_t inter = map_outer_to_inter(map_to_with_bva(var));
+        if (inter < var_act_vsids.size()) {
+            var_act_vsids[inter] = act_vsids[var];
+        }
+        if (inter < var_act_maple.size()) {
+            var_act_maple[inter] = act_maple[var];
+        }
+        varData[inter].polarity = polars[var];
+    }
+    rebuildOrderHeap();
+
+    vector<Lit> lits;
+    size_t num_long = 0;
+    for(const Lit lit: units) {
+        lits.clear();
+        lits.push_back(lit);
+        back_number_from_outside_to_outer(lits);
+        if (!addClauseInt(back_number_from_outside_to_outer_tmp, true)) {
+            goto end;
+        }
+    }
+    for(size_t i = 0; i < bins.size(); i += 2) {
+        lits.clear();
+        lits.push_back(bins[i]);
+        lits.push_back(bins[i+1]);
+        back_number_from_outside_to_outer(lits);
+        if (!addClauseInt(back_number_from_outside_to_outer_tmp, true)) {
+            goto end;
+        }
+    }
+    {
+        const Lit* at = long_lits.data();
+        for(size_t i = 0; i < long_sizes.size(); i++) {
+            lits.assign(at, at + long_sizes[i]);
+            at += long_sizes[i];
+            back_number_from_outside_to_outer(lits);
+            if (!addClauseInt(back_number_from_outside_to_outer_tmp, true, &long_stats[i])) {
+                goto end;
+            }
+            num_long++;
+        }
+    }
+
+    end:
+    if (conf.verbosity) {
+        cout << "c [checkpoint] resumed from '" << conf.checkpoint_file << "'"
+        << " conflicts: " << sumConflicts
+        << " units: " << units.size()
+        << " red bins: " << bins.size()/2
+        << " red long: " << num_long
+        << endl;
+    }
+}
+
 lbool Solver::load_solution_from_file(const string& fname)
 {
     //At this point, model is set up, we just need to fill the l_Undef in
@@ -3962,6 +4659,12 @@ void Solver::dump_irred_clauses(std::ostream *out) const
     dumper.dump_irred_clauses(out);
 }
 
+void Solver::dump_irred_clauses(vector<Lit>& buf) const
+{
+    ClauseDumper dumper(this);
+    dumper.dump_irred_clauses(buf);
+}
+
 void Solver::dump_red_clauses(std::ostream *out) const
 {
     ClauseDumper dumper(this);
@@ -4118,7 +4821,7 @@ bool Solver::get_next_small_clause(vector<Lit>& out)
         const ClOffset offs = longRedCls[0][learnt_clause_query_at];
         const Clause* cl = cl_alloc.ptr(offs);
         if (cl->size() <= learnt_clause_query_max_len
-            && cl->stats.glue <= learnt_clause_query_max_glue
+            && cl_alloc.stats(cl).glue <= learnt_clause_query_max_glue
         ) {
             out = clause_outer_numbered(*cl);
             if (all_vars_outside(out)) {
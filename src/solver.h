@@ -67,6 +67,7 @@ class DataSync;
 class SharedData;
 class ReduceDB;
 class InTree;
+class CheckpointWriter;
 
 struct SolveStats
 {
@@ -86,11 +87,18 @@ class Solver : public Searcher
         void new_external_var();
         void new_external_vars(size_t n);
         bool add_clause_outer(const vector<Lit>& lits, bool red = false);
+        bool add_clauses_outer(const Lit* lits, const size_t* offsets, size_t num_clauses);
         bool add_xor_clause_outer(const vector<uint32_t>& vars, bool rhs);
 
         lbool solve_with_assumptions(const vector<Lit>* _assumptions, bool only_indep_solution);
-        lbool simplify_with_assumptions(const vector<Lit>* _assumptions = NULL);
-        void  set_shared_data(SharedData* shared_data);
+        lbool simplify_with_assumptions(const vector<Lit>* _assumptions = NULL, bool startup = false);
+        void set_model_enumeration(
+            bool (*model_cb)(void* state, const vector<lbool>& values)
+            , void* state
+            , bool with_model
+            , bool only_indep_solution
+        );
+        void  set_shared_data(SharedData* shared_data, uint32_t thread_num);
 
         //Querying model
         lbool model_value (const Lit p) const;  ///<Found model value for lit
@@ -110,6 +118,7 @@ class Solver : public Searcher
         void end_getting_small_clauses();
 
         void dump_irred_clauses(std::ostream *out) const;
+        void dump_irred_clauses(vector<Lit>& buf) const;
         void dump_red_clauses(std::ostream *out) const;
         void open_file_and_dump_irred_clauses(const std::string &fname) const;
         void open_file_and_dump_red_clauses(const std::string &fname) const;
@@ -176,6 +185,7 @@ class Solver : public Searcher
         template<typename A>
         void parse_v_line(A* in, const size_t lineNum);
         lbool load_solution_from_file(const string& fname);
+        void checkpoint_if_due();
 
         uint64_t getNumLongClauses() const;
         bool addClause(const vector<Lit>& ps, const bool red = false);
@@ -242,6 +252,7 @@ class Solver : public Searcher
         size_t mem_used() const;
         void dump_memory_stats_to_sql();
         void set_sqlite(string filename);
+        void share_sqlite(const Solver* main_solver, uint32_t thread_num);
         //Not Private for testing (maybe could be called from outside)
         bool renumber_variables(bool must_renumber = true);
         SolveFeatures calculate_features();
@@ -275,6 +286,16 @@ class Solver : public Searcher
 
         vector<Lit> add_clause_int_tmp_cl;
         lbool iterate_until_solved();
+
+        //Projected model enumeration, see set_model_enumeration()
+        bool (*enum_user_cb)(void* state, const vector<lbool>& values) = NULL;
+        void* enum_user_state = NULL;
+        bool enum_with_model = false;
+        bool enum_only_indep_solution = false;
+        vector<uint32_t>* enum_orig_sampling_vars = NULL;
+        vector<uint32_t> enum_all_vars;
+        static bool enum_model_found_cb(void* state, const vector<lbool>& values);
+        bool enum_undo_removed_sampling_vars();
         uint64_t mem_used_vardata() const;
         void check_reconfigure();
         void reconfigure(int val);
@@ -300,25 +321,47 @@ class Solver : public Searcher
         void check_too_large_variable_number(const vector<Lit>& lits) const;
         void set_assumptions();
 
-        lbool simplify_problem_outside();
+        lbool simplify_problem_outside(bool startup);
         void move_to_outside_assumps(const vector<Lit>* assumps);
         vector<Lit> back_number_from_outside_to_outer_tmp;
         void back_number_from_outside_to_outer(const vector<Lit>& lits)
         {
-            back_number_from_outside_to_outer_tmp.clear();
-            for (const Lit lit: lits) {
+            back_number_from_outside_to_outer(lits.data(), lits.size());
+        }
+        void back_number_from_outside_to_outer(const Lit* lits, const size_t num)
+        {
+            back_number_from_outside_to_outer(lits, num, back_number_from_outside_to_outer_tmp);
+        }
+        void back_number_from_outside_to_outer(
+            const Lit* lits, const size_t num, vector<Lit>& out)
+        {
+            out.clear();
+            const bool must_map = get_num_bva_vars() > 0 || !fresh_solver;
+            for (const Lit* it = lits, *end = lits + num; it != end; ++it) {
+                const Lit lit = *it;
                 assert(lit.var() < nVarsOutside());
-                if (get_num_bva_vars() > 0 || !fresh_solver) {
-                    back_number_from_outside_to_outer_tmp.push_back(map_to_with_bva(lit));
-                    assert(back_number_from_outside_to_outer_tmp.back().var() < nVarsOuter());
+                if (must_map) {
+                    out.push_back(map_to_with_bva(lit));
+                    assert(out.back().var() < nVarsOuter());
                 } else {
-                    back_number_from_outside_to_outer_tmp.push_back(lit);
+                    out.push_back(lit);
                 }
             }
         }
         void check_switchoff_limits_newvar(size_t n = 1);
         vector<Lit> outside_assumptions;
 
+        //Checkpointing, see conf.checkpoint_file
+        CheckpointWriter* checkpoint_writer = NULL;
+        double next_checkpoint_time = 0;
+        bool checkpoint_tried_load = false;
+        uint64_t checkpoint_input_hash = 14695981039346656037ULL;
+        void checkpoint_hash_input(const Lit* lits, size_t num, uint32_t tag);
+        bool can_checkpoint() const;
+        void write_checkpoint(const bool wait);
+        void save_checkpoint(SimpleOutFile& f) const;
+        void load_checkpoint();
+
         //Stats printing
         void print_norm_stats(const double cpu_time, const double cpu_time_total) const;
         void print_min_stats(const double cpu_time, const double cpu_time_total) const;
@@ -400,7 +443,16 @@ class Solver : public Searcher
         /////////////////////
         // Clauses
         bool addClauseHelper(vector<Lit>& ps);
-        bool addClauseInt(vector<Lit>& ps, const bool red = false);
+        void check_no_blocked_clauses() const;
+        bool undo_removed_vars_of_batch(const vector<Lit>& ps);
+        bool attach_clean_irred_clause(vector<Lit>& ps);
+        vector<Lit> add_batch_lits;
+        vector<uint32_t> add_batch_ends;
+        bool addClauseInt(
+            vector<Lit>& ps
+            , const bool red = false
+            , const ClauseStats* red_stats = NULL
+        );
 
         /////////////////
         // Debug
@@ -500,10 +552,11 @@ inline void Solver::move_to_outside_assumps(const vector<Lit>* assumps)
 
 inline lbool Solver::simplify_with_assumptions(
     const vector<Lit>* _assumptions
+    , const bool startup
 ) {
     fresh_solver = false;
     move_to_outside_assumps(_assumptions);
-    return simplify_problem_outside();
+    return simplify_problem_outside(startup);
 }
 
 inline bool Solver::find_with_stamp_a_or_b(Lit a, const Lit b) const
@@ -56,6 +56,8 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , maple(true)
         , modulo_maple_iter(3)
         , more_maple_bump_high_glue(false)
+        , vmtf(false)
+        , vmtf_threads(0)
 
         //Restarting
         , restart_first(100)
@@ -125,6 +127,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , skip_some_bve_resolvents(true) //based on gates
         , velim_resolvent_too_large(20)
         , var_linkin_limit_MB(1000)
+        , varelim_threads(1)
 
         //Subs, str limits for simplifier
         , subsumption_time_limitM(300)
@@ -135,6 +138,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
         //Ternary resolution
         , doTernary(false)
         , ternary_res_time_limitM(100)
+        , ternary_res_threads(1)
 
         //Bounded variable addition
         , do_bva(true)
@@ -187,6 +191,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
         //Iterative Alo Scheduling
         , simplify_at_startup(false)
         , simplify_at_every_startup(false)
+        , simplify_once_for_threads(false)
         , do_simplify_problem(true)
         , full_simplify_at_startup(false)
         , never_stop_search(false)
@@ -241,6 +246,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , maxOccurRedMB    (600)
         , maxOccurRedLitLinkedM(50)
         , subsume_gothrough_multip(2.0)
+        , sub_str_threads(1)
 
         //WalkSAT
         , doSLS(true)
@@ -262,12 +268,19 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , doSaveMem        (true)
         , full_watch_consolidate_every_n_confl (4ULL*1000ULL*1000ULL) //validated in run 8113323.wlm01
         , static_mem_consolidate_order(true)
+        , cl_alloc_huge_pages(true)
+        , cl_alloc_reuse(true)
+        , cl_compact_incremental(true)
+        , cl_compact_max_mb(64)
 
         //Component finding
         , doCompHandler    (false)
         , handlerFromSimpNum (0)
         , compVarLimit      (1ULL*1000ULL*1000ULL)
         , comp_find_time_limitM (500)
+        , comp_find_threads (1)
+        , comp_threads      (1)
+        , comp_threads_max_memMB (2000)
 
         //Misc optimisations
         , doStrSubImplicit (true)
@@ -298,12 +311,18 @@ DLL_PUBLIC SolverConf::SolverConf() :
         //misc
         , origSeed(0)
         , sync_every_confl(20000)
+        , sync_bin_ring_size_log2(16)
+        , sync_long_max_glue(2)
+        , sync_long_max_size(30)
+        , sync_long_max_buffered(100000)
         , reconfigure_val(0)
         , reconfigure_at(2)
         , preprocess(0)
         , simulate_drat(false)
+        , drat_async_bufs(4)
         , need_decisions_reaching(false)
         , saved_state_file("savedstate.dat")
+        , checkpoint_every_secs(1800)
 {
     ratio_keep_clauses[clean_to_int(ClauseClean::glue)] = 0;
     ratio_keep_clauses[clean_to_int(ClauseClean::activity)] = 0.44;
@@ -185,6 +185,8 @@ class DLL_PUBLIC SolverConf
         int      maple;
         unsigned modulo_maple_iter;
         bool     more_maple_bump_high_glue;
+        int      vmtf; ///<Use a VMTF queue instead of the VSIDS heap in non-maple rounds
+        unsigned vmtf_threads; ///<Number of VSIDS-only helper threads that use VMTF
 
         //For restarting
         unsigned    restart_first;      ///<The initial restart limit.                                                                (default 100)
@@ -259,6 +261,7 @@ class DLL_PUBLIC SolverConf
         int      skip_some_bve_resolvents;
         int velim_resolvent_too_large; //-1 == no limit
         int var_linkin_limit_MB;
+        unsigned varelim_threads;
 
         //Subs, str limits for simplifier
         long long subsumption_time_limitM;
@@ -268,6 +271,7 @@ class DLL_PUBLIC SolverConf
         //Ternary resolution
         bool doTernary;
         long long ternary_res_time_limitM;
+        unsigned ternary_res_threads;
 
         //BVA
         int      do_bva;
@@ -307,11 +311,12 @@ class DLL_PUBLIC SolverConf
         //Var-replacement
         int doFindAndReplaceEqLits;
         int doExtendedSCC;
-        int max_scc_depth;
+        int max_scc_depth; //deprecated, ignored: the SCC search has no depth limit
 
         //Iterative Alo Scheduling
         int      simplify_at_startup; //simplify at 1st startup (only)
         int      simplify_at_every_startup; //always simplify at startup, not only at 1st startup
+        int      simplify_once_for_threads; //with threads, simplify at startup in one and share the result
         int      do_simplify_problem;
         int      full_simplify_at_startup;
         int      never_stop_search;
@@ -331,6 +336,7 @@ class DLL_PUBLIC SolverConf
         double maxOccurRedMB;
         double maxOccurRedLitLinkedM;
         double   subsume_gothrough_multip;
+        unsigned sub_str_threads;
 
         //Walksat
         int doSLS;
@@ -352,12 +358,19 @@ class DLL_PUBLIC SolverConf
         int       doSaveMem;
         uint64_t  full_watch_consolidate_every_n_confl;
         int       static_mem_consolidate_order;
+        int       cl_alloc_huge_pages;
+        int       cl_alloc_reuse;
+        int       cl_compact_incremental;
+        unsigned  cl_compact_max_mb;
 
         //Component handling
         int       doCompHandler;
         unsigned  handlerFromSimpNum;
         size_t    compVarLimit;
         unsigned long long  comp_find_time_limitM;
+        unsigned  comp_find_threads;
+        unsigned  comp_threads;
+        size_t    comp_threads_max_memMB;
 
 
         //Misc Optimisations
@@ -393,14 +406,23 @@ class DLL_PUBLIC SolverConf
         //Misc
         unsigned origSeed;
         unsigned long long sync_every_confl;
+        unsigned sync_bin_ring_size_log2;
+        unsigned sync_long_max_glue;
+        unsigned sync_long_max_size;
+        unsigned sync_long_max_buffered;
         unsigned reconfigure_val;
         unsigned reconfigure_at;
         unsigned preprocess;
         int      simulate_drat;
+        unsigned drat_async_bufs;
         int      need_decisions_reaching;
         std::string simplified_cnf;
         std::string solution_file;
         std::string saved_state_file;
+
+        //Checkpointing of the search, resumed from on the first solve()
+        std::string checkpoint_file; //empty: off
+        double   checkpoint_every_secs; //wall-clock time
 };
 
 } //end namespace
@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include <string>
 #include <cmath>
 #include <time.h>
+#include <cassert>
 #include "constants.h"
 #include "reducedb.h"
 #include "sql_tablestructure.h"
@@ -41,53 +42,105 @@ using std::cerr;
 using std::endl;
 using std::string;
 
+//The writer thread looks at the rings at least this often
+static const std::chrono::milliseconds sql_write_interval(20);
+
+SQLiteStats::SQLiteStats(std::string _filename) :
+    SQLiteStats(std::make_shared<SQLiteWriter>(_filename), 0)
+{
+}
+
+SQLiteStats::SQLiteStats(
+    std::shared_ptr<SQLiteWriter> _writer
+    , uint32_t _thread_num
+) :
+    writer(_writer)
+    , thread_num(_thread_num)
+{
+    runID = 0;
+    ring = writer->add_thread();
+}
+
 SQLiteStats::~SQLiteStats()
 {
-    if (!setup_ok)
-        return;
+    writer->remove_thread();
+}
 
-    //Free all the prepared statements
-    int ret = sqlite3_finalize(stmtRst);
-    if (ret != SQLITE_OK) {
-        cout << "Error closing prepared statement" << endl;
-        std::exit(-1);
+SQLStats* SQLiteStats::new_for_thread(uint32_t _thread_num)
+{
+    return new SQLiteStats(writer, _thread_num);
+}
+
+bool SQLiteStats::setup(const Solver* solver)
+{
+    if (!writer->setup(solver)) {
+        return false;
     }
+    runID = writer->get_runID();
 
-    ret = sqlite3_finalize(stmtFeat);
-    if (ret != SQLITE_OK) {
-        cout << "Error closing prepared statement" << endl;
-        std::exit(-1);
+    return true;
+}
+
+//Waits only if the writer thread is a full ring behind
+SQLRow& SQLiteStats::new_row(const SQLTable table)
+{
+    const uint64_t head = ring->head.load(std::memory_order_relaxed);
+    while (head - ring->tail.load(std::memory_order_acquire) >= SQLRing::size) {
+        writer->wake_up();
+        std::this_thread::yield();
     }
-    ret = sqlite3_finalize(stmtReduceDB);
-    if (ret != SQLITE_OK) {
-        cout << "Error closing prepared statement" << endl;
-        std::exit(-1);
+    SQLRow& row = ring->rows[head & (SQLRing::size-1)];
+    row.reset(table);
+    return row;
+}
+
+void SQLiteStats::row_done()
+{
+    const uint64_t head = ring->head.load(std::memory_order_relaxed) + 1;
+    ring->head.store(head, std::memory_order_release);
+    if (head - ring->tail.load(std::memory_order_relaxed) == SQLRing::size/2) {
+        writer->wake_up();
     }
+}
 
-    ret = sqlite3_finalize(stmtTimePassed);
-    if (ret != SQLITE_OK) {
-        cout << "Error closing prepared statement" << endl;
-        std::exit(-1);
+SQLiteWriter::~SQLiteWriter()
+{
+    if (!setup_ok) {
+        if (db) {
+            sqlite3_close(db);
+        }
+        return;
     }
 
-    ret = sqlite3_finalize(stmtMemUsed);
-    if (ret != SQLITE_OK) {
-        cout << "Error closing prepared statement" << endl;
-        std::exit(-1);
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        stop = true;
     }
+    cond_todo.notify_one();
+    writer.join();
 
-    ret = sqlite3_finalize(stmt_clause_stats);
-    if (ret != SQLITE_OK) {
-        cout << "Error closing prepared statement" << endl;
-        std::exit(-1);
+    //Free all the prepared statements
+    for(sqlite3_stmt* stmt: {stmtRst, stmtFeat, stmtReduceDB, stmtTimePassed
+        , stmtMemUsed, stmt_clause_stats, stmtTags, stmtFinishup}
+    ) {
+        int ret = sqlite3_finalize(stmt);
+        if (ret != SQLITE_OK) {
+            cout << "Error closing prepared statement" << endl;
+            std::exit(-1);
+        }
     }
 
     //Close clonnection
     sqlite3_close(db);
 }
 
-bool SQLiteStats::setup(const Solver* solver)
+bool SQLiteWriter::setup(const Solver* solver)
 {
+    if (setup_done) {
+        return setup_ok;
+    }
+    setup_done = true;
+
     setup_ok = connectServer(solver->conf.verbosity);
     if (!setup_ok) {
         return false;
@@ -101,11 +154,15 @@ bool SQLiteStats::setup(const Solver* solver)
     initMemUsedSTMT();
     init_features();
     init_clause_stats_STMT();
+    init_tags_finishup_STMT();
+
+    //From now on, only the writer thread touches the database
+    writer = std::thread(&SQLiteWriter::write_loop, this);
 
     return true;
 }
 
-bool SQLiteStats::connectServer(const int verbosity)
+bool SQLiteWriter::connectServer(const int verbosity)
 {
     int rc = sqlite3_open(filename.c_str(), &db);
     if(rc) {
@@ -127,7 +184,7 @@ bool SQLiteStats::connectServer(const int verbosity)
     return true;
 }
 
-bool SQLiteStats::tryIDInSQL(const Solver* solver)
+bool SQLiteWriter::tryIDInSQL(const Solver* solver)
 {
     std::stringstream ss;
     ss
@@ -151,13 +208,13 @@ bool SQLiteStats::tryIDInSQL(const Solver* solver)
     return true;
 }
 
-void SQLiteStats::getID(const Solver* solver)
+void SQLiteWriter::getID(const Solver* solver)
 {
     bool created_tablestruct = false;
     size_t numTries = 0;
-    getRandomID();
+    runID = SQLStats::get_random_runID();
     while(!tryIDInSQL(solver)) {
-        getRandomID();
+        runID = SQLStats::get_random_runID();
         numTries++;
 
         //Check if we have been in this loop for too long
@@ -186,23 +243,14 @@ void SQLiteStats::getID(const Solver* solver)
 
 void SQLiteStats::add_tag(const std::pair<string, string>& tag)
 {
-    std::stringstream ss;
-    ss
-    << "INSERT INTO `tags` (`runID`, `tagname`, `tag`) VALUES("
-    << runID
-    << ", '" << tag.first << "'"
-    << ", '" << tag.second << "'"
-    << ");";
-
-    //Inserting element into solverruns to get unique ID
-    if (sqlite3_exec(db, ss.str().c_str(), NULL, NULL, NULL)) {
-        cerr << "SQLite: ERROR Couldn't insert into table 'tags'" << endl;
-        assert(false);
-        std::exit(-1);
+    //All threads are given the same tags
+    if (thread_num != 0) {
+        return;
     }
+    writer->add_tag(tag);
 }
 
-void SQLiteStats::addStartupData()
+void SQLiteWriter::addStartupData()
 {
     std::stringstream ss;
     ss
@@ -220,22 +268,240 @@ void SQLiteStats::addStartupData()
 }
 
 void SQLiteStats::finishup(const lbool status)
+{
+    writer->finishup(status);
+}
+
+SQLRing* SQLiteWriter::add_thread()
+{
+    std::lock_guard<std::mutex> lock(mu);
+    num_threads++;
+    rings.push_back(std::unique_ptr<SQLRing>(new SQLRing));
+    return rings.back().get();
+}
+
+void SQLiteWriter::remove_thread()
+{
+    std::lock_guard<std::mutex> lock(mu);
+    assert(num_threads > 0);
+    num_threads--;
+}
+
+void SQLiteWriter::add_tag(const std::pair<string, string>& tag)
+{
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        tags.push_back(tag);
+    }
+    cond_todo.notify_one();
+}
+
+void SQLiteWriter::finishup(const lbool status)
+{
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        num_finished++;
+
+        //The threads that were interrupted return l_Undef
+        if (status != l_Undef) {
+            finish_status = status;
+        }
+        if (num_finished < num_threads) {
+            return;
+        }
+
+        finish_waiting = true;
+        finish_todo = finish_status;
+        num_finished = 0;
+        finish_status = l_Undef;
+    }
+    cond_todo.notify_one();
+}
+
+//Notifying without the lock is fine, the writer never sleeps for longer
+//than sql_write_interval anyway
+void SQLiteWriter::wake_up()
+{
+    cond_todo.notify_one();
+}
+
+bool SQLiteWriter::rows_waiting() const
+{
+    for(const auto& ring: rings) {
+        if (ring->head.load(std::memory_order_relaxed)
+            != ring->tail.load(std::memory_order_relaxed)
+        ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SQLiteWriter::write_loop()
+{
+    vector<SQLRing*> to_drain;
+    vector<std::pair<string, string> > tags_todo;
+    std::unique_lock<std::mutex> lock(mu);
+    while(true) {
+        const bool work = cond_todo.wait_for(lock, sql_write_interval, [this]{
+            return stop || finish_waiting || !tags.empty() || rows_waiting();
+        });
+        if (!work) {
+            continue;
+        }
+
+        //Rows waiting are written even if we are asked to stop. Everything
+        //written to the rings before this point is seen by drain().
+        const bool stopping = stop;
+        const bool finishing = finish_waiting;
+        const lbool status = finish_todo;
+        finish_waiting = false;
+        tags_todo.swap(tags);
+        to_drain.clear();
+        for(const auto& ring: rings) {
+            to_drain.push_back(ring.get());
+        }
+        lock.unlock();
+
+        exec("BEGIN TRANSACTION");
+        for(SQLRing* ring: to_drain) {
+            drain(ring);
+        }
+        for(const auto& tag: tags_todo) {
+            write_tag(tag);
+        }
+        tags_todo.clear();
+        if (finishing) {
+            write_finishup(status);
+        }
+        exec("COMMIT");
+
+        lock.lock();
+        if (stopping) {
+            break;
+        }
+    }
+}
+
+void SQLiteWriter::drain(SQLRing* ring)
+{
+    const uint64_t head = ring->head.load(std::memory_order_acquire);
+    const uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+    for(uint64_t at = tail; at < head; at++) {
+        write_row(ring->rows[at & (SQLRing::size-1)]);
+    }
+    ring->tail.store(head, std::memory_order_release);
+}
+
+void SQLiteWriter::exec(const char* sql)
+{
+    if (sqlite3_exec(db, sql, NULL, NULL, NULL)) {
+        cerr << "ERROR: Couldn't execute '" << sql << "' on SQLite DB: "
+        << sqlite3_errmsg(db) << endl;
+        std::exit(-1);
+    }
+}
+
+sqlite3_stmt* SQLiteWriter::get_stmt(const SQLTable table) const
+{
+    switch(table) {
+        case SQLTable::restart: return stmtRst;
+        case SQLTable::reduceDB: return stmtReduceDB;
+        case SQLTable::timepassed: return stmtTimePassed;
+        case SQLTable::memused: return stmtMemUsed;
+        case SQLTable::features: return stmtFeat;
+        case SQLTable::clause_stats: return stmt_clause_stats;
+    }
+    assert(false);
+    return NULL;
+}
+
+void SQLiteWriter::write_row(const SQLRow& row)
+{
+    sqlite3_stmt* stmt = get_stmt(row.table);
+    int bindAt = 1;
+    for(uint32_t i = 0; i < row.num_vals; i++) {
+        const SQLValue& val = row.vals[i];
+        switch(val.type) {
+            case SQLValue::int_t:
+                sqlite3_bind_int64(stmt, bindAt++, val.i);
+                break;
+            case SQLValue::double_t:
+                sqlite3_bind_double(stmt, bindAt++, val.d);
+                break;
+            case SQLValue::text_t:
+                sqlite3_bind_text(stmt, bindAt++, row.text, -1, NULL);
+                break;
+            case SQLValue::null_t:
+                sqlite3_bind_null(stmt, bindAt++);
+                break;
+        }
+    }
+    step(stmt);
+}
+
+void SQLiteWriter::write_tag(const std::pair<string, string>& tag)
+{
+    sqlite3_bind_int64(stmtTags, 1, runID);
+    sqlite3_bind_text(stmtTags, 2, tag.first.c_str(), -1, NULL);
+    sqlite3_bind_text(stmtTags, 3, tag.second.c_str(), -1, NULL);
+    step(stmtTags);
+}
+
+void SQLiteWriter::write_finishup(const lbool status)
 {
     std::stringstream ss;
-    ss
-    << "INSERT INTO `finishup` (`runID`, `endTime`, `status`) VALUES ("
-    << runID << ","
-    << "datetime('now') , "
-    << "'" << status << "'"
-    << ");";
+    ss << status;
+    const string status_str = ss.str();
+    sqlite3_bind_int64(stmtFinishup, 1, runID);
+    sqlite3_bind_text(stmtFinishup, 2, status_str.c_str(), -1, NULL);
+    step(stmtFinishup);
+}
 
-    if (sqlite3_exec(db, ss.str().c_str(), NULL, NULL, NULL)) {
-        cerr << "ERROR Couldn't insert into table 'finishup'" << endl;
+void SQLiteWriter::step(sqlite3_stmt* stmt)
+{
+    int rc = sqlite3_step(stmt);
+    if (rc != SQLITE_DONE) {
+        cerr << "ERROR while executing SQLite prepared statement: "
+        << sqlite3_sql(stmt)
+        << endl
+        << "Error from sqlite: "
+        << sqlite3_errmsg(db)
+        << " error code: " << rc
+        << endl;
+
+        std::exit(-1);
+    }
+
+    if (sqlite3_reset(stmt)) {
+        cerr << "Error calling sqlite3_reset on " << sqlite3_sql(stmt) << endl;
+        std::exit(-1);
+    }
+    if (sqlite3_clear_bindings(stmt)) {
+        cerr << "Error calling sqlite3_clear_bindings on " << sqlite3_sql(stmt) << endl;
         std::exit(-1);
     }
 }
 
-void SQLiteStats::writeQuestionMarks(
+void SQLiteWriter::init_tags_finishup_STMT()
+{
+    const char* tags_sql =
+    "INSERT INTO `tags` (`runID`, `tagname`, `tag`) VALUES (?, ?, ?);";
+    const char* finishup_sql =
+    "INSERT INTO `finishup` (`runID`, `endTime`, `status`) VALUES (?, datetime('now'), ?);";
+
+    if (sqlite3_prepare(db, tags_sql, -1, &stmtTags, NULL)
+        || sqlite3_prepare(db, finishup_sql, -1, &stmtFinishup, NULL)
+    ) {
+        cerr << "ERROR in sqlite_stmt_prepare(), INSERT failed"
+        << endl
+        << sqlite3_errmsg(db)
+        << endl;
+        std::exit(-1);
+    }
+}
+
+void SQLiteWriter::writeQuestionMarks(
     size_t num
     , std::stringstream& ss
 ) {
@@ -253,15 +519,15 @@ void SQLiteStats::writeQuestionMarks(
 }
 
 
-void SQLiteStats::initMemUsedSTMT()
+void SQLiteWriter::initMemUsedSTMT()
 {
-    const size_t numElems = 6;
+    const size_t numElems = 7;
 
     std::stringstream ss;
     ss << "insert into `memused`"
     << "("
     //Position
-    << "  `runID`, `simplifications`, `conflicts`, `runtime`"
+    << "  `runID`, `threadID`, `simplifications`, `conflicts`, `runtime`"
 
     //memory stats
     << ", `name`, `MB`"
@@ -292,47 +558,29 @@ void SQLiteStats::mem_used(
     , double given_time
     , uint64_t mem_used_mb
 ) {
-    int bindAt = 1;
+    SQLRow& row = new_row(SQLTable::memused);
     //Position
-    sqlite3_bind_int64(stmtMemUsed, bindAt++, runID);
-    sqlite3_bind_int64(stmtMemUsed, bindAt++, solver->get_solve_stats().num_simplify);
-    sqlite3_bind_int64(stmtMemUsed, bindAt++, solver->sumConflicts);
-    sqlite3_bind_double(stmtMemUsed, bindAt++, given_time);
+    row.bind_int64(runID);
+    row.bind_int(thread_num);
+    row.bind_int64(solver->get_solve_stats().num_simplify);
+    row.bind_int64(solver->sumConflicts);
+    row.bind_double(given_time);
     //memory stats
-    sqlite3_bind_text(stmtMemUsed, bindAt++, name.c_str(), -1, NULL);
-    sqlite3_bind_int(stmtMemUsed, bindAt++, mem_used_mb);
-
-    int rc = sqlite3_step(stmtMemUsed);
-    if (rc != SQLITE_DONE) {
-        cerr << "ERROR while executing mem_used prepared statement"
-        << endl
-        << "Error from sqlite: "
-        << sqlite3_errmsg(db)
-        << " error code: " << rc
-        << endl;
-
-        std::exit(-1);
-    }
+    row.bind_text(name);
+    row.bind_int(mem_used_mb);
 
-    if (sqlite3_reset(stmtMemUsed)) {
-        cerr << "Error calling sqlite3_reset on stmtMemUsed" << endl;
-        std::exit(-1);
-    }
-    /*if (sqlite3_clear_bindings(stmtMemUsed)) {
-        cerr << "Error calling sqlite3_clear_bindings on stmtMemUsed" << endl;
-        std::exit(-1);
-    }*/
+    row_done();
 }
 
-void SQLiteStats::initTimePassedSTMT()
+void SQLiteWriter::initTimePassedSTMT()
 {
-    const size_t numElems = 8;
+    const size_t numElems = 9;
 
     std::stringstream ss;
     ss << "insert into `timepassed`"
     << "("
     //Position
-    << "  `runID`, `simplifications`, `conflicts`, `runtime`"
+    << "  `runID`, `threadID`, `simplifications`, `conflicts`, `runtime`"
 
     //Clause stats
     << ", `name`, `elapsed`, `timeout`, `percenttimeremain`"
@@ -365,36 +613,18 @@ void SQLiteStats::time_passed(
     , double percent_time_remain
 ) {
 
-    int bindAt = 1;
-    sqlite3_bind_int64(stmtTimePassed, bindAt++, runID);
-    sqlite3_bind_int64(stmtTimePassed, bindAt++, solver->get_solve_stats().num_simplify);
-    sqlite3_bind_int64(stmtTimePassed, bindAt++, solver->sumConflicts);
-    sqlite3_bind_double(stmtTimePassed, bindAt++, cpuTime());
-    sqlite3_bind_text(stmtTimePassed, bindAt++, name.c_str(), -1, NULL);
-    sqlite3_bind_double(stmtTimePassed, bindAt++, time_passed);
-    sqlite3_bind_int(stmtTimePassed, bindAt++, time_out);
-    sqlite3_bind_double(stmtTimePassed, bindAt++, percent_time_remain);
-
-    int rc = sqlite3_step(stmtTimePassed);
-    if (rc != SQLITE_DONE) {
-        cerr << "ERROR while executing time_passed prepared statement"
-        << endl
-        << "Error from sqlite: "
-        << sqlite3_errmsg(db)
-        << " error code: " << rc
-        << endl;
-
-        std::exit(-1);
-    }
-
-    if (sqlite3_reset(stmtTimePassed)) {
-        cerr << "Error calling sqlite3_reset on stmtTimePassed" << endl;
-        std::exit(-1);
-    }
-    /*if (sqlite3_clear_bindings(stmtTimePassed)) {
-        cerr << "Error calling sqlite3_clear_bindings on stmtTimePassed" << endl;
-        std::exit(-1);
-    }*/
+    SQLRow& row = new_row(SQLTable::timepassed);
+    row.bind_int64(runID);
+    row.bind_int(thread_num);
+    row.bind_int64(solver->get_solve_stats().num_simplify);
+    row.bind_int64(solver->sumConflicts);
+    row.bind_double(cpuTime());
+    row.bind_text(name);
+    row.bind_double(time_passed);
+    row.bind_int(time_out);
+    row.bind_double(percent_time_remain);
+
+    row_done();
 }
 
 void SQLiteStats::time_passed_min(
@@ -402,46 +632,28 @@ void SQLiteStats::time_passed_min(
     , const string& name
     , double time_passed
 ) {
-    int bindAt = 1;
-    sqlite3_bind_int64(stmtTimePassed, bindAt++, runID);
-    sqlite3_bind_int64(stmtTimePassed, bindAt++, solver->get_solve_stats().num_simplify);
-    sqlite3_bind_int64(stmtTimePassed, bindAt++, solver->sumConflicts);
-    sqlite3_bind_double(stmtTimePassed, bindAt++, cpuTime());
-    sqlite3_bind_text(stmtTimePassed, bindAt++, name.c_str(), -1, NULL);
-    sqlite3_bind_double(stmtTimePassed, bindAt++, time_passed);
-    sqlite3_bind_null(stmtTimePassed, bindAt++);
-    sqlite3_bind_null(stmtTimePassed, bindAt++);
-
-    int rc = sqlite3_step(stmtTimePassed);
-    if (rc != SQLITE_DONE) {
-        cerr << "ERROR while executing time_passed prepared statement (time_passed_min function)"
-        << endl
-        << "Error from sqlite: "
-        << sqlite3_errmsg(db)
-        << " error code: " << rc
-        << endl;
-
-        std::exit(-1);
-    }
-
-    if (sqlite3_reset(stmtTimePassed)) {
-        cerr << "Error calling sqlite3_reset on stmtTimePassed" << endl;
-        std::exit(-1);
-    }
-    if (sqlite3_clear_bindings(stmtTimePassed)) {
-        cerr << "Error calling sqlite3_clear_bindings on stmtTimePassed" << endl;
-        std::exit(-1);
-    }
+    SQLRow& row = new_row(SQLTable::timepassed);
+    row.bind_int64(runID);
+    row.bind_int(thread_num);
+    row.bind_int64(solver->get_solve_stats().num_simplify);
+    row.bind_int64(solver->sumConflicts);
+    row.bind_double(cpuTime());
+    row.bind_text(name);
+    row.bind_double(time_passed);
+    row.bind_null();
+    row.bind_null();
+
+    row_done();
 }
 
-void SQLiteStats::init_features() {
-    const size_t numElems = 67;
+void SQLiteWriter::init_features() {
+    const size_t numElems = 68;
 
     std::stringstream ss;
     ss << "insert into `features`"
     << "("
     //Position
-    << "  `runID`, `simplifications`, `restarts`, `conflicts`, `latest_feature_calc`"
+    << "  `runID`, `threadID`, `simplifications`, `restarts`, `conflicts`, `latest_feature_calc`"
 
     //Base data
     << ", `numVars`"
@@ -540,15 +752,15 @@ void SQLiteStats::init_features() {
 }
 
 //Prepare statement for restart
-void SQLiteStats::initRestartSTMT()
+void SQLiteWriter::initRestartSTMT()
 {
-    const size_t numElems = 67;
+    const size_t numElems = 68;
 
     std::stringstream ss;
     ss << "insert into `restart`"
     << "("
     //Position
-    << "  `runID`, `simplifications`, `restarts`, `conflicts`, `latest_feature_calc`"
+    << "  `runID`, `threadID`, `simplifications`, `restarts`, `conflicts`, `latest_feature_calc`"
     << ", `runtime` "
 
     //Clause stats
@@ -612,109 +824,92 @@ void SQLiteStats::features(
     , const Searcher* search
     , const SolveFeatures& feat
 ) {
-    int bindAt = 1;
-    sqlite3_bind_int64(stmtFeat, bindAt++, runID);
-    sqlite3_bind_int64(stmtFeat, bindAt++, solver->get_solve_stats().num_simplify);
-    sqlite3_bind_int64(stmtFeat, bindAt++, search->sumRestarts());
-    sqlite3_bind_int64(stmtFeat, bindAt++, solver->sumConflicts);
-    sqlite3_bind_int(stmtFeat, bindAt++, solver->latest_feature_calc);
-
-    sqlite3_bind_int64(stmtFeat, bindAt++, feat.numVars);
-    sqlite3_bind_int64(stmtFeat, bindAt++, feat.numClauses);
-    sqlite3_bind_int64(stmtFeat, bindAt++, feat.var_cl_ratio);
+    SQLRow& row = new_row(SQLTable::features);
+    row.bind_int64(runID);
+    row.bind_int(thread_num);
+    row.bind_int64(solver->get_solve_stats().num_simplify);
+    row.bind_int64(search->sumRestarts());
+    row.bind_int64(solver->sumConflicts);
+    row.bind_int(solver->latest_feature_calc);
+
+    row.bind_int64(feat.numVars);
+    row.bind_int64(feat.numClauses);
+    row.bind_int64(feat.var_cl_ratio);
 
     //Clause distribution
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.binary);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.horn);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.horn_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.horn_std);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.horn_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.horn_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.horn_spread);
-
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.vcg_var_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.vcg_var_std);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.vcg_var_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.vcg_var_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.vcg_var_spread);
-
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.vcg_cls_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.vcg_cls_std);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.vcg_cls_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.vcg_cls_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.vcg_cls_spread);
-
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.pnr_var_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.pnr_var_std);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.pnr_var_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.pnr_var_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.pnr_var_spread);
-
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.pnr_cls_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.pnr_cls_std);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.pnr_cls_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.pnr_cls_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.pnr_cls_spread);
+    row.bind_double(feat.binary);
+    row.bind_double(feat.horn);
+    row.bind_double(feat.horn_mean);
+    row.bind_double(feat.horn_std);
+    row.bind_double(feat.horn_min);
+    row.bind_double(feat.horn_max);
+    row.bind_double(feat.horn_spread);
+
+    row.bind_double(feat.vcg_var_mean);
+    row.bind_double(feat.vcg_var_std);
+    row.bind_double(feat.vcg_var_min);
+    row.bind_double(feat.vcg_var_max);
+    row.bind_double(feat.vcg_var_spread);
+
+    row.bind_double(feat.vcg_cls_mean);
+    row.bind_double(feat.vcg_cls_std);
+    row.bind_double(feat.vcg_cls_min);
+    row.bind_double(feat.vcg_cls_max);
+    row.bind_double(feat.vcg_cls_spread);
+
+    row.bind_double(feat.pnr_var_mean);
+    row.bind_double(feat.pnr_var_std);
+    row.bind_double(feat.pnr_var_min);
+    row.bind_double(feat.pnr_var_max);
+    row.bind_double(feat.pnr_var_spread);
+
+    row.bind_double(feat.pnr_cls_mean);
+    row.bind_double(feat.pnr_cls_std);
+    row.bind_double(feat.pnr_cls_min);
+    row.bind_double(feat.pnr_cls_max);
+    row.bind_double(feat.pnr_cls_spread);
 
     //Conflict clauses
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.avg_confl_size);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.confl_size_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.confl_size_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.avg_confl_glue);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.confl_glue_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.confl_glue_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.avg_num_resolutions);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.num_resolutions_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.num_resolutions_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.learnt_bins_per_confl);
+    row.bind_double(feat.avg_confl_size);
+    row.bind_double(feat.confl_size_min);
+    row.bind_double(feat.confl_size_max);
+    row.bind_double(feat.avg_confl_glue);
+    row.bind_double(feat.confl_glue_min);
+    row.bind_double(feat.confl_glue_max);
+    row.bind_double(feat.avg_num_resolutions);
+    row.bind_double(feat.num_resolutions_min);
+    row.bind_double(feat.num_resolutions_max);
+    row.bind_double(feat.learnt_bins_per_confl);
 
     //Search
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.avg_branch_depth);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.branch_depth_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.branch_depth_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.avg_trail_depth_delta);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.trail_depth_delta_min);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.trail_depth_delta_max);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.avg_branch_depth_delta);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.props_per_confl);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.confl_per_restart);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.decisions_per_conflict);
+    row.bind_double(feat.avg_branch_depth);
+    row.bind_double(feat.branch_depth_min);
+    row.bind_double(feat.branch_depth_max);
+    row.bind_double(feat.avg_trail_depth_delta);
+    row.bind_double(feat.trail_depth_delta_min);
+    row.bind_double(feat.trail_depth_delta_max);
+    row.bind_double(feat.avg_branch_depth_delta);
+    row.bind_double(feat.props_per_confl);
+    row.bind_double(feat.confl_per_restart);
+    row.bind_double(feat.decisions_per_conflict);
 
     //red stats
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.red_cl_distrib.glue_distr_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.red_cl_distrib.glue_distr_var);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.red_cl_distrib.size_distr_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.red_cl_distrib.size_distr_var);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.red_cl_distrib.activity_distr_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.red_cl_distrib.activity_distr_var);
+    row.bind_double(feat.red_cl_distrib.glue_distr_mean);
+    row.bind_double(feat.red_cl_distrib.glue_distr_var);
+    row.bind_double(feat.red_cl_distrib.size_distr_mean);
+    row.bind_double(feat.red_cl_distrib.size_distr_var);
+    row.bind_double(feat.red_cl_distrib.activity_distr_mean);
+    row.bind_double(feat.red_cl_distrib.activity_distr_var);
 
     //irred stats
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.irred_cl_distrib.glue_distr_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.irred_cl_distrib.glue_distr_var);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.irred_cl_distrib.size_distr_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.irred_cl_distrib.size_distr_var);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.irred_cl_distrib.activity_distr_mean);
-    sqlite3_bind_double(stmtFeat, bindAt++, feat.irred_cl_distrib.activity_distr_var);
-
-    int rc = sqlite3_step(stmtFeat);
-    if (rc != SQLITE_DONE) {
-        cerr << "ERROR  while executing restart insertion SQLite prepared statement"
-        << endl
-        << "Error from sqlite: "
-        << sqlite3_errmsg(db)
-        << endl;
-
-        std::exit(-1);
-    }
-
-    if (sqlite3_reset(stmtFeat)) {
-        cerr << "Error calling sqlite3_reset on stmtFeat" << endl;
-        std::exit(-1);
-    }
-    if (sqlite3_clear_bindings(stmtFeat)) {
-        cerr << "Error calling sqlite3_clear_bindings on stmtFeat" << endl;
-        std::exit(-1);
-    }
+    row.bind_double(feat.irred_cl_distrib.glue_distr_mean);
+    row.bind_double(feat.irred_cl_distrib.glue_distr_var);
+    row.bind_double(feat.irred_cl_distrib.size_distr_mean);
+    row.bind_double(feat.irred_cl_distrib.size_distr_var);
+    row.bind_double(feat.irred_cl_distrib.activity_distr_mean);
+    row.bind_double(feat.irred_cl_distrib.activity_distr_var);
+
+    row_done();
 }
 
 void SQLiteStats::restart(
@@ -727,134 +922,117 @@ void SQLiteStats::restart(
     const SearchHist& searchHist = search->getHistory();
     const BinTriStats& binTri = solver->getBinTriStats();
 
-    int bindAt = 1;
-    sqlite3_bind_int64(stmtRst, bindAt++, runID);
-    sqlite3_bind_int64(stmtRst, bindAt++, solver->get_solve_stats().num_simplify);
-    sqlite3_bind_int64(stmtRst, bindAt++, search->sumRestarts());
-    sqlite3_bind_int64(stmtRst, bindAt++, solver->sumConflicts);
-    sqlite3_bind_int(stmtRst, bindAt++, solver->latest_feature_calc);
-    sqlite3_bind_double(stmtRst, bindAt++, cpuTime());
+    SQLRow& row = new_row(SQLTable::restart);
+    row.bind_int64(runID);
+    row.bind_int(thread_num);
+    row.bind_int64(solver->get_solve_stats().num_simplify);
+    row.bind_int64(search->sumRestarts());
+    row.bind_int64(solver->sumConflicts);
+    row.bind_int(solver->latest_feature_calc);
+    row.bind_double(cpuTime());
 
 
-    sqlite3_bind_int64(stmtRst, bindAt++, binTri.irredBins);
-    sqlite3_bind_int64(stmtRst, bindAt++, solver->get_num_long_irred_cls());
+    row.bind_int64(binTri.irredBins);
+    row.bind_int64(solver->get_num_long_irred_cls());
 
-    sqlite3_bind_int64(stmtRst, bindAt++, binTri.redBins);
-    sqlite3_bind_int64(stmtRst, bindAt++, solver->get_num_long_red_cls());
+    row.bind_int64(binTri.redBins);
+    row.bind_int64(solver->get_num_long_red_cls());
 
-    sqlite3_bind_int64(stmtRst, bindAt++, solver->litStats.irredLits);
-    sqlite3_bind_int64(stmtRst, bindAt++, solver->litStats.redLits);
+    row.bind_int64(solver->litStats.irredLits);
+    row.bind_int64(solver->litStats.redLits);
 
     //Conflict stats
-    sqlite3_bind_text(stmtRst, bindAt++, restart_type.c_str(), -1, NULL);
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.glueHist.getLongtTerm().avg());
-    sqlite3_bind_double(stmtRst, bindAt++, std:: sqrt(searchHist.glueHist.getLongtTerm().var()));
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.glueHist.getLongtTerm().getMin());
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.glueHist.getLongtTerm().getMax());
-
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.conflSizeHist.avg());
-    sqlite3_bind_double(stmtRst, bindAt++, std:: sqrt(searchHist.conflSizeHist.var()));
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.conflSizeHist.getMin());
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.conflSizeHist.getMax());
-
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.numResolutionsHist.avg());
-    sqlite3_bind_double(stmtRst, bindAt++, std:: sqrt(searchHist.numResolutionsHist.var()));
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.numResolutionsHist.getMin());
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.numResolutionsHist.getMax());
+    row.bind_text(restart_type);
+    row.bind_double(searchHist.glueHist.getLongtTerm().avg());
+    row.bind_double(std:: sqrt(searchHist.glueHist.getLongtTerm().var()));
+    row.bind_double(searchHist.glueHist.getLongtTerm().getMin());
+    row.bind_double(searchHist.glueHist.getLongtTerm().getMax());
+
+    row.bind_double(searchHist.conflSizeHist.avg());
+    row.bind_double(std:: sqrt(searchHist.conflSizeHist.var()));
+    row.bind_double(searchHist.conflSizeHist.getMin());
+    row.bind_double(searchHist.conflSizeHist.getMax());
+
+    row.bind_double(searchHist.numResolutionsHist.avg());
+    row.bind_double(std:: sqrt(searchHist.numResolutionsHist.var()));
+    row.bind_double(searchHist.numResolutionsHist.getMin());
+    row.bind_double(searchHist.numResolutionsHist.getMax());
 
     //Search stats
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.branchDepthHist.avg());
-    sqlite3_bind_double(stmtRst, bindAt++, std:: sqrt(searchHist.branchDepthHist.var()));
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.branchDepthHist.getMin());
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.branchDepthHist.getMax());
-
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.branchDepthDeltaHist.avg());
-    sqlite3_bind_double(stmtRst, bindAt++, std:: sqrt(searchHist.branchDepthDeltaHist.var()));
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.branchDepthDeltaHist.getMin());
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.branchDepthDeltaHist.getMax());
-
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.trailDepthHist.getLongtTerm().avg());
-    sqlite3_bind_double(stmtRst, bindAt++, std:: sqrt(searchHist.trailDepthHist.getLongtTerm().var()));
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.trailDepthHist.getLongtTerm().getMin());
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.trailDepthHist.getLongtTerm().getMax());
-
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.trailDepthDeltaHist.avg());
-    sqlite3_bind_double(stmtRst, bindAt++, std:: sqrt(searchHist.trailDepthDeltaHist.var()));
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.trailDepthDeltaHist.getMin());
-    sqlite3_bind_double(stmtRst, bindAt++, searchHist.trailDepthDeltaHist.getMax());
+    row.bind_double(searchHist.branchDepthHist.avg());
+    row.bind_double(std:: sqrt(searchHist.branchDepthHist.var()));
+    row.bind_double(searchHist.branchDepthHist.getMin());
+    row.bind_double(searchHist.branchDepthHist.getMax());
+
+    row.bind_double(searchHist.branchDepthDeltaHist.avg());
+    row.bind_double(std:: sqrt(searchHist.branchDepthDeltaHist.var()));
+    row.bind_double(searchHist.branchDepthDeltaHist.getMin());
+    row.bind_double(searchHist.branchDepthDeltaHist.getMax());
+
+    row.bind_double(searchHist.trailDepthHist.getLongtTerm().avg());
+    row.bind_double(std:: sqrt(searchHist.trailDepthHist.getLongtTerm().var()));
+    row.bind_double(searchHist.trailDepthHist.getLongtTerm().getMin());
+    row.bind_double(searchHist.trailDepthHist.getLongtTerm().getMax());
+
+    row.bind_double(searchHist.trailDepthDeltaHist.avg());
+    row.bind_double(std:: sqrt(searchHist.trailDepthDeltaHist.var()));
+    row.bind_double(searchHist.trailDepthDeltaHist.getMin());
+    row.bind_double(searchHist.trailDepthDeltaHist.getMax());
 
     //Prop
-    sqlite3_bind_int64(stmtRst, bindAt++, thisPropStats.propsBinIrred);
-    sqlite3_bind_int64(stmtRst, bindAt++, thisPropStats.propsBinRed);
-    sqlite3_bind_int64(stmtRst, bindAt++, thisPropStats.propsLongIrred);
-    sqlite3_bind_int64(stmtRst, bindAt++, thisPropStats.propsLongRed);
+    row.bind_int64(thisPropStats.propsBinIrred);
+    row.bind_int64(thisPropStats.propsBinRed);
+    row.bind_int64(thisPropStats.propsLongIrred);
+    row.bind_int64(thisPropStats.propsLongRed);
 
     //Confl
-    sqlite3_bind_int64(stmtRst, bindAt++, thisStats.conflStats.conflsBinIrred);
-    sqlite3_bind_int64(stmtRst, bindAt++, thisStats.conflStats.conflsBinRed);
-    sqlite3_bind_int64(stmtRst, bindAt++, thisStats.conflStats.conflsLongIrred);
-    sqlite3_bind_int64(stmtRst, bindAt++, thisStats.conflStats.conflsLongRed);
+    row.bind_int64(thisStats.conflStats.conflsBinIrred);
+    row.bind_int64(thisStats.conflStats.conflsBinRed);
+    row.bind_int64(thisStats.conflStats.conflsLongIrred);
+    row.bind_int64(thisStats.conflStats.conflsLongRed);
 
     //Red
-    sqlite3_bind_int64(stmtRst, bindAt++, thisStats.learntUnits);
-    sqlite3_bind_int64(stmtRst, bindAt++, thisStats.learntBins);
-    sqlite3_bind_int64(stmtRst, bindAt++, thisStats.learntLongs);
+    row.bind_int64(thisStats.learntUnits);
+    row.bind_int64(thisStats.learntBins);
+    row.bind_int64(thisStats.learntLongs);
 
     //Resolv stats
-    sqlite3_bind_int64(stmtRst, bindAt++, thisStats.resolvs.binIrred);
-    sqlite3_bind_int64(stmtRst, bindAt++, thisStats.resolvs.binRed);
-    sqlite3_bind_int64(stmtRst, bindAt++, thisStats.resolvs.longIrred);
-    sqlite3_bind_int64(stmtRst, bindAt++, thisStats.resolvs.longRed);
+    row.bind_int64(thisStats.resolvs.binIrred);
+    row.bind_int64(thisStats.resolvs.binRed);
+    row.bind_int64(thisStats.resolvs.longIrred);
+    row.bind_int64(thisStats.resolvs.longRed);
 
 
     //Var stats
-    sqlite3_bind_int64(stmtRst, bindAt++, thisPropStats.propagations);
-    sqlite3_bind_int64(stmtRst, bindAt++, thisStats.decisions);
+    row.bind_int64(thisPropStats.propagations);
+    row.bind_int64(thisStats.decisions);
 
-    sqlite3_bind_int64(stmtRst, bindAt++, thisPropStats.varFlipped);
-    sqlite3_bind_int64(stmtRst, bindAt++, thisPropStats.varSetPos);
-    sqlite3_bind_int64(stmtRst, bindAt++, thisPropStats.varSetNeg);
-    sqlite3_bind_int64(stmtRst, bindAt++, solver->get_num_free_vars());
-    sqlite3_bind_int64(stmtRst, bindAt++, solver->varReplacer->get_num_replaced_vars());
-    sqlite3_bind_int64(stmtRst, bindAt++, solver->get_num_vars_elimed());
-    sqlite3_bind_int64(stmtRst, bindAt++, search->getTrailSize());
+    row.bind_int64(thisPropStats.varFlipped);
+    row.bind_int64(thisPropStats.varSetPos);
+    row.bind_int64(thisPropStats.varSetNeg);
+    row.bind_int64(solver->get_num_free_vars());
+    row.bind_int64(solver->varReplacer->get_num_replaced_vars());
+    row.bind_int64(solver->get_num_vars_elimed());
+    row.bind_int64(search->getTrailSize());
 
     //ClauseID
-    sqlite3_bind_int64(stmtRst, bindAt++, thisStats.clauseID_at_start_inclusive);
-    sqlite3_bind_int64(stmtRst, bindAt++, thisStats.clauseID_at_end_exclusive);
-
-    int rc = sqlite3_step(stmtRst);
-    if (rc != SQLITE_DONE) {
-        cerr << "ERROR  while executing restart insertion SQLite prepared statement"
-        << endl
-        << "Error from sqlite: "
-        << sqlite3_errmsg(db)
-        << endl;
+    row.bind_int64(thisStats.clauseID_at_start_inclusive);
+    row.bind_int64(thisStats.clauseID_at_end_exclusive);
 
-        std::exit(-1);
-    }
-
-    if (sqlite3_reset(stmtRst)) {
-        cerr << "Error calling sqlite3_reset on stmtRst" << endl;
-        std::exit(-1);
-    }
-    if (sqlite3_clear_bindings(stmtRst)) {
-        cerr << "Error calling sqlite3_clear_bindings on stmtRst" << endl;
-        std::exit(-1);
-    }
+    row_done();
 }
 
 
 //Prepare statement for restart
-void SQLiteStats::initReduceDBSTMT()
+void SQLiteWriter::initReduceDBSTMT()
 {
-    const size_t numElems = 19;
+    const size_t numElems = 20;
 
     std::stringstream ss;
     ss << "insert into `reduceDB`"
     << "("
     //Position
-    << "  `runID`, `simplifications`, `restarts`, `conflicts`, `runtime`"
+    << "  `runID`, `threadID`, `simplifications`, `restarts`, `conflicts`, `runtime`"
 
     //data
     << ", `clauseID`"
@@ -897,70 +1075,53 @@ void SQLiteStats::reduceDB(
     , const bool locked
     , const Clause* cl
 ) {
-    assert(cl->stats.dump_number != std::numeric_limits<uint32_t>::max());
+    const ClauseStats& stats = solver->cl_alloc.stats(cl);
+    assert(stats.dump_number != std::numeric_limits<uint32_t>::max());
 
-    int bindAt = 1;
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, runID);
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, solver->get_solve_stats().num_simplify);
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, solver->sumRestarts());
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, solver->sumConflicts);
-    sqlite3_bind_double(stmtReduceDB, bindAt++, cpuTime());
+    SQLRow& row = new_row(SQLTable::reduceDB);
+    row.bind_int64(runID);
+    row.bind_int(thread_num);
+    row.bind_int64(solver->get_solve_stats().num_simplify);
+    row.bind_int64(solver->sumRestarts());
+    row.bind_int64(solver->sumConflicts);
+    row.bind_double(cpuTime());
 
     //data
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, cl->stats.ID);
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, cl->stats.dump_number);
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, cl->stats.conflicts_made);
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, cl->stats.sum_of_branch_depth_conflict);
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, cl->stats.propagations_made);
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, cl->stats.clause_looked_at);
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, cl->stats.used_for_uip_creation);
+    row.bind_int64(stats.ID);
+    row.bind_int64(stats.dump_number);
+    row.bind_int64(stats.conflicts_made);
+    row.bind_int64(stats.sum_of_branch_depth_conflict);
+    row.bind_int64(stats.propagations_made);
+    row.bind_int64(stats.clause_looked_at);
+    row.bind_int64(stats.used_for_uip_creation);
 
     uint64_t last_touched_diff;
-    if (cl->stats.last_touched == 0) {
-        last_touched_diff = solver->sumConflicts-cl->stats.introduced_at_conflict;
+    if (stats.last_touched == 0) {
+        last_touched_diff = solver->sumConflicts-stats.introduced_at_conflict;
     } else {
-        last_touched_diff = solver->sumConflicts-cl->stats.last_touched;
+        last_touched_diff = solver->sumConflicts-stats.last_touched;
     }
-    sqlite3_bind_int64(stmtReduceDB, bindAt++, last_touched_diff);
-
-    sqlite3_bind_double(stmtReduceDB, bindAt++, (double)cl->stats.activity/(double)solver->get_cla_inc());
-    sqlite3_bind_int(stmtReduceDB, bindAt++, locked);
-    sqlite3_bind_int(stmtReduceDB, bindAt++, cl->used_in_xor());
-    sqlite3_bind_int(stmtReduceDB, bindAt++, cl->stats.glue);
-    sqlite3_bind_int(stmtReduceDB, bindAt++, cl->size());
-    sqlite3_bind_int(stmtReduceDB, bindAt++, cl->stats.ttl);
+    row.bind_int64(last_touched_diff);
 
-    int rc = sqlite3_step(stmtReduceDB);
-    if (rc != SQLITE_DONE) {
-        cout
-        << "ERROR: while executing clause DB cleaning SQLite prepared statement"
-        << endl;
+    row.bind_double((double)stats.activity/(double)solver->get_cla_inc());
+    row.bind_int(locked);
+    row.bind_int(cl->used_in_xor());
+    row.bind_int(stats.glue);
+    row.bind_int(cl->size());
+    row.bind_int(stats.ttl);
 
-        cout << "Error from sqlite: "
-        << sqlite3_errmsg(db)
-        << endl;
-        std::exit(-1);
-    }
-
-    if (sqlite3_reset(stmtReduceDB)) {
-        cerr << "Error calling sqlite3_reset on stmtReduceDB" << endl;
-        std::exit(-1);
-    }
-
-    if (sqlite3_clear_bindings(stmtReduceDB)) {
-        cerr << "Error calling sqlite3_clear_bindings on stmtReduceDB" << endl;
-        std::exit(-1);
-    }
+    row_done();
 }
 
-void SQLiteStats::init_clause_stats_STMT()
+void SQLiteWriter::init_clause_stats_STMT()
 {
-    const size_t numElems = 67;
+    const size_t numElems = 68;
 
     std::stringstream ss;
     ss << "insert into `clauseStats`"
     << "("
     << " `runID`,"
+    << " `threadID`,"
     << " `simplifications`,"
     << " `restarts`,"
     << " `prev_restart`,"
@@ -1078,110 +1239,91 @@ void SQLiteStats::dump_clause_stats(
 ) {
     uint32_t num_overlap_literals = antec_data.sum_size()-(antec_data.num()-1)-size;
 
-    int bindAt = 1;
-    sqlite3_bind_int64(stmt_clause_stats, bindAt++, runID);
-    sqlite3_bind_int64(stmt_clause_stats, bindAt++, solver->get_solve_stats().num_simplify);
-    sqlite3_bind_int64(stmt_clause_stats, bindAt++, solver->sumRestarts());
+    SQLRow& row = new_row(SQLTable::clause_stats);
+    row.bind_int64(runID);
+    row.bind_int(thread_num);
+    row.bind_int64(solver->get_solve_stats().num_simplify);
+    row.bind_int64(solver->sumRestarts());
     if (solver->sumRestarts() == 0) {
-        sqlite3_bind_int64(stmt_clause_stats, bindAt++, 0);
+        row.bind_int64(0);
     } else {
-        sqlite3_bind_int64(stmt_clause_stats, bindAt++, solver->sumRestarts()-1);
-    }
-    sqlite3_bind_int64(stmt_clause_stats, bindAt++, solver->sumConflicts);
-    sqlite3_bind_int(stmt_clause_stats, bindAt++, solver->latest_feature_calc);
-    sqlite3_bind_int64(stmt_clause_stats, bindAt++, clauseID);
-
-    sqlite3_bind_int(stmt_clause_stats, bindAt++, glue);
-    sqlite3_bind_int(stmt_clause_stats, bindAt++, size);
-    sqlite3_bind_int64(stmt_clause_stats, bindAt++, conflicts_this_restart);
-    sqlite3_bind_int(stmt_clause_stats, bindAt++, num_overlap_literals);
-    sqlite3_bind_int(stmt_clause_stats, bindAt++, antec_data.num());
-    sqlite3_bind_int(stmt_clause_stats, bindAt++, antec_data.sum_size());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, (double)antec_data.sum_size()/(double)antec_data.num() );
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, last_dec_var_act_vsids_0);
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, last_dec_var_act_vsids_1);
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, first_dec_var_act_vsids_0);
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, first_dec_var_act_vsids_1);
-
-    sqlite3_bind_int(stmt_clause_stats, bindAt++, backtrack_level);
-    sqlite3_bind_int64(stmt_clause_stats, bindAt++, decision_level);
-    sqlite3_bind_int64(stmt_clause_stats, bindAt++, hist.branchDepthHistQueue.prev(1));
-    sqlite3_bind_int64(stmt_clause_stats, bindAt++, hist.branchDepthHistQueue.prev(2));
-    sqlite3_bind_int64(stmt_clause_stats, bindAt++, trail_depth);
-    sqlite3_bind_text(stmt_clause_stats, bindAt++,  restart_type.c_str(), -1, NULL);
-
-    sqlite3_bind_int(stmt_clause_stats, bindAt++, antec_data.binIrred);
-    sqlite3_bind_int(stmt_clause_stats, bindAt++, antec_data.binRed);
-    sqlite3_bind_int(stmt_clause_stats, bindAt++, antec_data.longIrred);
-    sqlite3_bind_int(stmt_clause_stats, bindAt++, antec_data.longRed);
-
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, antec_data.vsids_vars.avg());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, antec_data.vsids_vars.var());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, antec_data.vsids_vars.getMin());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, antec_data.vsids_vars.getMax());
-
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, antec_data.glue_long_reds.avg());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, antec_data.glue_long_reds.var());
-    sqlite3_bind_int(stmt_clause_stats, bindAt++, antec_data.glue_long_reds.getMin());
-    sqlite3_bind_int(stmt_clause_stats, bindAt++, antec_data.glue_long_reds.getMax());
-
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, antec_data.age_long_reds.avg() );
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, antec_data.age_long_reds.var() );
-    sqlite3_bind_int64(stmt_clause_stats, bindAt++, antec_data.age_long_reds.getMin() );
-    sqlite3_bind_int64(stmt_clause_stats, bindAt++, antec_data.age_long_reds.getMax() );
-
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, antec_data.vsids_of_resolving_literals.avg());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, antec_data.vsids_of_resolving_literals.var());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, antec_data.vsids_of_resolving_literals.getMin());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, antec_data.vsids_of_resolving_literals.getMax());
-
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, antec_data.vsids_all_incoming_vars.avg());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, antec_data.vsids_all_incoming_vars.var());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, antec_data.vsids_all_incoming_vars.getMin());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, antec_data.vsids_all_incoming_vars.getMax());
-
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, antec_data.vsids_of_ants.avg());
-
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.decisionLevelHistLT.avg());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.backtrackLevelHistLT.avg());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.trailDepthHistLT.avg());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.vsidsVarsAvgLT.avg());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.conflSizeHistLT.avg());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.glueHistLTAll.avg());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.numResolutionsHistLT.avg());
-
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.antec_data_sum_sizeHistLT.avg());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.overlapHistLT.avg());
-
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.branchDepthHistQueue.avg_nocheck());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.trailDepthHist.avg_nocheck());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.trailDepthHistLonger.avg_nocheck());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.numResolutionsHist.avg());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.conflSizeHist.avg());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.trailDepthDeltaHist.avg());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.backtrackLevelHist.avg_nocheck());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.glueHist.avg_nocheck());
-    sqlite3_bind_double(stmt_clause_stats, bindAt++, hist.glueHist.getLongtTerm().avg());
-
-    int rc = sqlite3_step(stmt_clause_stats);
-    if (rc != SQLITE_DONE) {
-        cout
-        << "ERROR: while executing clause DB cleaning SQLite prepared statement"
-        << endl;
-
-        cout << "Error from sqlite: "
-        << sqlite3_errmsg(db)
-        << endl;
-        std::exit(-1);
-    }
-
-    if (sqlite3_reset(stmt_clause_stats)) {
-        cerr << "Error calling sqlite3_reset on stmt_clause_stats" << endl;
-        std::exit(-1);
-    }
-
-    if (sqlite3_clear_bindings(stmt_clause_stats)) {
-        cerr << "Error calling sqlite3_clear_bindings on stmt_clause_stats" << endl;
-        std::exit(-1);
+        row.bind_int64(solver->sumRestarts()-1);
     }
+    row.bind_int64(solver->sumConflicts);
+    row.bind_int(solver->latest_feature_calc);
+    row.bind_int64(clauseID);
+
+    row.bind_int(glue);
+    row.bind_int(size);
+    row.bind_int64(conflicts_this_restart);
+    row.bind_int(num_overlap_literals);
+    row.bind_int(antec_data.num());
+    row.bind_int(antec_data.sum_size());
+    row.bind_double((double)antec_data.sum_size()/(double)antec_data.num() );
+    row.bind_double(last_dec_var_act_vsids_0);
+    row.bind_double(last_dec_var_act_vsids_1);
+    row.bind_double(first_dec_var_act_vsids_0);
+    row.bind_double(first_dec_var_act_vsids_1);
+
+    row.bind_int(backtrack_level);
+    row.bind_int64(decision_level);
+    row.bind_int64(hist.branchDepthHistQueue.prev(1));
+    row.bind_int64(hist.branchDepthHistQueue.prev(2));
+    row.bind_int64(trail_depth);
+    row.bind_text(restart_type);
+
+    row.bind_int(antec_data.binIrred);
+    row.bind_int(antec_data.binRed);
+    row.bind_int(antec_data.longIrred);
+    row.bind_int(antec_data.longRed);
+
+    row.bind_double(antec_data.vsids_vars.avg());
+    row.bind_double(antec_data.vsids_vars.var());
+    row.bind_double(antec_data.vsids_vars.getMin());
+    row.bind_double(antec_data.vsids_vars.getMax());
+
+    row.bind_double(antec_data.glue_long_reds.avg());
+    row.bind_double(antec_data.glue_long_reds.var());
+    row.bind_int(antec_data.glue_long_reds.getMin());
+    row.bind_int(antec_data.glue_long_reds.getMax());
+
+    row.bind_double(antec_data.age_long_reds.avg() );
+    row.bind_double(antec_data.age_long_reds.var() );
+    row.bind_int64(antec_data.age_long_reds.getMin() );
+    row.bind_int64(antec_data.age_long_reds.getMax() );
+
+    row.bind_double(antec_data.vsids_of_resolving_literals.avg());
+    row.bind_double(antec_data.vsids_of_resolving_literals.var());
+    row.bind_double(antec_data.vsids_of_resolving_literals.getMin());
+    row.bind_double(antec_data.vsids_of_resolving_literals.getMax());
+
+    row.bind_double(antec_data.vsids_all_incoming_vars.avg());
+    row.bind_double(antec_data.vsids_all_incoming_vars.var());
+    row.bind_double(antec_data.vsids_all_incoming_vars.getMin());
+    row.bind_double(antec_data.vsids_all_incoming_vars.getMax());
+
+    row.bind_double(antec_data.vsids_of_ants.avg());
+
+    row.bind_double(hist.decisionLevelHistLT.avg());
+    row.bind_double(hist.backtrackLevelHistLT.avg());
+    row.bind_double(hist.trailDepthHistLT.avg());
+    row.bind_double(hist.vsidsVarsAvgLT.avg());
+    row.bind_double(hist.conflSizeHistLT.avg());
+    row.bind_double(hist.glueHistLTAll.avg());
+    row.bind_double(hist.numResolutionsHistLT.avg());
+
+    row.bind_double(hist.antec_data_sum_sizeHistLT.avg());
+    row.bind_double(hist.overlapHistLT.avg());
+
+    row.bind_double(hist.branchDepthHistQueue.avg_nocheck());
+    row.bind_double(hist.trailDepthHist.avg_nocheck());
+    row.bind_double(hist.trailDepthHistLonger.avg_nocheck());
+    row.bind_double(hist.numResolutionsHist.avg());
+    row.bind_double(hist.conflSizeHist.avg());
+    row.bind_double(hist.trailDepthDeltaHist.avg());
+    row.bind_double(hist.backtrackLevelHist.avg_nocheck());
+    row.bind_double(hist.glueHist.avg_nocheck());
+    row.bind_double(hist.glueHist.getLongtTerm().avg());
+
+    row_done();
 }
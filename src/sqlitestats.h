@@ -23,18 +23,211 @@ THE SOFTWARE.
 #include "sqlstats.h"
 #include "solvefeatures.h"
 #include <sqlite3.h>
+#include <memory>
+#include <atomic>
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 namespace CMSat {
 
+//Tables that the solver threads insert rows into. Each has a prepared
+//statement. Tags and the finishup row are rare and are handed to the
+//SQLiteWriter directly.
+enum class SQLTable {
+    restart
+    , reduceDB
+    , timepassed
+    , memused
+    , features
+    , clause_stats
+};
 
-class SQLiteStats: public SQLStats
+//Widest table is clauseStats
+static const size_t sql_max_cols = 72;
+static const size_t sql_max_text = 64;
+
+struct SQLValue
+{
+    enum Type {int_t, double_t, text_t, null_t};
+    Type type;
+    union {
+        int64_t i;
+        double d;
+    };
+};
+
+//The values of a row, in the order of the columns of the prepared statement.
+//Filled by the solver thread in its ring, bound and inserted later by the
+//writer thread. A row has at most one text value, truncated to
+//sql_max_text-1 characters (they are names like "occ-bve" or "luby").
+struct SQLRow
+{
+    void reset(const SQLTable _table)
+    {
+        table = _table;
+        num_vals = 0;
+        text[0] = 0;
+    }
+
+    SQLValue& next_val()
+    {
+        assert(num_vals < sql_max_cols);
+        return vals[num_vals++];
+    }
+
+    void bind_int64(const int64_t v)
+    {
+        SQLValue& val = next_val();
+        val.type = SQLValue::int_t;
+        val.i = v;
+    }
+
+    void bind_int(const int v)
+    {
+        bind_int64(v);
+    }
+
+    void bind_double(const double v)
+    {
+        SQLValue& val = next_val();
+        val.type = SQLValue::double_t;
+        val.d = v;
+    }
+
+    void bind_text(const string& v)
+    {
+        assert(text[0] == 0);
+        SQLValue& val = next_val();
+        val.type = SQLValue::text_t;
+        const size_t len = std::min(v.size(), sql_max_text-1);
+        memcpy(text, v.data(), len);
+        text[len] = 0;
+    }
+
+    void bind_null()
+    {
+        SQLValue& val = next_val();
+        val.type = SQLValue::null_t;
+    }
+
+    SQLTable table;
+    uint32_t num_vals;
+    SQLValue vals[sql_max_cols];
+    char text[sql_max_text];
+};
+
+//Single producer (a solver thread), single consumer (the writer thread).
+//"head" is only written by the producer, "tail" only by the consumer, so
+//handing over a row needs no lock and no allocation.
+struct SQLRing
+{
+    static const uint64_t size = 1024; //must be a power of 2
+
+    std::atomic<uint64_t> head {0};
+    char pad[64 - sizeof(std::atomic<uint64_t>)];
+    std::atomic<uint64_t> tail {0};
+    SQLRow rows[size];
+};
+
+//Owns the database, shared by the SQLiteStats of all threads. Each thread
+//gets an SQLRing from add_thread(). The background thread drains the rings
+//when woken up or every few milliseconds, everything it finds waiting is
+//inserted in one transaction.
+class SQLiteWriter
 {
 public:
-    ~SQLiteStats() override;
-    explicit SQLiteStats(std::string _filename) :
+    explicit SQLiteWriter(const string& _filename) :
         filename(_filename)
     {
     }
+    ~SQLiteWriter();
+    SQLiteWriter(const SQLiteWriter&) = delete;
+    SQLiteWriter& operator=(const SQLiteWriter&) = delete;
+
+    //Only the first call does anything
+    bool setup(const Solver* solver);
+    unsigned long get_runID() const
+    {
+        return runID;
+    }
+
+    //Called by the producer when its ring is filling up
+    void wake_up();
+
+    //The ring stays valid until the writer is destroyed
+    SQLRing* add_thread();
+    void remove_thread();
+    void add_tag(const std::pair<string, string>& tag);
+
+    //Each thread calls this at the end of solve(). The status is written
+    //when the last one has, after all the rows the threads wrote before.
+    void finishup(const lbool status);
+
+private:
+    bool connectServer(const int verbosity);
+    void getID(const Solver* solver);
+    bool tryIDInSQL(const Solver* solver);
+
+    void addStartupData();
+    void initRestartSTMT();
+    void initTimePassedSTMT();
+    void initMemUsedSTMT();
+    void init_clause_stats_STMT();
+    void init_features();
+    void initReduceDBSTMT();
+    void init_tags_finishup_STMT();
+
+    void writeQuestionMarks(size_t num, std::stringstream& ss);
+    sqlite3_stmt* get_stmt(const SQLTable table) const;
+    bool rows_waiting() const;
+    void write_loop();
+    void drain(SQLRing* ring);
+    void write_row(const SQLRow& row);
+    void write_tag(const std::pair<string, string>& tag);
+    void write_finishup(const lbool status);
+    void step(sqlite3_stmt* stmt);
+    void exec(const char* sql);
+
+    sqlite3_stmt *stmtTimePassed = NULL;
+    sqlite3_stmt *stmtMemUsed = NULL;
+    sqlite3_stmt *stmtReduceDB = NULL;
+    sqlite3_stmt *stmtRst = NULL;
+    sqlite3_stmt *stmtFeat = NULL;
+    sqlite3_stmt *stmt_clause_stats = NULL;
+    sqlite3_stmt *stmtTags = NULL;
+    sqlite3_stmt *stmtFinishup = NULL;
+
+    sqlite3 *db = NULL;
+    bool setup_done = false;
+    bool setup_ok = false;
+    const string filename;
+    unsigned long runID = 0;
+
+    //Shared with the writer thread
+    std::mutex mu;
+    std::condition_variable cond_todo;
+    vector<std::unique_ptr<SQLRing> > rings;
+    vector<std::pair<string, string> > tags;
+    lbool finish_todo = l_Undef;
+    bool finish_waiting = false;
+    bool stop = false;
+    uint32_t num_threads = 0;
+    uint32_t num_finished = 0;
+    lbool finish_status = l_Undef;
+    std::thread writer;
+};
+
+//One per solver thread. Rows are written straight into the thread's ring,
+//without any locking.
+class SQLiteStats: public SQLStats
+{
+public:
+    ~SQLiteStats() override;
+    explicit SQLiteStats(std::string _filename);
+    SQLiteStats(std::shared_ptr<SQLiteWriter> _writer, uint32_t _thread_num);
 
     void restart(
         const std::string& restart_type
@@ -99,33 +292,15 @@ public:
     bool setup(const Solver* solver) override;
     void finishup(lbool status) override;
     void add_tag(const std::pair<std::string, std::string>& tag) override;
+    SQLStats* new_for_thread(uint32_t thread_num) override;
 
 private:
+    SQLRow& new_row(const SQLTable table);
+    void row_done();
 
-    bool connectServer(const int verbosity);
-    void getID(const Solver* solver);
-    bool tryIDInSQL(const Solver* solver);
-
-    void addStartupData();
-    void initRestartSTMT();
-    void initTimePassedSTMT();
-    void initMemUsedSTMT();
-    void init_clause_stats_STMT();
-    void init_features();
-
-    void writeQuestionMarks(size_t num, std::stringstream& ss);
-    void initReduceDBSTMT();
-
-    sqlite3_stmt *stmtTimePassed = NULL;
-    sqlite3_stmt *stmtMemUsed = NULL;
-    sqlite3_stmt *stmtReduceDB = NULL;
-    sqlite3_stmt *stmtRst = NULL;
-    sqlite3_stmt *stmtFeat = NULL;
-    sqlite3_stmt *stmt_clause_stats = NULL;
-
-    sqlite3 *db = NULL;
-    bool setup_ok = false;
-    const string filename;
+    std::shared_ptr<SQLiteWriter> writer;
+    SQLRing* ring;
+    const uint32_t thread_num;
 };
 
 }
@@ -28,9 +28,10 @@ SQLStats::~SQLStats() = default;
 #ifndef _MSC_VER
 #include <fcntl.h>
 #include <unistd.h>
-void SQLStats::getRandomID()
+unsigned long SQLStats::get_random_runID()
 {
     //Generate random ID for SQL
+    unsigned long runID;
     int randomData = open("/dev/urandom", O_RDONLY);
     if (randomData == -1) {
         cout << "Error reading from /dev/urandom !" << endl;
@@ -50,15 +51,18 @@ void SQLStats::getRandomID()
 
     if (runID == 0)
         runID = 1;
+
+    return runID;
 }
 #else
 #include <ctime>
-void SQLStats::getRandomID()
+unsigned long SQLStats::get_random_runID()
 {
     srand((unsigned) time(NULL));
-    runID = rand();
+    unsigned long runID = rand();
     if (runID == 0) {
         runID = 1;
     }
+    return runID;
 }
 #endif
@@ -106,9 +106,11 @@ public:
     }
     virtual void add_tag(const std::pair<std::string, std::string>& tag) = 0;
 
-protected:
+    //Writes to the same database, rows tagged with "thread_num"
+    virtual SQLStats* new_for_thread(uint32_t thread_num) = 0;
+    static unsigned long get_random_runID();
 
-    void getRandomID();
+protected:
     unsigned long runID;
 };
 
@@ -198,7 +198,9 @@ public:
     {
         str.clear();
         skipWhitespace();
-        while (value() != ' ' && value() != '\n' && value() != EOF) {
+        while (value() != ' ' && value() != '\t' && value() != '\r'
+            && value() != '\n' && value() != EOF
+        ) {
             str.push_back(value());
             advance();
         }
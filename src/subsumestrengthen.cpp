@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "solvertypes.h"
 #include "subsumeimplicit.h"
 #include <array>
+#include <thread>
 
 //#define VERBOSE_DEBUG
 
@@ -57,14 +58,22 @@ uint32_t SubsumeStrengthen::subsume_and_unlink_and_markirred(const ClOffset offs
     Sub0Ret ret = subsume_and_unlink(
         offset
         , cl
-        , cl.abst
+        , solver->cl_alloc.abst(cl)
     );
 
+    return markirred_and_combine(cl, ret);
+}
+
+uint32_t SubsumeStrengthen::markirred_and_combine(Clause& cl, const Sub0Ret& ret)
+{
     //If irred is subsumed by redundant, make the redundant into irred
     if (cl.red()
         && ret.subsumedIrred
     ) {
         cl.makeIrred();
+        #ifdef STATS_NEEDED
+        solver->cl_alloc.stats(cl).ID = 0;
+        #endif
         solver->litStats.redLits -= cl.size();
         solver->litStats.irredLits += cl.size();
         if (!cl.getOccurLinked()) {
@@ -77,7 +86,8 @@ uint32_t SubsumeStrengthen::subsume_and_unlink_and_markirred(const ClOffset offs
     }
 
     //Combine stats
-    cl.combineStats(ret.stats);
+    ClauseStats& stats = solver->cl_alloc.stats(cl);
+    stats = ClauseStats::combineStats(stats, ret.stats);
 
     return ret.numSubsumed;
 }
@@ -98,15 +108,26 @@ SubsumeStrengthen::Sub0Ret SubsumeStrengthen::subsume_and_unlink(
     , const cl_abst_type abs
     , const bool removeImplicit
 ) {
-    Sub0Ret ret;
-
     subs.clear();
     find_subsumed(offset, ps, abs, subs, removeImplicit);
 
+    return unlink_subsumed(subs);
+}
+
+SubsumeStrengthen::Sub0Ret SubsumeStrengthen::unlink_subsumed(
+    const vector<ClOffset>& subsumed
+) {
+    Sub0Ret ret;
+
     //Go through each clause that can be subsumed
-    for (const ClOffset offs: subs) {
+    for (const ClOffset offs: subsumed) {
         Clause *tmp = solver->cl_alloc.ptr(offs);
-        ret.stats = ClauseStats::combineStats(tmp->stats, ret.stats);
+
+        //Already removed by a clause applied earlier in the same window
+        if (tmp->getRemoved())
+            continue;
+
+        ret.stats = ClauseStats::combineStats(solver->cl_alloc.stats(tmp), ret.stats);
         #ifdef VERBOSE_DEBUG
         cout << "-> subsume removing:" << *tmp << endl;
         #endif
@@ -130,7 +151,6 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_
 {
     subs.clear();
     subsLits.clear();
-    Sub1Ret ret;
     Clause& cl = *solver->cl_alloc.ptr(offset);
     assert(!cl.getRemoved());
     assert(!cl.freed());
@@ -141,16 +161,35 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_
     findStrengthened(
         offset
         , cl
-        , cl.abst
+        , solver->cl_alloc.abst(cl)
         , subs
         , subsLits
+        , *simplifier->limit_to_decrease
     );
 
+    return apply_strengthened(offset, subs, subsLits, false);
+}
+
+/**
+@brief Subsumes or strengthens the clauses found by findStrengthened
+
+@param recheck The clauses may have changed since they were found, so the
+relationship is re-computed before applying it
+*/
+SubsumeStrengthen::Sub1Ret SubsumeStrengthen::apply_strengthened(
+    const ClOffset offset
+    , const vector<ClOffset>& subsumed
+    , const vector<Lit>& lits
+    , const bool recheck
+) {
+    Sub1Ret ret;
+    Clause& cl = *solver->cl_alloc.ptr(offset);
+
     for (size_t j = 0
-        ; j < subs.size() && solver->okay()
+        ; j < subsumed.size() && solver->okay()
         ; j++
     ) {
-        ClOffset offset2 = subs[j];
+        ClOffset offset2 = subsumed[j];
         Clause& cl2 = *solver->cl_alloc.ptr(offset2);
         #ifdef USE_GAUSS
         if (cl2.used_in_xor()) {
@@ -158,7 +197,17 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_
         }
         #endif
 
-        if (subsLits[j] == lit_Undef) {  //Subsume
+        Lit litSub = lits[j];
+        if (recheck) {
+            if (cl2.getRemoved())
+                continue;
+
+            litSub = subset1(cl, cl2, *simplifier->limit_to_decrease);
+            if (litSub == lit_Error)
+                continue;
+        }
+
+        if (litSub == lit_Undef) {  //Subsume
             #ifdef VERBOSE_DEBUG
             if (solver->conf.verbosity >= 6)
                 cout << "subsumed clause " << cl2 << endl;
@@ -169,6 +218,9 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_
                 && !cl2.red()
             ) {
                 cl.makeIrred();
+                #ifdef STATS_NEEDED
+                solver->cl_alloc.stats(cl).ID = 0;
+                #endif
                 solver->litStats.redLits -= cl.size();
                 solver->litStats.irredLits += cl.size();
                 if (!cl.getOccurLinked()) {
@@ -181,7 +233,8 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_
             }
 
             //Update stats
-            cl.combineStats(cl2.stats);
+            ClauseStats& stats = solver->cl_alloc.stats(cl);
+            stats = ClauseStats::combineStats(stats, solver->cl_alloc.stats(cl2));
 
             simplifier->unlink_clause(offset2, true, false, true);
             ret.sub++;
@@ -196,7 +249,7 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_
                 continue;
             }
             #endif
-            remove_literal(offset2, subsLits[j]);
+            remove_literal(offset2, litSub);
 
             ret.str++;
             if (!solver->ok)
@@ -236,30 +289,34 @@ void SubsumeStrengthen::backw_sub_long_with_long()
     size_t subsumed = 0;
     const int64_t orig_limit = simplifier->subsumption_time_limit;
     randomise_clauses_order();
-    while (*simplifier->limit_to_decrease > 0
-        && (double)wenThrough < solver->conf.subsume_gothrough_multip*(double)simplifier->clauses.size()
-    ) {
-        *simplifier->limit_to_decrease -= 3;
-        wenThrough++;
-
-        //Print status
-        if (solver->conf.verbosity >= 5
-            && wenThrough % 10000 == 0
+    if (solver->conf.sub_str_threads > 1) {
+        backw_sub_long_with_long_par(wenThrough, subsumed);
+    } else {
+        while (*simplifier->limit_to_decrease > 0
+            && (double)wenThrough < solver->conf.subsume_gothrough_multip*(double)simplifier->clauses.size()
         ) {
-            cout << "toDecrease: " << *simplifier->limit_to_decrease << endl;
-        }
+            *simplifier->limit_to_decrease -= 3;
+            wenThrough++;
 
-        const size_t at = wenThrough % simplifier->clauses.size();
-        const ClOffset offset = simplifier->clauses[at];
-        Clause* cl = solver->cl_alloc.ptr(offset);
+            //Print status
+            if (solver->conf.verbosity >= 5
+                && wenThrough % 10000 == 0
+            ) {
+                cout << "toDecrease: " << *simplifier->limit_to_decrease << endl;
+            }
 
-        //Has already been removed
-        if (cl->freed() || cl->getRemoved())
-            continue;
+            const size_t at = wenThrough % simplifier->clauses.size();
+            const ClOffset offset = simplifier->clauses[at];
+            Clause* cl = solver->cl_alloc.ptr(offset);
 
+            //Has already been removed
+            if (cl->freed() || cl->getRemoved())
+                continue;
 
-        *simplifier->limit_to_decrease -= 10;
-        subsumed += subsume_and_unlink_and_markirred(offset);
+
+            *simplifier->limit_to_decrease -= 10;
+            subsumed += subsume_and_unlink_and_markirred(offset);
+        }
     }
 
     const double time_used = cpuTime() - myTime;
@@ -300,30 +357,34 @@ bool SubsumeStrengthen::backw_str_long_with_long()
     Sub1Ret ret;
 
     randomise_clauses_order();
-    while(*simplifier->limit_to_decrease > 0
-        && wenThrough < 1.5*(double)2*simplifier->clauses.size()
-        && solver->okay()
-    ) {
-        *simplifier->limit_to_decrease -= 10;
-        wenThrough++;
-
-        //Print status
-        if (solver->conf.verbosity >= 5
-            && wenThrough % 10000 == 0
+    if (solver->conf.sub_str_threads > 1) {
+        backw_str_long_with_long_par(wenThrough, ret);
+    } else {
+        while(*simplifier->limit_to_decrease > 0
+            && wenThrough < 1.5*(double)2*simplifier->clauses.size()
+            && solver->okay()
         ) {
-            cout << "toDecrease: " << *simplifier->limit_to_decrease << endl;
-        }
+            *simplifier->limit_to_decrease -= 10;
+            wenThrough++;
+
+            //Print status
+            if (solver->conf.verbosity >= 5
+                && wenThrough % 10000 == 0
+            ) {
+                cout << "toDecrease: " << *simplifier->limit_to_decrease << endl;
+            }
 
-        const size_t at = wenThrough % simplifier->clauses.size();
-        ClOffset offset = simplifier->clauses[at];
-        Clause* cl = solver->cl_alloc.ptr(offset);
+            const size_t at = wenThrough % simplifier->clauses.size();
+            ClOffset offset = simplifier->clauses[at];
+            Clause* cl = solver->cl_alloc.ptr(offset);
 
-        //Has already been removed
-        if (cl->freed() || cl->getRemoved())
-            continue;
+            //Has already been removed
+            if (cl->freed() || cl->getRemoved())
+                continue;
 
-        ret += strengthen_subsume_and_unlink_and_markirred(offset);
+            ret += strengthen_subsume_and_unlink_and_markirred(offset);
 
+        }
     }
 
     const double time_used = cpuTime() - myTime;
@@ -359,6 +420,165 @@ bool SubsumeStrengthen::backw_str_long_with_long()
     return solver->okay();
 }
 
+//Number of clauses searched by the threads before the results are applied
+static const size_t par_window = 16*1024;
+
+/**
+@brief Runs the occur-list search for each clause in todo on conf.sub_str_threads threads
+
+Searching only reads the occur lists and the clauses, so the threads need no
+locking. Every clause's result is independent of how the clauses are split
+among the threads.
+*/
+void SubsumeStrengthen::par_find(
+    const vector<ClOffset>& todo
+    , vector<ParFound>& found
+    , const bool strengthen
+) {
+    if (found.size() < todo.size()) {
+        found.resize(todo.size());
+    }
+    const size_t num_threads = std::max<size_t>(1,
+        std::min<size_t>(solver->conf.sub_str_threads, todo.size()));
+
+    auto find_some = [&](const size_t thread_num) {
+        for(size_t i = thread_num; i < todo.size(); i += num_threads) {
+            ParFound& f = found[i];
+            f.subs.clear();
+            f.subsLits.clear();
+            f.cost = 0;
+
+            const Clause& cl = *solver->cl_alloc.ptr(todo[i]);
+            if (cl.freed() || cl.getRemoved())
+                continue;
+
+            if (strengthen) {
+                findStrengthened(todo[i], cl, solver->cl_alloc.abst(cl), f.subs, f.subsLits, f.cost);
+            } else {
+                find_subsumed(todo[i], cl, solver->cl_alloc.abst(cl), f.subs, false, f.cost);
+            }
+        }
+    };
+
+    vector<std::thread> threads;
+    for(size_t i = 1; i < num_threads; i++) {
+        threads.push_back(std::thread(find_some, i));
+    }
+    find_some(0);
+    for(std::thread& t: threads) {
+        t.join();
+    }
+}
+
+/**
+@brief Same walk over the clauses as backw_sub_long_with_long, in windows
+
+Each window is searched by par_find() and the results are then applied in the
+order of the walk. Clauses removed by an earlier clause of the same window are
+skipped. As the search cost is charged in walk order, too, the result is the
+same regardless of the number of threads.
+*/
+void SubsumeStrengthen::backw_sub_long_with_long_par(
+    size_t& wenThrough
+    , size_t& subsumed
+) {
+    const double max_through =
+        solver->conf.subsume_gothrough_multip*(double)simplifier->clauses.size();
+
+    while (*simplifier->limit_to_decrease > 0
+        && (double)wenThrough < max_through
+    ) {
+        par_todo.clear();
+        for(size_t w = wenThrough
+            ; par_todo.size() < par_window && (double)w < max_through
+            ; w++
+        ) {
+            const size_t at = (w+1) % simplifier->clauses.size();
+            par_todo.push_back(simplifier->clauses[at]);
+        }
+        par_find(par_todo, par_found, false);
+
+        for(size_t i = 0
+            ; i < par_todo.size() && *simplifier->limit_to_decrease > 0
+            ; i++
+        ) {
+            *simplifier->limit_to_decrease -= 3;
+            wenThrough++;
+
+            const ClOffset offset = par_todo[i];
+            Clause* cl = solver->cl_alloc.ptr(offset);
+
+            //Has already been removed
+            if (cl->freed() || cl->getRemoved())
+                continue;
+
+            *simplifier->limit_to_decrease -= 10;
+            *simplifier->limit_to_decrease += par_found[i].cost;
+            const Sub0Ret ret = unlink_subsumed(par_found[i].subs);
+            subsumed += markirred_and_combine(*cl, ret);
+        }
+
+        if (solver->must_interrupt_asap())
+            break;
+    }
+}
+
+/**
+@brief Same walk over the clauses as backw_str_long_with_long, in windows
+
+Strengthening changes clauses, so every clause found is re-checked against
+the current state of both clauses before it is applied.
+*/
+void SubsumeStrengthen::backw_str_long_with_long_par(
+    size_t& wenThrough
+    , Sub1Ret& ret
+) {
+    const double max_through = 1.5*(double)2*simplifier->clauses.size();
+
+    while (*simplifier->limit_to_decrease > 0
+        && wenThrough < max_through
+        && solver->okay()
+    ) {
+        par_todo.clear();
+        for(size_t w = wenThrough
+            ; par_todo.size() < par_window && w < max_through
+            ; w++
+        ) {
+            const size_t at = (w+1) % simplifier->clauses.size();
+            par_todo.push_back(simplifier->clauses[at]);
+        }
+        par_find(par_todo, par_found, true);
+
+        for(size_t i = 0
+            ; i < par_todo.size()
+            && *simplifier->limit_to_decrease > 0
+            && solver->okay()
+            ; i++
+        ) {
+            *simplifier->limit_to_decrease -= 10;
+            wenThrough++;
+
+            const ClOffset offset = par_todo[i];
+            Clause* cl = solver->cl_alloc.ptr(offset);
+
+            //Has already been removed
+            if (cl->freed() || cl->getRemoved())
+                continue;
+
+            *simplifier->limit_to_decrease += par_found[i].cost;
+            ret += apply_strengthened(
+                offset
+                , par_found[i].subs
+                , par_found[i].subsLits
+                , true
+            );
+        }
+
+        if (solver->must_interrupt_asap())
+            break;
+    }
+}
+
 /**
 @brief Helper function for findStrengthened
 
@@ -372,10 +592,11 @@ void inline SubsumeStrengthen::fillSubs(
     , vector<ClOffset>& out_subsumed
     , vector<Lit>& out_lits
     , const Lit lit
-) {
+    , int64_t& limit
+) const {
     Lit litSub;
     watch_subarray_const cs = solver->watches[lit];
-    *simplifier->limit_to_decrease -= (long)cs.size()*2+ 40;
+    limit -= (long)cs.size()*2+ 40;
     for (const Watched *it = cs.begin(), *end = cs.end()
         ; it != end
         ; ++it
@@ -397,8 +618,8 @@ void inline SubsumeStrengthen::fillSubs(
             continue;
         }
 
-        *simplifier->limit_to_decrease -= (long)((cl.size() + cl2.size())/4);
-        litSub = subset1(cl, cl2);
+        limit -= (long)((cl.size() + cl2.size())/4);
+        litSub = subset1(cl, cl2, limit);
         if (litSub != lit_Error) {
             out_subsumed.push_back(it->get_offset());
             out_lits.push_back(litSub);
@@ -427,6 +648,9 @@ Checks if:
 @param[out] out_subsumed The clauses that could be modified by ps
 @param[out] out_lits Defines HOW these clauses could be modified. By removing
 literal, or by subsumption (in this case, there is lit_Undef here)
+@param[in,out] limit Time limit to decrease
+
+Only reads the occur lists and the clauses
 */
 template<class T>
 void SubsumeStrengthen::findStrengthened(
@@ -435,7 +659,8 @@ void SubsumeStrengthen::findStrengthened(
     , const cl_abst_type abs
     , vector<ClOffset>& out_subsumed
     , vector<Lit>& out_lits
-)
+    , int64_t& limit
+) const
 {
     #ifdef VERBOSE_DEBUG
     cout << "findStrengthened: " << cl << endl;
@@ -454,10 +679,10 @@ void SubsumeStrengthen::findStrengthened(
         }
     }
     assert(minVar != var_Undef);
-    *simplifier->limit_to_decrease -= (long)cl.size();
+    limit -= (long)cl.size();
 
-    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, true));
-    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, false));
+    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, true), limit);
+    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, false), limit);
 }
 
 bool SubsumeStrengthen::handle_added_long_cl(
@@ -480,7 +705,7 @@ bool SubsumeStrengthen::handle_added_long_cl(
         if (cl->freed() || cl->getRemoved())
             continue;
 
-        cl->stats.marked_clause = 0;
+        solver->cl_alloc.stats(cl).marked_clause = 0;
         auto ret = strengthen_subsume_and_unlink_and_markirred(offs);
         stat += ret;
         if (!solver->ok) {
@@ -507,7 +732,7 @@ bool SubsumeStrengthen::handle_added_long_cl(
             if (cl->freed() || cl->getRemoved())
                 continue;
 
-            cl->stats.marked_clause = 0;
+            solver->cl_alloc.stats(cl).marked_clause = 0;
         }
     }
 
@@ -551,7 +776,7 @@ void SubsumeStrengthen::remove_literal(ClOffset offset, const Lit toRemoveLit)
     (*solver->drat) << deldelay << cl << fin;
     cl.strengthen(toRemoveLit);
     simplifier->added_cl_to_var.touch(toRemoveLit.var());
-    cl.recalc_abst_if_needed();
+    solver->cl_alloc.recalc_abst_if_needed(cl);
     (*solver->drat) << add << cl
     #ifdef STATS_NEEDED
     << solver->sumConflicts
@@ -588,7 +813,7 @@ bool SubsumeStrengthen::subsetAbst(const cl_abst_type A, const cl_abst_type B)
 
 //A subsumes B (A <= B)
 template<class T1, class T2>
-bool SubsumeStrengthen::subset(const T1& A, const T2& B)
+bool SubsumeStrengthen::subset(const T1& A, const T2& B, int64_t& limit)
 {
     #ifdef MORE_DEUBUG
     cout << "A:" << A << endl;
@@ -629,7 +854,7 @@ bool SubsumeStrengthen::subset(const T1& A, const T2& B)
     ret = false;
 
     end:
-    *simplifier->limit_to_decrease -= (long)i2*4 + (long)i*4;
+    limit -= (long)i2*4 + (long)i*4;
     return ret;
 }
 
@@ -647,7 +872,7 @@ clause B
 and returns the literal to remove if (2) is true
 */
 template<class T1, class T2>
-Lit SubsumeStrengthen::subset1(const T1& A, const T2& B)
+Lit SubsumeStrengthen::subset1(const T1& A, const T2& B, int64_t& limit)
 {
     Lit retLit = lit_Undef;
 
@@ -679,13 +904,15 @@ Lit SubsumeStrengthen::subset1(const T1& A, const T2& B)
     retLit = lit_Error;
 
     end:
-    *simplifier->limit_to_decrease -= (long)i2*4 + (long)i*4;
+    limit -= (long)i2*4 + (long)i*4;
     return retLit;
 }
 
 template<class T>
-size_t SubsumeStrengthen::find_smallest_watchlist_for_clause(const T& ps) const
-{
+size_t SubsumeStrengthen::find_smallest_watchlist_for_clause(
+    const T& ps
+    , int64_t& limit
+) const {
     size_t min_i = 0;
     size_t min_num = solver->watches[ps[min_i]].size();
     for (uint32_t i = 1; i < ps.size(); i++){
@@ -695,7 +922,7 @@ size_t SubsumeStrengthen::find_smallest_watchlist_for_clause(const T& ps) const
             min_num = this_num;
         }
     }
-    *simplifier->limit_to_decrease -= (long)ps.size();
+    limit -= (long)ps.size();
 
     return min_i;
 }
@@ -712,6 +939,29 @@ template<class T> void SubsumeStrengthen::find_subsumed(
     , const cl_abst_type abs //Abstraction of literals in clause
     , vector<ClOffset>& out_subsumed //List of clause indexes subsumed
     , bool removeImplicit
+) {
+    find_subsumed(
+        offset
+        , ps
+        , abs
+        , out_subsumed
+        , removeImplicit
+        , *simplifier->limit_to_decrease
+    );
+}
+
+/**
+@brief Same as above, decreasing the given limit
+
+@note Unless removeImplicit is set, only reads the occur lists and the clauses
+*/
+template<class T> void SubsumeStrengthen::find_subsumed(
+    const ClOffset offset
+    , const T& ps
+    , const cl_abst_type abs
+    , vector<ClOffset>& out_subsumed
+    , bool removeImplicit
+    , int64_t& limit
 ) {
     #ifdef VERBOSE_DEBUG
     cout << "find_subsumed: ";
@@ -721,11 +971,11 @@ template<class T> void SubsumeStrengthen::find_subsumed(
     cout << endl;
     #endif
 
-    const size_t smallest = find_smallest_watchlist_for_clause(ps);
+    const size_t smallest = find_smallest_watchlist_for_clause(ps, limit);
 
     //Go through the occur list of the literal that has the smallest occur list
     watch_subarray occ = solver->watches[ps[smallest]];
-    *simplifier->limit_to_decrease -= (long)occ.size()*8 + 40;
+    limit -= (long)occ.size()*8 + 40;
 
     Watched* it = occ.begin();
     Watched* it2 = occ.begin();
@@ -753,14 +1003,14 @@ template<class T> void SubsumeStrengthen::find_subsumed(
                     continue;
                 }
             }
+            *it2++ = *it;
         }
-        *it2++ = *it;
 
         if (!it->isClause()) {
             continue;
         }
 
-        *simplifier->limit_to_decrease -= 15;
+        limit -= 15;
 
         if (it->get_offset() == offset
             || !subsetAbst(abs, it->getAbst())
@@ -774,15 +1024,17 @@ template<class T> void SubsumeStrengthen::find_subsumed(
         if (ps.size() > cl2.size() || cl2.getRemoved())
             continue;
 
-        *simplifier->limit_to_decrease -= 50;
-        if (subset(ps, cl2)) {
+        limit -= 50;
+        if (subset(ps, cl2, limit)) {
             out_subsumed.push_back(offset2);
             #ifdef VERBOSE_DEBUG
             cout << "subsumed cl offset: " << offset2 << endl;
             #endif
         }
     }
-    occ.shrink(it-it2);
+    if (removeImplicit) {
+        occ.shrink(it-it2);
+    }
 }
 template void SubsumeStrengthen::find_subsumed(
     const ClOffset offset
@@ -797,6 +1049,12 @@ size_t SubsumeStrengthen::mem_used() const
     size_t b = 0;
     b += subs.capacity()*sizeof(ClOffset);
     b += subsLits.capacity()*sizeof(Lit);
+    b += par_todo.capacity()*sizeof(ClOffset);
+    for(const ParFound& f: par_found) {
+        b += f.subs.capacity()*sizeof(ClOffset);
+        b += f.subsLits.capacity()*sizeof(Lit);
+    }
+    b += par_found.capacity()*sizeof(ParFound);
 
     return b;
 }
@@ -862,6 +1120,7 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::backw_sub_str_long_with_implicit(
         , calcAbstraction(lits)
         , subs
         , subsLits
+        , *simplifier->limit_to_decrease
     );
 
     Sub1Ret ret;
@@ -119,12 +119,46 @@ private:
         , const cl_abst_type abs
         , const bool removeImplicit = false
     );
+    Sub0Ret unlink_subsumed(const vector<ClOffset>& subsumed);
+    uint32_t markirred_and_combine(Clause& cl, const Sub0Ret& ret);
+    Sub1Ret apply_strengthened(
+        const ClOffset offset
+        , const vector<ClOffset>& subsumed
+        , const vector<Lit>& lits
+        , const bool recheck
+    );
+
+    //Multi-threaded find, single-threaded apply (see conf.sub_str_threads)
+    struct ParFound {
+        vector<ClOffset> subs;
+        vector<Lit> subsLits;
+        int64_t cost = 0;
+    };
+    void par_find(
+        const vector<ClOffset>& todo
+        , vector<ParFound>& found
+        , const bool strengthen
+    );
+    void backw_sub_long_with_long_par(size_t& wenThrough, size_t& subsumed);
+    void backw_str_long_with_long_par(size_t& wenThrough, Sub1Ret& ret);
+    vector<ClOffset> par_todo;
+    vector<ParFound> par_found;
 
     void randomise_clauses_order();
     void remove_literal(ClOffset c, const Lit toRemoveLit);
 
     template<class T>
-    size_t find_smallest_watchlist_for_clause(const T& ps) const;
+    void find_subsumed(
+        const ClOffset offset
+        , const T& ps
+        , const cl_abst_type abs
+        , vector<ClOffset>& out_subsumed
+        , const bool removeImplicit
+        , int64_t& limit
+    );
+
+    template<class T>
+    size_t find_smallest_watchlist_for_clause(const T& ps, int64_t& limit) const;
 
     template<class T>
     void findStrengthened(
@@ -133,7 +167,8 @@ private:
         , const cl_abst_type abs
         , vector<ClOffset>& out_subsumed
         , vector<Lit>& out_lits
-    );
+        , int64_t& limit
+    ) const;
 
     template<class T>
     void fillSubs(
@@ -143,14 +178,15 @@ private:
         , vector<ClOffset>& out_subsumed
         , vector<Lit>& out_lits
         , const Lit lit
-    );
+        , int64_t& limit
+    ) const;
 
     template<class T1, class T2>
-    bool subset(const T1& A, const T2& B);
+    static bool subset(const T1& A, const T2& B, int64_t& limit);
 
     template<class T1, class T2>
-    Lit subset1(const T1& A, const T2& B);
-    bool subsetAbst(const cl_abst_type A, const cl_abst_type B);
+    static Lit subset1(const T1& A, const T2& B, int64_t& limit);
+    static bool subsetAbst(const cl_abst_type A, const cl_abst_type B);
 
     vector<ClOffset> subs;
     vector<Lit> subsLits;
@@ -510,6 +510,7 @@ bool VarReplacer::replace_set(vector<ClOffset>& cs)
 
         const Lit origLit1 = c[0];
         const Lit origLit2 = c[1];
+        const Lit origLit3 = c[2];
 
         for (Lit& l: c) {
             if (isReplaced_fast(l)) {
@@ -519,7 +520,7 @@ bool VarReplacer::replace_set(vector<ClOffset>& cs)
             }
         }
 
-        if (changed && handleUpdatedClause(c, origLit1, origLit2)) {
+        if (changed && handleUpdatedClause(c, origLit1, origLit2, origLit3)) {
             runStats.removedLongClauses++;
             if (!solver->ok) {
                 return false;
@@ -552,6 +553,10 @@ bool VarReplacer::handleUpdatedClause(
     Clause& c
     , const Lit origLit1
     , const Lit origLit2
+    , const Lit
+    #ifdef INLINE_TERNARY
+    origLit3
+    #endif
 ) {
     assert(!c.getRemoved());
     bool satisfied = false;
@@ -559,6 +564,16 @@ bool VarReplacer::handleUpdatedClause(
     Lit p;
     uint32_t i, j;
     const uint32_t origSize = c.size();
+    auto smudge_orig_watches = [&]() {
+        solver->watches.smudge(origLit1);
+        solver->watches.smudge(origLit2);
+        #ifdef INLINE_TERNARY
+        //3-long clauses are watched in all 3 literals
+        if (origSize == 3) {
+            solver->watches.smudge(origLit3);
+        }
+        #endif
+    };
     for (i = j = 0, p = lit_Undef; i != origSize; i++) {
         assert(solver->varData[c[i].var()].removed == Removed::none);
         if (solver->value(c[i]) == l_True || c[i] == ~p) {
@@ -587,8 +602,7 @@ bool VarReplacer::handleUpdatedClause(
     if (satisfied) {
         (*solver->drat) << findelay;
         c.shrink(c.size()); //so we free() it
-        solver->watches.smudge(origLit1);
-        solver->watches.smudge(origLit2);
+        smudge_orig_watches();
         c.setRemoved();
         return true;
     }
@@ -606,16 +620,14 @@ bool VarReplacer::handleUpdatedClause(
         return true;
     case 1 :
         c.setRemoved();
-        solver->watches.smudge(origLit1);
-        solver->watches.smudge(origLit2);
+        smudge_orig_watches();
 
         delayedEnqueue.push_back(c[0]);
         runStats.removedLongLits += origSize;
         return true;
     case 2:
         c.setRemoved();
-        solver->watches.smudge(origLit1);
-        solver->watches.smudge(origLit2);
+        smudge_orig_watches();
 
         solver->attach_bin_clause(c[0], c[1], c.red());
         runStats.removedLongLits += origSize;
@@ -630,7 +642,12 @@ bool VarReplacer::handleUpdatedClause(
         if (at2 != NULL) {
             std::swap(c[1], *at2);
         }
-        if (at != NULL && at2 != NULL) {
+        bool keep_attached = at != NULL && at2 != NULL;
+        #ifdef INLINE_TERNARY
+        //The literals inlined in the watches may have been replaced
+        keep_attached &= origSize > 3;
+        #endif
+        if (keep_attached) {
             delayed_attach_or_free.pop_back();
             if (c.red()) {
                 solver->litStats.redLits += c.size();
@@ -639,8 +656,7 @@ bool VarReplacer::handleUpdatedClause(
             }
         } else {
             c.setRemoved();
-            solver->watches.smudge(origLit1);
-            solver->watches.smudge(origLit2);
+            smudge_orig_watches();
         }
 
         runStats.removedLongLits += origSize - c.size();
@@ -1272,8 +1288,3 @@ void VarReplacer::load_state(SimpleInFile& f)
         reverseTable[v] = point_to;
     }
 }
-
-bool VarReplacer::get_scc_depth_warning_triggered() const
-{
-    return scc_finder->depth_warning_triggered();
-}
@@ -103,7 +103,6 @@ class VarReplacer
         size_t mem_used() const;
         vector<std::pair<Lit, Lit> > get_all_binary_xors_outer() const;
         vector<uint32_t> get_vars_replacing_others() const;
-        bool get_scc_depth_warning_triggered() const;
 
         void save_state(SimpleOutFile& f) const;
         void load_state(SimpleInFile& f);
@@ -211,7 +210,12 @@ class VarReplacer
         );
         void updateStatsFromImplStats();
 
-        bool handleUpdatedClause(Clause& c, const Lit origLit1, const Lit origLit2);
+        bool handleUpdatedClause(
+            Clause& c
+            , const Lit origLit1
+            , const Lit origLit2
+            , const Lit origLit3
+        );
 
          //While replacing the implicit clauses we cannot enqeue
         vector<Lit> delayedEnqueue;
@@ -0,0 +1,223 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef __VMTF_H__
+#define __VMTF_H__
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cassert>
+#include "cryptominisat5/solvertypesmini.h"
+
+namespace CMSat {
+
+using std::vector;
+
+//Variable-move-to-front queue of decision variables
+//
+//All variables are always in the queue, ordered by the time they were last
+//bumped. Bumping moves a variable to the front and unassigning a variable
+//only compares two timestamps, so both are O(1). The search pointer is kept
+//such that every variable bumped more recently than it is assigned, so
+//picking walks from it towards older variables, amortized O(1).
+class VMTFQueue {
+public:
+    size_t size() const
+    {
+        return btab.size();
+    }
+
+    ///Enqueue a new variable at the front
+    void new_var()
+    {
+        const uint32_t var = btab.size();
+        btab.push_back(0);
+        links.push_back(Link());
+        enqueue(var);
+        search = var;
+    }
+
+    ///Move var to the front. Must be told if var is currently unassigned
+    void bump(const uint32_t var, const bool unassigned)
+    {
+        if (last != var) {
+            dequeue(var);
+            enqueue(var);
+        } else {
+            btab[var] = ++stamp;
+        }
+        if (unassigned) {
+            search = var;
+        }
+    }
+
+    ///Must be called when var becomes available for branching again
+    void unassigned(const uint32_t var)
+    {
+        if (search == var_Undef || btab[var] > btab[search]) {
+            search = var;
+        }
+    }
+
+    ///Start the next search from the front
+    void reset_search()
+    {
+        search = last;
+    }
+
+    ///Returns the most recently bumped var for which skip() is false,
+    ///or var_Undef if there is none. Skipped vars are assumed to stay
+    ///skipped until unassigned() is called on them
+    template<class F>
+    uint32_t pick(const F& skip)
+    {
+        uint32_t var = search;
+        while (var != var_Undef && skip(var)) {
+            var = links[var].prev;
+        }
+        search = var;
+        return var;
+    }
+
+    ///Bump all vars, keeping their relative order. All must be assigned.
+    ///Sorts vars
+    void bump_all(vector<uint32_t>& vars)
+    {
+        std::sort(vars.begin(), vars.end(), [&](uint32_t a, uint32_t b) {
+            return btab[a] < btab[b];
+        });
+        for(const uint32_t var: vars) {
+            bump(var, false);
+        }
+    }
+
+    ///Keep only the first n vars
+    void shrink(const size_t n)
+    {
+        btab.resize(n);
+        links.resize(n);
+        btab.shrink_to_fit();
+        links.shrink_to_fit();
+        relink();
+    }
+
+    ///Apply renumbering, mapper[new] = old, as in updateArray()
+    void renumber(const vector<uint32_t>& mapper)
+    {
+        vector<uint64_t> old = btab;
+        for(size_t i = 0; i < btab.size(); i++) {
+            btab[i] = old[mapper[i]];
+        }
+        relink();
+    }
+
+    uint64_t get_bumped(const uint32_t var) const
+    {
+        return btab[var];
+    }
+
+    uint32_t get_search() const
+    {
+        return search;
+    }
+
+    uint32_t front() const
+    {
+        return last;
+    }
+
+    uint32_t prev(const uint32_t var) const
+    {
+        return links[var].prev;
+    }
+
+    size_t mem_used() const
+    {
+        return btab.capacity()*sizeof(uint64_t)
+            + links.capacity()*sizeof(Link);
+    }
+
+private:
+    struct Link {
+        uint32_t prev = var_Undef; //bumped before
+        uint32_t next = var_Undef; //bumped after
+    };
+
+    void dequeue(const uint32_t var)
+    {
+        Link& l = links[var];
+        if (l.prev != var_Undef) {
+            links[l.prev].next = l.next;
+        }
+        if (l.next != var_Undef) {
+            links[l.next].prev = l.prev;
+        } else {
+            last = l.prev;
+        }
+        if (search == var) {
+            search = l.next != var_Undef ? l.next : l.prev;
+        }
+        l.prev = l.next = var_Undef;
+    }
+
+    void enqueue(const uint32_t var)
+    {
+        Link& l = links[var];
+        l.prev = last;
+        l.next = var_Undef;
+        if (last != var_Undef) {
+            links[last].next = var;
+        }
+        last = var;
+        btab[var] = ++stamp;
+    }
+
+    //Rebuild the links from the timestamps and search from the front
+    void relink()
+    {
+        vector<uint32_t> order(btab.size());
+        for(size_t i = 0; i < order.size(); i++) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            return btab[a] < btab[b];
+        });
+
+        last = var_Undef;
+        stamp = 0;
+        for(const uint32_t var: order) {
+            enqueue(var);
+        }
+        search = last;
+    }
+
+    vector<uint64_t> btab; ///<btab[var] = when var was last bumped
+    vector<Link> links;
+    uint32_t last = var_Undef; ///<most recently bumped
+    uint32_t search = var_Undef;
+    uint64_t stamp = 0;
+};
+
+}
+
+#endif //__VMTF_H__
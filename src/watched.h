@@ -60,16 +60,39 @@ class Watched {
         */
         Watched(const ClOffset offset, Lit blockedLit) :
             data1(blockedLit.toInt())
+            #ifdef INLINE_TERNARY
+            , data3(lit_Undef.toInt())
+            #endif
+            , type(watch_clause_t)
+            , data2(offset)
+        {
+        }
+
+        #ifdef INLINE_TERNARY
+        /**
+        @brief Constructor for a 3-long clause. Holds both other literals
+
+        3-long clauses are watched in all three of their literals, so
+        propagation never has to look at the clause itself, nor to move
+        the watch
+        */
+        Watched(const ClOffset offset, Lit blockedLit, Lit lit3, const bool red) :
+            data1(blockedLit.toInt())
+            , data3(lit3.toInt() | ((uint32_t)red << 31))
             , type(watch_clause_t)
             , data2(offset)
         {
         }
+        #endif
 
         /**
         @brief Constructor for a long (>3) clause
         */
         Watched(const ClOffset offset, cl_abst_type abst) :
             data1(abst)
+            #ifdef INLINE_TERNARY
+            , data3(lit_Undef.toInt())
+            #endif
             , type(watch_clause_t)
             , data2(offset)
         {
@@ -77,6 +100,9 @@ class Watched {
 
         Watched() :
             data1 (std::numeric_limits<uint32_t>::max())
+            #ifdef INLINE_TERNARY
+            , data3(lit_Undef.toInt())
+            #endif
             , type(watch_clause_t) // initialize type with most generic type of clause
             , data2(std::numeric_limits<uint32_t>::max() >> 2)
         {}
@@ -86,6 +112,9 @@ class Watched {
         */
         Watched(const Lit lit, const bool red) :
             data1(lit.toInt())
+            #ifdef INLINE_TERNARY
+            , data3(lit_Undef.toInt())
+            #endif
             , type(watch_binary_t)
             , data2(red)
         {
@@ -96,6 +125,9 @@ class Watched {
         */
         explicit Watched(const uint32_t idx) :
             data1(idx)
+            #ifdef INLINE_TERNARY
+            , data3(lit_Undef.toInt())
+            #endif
             , type(watch_idx_t)
         {
         }
@@ -215,6 +247,54 @@ class Watched {
             return Lit::toLit(data1);
         }
 
+        #ifdef INLINE_TERNARY
+        /**
+        @brief Get the 3rd literal of a 3-long clause, lit_Undef otherwise
+
+        Together with the blocked literal and the literal whose watchlist
+        this is, it makes up the whole clause
+        */
+        Lit getLit3() const
+        {
+            #ifdef DEBUG_WATCHED
+            assert(isClause());
+            #endif
+            return Lit::toLit(data3 & 0x7fffffffU);
+        }
+
+        void setLit3(const Lit lit3)
+        {
+            #ifdef DEBUG_WATCHED
+            assert(isClause());
+            #endif
+            data3 = lit3.toInt() | (data3 & 0x80000000U);
+        }
+
+        bool isTernary() const
+        {
+            return isClause() && getLit3() != lit_Undef;
+        }
+
+        bool red_ternary() const
+        {
+            #ifdef DEBUG_WATCHED
+            assert(isTernary());
+            #endif
+            return data3 >> 31;
+        }
+        #endif
+
+        /**
+        @brief Move the watch of a clause to the clause's new offset
+        */
+        void set_offset(const ClOffset offset)
+        {
+            #ifdef DEBUG_WATCHED
+            assert(isClause());
+            #endif
+            data2 = offset;
+        }
+
         cl_abst_type getAbst() const
         {
             #ifdef DEBUG_WATCHED
@@ -236,7 +316,11 @@ class Watched {
 
         bool operator==(const Watched& other) const
         {
-            return data1 == other.data1 && data2 == other.data2 && type == other.type;
+            return data1 == other.data1 && data2 == other.data2 && type == other.type
+            #ifdef INLINE_TERNARY
+                && data3 == other.data3
+            #endif
+            ;
         }
 
         bool operator!=(const Watched& other) const
@@ -246,6 +330,9 @@ class Watched {
 
     private:
         uint32_t data1;
+        #ifdef INLINE_TERNARY
+        uint32_t data3;
+        #endif
         // binary, tertiary or long, as per WatchType
         // currently WatchType is enum with range [0..3] and fits in type
         // in case if WatchType extended type size won't be enough.
@@ -69,8 +69,8 @@ void XorFinder::find_xors_based_on_long_clauses()
         }
 
         //If not tried already, find an XOR with it
-        if (!cl->stats.marked_clause ) {
-            cl->stats.marked_clause = true;
+        if (!solver->cl_alloc.stats(cl).marked_clause ) {
+            solver->cl_alloc.stats(cl).marked_clause = true;
             assert(!cl->getRemoved());
 
             size_t needed_per_ws = 1ULL << (cl->size()-2);
@@ -88,7 +88,7 @@ void XorFinder::find_xors_based_on_long_clauses()
 
             lits.resize(cl->size());
             std::copy(cl->begin(), cl->end(), lits.begin());
-            findXor(lits, offset, cl->abst);
+            findXor(lits, offset, solver->cl_alloc.abst(cl));
             next:;
         }
     }
@@ -157,7 +157,7 @@ void XorFinder::find_xors()
     //Cleanup
     for(ClOffset offset: occsimplifier->clauses) {
         Clause* cl = solver->cl_alloc.ptr(offset);
-        cl->stats.marked_clause = false;
+        solver->cl_alloc.stats(cl).marked_clause = false;
     }
 
     //Print stats
@@ -337,9 +337,9 @@ void XorFinder::findXorMatch(watch_subarray_const occ, const Lit wlit)
 
             //Doesn't contain variables not in the original clause
             #if defined(SLOW_DEBUG) || defined(XOR_DEBUG)
-            assert(cl.abst == calcAbstraction(cl));
+            assert(solver->cl_alloc.abst(cl) == calcAbstraction(cl));
             #endif
-            if ((cl.abst | poss_xor.getAbst()) != poss_xor.getAbst())
+            if ((solver->cl_alloc.abst(cl) | poss_xor.getAbst()) != poss_xor.getAbst())
                 continue;
 
             //Check RHS, vars inside
@@ -359,7 +359,7 @@ void XorFinder::findXorMatch(watch_subarray_const occ, const Lit wlit)
             //there is no point in using this clause as a base for another XOR
             //because exactly the same things will be found.
             if (cl.size() == poss_xor.getSize()) {
-                cl.stats.marked_clause = true;
+                solver->cl_alloc.stats(cl).marked_clause = true;
             }
 
             xor_find_time_limit -= cl.size()/4+1;
@@ -23,12 +23,15 @@ THE SOFTWARE.
 #include "gtest/gtest.h"
 
 #include <fstream>
+#include <random>
 
 #include "cryptominisat5/cryptominisat.h"
 #include "src/solverconf.h"
 #include "test_helper.h"
 using namespace CMSat;
 #include <vector>
+#include <set>
+#include <limits>
 using std::vector;
 
 
@@ -110,6 +113,259 @@ TEST(normal_interface, solve_multi_thread)
     EXPECT_EQ(s.get_model()[1], l_True);
 }
 
+//Defined in cryptominisat.cpp, sets up the config of a portfolio thread
+void update_config(SolverConf& conf, unsigned thread_num);
+
+TEST(normal_interface, vmtf_threads)
+{
+    SolverConf conf;
+    for(unsigned i = 0; i < 30; i++) {
+        SolverConf c = conf;
+        update_config(c, i);
+        EXPECT_FALSE(c.vmtf) << "thread " << i;
+    }
+
+    //Threads 1 and 3 are the first helpers that don't use maple
+    conf.vmtf_threads = 2;
+    vector<unsigned> vmtf;
+    for(unsigned i = 0; i < 30; i++) {
+        SolverConf c = conf;
+        update_config(c, i);
+        if (c.vmtf) {
+            EXPECT_FALSE(c.maple);
+            vmtf.push_back(i);
+        }
+    }
+    EXPECT_EQ(vmtf, (vector<unsigned>{1, 3}));
+
+    SATSolver s(&conf);
+    s.set_num_threads(4);
+    std::mt19937 mtrand(3);
+    s.new_vars(50);
+    for(int i = 0; i < 150; i++) {
+        vector<Lit> cl;
+        for(int j = 0; j < 3; j++) {
+            cl.push_back(Lit(mtrand() % 50, mtrand() & 1));
+        }
+        s.add_clause(cl);
+    }
+    EXPECT_EQ(s.solve(), l_True);
+}
+
+TEST(normal_interface, solve_multi_thread_simplify_once)
+{
+    SolverConf conf;
+    conf.simplify_once_for_threads = true;
+    SATSolver s(&conf);
+    s.set_num_threads(3);
+    s.new_vars(4);
+    s.add_clause(str_to_cl("-1, 2"));
+    s.add_clause(str_to_cl("-2, 3"));
+    s.add_clause(str_to_cl("-3, 4"));
+    lbool ret = s.solve();
+    EXPECT_EQ( ret, l_True);
+
+    vector<Lit> assumps = str_to_cl("1");
+    ret = s.solve(&assumps);
+    EXPECT_EQ( ret, l_True);
+    EXPECT_EQ(s.get_model()[3], l_True);
+
+    s.add_clause(str_to_cl("-4"));
+    ret = s.solve(&assumps);
+    EXPECT_EQ( ret, l_False);
+    ret = s.solve();
+    EXPECT_EQ( ret, l_True);
+    EXPECT_EQ(s.get_model()[0], l_False);
+}
+
+TEST(normal_interface, solve_multi_thread_simplify_once_batch)
+{
+    SolverConf conf;
+    conf.simplify_once_for_threads = true;
+    SATSolver s(&conf);
+    s.set_num_threads(3);
+    s.new_vars(30);
+
+    vector<Lit> lits;
+    vector<size_t> offsets;
+    offsets.push_back(0);
+    for(unsigned i = 0; i < 100; i++) {
+        for(unsigned j = 0; j < 3; j++) {
+            lits.push_back(Lit((i*7 + j*11) % 30, (i+j) % 3 == 0));
+        }
+        offsets.push_back(lits.size());
+    }
+    EXPECT_TRUE(s.add_clauses(lits, offsets));
+
+    //Only the first thread holds the original clauses before solve()
+    const uint64_t orig_cls = s.get_num_irred_cls(0);
+    EXPECT_GT(orig_cls, 0U);
+    EXPECT_EQ(s.get_num_irred_cls(1), 0U);
+    EXPECT_EQ(s.get_num_irred_cls(2), 0U);
+
+    lbool ret = s.solve();
+    EXPECT_EQ( ret, l_True);
+
+    //The others only got the simplified copy, not the originals too
+    EXPECT_LE(s.get_num_irred_cls(1), orig_cls);
+    EXPECT_LE(s.get_num_irred_cls(2), orig_cls);
+    for(size_t i = 0; i+1 < offsets.size(); i++) {
+        bool sat = false;
+        for(size_t at = offsets[i]; at < offsets[i+1]; at++) {
+            sat |= (s.get_model()[lits[at].var()] ^ lits[at].sign()) == l_True;
+        }
+        EXPECT_TRUE(sat);
+    }
+}
+
+static void add_pigeonhole(SATSolver& s, unsigned pigeons, unsigned holes)
+{
+    s.new_vars(pigeons*holes);
+    for(unsigned p = 0; p < pigeons; p++) {
+        vector<Lit> cl;
+        for(unsigned h = 0; h < holes; h++) {
+            cl.push_back(Lit(p*holes + h, false));
+        }
+        s.add_clause(cl);
+    }
+    for(unsigned h = 0; h < holes; h++) {
+        for(unsigned p = 0; p < pigeons; p++) {
+            for(unsigned p2 = p+1; p2 < pigeons; p2++) {
+                s.add_clause(vector<Lit>{Lit(p*holes + h, true), Lit(p2*holes + h, true)});
+            }
+        }
+    }
+}
+
+TEST(normal_interface, checkpoint_resume)
+{
+    const std::string fname = "checkpoint_resume_test.chk";
+    std::remove(fname.c_str());
+    SolverConf conf;
+    conf.checkpoint_file = fname;
+    {
+        SATSolver s(&conf);
+        add_pigeonhole(s, 8, 7);
+        s.set_max_confl(300);
+        lbool ret = s.solve();
+        EXPECT_EQ( ret, l_Undef);
+    }
+    EXPECT_TRUE(std::ifstream(fname).good());
+
+    //Different CNF, checkpoint must be ignored
+    {
+        SATSolver s(&conf);
+        add_pigeonhole(s, 7, 8);
+        lbool ret = s.solve();
+        EXPECT_EQ( ret, l_True);
+    }
+
+    {
+        SATSolver s(&conf);
+        add_pigeonhole(s, 8, 7);
+        lbool ret = s.solve();
+        EXPECT_EQ( ret, l_False);
+    }
+    std::remove(fname.c_str());
+}
+
+TEST(normal_interface, add_clauses)
+{
+    SATSolver s;
+    s.new_vars(3);
+    vector<Lit> lits = {Lit(0, false), Lit(1, true), Lit(0, true), Lit(2, false)};
+    vector<size_t> offsets = {0, 1, 2, 4};
+    EXPECT_EQ(s.add_clauses(lits, offsets), true);
+    lbool ret = s.solve();
+    EXPECT_EQ( ret, l_True);
+    EXPECT_EQ( s.get_model()[0], l_True);
+    EXPECT_EQ( s.get_model()[1], l_False);
+    EXPECT_EQ( s.get_model()[2], l_True);
+}
+
+TEST(normal_interface, add_clauses_unsat_multi_thread)
+{
+    SATSolver s;
+    s.set_num_threads(3);
+    s.new_vars(2);
+    s.add_clause(str_to_cl("1, 2"));
+    vector<Lit> lits = {Lit(0, true), Lit(1, false), Lit(1, true)};
+    vector<size_t> offsets = {0, 1, 2, 3};
+    s.add_clauses(lits, offsets);
+    lbool ret = s.solve();
+    EXPECT_EQ( ret, l_False);
+    EXPECT_EQ( s.okay(), false);
+}
+
+//The batch is cleaned in one go, the result must be the same as clause by
+//clause. Solving in between makes vars replaced and eliminated, and the
+//clauses contain duplicates, tautologies and assigned literals.
+TEST(normal_interface, add_clauses_same_as_add_clause)
+{
+    std::mt19937 mtrand(7);
+    const uint32_t num_vars = 100;
+    SolverConf conf;
+    conf.simplify_at_startup = true;
+    conf.simplify_at_every_startup = true;
+    SATSolver batch(&conf);
+    SATSolver single(&conf);
+    batch.new_vars(num_vars);
+    single.new_vars(num_vars);
+    vector<vector<Lit> > all;
+    int rounds = 0;
+    for(; rounds < 40; rounds++) {
+        vector<Lit> lits;
+        vector<size_t> offsets = {0};
+        const Lit eq1 = Lit(mtrand() % num_vars, false);
+        const Lit eq2 = Lit(mtrand() % num_vars, mtrand() & 1);
+        for(int i = 0; i < 12; i++) {
+            vector<Lit> cl;
+            if (i < 2) {
+                //An equivalence, so that vars get replaced
+                cl = {eq1 ^ (i == 1), eq2 ^ (i == 0)};
+            } else {
+                const uint32_t size = (mtrand() % 40 == 0) ? 1 : 2 + mtrand() % 5;
+                for(uint32_t k = 0; k < size; k++) {
+                    cl.push_back(Lit(mtrand() % num_vars, mtrand() & 1));
+                }
+            }
+            lits.insert(lits.end(), cl.begin(), cl.end());
+            offsets.push_back(lits.size());
+            all.push_back(cl);
+            single.add_clause(cl);
+        }
+        batch.add_clauses(lits, offsets);
+
+        const lbool ret = batch.solve();
+        ASSERT_EQ(ret, single.solve());
+        if (ret == l_False) {
+            break;
+        }
+        for(const auto& cl: all) {
+            bool sat = false;
+            for(const Lit l: cl) {
+                sat |= (batch.get_model()[l.var()] ^ l.sign()) == l_True;
+            }
+            EXPECT_TRUE(sat);
+        }
+    }
+    EXPECT_GT(rounds, 10);
+}
+
+//The cached clauses are UNSAT, the batch itself is not
+TEST(normal_interface, add_clauses_unsat_in_cache_multi_thread)
+{
+    SATSolver s;
+    s.set_num_threads(3);
+    s.new_vars(2);
+    s.add_clause(str_to_cl("1"));
+    s.add_clause(str_to_cl("-1"));
+    vector<Lit> lits = {Lit(0, false), Lit(1, false)};
+    vector<size_t> offsets = {0, 2};
+    EXPECT_EQ(s.add_clauses(lits, offsets), false);
+    EXPECT_EQ( s.solve(), l_False);
+}
+
 TEST(normal_interface, logfile)
 {
     SATSolver* s = new SATSolver();
@@ -953,6 +1209,129 @@ TEST(sampling, indep2)
     EXPECT_EQ(s.get_model()[6], l_Undef);
 }
 
+struct Models
+{
+    vector<vector<lbool> > found;
+    std::set<string> distinct;
+    size_t stop_at = std::numeric_limits<size_t>::max();
+    SATSolver* s = NULL;
+};
+
+static bool collect_model(void* state, const vector<lbool>& values)
+{
+    Models* m = (Models*)state;
+    if (m->s) {
+        //"1, 2, 3, 4" must hold in the full model
+        bool sat = false;
+        for(uint32_t i = 0; i < 4; i++) {
+            sat |= m->s->get_model()[i] == l_True;
+        }
+        EXPECT_TRUE(sat);
+    }
+    m->found.push_back(values);
+    string str;
+    for(const lbool val: values) {
+        str += val == l_True ? '1' : (val == l_False ? '0' : 'u');
+    }
+    m->distinct.insert(str);
+    return m->found.size() < m->stop_at;
+}
+
+TEST(enumerate, all_vars)
+{
+    SATSolver s;
+    s.new_vars(3);
+    s.add_clause(str_to_cl("1"));
+    s.add_clause(str_to_cl("-1, 2, 3"));
+
+    Models m;
+    lbool ret = s.enumerate_models(collect_model, &m);
+    EXPECT_EQ(ret, l_False);
+    EXPECT_EQ(m.found.size(), 3U);
+    EXPECT_EQ(m.distinct.size(), m.found.size());
+}
+
+TEST(enumerate, projected)
+{
+    SolverConf conf;
+    conf.simplify_at_startup = true;
+    SATSolver s(&conf);
+
+    s.new_vars(30);
+    s.add_clause(str_to_cl("1, 2, 3, 4"));
+    s.add_clause(str_to_cl("-5, 6"));
+    s.add_clause(str_to_cl("-1, 7, 8"));
+
+    vector<uint32_t> x{0U,1U,2U,3U};
+    s.set_sampling_vars(&x);
+
+    Models m;
+    m.s = &s;
+    lbool ret = s.enumerate_models(collect_model, &m, true);
+    EXPECT_EQ(ret, l_False);
+    EXPECT_EQ(m.found.size(), 15U);
+    EXPECT_EQ(m.distinct.size(), m.found.size());
+}
+
+TEST(enumerate, stop)
+{
+    SATSolver s;
+    s.new_vars(30);
+    s.add_clause(str_to_cl("1, 2, 3, 4"));
+
+    vector<uint32_t> x{0U,1U,2U,3U};
+    s.set_sampling_vars(&x);
+
+    Models m;
+    m.stop_at = 2;
+    lbool ret = s.enumerate_models(collect_model, &m);
+    EXPECT_EQ(ret, l_True);
+    EXPECT_EQ(m.found.size(), 2U);
+    for(uint32_t i = 0; i < 4; i++) {
+        EXPECT_EQ(s.get_model()[i], m.found[1][i]);
+    }
+
+    //First one is blocked, the last one is not
+    m.found.clear();
+    m.stop_at = std::numeric_limits<size_t>::max();
+    ret = s.enumerate_models(collect_model, &m);
+    EXPECT_EQ(ret, l_False);
+    EXPECT_EQ(m.found.size(), 14U);
+}
+
+TEST(enumerate, threads)
+{
+    SATSolver s;
+    s.set_num_threads(2);
+    s.new_vars(30);
+    s.add_clause(str_to_cl("1, 2, 3, 4"));
+    s.add_clause(str_to_cl("-5, 6"));
+
+    vector<uint32_t> x{0U,1U,2U,3U};
+    s.set_sampling_vars(&x);
+
+    Models m;
+    m.s = &s;
+    lbool ret = s.enumerate_models(collect_model, &m, true);
+    EXPECT_EQ(ret, l_False);
+    EXPECT_EQ(m.found.size(), 15U);
+    EXPECT_EQ(m.distinct.size(), m.found.size());
+}
+
+TEST(enumerate, unsat)
+{
+    SATSolver s;
+    s.new_vars(2);
+    s.add_clause(str_to_cl("1, 2"));
+    s.add_clause(str_to_cl("-1"));
+    s.add_clause(str_to_cl("-2"));
+
+    Models m;
+    lbool ret = s.enumerate_models(collect_model, &m);
+    EXPECT_EQ(ret, l_False);
+    EXPECT_EQ(m.found.size(), 0U);
+}
+
 
 
 TEST(xor_recovery, find_1_3_xor)
@@ -48,7 +48,8 @@ struct clause_allocator : public ::testing::Test {
     std::atomic<bool> must_inter;
 };
 
-TEST_F(clause_allocator, add_1)
+//Slow, run with --gtest_also_run_disabled_tests
+TEST_F(clause_allocator, DISABLED_add_1)
 {
     vector<Lit> cl;
     srand(0);
@@ -71,10 +72,260 @@ TEST_F(clause_allocator, add_1)
         }
     }
     s->cl_alloc.consolidate(s, true);
-    lbool ret = s->solve_with_assumptions(NULL);
+    lbool ret = s->solve_with_assumptions(NULL, false);
     EXPECT_EQ(ret, l_True);
 }
 
+static Clause* new_cl(Solver* s, const vector<Lit>& lits)
+{
+    return s->cl_alloc.Clause_new(lits, 0
+    #ifdef STATS_NEEDED
+    , 1
+    #endif
+    );
+}
+
+TEST_F(clause_allocator, reuse_after_release)
+{
+    vector<Lit> lits;
+    for(uint32_t i = 0; i < 10; i++) {
+        lits.push_back(Lit(i, i%2));
+    }
+    Clause* c1 = new_cl(s, lits);
+    const ClOffset offs = s->cl_alloc.get_offset(c1);
+    s->cl_alloc.clauseFree(c1);
+
+    //Not reused until release_freed()
+    Clause* c2 = new_cl(s, lits);
+    EXPECT_NE(s->cl_alloc.get_offset(c2), offs);
+
+    //Not reused for a clause of different size
+    s->cl_alloc.release_freed();
+    vector<Lit> lits2(lits.begin(), lits.begin()+5);
+    Clause* c3 = new_cl(s, lits2);
+    EXPECT_NE(s->cl_alloc.get_offset(c3), offs);
+
+    //Same size, same place
+    Clause* c4 = new_cl(s, lits);
+    EXPECT_EQ(s->cl_alloc.get_offset(c4), offs);
+    EXPECT_EQ(c4->size(), lits.size());
+    for(uint32_t i = 0; i < lits.size(); i++) {
+        EXPECT_EQ((*c4)[i], lits[i]);
+    }
+
+    //Only once
+    Clause* c5 = new_cl(s, lits);
+    EXPECT_NE(s->cl_alloc.get_offset(c5), offs);
+}
+
+TEST_F(clause_allocator, no_reuse)
+{
+    s->cl_alloc.set_reuse(false);
+    vector<Lit> lits = {Lit(0, false), Lit(1, true), Lit(2, false), Lit(3, false)};
+    Clause* c1 = new_cl(s, lits);
+    const ClOffset offs = s->cl_alloc.get_offset(c1);
+    s->cl_alloc.clauseFree(c1);
+    s->cl_alloc.release_freed();
+
+    Clause* c2 = new_cl(s, lits);
+    EXPECT_NE(s->cl_alloc.get_offset(c2), offs);
+}
+
+TEST_F(clause_allocator, stats)
+{
+    vector<Lit> lits = {Lit(0, false), Lit(1, true), Lit(2, false)};
+    Clause* c1 = s->cl_alloc.Clause_new(lits, 5
+    #ifdef STATS_NEEDED
+    , 1
+    #endif
+    );
+    EXPECT_EQ(s->cl_alloc.stats(c1).glue, 3U);
+    EXPECT_EQ(s->cl_alloc.stats(c1).last_touched, 5U);
+    s->cl_alloc.stats(c1).glue = 2;
+    s->cl_alloc.recalc_abst_if_needed(c1);
+    EXPECT_EQ(s->cl_alloc.abst(c1), calcAbstraction(*c1));
+
+    Clause* c2 = new_cl(s, lits);
+    EXPECT_EQ(s->cl_alloc.stats(c1).glue, 2U);
+    EXPECT_EQ(s->cl_alloc.stats(c2).glue, 3U);
+
+    #ifdef CLAUSE_STATS_SIDE_TABLE
+    //The stats of a freed clause are only reused after release_freed()
+    const uint32_t idx = c1->stats_idx;
+    s->cl_alloc.clauseFree(c1);
+    Clause* c3 = new_cl(s, lits);
+    EXPECT_NE(c3->stats_idx, idx);
+
+    s->cl_alloc.release_freed();
+    Clause* c4 = s->cl_alloc.Clause_new(lits, 7
+    #ifdef STATS_NEEDED
+    , 3
+    #endif
+    );
+    EXPECT_EQ(c4->stats_idx, idx);
+    EXPECT_EQ(s->cl_alloc.stats(c4).glue, 3U);
+    EXPECT_EQ(s->cl_alloc.stats(c4).last_touched, 7U);
+    #endif
+}
+
+#ifndef _WIN32
+TEST_F(clause_allocator, grows_in_place)
+{
+    vector<Lit> lits;
+    for(uint32_t i = 0; i < 100; i++) {
+        lits.push_back(Lit(i*3, i%3 == 0));
+    }
+    Clause* c1 = new_cl(s, lits);
+    const ClOffset offs = s->cl_alloc.get_offset(c1);
+    const size_t mem_before = s->cl_alloc.mem_used();
+
+    //Several times the initial capacity
+    for(uint32_t i = 0; i < 100000; i++) {
+        new_cl(s, lits);
+    }
+    EXPECT_GT(s->cl_alloc.mem_used(), 10*mem_before);
+
+    //The stack was not moved
+    EXPECT_EQ(s->cl_alloc.ptr(offs), c1);
+    EXPECT_EQ(s->cl_alloc.get_offset(c1), offs);
+    ASSERT_EQ(c1->size(), lits.size());
+    for(uint32_t i = 0; i < lits.size(); i++) {
+        EXPECT_EQ((*c1)[i], lits[i]);
+    }
+}
+#endif
+
+//REGION_ELEMS in clauseallocator.cpp
+static const uint64_t region_elems = 1ULL << 20;
+
+static uint64_t cl_elems(const Clause* cl)
+{
+    const uint64_t bytes = sizeof(Clause) + cl->size()*sizeof(Lit);
+    return bytes/sizeof(BASE_DATA_TYPE) + (bool)(bytes % sizeof(BASE_DATA_TYPE));
+}
+
+static vector<Lit> cl_lits(const Clause* cl)
+{
+    return vector<Lit>(cl->begin(), cl->end());
+}
+
+TEST_F(clause_allocator, compact_sparse_region)
+{
+    //Fill a bit over 4 regions with 100-long clauses, every 5th redundant
+    vector<Lit> lits(100);
+    const uint64_t bytes = sizeof(Clause) + lits.size()*sizeof(Lit);
+    const uint64_t num = 4.3*region_elems*sizeof(BASE_DATA_TYPE)/bytes;
+    for(uint32_t n = 0; n < num; n++) {
+        for(uint32_t i = 0; i < 100; i++) {
+            lits[i] = Lit((n*7 + i*13) % 50000, (n+i) % 2);
+        }
+        s->add_clause_outer(lits, n % 5 == 0);
+    }
+
+    //Free most clauses that start in region 1
+    uint32_t at = 0;
+    auto free_sparse = [&](vector<ClOffset>& offsets) {
+        size_t j = 0;
+        for(size_t i = 0; i < offsets.size(); i++) {
+            const ClOffset offs = offsets[i];
+            if (offs/region_elems == 1 && at++ % 20 != 0) {
+                s->detachClause(offs);
+                s->cl_alloc.clauseFree(offs);
+            } else {
+                offsets[j++] = offs;
+            }
+        }
+        offsets.resize(j);
+    };
+    free_sparse(s->longIrredCls);
+    for(auto& lredcls: s->longRedCls) {
+        free_sparse(lredcls);
+    }
+
+    //What is left, and what will be moved
+    vector<vector<vector<Lit> > > before;
+    uint64_t to_move = 0;
+    ClOffset reason_offs = std::numeric_limits<ClOffset>::max();
+    auto record = [&](const vector<ClOffset>& offsets) {
+        before.push_back(vector<vector<Lit> >());
+        for(const ClOffset offs: offsets) {
+            const Clause* cl = s->cl_alloc.ptr(offs);
+            before.back().push_back(cl_lits(cl));
+            const uint64_t end = offs + cl_elems(cl) - 1;
+            if (offs/region_elems <= 1 && end/region_elems >= 1) {
+                to_move += cl_elems(cl)*sizeof(BASE_DATA_TYPE);
+                if (offs/region_elems == 1) {
+                    reason_offs = offs;
+                }
+            }
+        }
+    };
+    record(s->longIrredCls);
+    for(auto& lredcls: s->longRedCls) {
+        record(lredcls);
+    }
+
+    EXPECT_GT(to_move, 0u);
+
+    //A clause in region 1 is the reason of a propagation
+    ASSERT_NE(reason_offs, std::numeric_limits<ClOffset>::max());
+    const vector<Lit> reason_lits = cl_lits(s->cl_alloc.ptr(reason_offs));
+    s->new_decision_level();
+    s->enqueue(reason_lits[0], PropBy(reason_offs));
+
+    s->cl_alloc.consolidate(s, false);
+    EXPECT_EQ(s->cl_alloc.get_compact_stats().calls, 1u);
+    EXPECT_EQ(s->cl_alloc.get_compact_stats().regions, 1u);
+    EXPECT_EQ(s->cl_alloc.get_compact_stats().bytes_moved, to_move);
+
+    //Clauses
+    size_t list = 0;
+    auto check = [&](const vector<ClOffset>& offsets) {
+        ASSERT_EQ(offsets.size(), before[list].size());
+        for(size_t i = 0; i < offsets.size(); i++) {
+            const Clause* cl = s->cl_alloc.ptr(offsets[i]);
+            EXPECT_FALSE(cl->freed());
+            EXPECT_FALSE(cl->reloced);
+            EXPECT_NE(offsets[i]/region_elems, 1u);
+            EXPECT_EQ(cl_lits(cl), before[list][i]);
+        }
+        list++;
+    };
+    check(s->longIrredCls);
+    for(auto& lredcls: s->longRedCls) {
+        check(lredcls);
+    }
+
+    //Watches
+    size_t num_cl_watches = 0;
+    for(uint32_t i = 0; i < s->watches.size(); i++) {
+        const Lit lit = Lit::toLit(i);
+        for(const Watched& w: s->watches[lit]) {
+            if (!w.isClause()) {
+                continue;
+            }
+            num_cl_watches++;
+            const Clause* cl = s->cl_alloc.ptr(w.get_offset());
+            EXPECT_FALSE(cl->freed());
+            EXPECT_FALSE(cl->reloced);
+            EXPECT_TRUE((*cl)[0] == lit || (*cl)[1] == lit);
+        }
+    }
+    size_t num_cls = 0;
+    for(const auto& b: before) {
+        num_cls += b.size();
+    }
+    EXPECT_EQ(num_cl_watches, 2*num_cls);
+
+    //Reason
+    const PropBy& reason = s->varData[reason_lits[0].var()].reason;
+    ASSERT_TRUE(reason.isClause());
+    EXPECT_NE(reason.get_offset(), reason_offs);
+    EXPECT_EQ(cl_lits(s->cl_alloc.ptr(reason.get_offset())), reason_lits);
+
+    s->cancelUntil(0);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
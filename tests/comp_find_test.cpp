@@ -124,6 +124,37 @@ TEST_F(comp_finder, find_5_1)
     EXPECT_EQ(finder->getNumComps(), 5U);
 }
 
+TEST(comp_finder_threads, find_200)
+{
+    std::atomic<bool> must_inter(false);
+    SolverConf conf;
+    conf.doCache = false;
+    conf.comp_find_threads = 4;
+    Solver s(&conf, &must_inter);
+    s.new_vars(20000);
+
+    //Components of 100 vars, linked backwards by binaries and forwards by
+    //long clauses so that they span multiple chunks of work
+    for(uint32_t v = 0; v < 20000; v++) {
+        if (v % 100 != 0) {
+            s.add_clause_outer({Lit(v-1, false), Lit(v, true)});
+        }
+        if (v % 100 < 98) {
+            s.add_clause_outer({Lit(v, false), Lit(v+1, false), Lit(v+2, true)});
+        }
+    }
+
+    CompFinder finder(&s);
+    finder.find_components();
+    EXPECT_EQ(finder.getNumComps(), 200U);
+    for(uint32_t v = 0; v < 20000; v++) {
+        EXPECT_EQ(finder.getVarComp(v), finder.getVarComp(v - v%100));
+        if (v % 100 == 0 && v > 0) {
+            EXPECT_NE(finder.getVarComp(v), finder.getVarComp(v-1));
+        }
+    }
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -23,6 +23,7 @@ THE SOFTWARE.
 #include "gtest/gtest.h"
 
 #include <set>
+#include <chrono>
 using std::set;
 
 #include "src/solver.h"
@@ -168,6 +169,124 @@ TEST_F(comp_handle, check_unsat)
     EXPECT_EQ(chandle->get_num_components_solved(), 1u);
 }
 
+struct comp_handle_threads : public ::testing::Test {
+    comp_handle_threads()
+    {
+        must_inter.store(false, std::memory_order_relaxed);
+        SolverConf conf;
+        conf.doCompHandler = true;
+        conf.comp_threads = 3;
+        conf.comp_threads_max_memMB = 0;
+        s = new Solver(&conf, &must_inter);
+        s->new_vars(100);
+        s->testing_fill_assumptions_set();
+        chandle = s->compHandler;
+    }
+    ~comp_handle_threads()
+    {
+        delete s;
+    }
+
+    Solver* s;
+    CompHandler* chandle = NULL;
+    std::atomic<bool> must_inter;
+};
+
+TEST_F(comp_handle_threads, handle_many_comps)
+{
+    //Largest component stays in the main solver
+    s->add_clause_outer(str_to_cl("91, 92, 93"));
+    s->add_clause_outer(str_to_cl("93, 94, 95"));
+    s->add_clause_outer(str_to_cl("95, 96, 97"));
+
+    for(unsigned i = 0; i < 10; i++) {
+        const unsigned a = i*5+1;
+        s->add_clause_outer(str_to_cl(std::to_string(a) + ", " + std::to_string(a+1)));
+        s->add_clause_outer(str_to_cl("-" + std::to_string(a) + ", " + std::to_string(a+2)));
+        s->add_clause_outer(str_to_cl("-" + std::to_string(a+1) + ", -" + std::to_string(a+2)));
+    }
+
+    chandle->handle();
+    EXPECT_TRUE(s->okay());
+    EXPECT_EQ(chandle->get_num_components_solved(), 10u);
+    vector<lbool> solution(s->nVarsOuter(), l_Undef);
+    vector<Lit> decisions;
+    chandle->addSavedState(solution, decisions);
+    for(unsigned i = 0; i < 10; i++) {
+        const unsigned a = i*5+1;
+        EXPECT_TRUE(clause_satisfied(std::to_string(a) + ", " + std::to_string(a+1), solution));
+        EXPECT_TRUE(clause_satisfied("-" + std::to_string(a) + ", " + std::to_string(a+2), solution));
+        EXPECT_TRUE(clause_satisfied("-" + std::to_string(a+1) + ", -" + std::to_string(a+2), solution));
+    }
+}
+
+TEST_F(comp_handle_threads, check_unsat)
+{
+    s->add_clause_outer(str_to_cl("19, 14, 15"));
+    s->add_clause_outer(str_to_cl("15, 16, 17"));
+    s->add_clause_outer(str_to_cl("17, 16, 18, 14"));
+    s->add_clause_outer(str_to_cl("17, 18, 13"));
+
+    s->add_clause_outer(str_to_cl("1, 2"));
+    s->add_clause_outer(str_to_cl("-1, 2"));
+    s->add_clause_outer(str_to_cl("1, -2"));
+    s->add_clause_outer(str_to_cl("-1, -2"));
+
+    s->add_clause_outer(str_to_cl("5, 6"));
+    s->add_clause_outer(str_to_cl("7, 8"));
+
+    bool ret = chandle->handle();
+    EXPECT_FALSE(ret);
+    EXPECT_FALSE(s->okay());
+}
+
+TEST_F(comp_handle_threads, unsat_stops_running_comps)
+{
+    s->conf.comp_threads_max_memMB = 1000;
+    s->new_vars(300);
+    s->testing_fill_assumptions_set();
+
+    //Pigeon-hole 10->9, hard. Var 9*p+h means pigeon p is in hole h
+    for(unsigned p = 0; p < 10; p++) {
+        string cl;
+        for(unsigned h = 0; h < 9; h++) {
+            cl += (h ? ", " : "") + std::to_string(9*p+h+1);
+        }
+        s->add_clause_outer(str_to_cl(cl));
+    }
+    for(unsigned h = 0; h < 9; h++) {
+        for(unsigned p = 0; p < 10; p++) {
+            for(unsigned p2 = p+1; p2 < 10; p2++) {
+                s->add_clause_outer(str_to_cl(
+                    "-" + std::to_string(9*p+h+1) + ", -" + std::to_string(9*p2+h+1)));
+            }
+        }
+    }
+
+    //Trivially UNSAT, but larger, so it's queued after the pigeon-hole
+    s->add_clause_outer(str_to_cl("101, 102"));
+    s->add_clause_outer(str_to_cl("-101, 102"));
+    s->add_clause_outer(str_to_cl("101, -102"));
+    s->add_clause_outer(str_to_cl("-101, -102"));
+    for(unsigned i = 102; i < 200; i++) {
+        s->add_clause_outer(str_to_cl(std::to_string(i) + ", " + std::to_string(i+1)));
+    }
+
+    //Largest component stays in the main solver
+    for(unsigned i = 201; i < 400; i++) {
+        s->add_clause_outer(str_to_cl(std::to_string(i) + ", " + std::to_string(i+1)));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    bool ret = chandle->handle();
+    const std::chrono::duration<double> took =
+        std::chrono::steady_clock::now() - start;
+    EXPECT_FALSE(ret);
+    EXPECT_FALSE(s->okay());
+    EXPECT_FALSE(must_inter.load());
+    EXPECT_LT(took.count(), 10.0);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
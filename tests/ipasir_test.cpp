@@ -176,6 +176,80 @@ TEST(ipasir_interface, assump_clears)
     ipasir_release(s);
 }
 
+static void add_pigeonhole(void* s, const int holes)
+{
+    const int pigeons = holes+1;
+    for(int p = 0; p < pigeons; p++) {
+        for(int h = 0; h < holes; h++) {
+            ipasir_add(s, p*holes+h+1);
+        }
+        ipasir_add(s, 0);
+    }
+    for(int h = 0; h < holes; h++) {
+        for(int p1 = 0; p1 < pigeons; p1++) {
+            for(int p2 = p1+1; p2 < pigeons; p2++) {
+                ipasir_add(s, -(p1*holes+h+1));
+                ipasir_add(s, -(p2*holes+h+1));
+                ipasir_add(s, 0);
+            }
+        }
+    }
+}
+
+static int terminate_after_calls(void* state)
+{
+    int* calls = (int*)state;
+    (*calls)++;
+    return *calls >= 2;
+}
+
+TEST(ipasir_interface, terminate)
+{
+    void* s = ipasir_init();
+    add_pigeonhole(s, 12);
+
+    int calls = 0;
+    ipasir_set_terminate(s, &calls, terminate_after_calls);
+    int ret = ipasir_solve(s);
+    EXPECT_EQ(ret, 0);
+    EXPECT_EQ(calls, 2);
+
+    ipasir_release(s);
+}
+
+struct Learnt {
+    int max_len = 0;
+    int num = 0;
+    bool too_long = false;
+};
+
+static void learn_check(void* state, int* clause)
+{
+    Learnt* l = (Learnt*)state;
+    int len = 0;
+    while(clause[len] != 0) {
+        EXPECT_LE(std::abs(clause[len]), 42);
+        len++;
+    }
+    l->too_long |= len > l->max_len;
+    l->num++;
+}
+
+TEST(ipasir_interface, learn)
+{
+    void* s = ipasir_init();
+    add_pigeonhole(s, 6);
+
+    Learnt l;
+    l.max_len = 4;
+    ipasir_set_learn(s, &l, l.max_len, learn_check);
+    int ret = ipasir_solve(s);
+    EXPECT_EQ(ret, 20);
+    EXPECT_GT(l.num, 0);
+    EXPECT_FALSE(l.too_long);
+
+    ipasir_release(s);
+}
 
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
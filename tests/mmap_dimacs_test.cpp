@@ -0,0 +1,251 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include "cryptominisat5/cryptominisat.h"
+#include "src/dimacsparser.h"
+#include "src/streambuffer.h"
+#include "src/mmapdimacsparser.h"
+
+using namespace CMSat;
+using std::string;
+
+#ifdef MMAP_DIMACS_AVAILABLE
+
+static const char* cnf_file = "mmap_dimacs_test.cnf";
+
+//What the solver looks like after parsing
+struct Parsed
+{
+    bool ok;
+    unsigned vars = 0;
+    uint64_t cls = 0;
+    vector<Lit> units;
+    vector<uint32_t> sampling_vars;
+    lbool solved = l_Undef;
+
+    bool operator==(const Parsed& other) const
+    {
+        return ok == other.ok
+            && vars == other.vars
+            && cls == other.cls
+            && units == other.units
+            && sampling_vars == other.sampling_vars
+            && solved == other.solved;
+    }
+};
+
+static std::ostream& operator<<(std::ostream& os, const Parsed& p)
+{
+    os << "ok: " << p.ok << " vars: " << p.vars << " cls: " << p.cls
+    << " units: " << p.units.size() << " sampling: " << p.sampling_vars.size()
+    << " solved: " << p.solved;
+    return os;
+}
+
+static Parsed finish(SATSolver& s, const bool ok, vector<uint32_t>& sampling_vars)
+{
+    Parsed p;
+    p.ok = ok;
+    if (!ok) {
+        return p;
+    }
+    p.vars = s.nVars();
+    p.cls = s.get_num_irred_cls();
+    p.units = s.get_zero_assigned_lits();
+    std::sort(p.units.begin(), p.units.end());
+    p.sampling_vars.swap(sampling_vars);
+    p.solved = s.solve();
+    return p;
+}
+
+static Parsed parse_stream(const string& fname, const bool strict)
+{
+    SATSolver s;
+    DimacsParser<StreamBuffer<FILE*, FN> > parser(&s, NULL, 0);
+    FILE* in = fopen(fname.c_str(), "rb");
+    EXPECT_TRUE(in != NULL);
+    const bool ok = parser.parse_DIMACS(in, strict);
+    fclose(in);
+    return finish(s, ok, parser.sampling_vars);
+}
+
+static Parsed parse_mmap(
+    const string& fname
+    , const bool strict
+    , const unsigned threads
+    , const size_t chunk_bytes
+) {
+    SATSolver s;
+    MmapDimacsParser parser(&s, 0, threads);
+    parser.chunk_bytes = chunk_bytes;
+    EXPECT_TRUE(parser.open(fname));
+    const bool ok = parser.parse_DIMACS(strict);
+    return finish(s, ok, parser.sampling_vars);
+}
+
+//The mmap parser must leave the solver in the same state as DimacsParser,
+//whatever the number of threads and wherever the chunks are cut
+static void check_same(const string& fname, const bool strict, const bool expect_ok)
+{
+    const Parsed ref = parse_stream(fname, strict);
+    EXPECT_EQ(ref.ok, expect_ok);
+    for(unsigned threads: {1, 2, 4}) {
+        for(size_t chunk_bytes: {(size_t)1, (size_t)7, (size_t)64, (size_t)1<<25}) {
+            EXPECT_EQ(parse_mmap(fname, strict, threads, chunk_bytes), ref)
+                << "threads: " << threads << " chunk bytes: " << chunk_bytes;
+        }
+    }
+}
+
+static void check_same_str(const string& data, const bool strict, const bool expect_ok)
+{
+    std::ofstream f(cnf_file, std::ios::binary);
+    f << data;
+    f.close();
+    check_same(cnf_file, strict, expect_ok);
+    std::remove(cnf_file);
+}
+
+TEST(mmap_dimacs, cnf_files)
+{
+    for(const char* name: {"indep-1.cnf", "indep-2.cnf", "indep-3.cnf"
+        , "indep_vars.cnf", "indep_vars_2.cnf", "reconftest.cnf"
+        , "simptest.cnf", "simptest2.cnf", "verbosity.cnf"
+        , "xor.cnf", "xor_longer.cnf"}
+    ) {
+        SCOPED_TRACE(name);
+        check_same(string(CNF_FILES_DIR) + "/" + name, false, true);
+    }
+}
+
+TEST(mmap_dimacs, comments)
+{
+    check_same_str(
+        "c first\n"
+        "c\n"
+        "p cnf 4 3\n"
+        "c between clauses\n"
+        "1 -2 0\n"
+        "\n"
+        "c ind 1 3 0\n"
+        "2 3 -4 0\n"
+        "  c indented\n"
+        "-1 4 0\n"
+        "c last\n"
+        , true, true);
+}
+
+TEST(mmap_dimacs, no_trailing_newline)
+{
+    check_same_str("p cnf 3 2\n1 2 0\n-1 3 0", true, true);
+    check_same_str("p cnf 3 2\n1 2 0\nc no newline", true, true);
+}
+
+TEST(mmap_dimacs, whitespace)
+{
+    //Tabs and runs of spaces between tokens
+    check_same_str(
+        "p cnf\t4  3\n"
+        "1\t-2\t0\n"
+        "  2   3 \t -4    0   \n"
+        "\t-1 \t4\t\t0\t\n"
+        "c\tind\t1\t3 0\n"
+        "x1\t2  3\t0\n"
+        , true, true);
+}
+
+TEST(mmap_dimacs, crlf)
+{
+    check_same_str(
+        "c windows\r\n"
+        "p cnf 4 3\r\n"
+        "1 -2 0\r\n"
+        "\r\n"
+        "c ind 2 4 0\r\n"
+        "2 3 -4 0\r\n"
+        "x-1 4 0\r\n"
+        , true, true);
+    check_same_str("p cnf 3 2\r\n1 2 0\r\n-1 3 0\r", true, true);
+    check_same_str("p cnf 3 2\r\n1 2 0\r\n-1 3\r\n", true, false);
+}
+
+TEST(mmap_dimacs, xor_clauses)
+{
+    check_same_str(
+        "p cnf 5 4\n"
+        "x1 2 -3 0\n"
+        "x-2 4 5 0\n"
+        "1 5 0\n"
+        "x3 0\n"
+        , true, true);
+}
+
+TEST(mmap_dimacs, unsat_by_units)
+{
+    check_same_str("p cnf 2 3\n1 0\n-1 2 0\n-2 0\n", true, true);
+}
+
+TEST(mmap_dimacs, truncated)
+{
+    check_same_str("p cnf 3 2\n1 2 0\n-1 3", true, false);
+    check_same_str("p cnf 3 2\n1 2 0\n-1 3 ", true, false);
+    check_same_str("p cnf 3 2\n1 2 0\nx1 -", true, false);
+}
+
+TEST(mmap_dimacs, bad_input)
+{
+    check_same_str("p cnf 3 1\n1 a 0\n", true, false);
+    check_same_str("p cnf 2 1\n1 3 0\n", true, false);
+    check_same_str("1 3 0\n", true, false);
+}
+
+TEST(mmap_dimacs, random_many_lines)
+{
+    std::mt19937 mtrand(1);
+    std::stringstream ss;
+    ss << "p cnf 200 3000\n";
+    for(int i = 0; i < 3000; i++) {
+        if (i % 97 == 0) {
+            ss << "c comment " << i << "\n";
+        }
+        ss << (i % 50 == 0 ? "x" : "");
+        for(int j = 0; j < 3; j++) {
+            ss << ((mtrand() & 1) ? "-" : "") << (mtrand() % 200 + 1) << " ";
+        }
+        ss << "0\n";
+    }
+    check_same_str(ss.str(), true, true);
+}
+
+#endif //MMAP_DIMACS_AVAILABLE
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
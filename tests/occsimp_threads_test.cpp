@@ -0,0 +1,179 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+
+#include "src/solver.h"
+#include "src/solverconf.h"
+#include "src/occsimplifier.h"
+#include "test_helper.h"
+
+using namespace CMSat;
+
+//Runs one OCC schedule on the same problem with the given number of
+//BVE and sub/str threads
+struct occ_threads : public ::testing::Test {
+    ~occ_threads()
+    {
+        delete s;
+    }
+
+    void setup(const unsigned threads, const string& schedule)
+    {
+        must_inter.store(false, std::memory_order_relaxed);
+        SolverConf conf;
+        conf.doCache = false;
+        conf.varelim_threads = threads;
+        conf.sub_str_threads = threads;
+        conf.simplify_schedule_nonstartup = schedule;
+        delete s;
+        s = new Solver(&conf, &must_inter);
+        s->new_vars(num_vars);
+        for(const auto& cl: cls) {
+            s->add_clause_outer(cl);
+        }
+    }
+
+    vector<vector<Lit> > run(const unsigned threads, const string& schedule)
+    {
+        setup(threads, schedule);
+        s->simplify_with_assumptions();
+
+        vector<vector<Lit> > ret = get_irred_cls(s);
+        for(auto& cl: ret) {
+            std::sort(cl.begin(), cl.end());
+        }
+        std::sort(ret.begin(), ret.end(), VecVecSorter());
+        return ret;
+    }
+
+    //Solves and checks the model against the original clauses
+    lbool solve()
+    {
+        const lbool ret = s->solve_with_assumptions(NULL, false);
+        if (ret == l_True) {
+            for(const auto& cl: cls) {
+                bool sat = false;
+                for(const Lit l: cl) {
+                    sat |= (s->get_model()[l.var()] ^ l.sign()) == l_True;
+                }
+                EXPECT_TRUE(sat);
+            }
+        }
+        return ret;
+    }
+
+    void add_str(const string& data)
+    {
+        for(const auto& cl: str_to_vecs(data)) {
+            cls.push_back(cl);
+        }
+    }
+
+    //Random 3-SAT, below the threshold so BVE has things to do
+    void add_random(const uint32_t seed, const uint32_t num_cls)
+    {
+        std::mt19937 mtrand(seed);
+        for(uint32_t i = 0; i < num_cls; i++) {
+            vector<Lit> cl;
+            while(cl.size() < 3) {
+                const Lit l = Lit(mtrand() % num_vars, mtrand() & 1);
+                if (std::find(cl.begin(), cl.end(), l) == cl.end()
+                    && std::find(cl.begin(), cl.end(), ~l) == cl.end()
+                ) {
+                    cl.push_back(l);
+                }
+            }
+            cls.push_back(cl);
+        }
+    }
+
+    Solver* s = NULL;
+    std::atomic<bool> must_inter;
+    uint32_t num_vars = 50;
+    vector<vector<Lit> > cls;
+};
+
+TEST_F(occ_threads, bve_same_for_any_thread_count)
+{
+    add_random(1, 150);
+    const auto two = run(2, "occ-bve");
+    const uint32_t elimed = s->occsimplifier->get_num_elimed_vars();
+    EXPECT_GT(elimed, 0U);
+    EXPECT_EQ(run(4, "occ-bve"), two);
+    EXPECT_EQ(s->occsimplifier->get_num_elimed_vars(), elimed);
+}
+
+//The batches are taken in a different order than the serial loop takes the
+//vars, so the clauses differ, but the problem must stay the same
+TEST_F(occ_threads, bve_sat_equivalent_to_serial)
+{
+    add_random(1, 150);
+    run(1, "occ-bve");
+    EXPECT_GT(s->occsimplifier->get_num_elimed_vars(), 0U);
+    EXPECT_EQ(solve(), l_True);
+    for(unsigned threads: {2, 4}) {
+        run(threads, "occ-bve");
+        EXPECT_EQ(solve(), l_True);
+    }
+}
+
+TEST_F(occ_threads, bve_unsat_equivalent_to_serial)
+{
+    num_vars = 15;
+    add_random(3, 120);
+    run(1, "occ-bve");
+    EXPECT_EQ(solve(), l_False);
+    for(unsigned threads: {2, 4}) {
+        run(threads, "occ-bve");
+        EXPECT_EQ(solve(), l_False);
+    }
+}
+
+TEST_F(occ_threads, sub_str_same_as_serial)
+{
+    add_str("1, 2, 3; 1, 2, 3, 4; 1, 2, 3, 5, 6; -1, 2, 3, 7");
+    add_str("10, 11, 12, 13; -10, 11, 12");
+    const auto serial = run(1, "occ-backw-sub-str");
+    check_irred_cls_eq(s, "1, 2, 3; 2, 3, 7; 11, 12, 13; -10, 11, 12");
+    EXPECT_EQ(run(2, "occ-backw-sub-str"), serial);
+    EXPECT_EQ(run(4, "occ-backw-sub-str"), serial);
+}
+
+TEST_F(occ_threads, sub_str_random_same_as_serial)
+{
+    num_vars = 20;
+    add_random(2, 300);
+    const auto serial = run(1, "occ-backw-sub-str");
+    EXPECT_LT(serial.size(), cls.size());
+    for(unsigned threads: {2, 4}) {
+        EXPECT_EQ(run(threads, "occ-backw-sub-str"), serial);
+    }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,125 @@
+/******************************************
+Copyright (c) 2018, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "gtest/gtest.h"
+
+#include <random>
+#include "src/packedmatrix.h"
+
+using namespace CMSat;
+
+static vector<uint64_t> random_words(std::mt19937_64& rnd, uint32_t num)
+{
+    vector<uint64_t> ret(num);
+    for(uint64_t& w: ret) {
+        //Sparse words, so zero-skipping gets exercised
+        w = (rnd() % 4 == 0) ? rnd() : 0;
+    }
+    return ret;
+}
+
+TEST(packedrow_kernels, xor_in)
+{
+    std::mt19937_64 rnd(1);
+    for(const PackedRowKernels* k: packedrow_available_kernels()) {
+        for(uint32_t num = 0; num < 90; num++) {
+            vector<uint64_t> a = random_words(rnd, num);
+            const vector<uint64_t> b = random_words(rnd, num);
+            vector<uint64_t> check = a;
+            for(uint32_t i = 0; i < num; i++) {
+                check[i] ^= b[i];
+            }
+            k->xor_in(a.data(), b.data(), num);
+            EXPECT_EQ(a, check) << k->name;
+        }
+    }
+}
+
+TEST(packedrow_kernels, popcnt)
+{
+    std::mt19937_64 rnd(2);
+    for(const PackedRowKernels* k: packedrow_available_kernels()) {
+        for(uint32_t num = 0; num < 90; num++) {
+            const vector<uint64_t> a = random_words(rnd, num);
+            uint32_t check = 0;
+            for(uint64_t w: a) {
+                for(uint32_t i = 0; i < 64; i++) {
+                    check += (w >> i) & 1;
+                }
+            }
+            EXPECT_EQ(k->popcnt(a.data(), num), check) << k->name;
+        }
+    }
+}
+
+TEST(packedrow_kernels, first_nonzero)
+{
+    std::mt19937_64 rnd(3);
+    for(const PackedRowKernels* k: packedrow_available_kernels()) {
+        for(uint32_t num = 0; num < 90; num++) {
+            const vector<uint64_t> a = random_words(rnd, num);
+            for(uint32_t from = 0; from <= num; from++) {
+                uint32_t check = from;
+                while(check < num && a[check] == 0) {
+                    check++;
+                }
+                EXPECT_EQ(k->first_nonzero(a.data(), from, num), check) << k->name;
+            }
+        }
+    }
+}
+
+TEST(packedrow, scan_and_popcnt)
+{
+    PackedMatrix m;
+    m.resize(2, 300);
+    PackedRow r = m.getMatrixAt(0);
+    PackedRow r2 = m.getMatrixAt(1);
+    r.setZero();
+    r2.setZero();
+    EXPECT_TRUE(r.isZero());
+    EXPECT_FALSE(r.popcnt_is_one());
+    EXPECT_EQ(r.scan(0), std::numeric_limits<unsigned long int>::max());
+
+    r.setBit(70);
+    EXPECT_TRUE(r.popcnt_is_one());
+    r.setBit(257);
+    EXPECT_FALSE(r.popcnt_is_one());
+    EXPECT_EQ(r.popcnt(), 2U);
+    EXPECT_EQ(r.scan(0), 70U);
+    EXPECT_EQ(r.scan(70), 70U);
+    EXPECT_EQ(r.scan(71), 257U);
+    EXPECT_EQ(r.scan(258), std::numeric_limits<unsigned long int>::max());
+
+    r2.setBit(70);
+    r2.invert_rhs();
+    const uint64_t rhs = r2.rhs() ^ r.rhs();
+    r2 ^= r;
+    EXPECT_TRUE(r2.popcnt_is_one());
+    EXPECT_EQ(r2.scan(0), 257U);
+    EXPECT_EQ(r2.rhs(), rhs);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
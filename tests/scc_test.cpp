@@ -139,10 +139,9 @@ TEST(scc_test, find_0)
 }
 
 
-TEST(scc_test, limit_test4)
+TEST(scc_test, find_circle_3_mixed)
 {
     SolverConf conf;
-    conf.max_scc_depth = 4;
 
     std::unique_ptr<std::atomic<bool>> tmp(new std::atomic<bool>(false));
     Solver s(&conf, tmp.get());
@@ -156,34 +155,43 @@ TEST(scc_test, limit_test4)
     EXPECT_EQ(scc.get_binxors().size(), 3U);
 }
 
-TEST(scc_test, limit_test3)
+TEST(scc_test, find_long_circle)
 {
     SolverConf conf;
-    conf.max_scc_depth = 3;
+    conf.doCache = false;
 
     std::unique_ptr<std::atomic<bool>> tmp(new std::atomic<bool>(false));
     Solver s(&conf, tmp.get());
-    s.new_vars(4);
-    s.add_clause_outer(str_to_cl("1, 2"));
-    s.add_clause_outer(str_to_cl("-2, 3"));
-    s.add_clause_outer(str_to_cl("-3, -1"));
+    const uint32_t n = 200000;
+    s.new_vars(n);
+    for(uint32_t i = 0; i < n; i++) {
+        s.add_clause_outer(vector<Lit>{Lit(i, true), Lit((i+1) % n, false)});
+    }
 
     SCCFinder scc(&s);
     scc.performSCC();
-    EXPECT_EQ(scc.get_binxors().size(), 0U);
+    std::set<uint32_t> vars;
+    for(const BinaryXor& x: scc.get_binxors()) {
+        EXPECT_FALSE(x.rhs);
+        vars.insert(x.vars[0]);
+        vars.insert(x.vars[1]);
+    }
+    EXPECT_GE(scc.get_binxors().size(), n-1);
+    EXPECT_EQ(vars.size(), n);
 }
 
-TEST(scc_test, limit_test2)
+TEST(scc_test, find_0_long_chain)
 {
     SolverConf conf;
-    conf.max_scc_depth = 2;
+    conf.doCache = false;
 
     std::unique_ptr<std::atomic<bool>> tmp(new std::atomic<bool>(false));
     Solver s(&conf, tmp.get());
-    s.new_vars(4);
-    s.add_clause_outer(str_to_cl("1, 2"));
-    s.add_clause_outer(str_to_cl("-2, 3"));
-    s.add_clause_outer(str_to_cl("-3, -1"));
+    const uint32_t n = 200000;
+    s.new_vars(n);
+    for(uint32_t i = 0; i+1 < n; i++) {
+        s.add_clause_outer(vector<Lit>{Lit(i, true), Lit(i+1, false)});
+    }
 
     SCCFinder scc(&s);
     scc.performSCC();
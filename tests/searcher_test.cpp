@@ -172,6 +172,51 @@ TEST_F(SearcherTest, pickpolar_auto_not_changed_by_simp)
     }
 }
 
+#ifdef INLINE_TERNARY
+TEST_F(SearcherTest, ternary_prop_from_watch)
+{
+    s = new Solver(&conf, &must_inter);
+    s->new_vars(30);
+    ss = (Searcher*)s;
+    s->add_clause_outer(str_to_cl(" 1,  2,  3"));
+
+    //Watched in all 3 literals
+    ASSERT_EQ(s->longIrredCls.size(), 1U);
+    const Clause& cl = *s->cl_alloc.ptr(s->longIrredCls[0]);
+    const vector<Lit> orig(cl.begin(), cl.end());
+    for(const Lit l: orig) {
+        ASSERT_EQ(s->watches[l].size(), 1U);
+        ASSERT_TRUE(s->watches[l][0].isTernary());
+    }
+
+    //Propagates with both other literals as the reason, clause untouched
+    s->new_decision_level();
+    s->enqueue<false>(Lit(0, true));
+    s->enqueue<false>(Lit(1, true));
+    ASSERT_TRUE(ss->propagate<false>().isNULL());
+    ASSERT_EQ(s->value(Lit(2, false)), l_True);
+    const PropBy reason = s->varData[2].reason;
+    ASSERT_EQ(reason.getType(), ternary_t);
+    ASSERT_EQ(
+        set<Lit>({reason.lit2(), reason.lit3()})
+        , set<Lit>({Lit(0, false), Lit(1, false)})
+    );
+    ASSERT_EQ(vector<Lit>(cl.begin(), cl.end()), orig);
+    s->cancelUntil(0);
+
+    //Conflict
+    s->new_decision_level();
+    s->enqueue<false>(Lit(0, true));
+    s->enqueue<false>(Lit(1, true));
+    s->enqueue<false>(Lit(2, true));
+    ASSERT_EQ(ss->propagate<false>().getType(), ternary_t);
+    s->cancelUntil(0);
+    for(const Lit l: orig) {
+        ASSERT_EQ(s->watches[l].size(), 1U);
+    }
+}
+#endif
+
 }
 
 int main(int argc, char **argv) {
@@ -0,0 +1,195 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <thread>
+
+#include "src/solver.h"
+#include "src/sqlitestats.h"
+#include "cryptominisat5/cryptominisat.h"
+
+using namespace CMSat;
+
+static const char* db_file = "sqlite_stats_test.sqlite";
+
+struct sqlite_stats : public ::testing::Test {
+    sqlite_stats()
+    {
+        std::remove(db_file);
+        must_inter.store(false, std::memory_order_relaxed);
+        SolverConf conf;
+        conf.verbosity = 0;
+        s = new Solver(&conf, &must_inter);
+    }
+    ~sqlite_stats()
+    {
+        delete s;
+        std::remove(db_file);
+    }
+
+    //Returns the single integer the query gives
+    int64_t query(const string& sql)
+    {
+        sqlite3* db;
+        EXPECT_EQ(sqlite3_open(db_file, &db), SQLITE_OK);
+        sqlite3_stmt* stmt;
+        EXPECT_EQ(sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, NULL), SQLITE_OK);
+        EXPECT_EQ(sqlite3_step(stmt), SQLITE_ROW);
+        const int64_t ret = sqlite3_column_int64(stmt, 0);
+        sqlite3_finalize(stmt);
+        sqlite3_close(db);
+        return ret;
+    }
+
+    string query_text(const string& sql)
+    {
+        sqlite3* db;
+        EXPECT_EQ(sqlite3_open(db_file, &db), SQLITE_OK);
+        sqlite3_stmt* stmt;
+        EXPECT_EQ(sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, NULL), SQLITE_OK);
+        EXPECT_EQ(sqlite3_step(stmt), SQLITE_ROW);
+        const string ret((const char*)sqlite3_column_text(stmt, 0));
+        sqlite3_finalize(stmt);
+        sqlite3_close(db);
+        return ret;
+    }
+
+    Solver* s;
+    std::atomic<bool> must_inter;
+};
+
+//Many times the size of the ring, so the thread has to wait for the writer
+TEST_F(sqlite_stats, all_rows_written)
+{
+    unsigned long runID;
+    {
+        SQLiteStats stats(db_file);
+        ASSERT_TRUE(stats.setup(s));
+        runID = stats.get_runID();
+        for(int i = 0; i < 10*(int)SQLRing::size; i++) {
+            stats.time_passed_min(s, "test", i);
+        }
+        stats.mem_used(s, "mem", 1.0, 123);
+        stats.finishup(l_False);
+    }
+
+    EXPECT_EQ(query("select count(*) from timepassed where runID = "
+        + std::to_string(runID)), 10*(int)SQLRing::size);
+    EXPECT_EQ(query("select sum(elapsed) from timepassed"),
+        (10*SQLRing::size-1)*10*SQLRing::size/2);
+    EXPECT_EQ(query("select MB from memused where name = 'mem'"), 123);
+    EXPECT_EQ(query_text("select status from finishup"), "l_False");
+}
+
+TEST_F(sqlite_stats, long_text_truncated_tags_not)
+{
+    const string long_name(200, 'a');
+    const string long_tag(5000, 'b');
+    {
+        SQLiteStats stats(db_file);
+        ASSERT_TRUE(stats.setup(s));
+        stats.time_passed_min(s, long_name, 1.0);
+        stats.add_tag(std::make_pair(string("long"), long_tag));
+    }
+
+    EXPECT_EQ(query_text("select name from timepassed"),
+        long_name.substr(0, sql_max_text-1));
+    EXPECT_EQ(query_text("select tag from tags where tagname = 'long'"), long_tag);
+}
+
+//Every thread writes into its own ring at the same time. The finishup row is
+//written once, when the last thread has finished, with the status of the
+//thread that solved it.
+TEST_F(sqlite_stats, threads_write_concurrently)
+{
+    const uint32_t num_threads = 4;
+    const int rows_per_thread = 3*SQLRing::size + 17;
+    {
+        SQLiteStats stats(db_file);
+        ASSERT_TRUE(stats.setup(s));
+        vector<std::unique_ptr<SQLStats> > thread_stats;
+        for(uint32_t i = 1; i < num_threads; i++) {
+            thread_stats.push_back(std::unique_ptr<SQLStats>(stats.new_for_thread(i)));
+            ASSERT_TRUE(thread_stats.back()->setup(s));
+        }
+
+        vector<std::thread> threads;
+        for(uint32_t i = 0; i < num_threads; i++) {
+            SQLStats* st = i == 0 ? &stats : thread_stats[i-1].get();
+            threads.push_back(std::thread([=]{
+                for(int j = 0; j < rows_per_thread; j++) {
+                    st->time_passed_min(s, "thread", j);
+                }
+                st->finishup(i == 2 ? l_True : l_Undef);
+            }));
+        }
+        for(auto& t: threads) {
+            t.join();
+        }
+    }
+
+    for(uint32_t i = 0; i < num_threads; i++) {
+        EXPECT_EQ(query("select count(*) from timepassed where threadID = "
+            + std::to_string(i)), rows_per_thread);
+    }
+    EXPECT_EQ(query("select count(*) from finishup"), 1);
+    EXPECT_EQ(query_text("select status from finishup"), "l_True");
+}
+
+TEST_F(sqlite_stats, multi_thread_solve)
+{
+    unsigned long runID;
+    {
+        SATSolver solver;
+        solver.set_num_threads(3);
+        solver.set_sqlite(db_file);
+        runID = solver.get_sql_id();
+        solver.add_sql_tag("filename", "random");
+
+        std::mt19937 mtrand(1);
+        solver.new_vars(100);
+        for(int i = 0; i < 400; i++) {
+            vector<Lit> cl;
+            for(int j = 0; j < 3; j++) {
+                cl.push_back(Lit(mtrand() % 100, mtrand() & 1));
+            }
+            solver.add_clause(cl);
+        }
+        EXPECT_EQ(solver.solve(), l_True);
+    }
+
+    EXPECT_EQ(query("select count(distinct threadID) from timepassed where runID = "
+        + std::to_string(runID)), 3);
+    EXPECT_EQ(query("select count(*) from tags where tagname = 'filename'"), 1);
+    EXPECT_EQ(query("select count(*) from finishup where runID = "
+        + std::to_string(runID)), 1);
+    EXPECT_EQ(query_text("select status from finishup"), "l_True");
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
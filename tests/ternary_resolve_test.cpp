@@ -137,6 +137,36 @@ TEST_F(ternary_resolv, only_one_v1)
     EXPECT_EQ(get_num_red_cls_contains(s, "1, 3, 4"), 1);
 }
 
+TEST_F(ternary_resolv, do_2_v2_threads)
+{
+    s->conf.ternary_res_threads = 2;
+    s->add_clause_outer(str_to_cl("1, 2, 3"));
+    s->add_clause_outer(str_to_cl("1, -2, 4"));
+
+
+    s->add_clause_outer(str_to_cl("10, 20, 30"));
+    s->add_clause_outer(str_to_cl("10, -20, 40"));
+
+    occsimp->setup();
+    occsimp->ternary_res();
+    occsimp->finishUp(0);
+    check_red_cls_contains(s, "1, 3, 4");
+    check_red_cls_contains(s, "10, 30, 40");
+}
+
+TEST_F(ternary_resolv, only_one_threads)
+{
+    s->conf.ternary_res_threads = 4;
+    s->add_clause_outer(str_to_cl("1, 2, 3"));
+    s->add_clause_outer(str_to_cl("1, -2, 4"));
+
+    occsimp->setup();
+    occsimp->ternary_res();
+    occsimp->ternary_res();
+    occsimp->finishUp(0);
+    EXPECT_EQ(get_num_red_cls_contains(s, "1, 3, 4"), 1);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,126 @@
+/******************************************
+Copyright (c) 2016, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "gtest/gtest.h"
+
+#include "cryptominisat5/cryptominisat.h"
+
+#include "src/vmtf.h"
+
+using CMSat::VMTFQueue;
+using std::vector;
+
+static vector<uint32_t> queue_order(const VMTFQueue& q)
+{
+    vector<uint32_t> ret;
+    for(uint32_t v = q.front(); v != var_Undef; v = q.prev(v)) {
+        ret.push_back(v);
+    }
+    return ret;
+}
+
+TEST(vmtf, new_vars_at_front)
+{
+    VMTFQueue q;
+    for(size_t i = 0; i < 4; i++) {
+        q.new_var();
+    }
+    EXPECT_EQ(q.size(), 4U);
+    EXPECT_EQ(queue_order(q), (vector<uint32_t>{3, 2, 1, 0}));
+    EXPECT_EQ(q.get_search(), 3U);
+}
+
+TEST(vmtf, bump_moves_to_front)
+{
+    VMTFQueue q;
+    for(size_t i = 0; i < 4; i++) {
+        q.new_var();
+    }
+    q.bump(1, false);
+    EXPECT_EQ(queue_order(q), (vector<uint32_t>{1, 3, 2, 0}));
+    q.bump(1, false);
+    EXPECT_EQ(queue_order(q), (vector<uint32_t>{1, 3, 2, 0}));
+    q.bump(0, true);
+    EXPECT_EQ(queue_order(q), (vector<uint32_t>{0, 1, 3, 2}));
+    EXPECT_EQ(q.get_search(), 0U);
+}
+
+TEST(vmtf, bump_all_keeps_order)
+{
+    VMTFQueue q;
+    for(size_t i = 0; i < 5; i++) {
+        q.new_var();
+    }
+    vector<uint32_t> vars = {1, 3, 0};
+    q.bump_all(vars);
+    EXPECT_EQ(queue_order(q), (vector<uint32_t>{3, 1, 0, 4, 2}));
+}
+
+TEST(vmtf, pick_and_unassign)
+{
+    VMTFQueue q;
+    for(size_t i = 0; i < 4; i++) {
+        q.new_var();
+    }
+    vector<bool> assigned(4, false);
+    const auto skip = [&](uint32_t v) { return assigned[v]; };
+
+    EXPECT_EQ(q.pick(skip), 3U);
+    assigned[3] = true;
+    EXPECT_EQ(q.pick(skip), 2U);
+    assigned[2] = true;
+    assigned[1] = true;
+    EXPECT_EQ(q.pick(skip), 0U);
+    assigned[0] = true;
+    EXPECT_EQ(q.pick(skip), var_Undef);
+
+    assigned[1] = false;
+    q.unassigned(1);
+    EXPECT_EQ(q.pick(skip), 1U);
+
+    assigned[3] = false;
+    q.unassigned(3);
+    EXPECT_EQ(q.pick(skip), 3U);
+}
+
+TEST(vmtf, renumber)
+{
+    VMTFQueue q;
+    for(size_t i = 0; i < 3; i++) {
+        q.new_var();
+    }
+    q.bump(0, false);
+    EXPECT_EQ(queue_order(q), (vector<uint32_t>{0, 2, 1}));
+
+    //new var 0 is old var 2, etc.
+    q.renumber(vector<uint32_t>{2, 0, 1});
+    EXPECT_EQ(queue_order(q), (vector<uint32_t>{1, 0, 2}));
+    EXPECT_EQ(q.get_search(), 1U);
+
+    q.shrink(2);
+    EXPECT_EQ(queue_order(q), (vector<uint32_t>{1, 0}));
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
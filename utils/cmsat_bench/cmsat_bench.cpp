@@ -0,0 +1,416 @@
+/******************************************
+Copyright (c) 2017, Mate Soos
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+// Microbenchmarks of the solver's hot paths on fixed, seeded instances.
+//
+// Run with --benchmark_format=json (or build the cmsat_bench_json target) to
+// get machine-readable output that can be compared between releases.
+//
+// Propagation is also measured on the CNF in $CMSAT_BENCH_CNF if it is set,
+// which is the way to see the effect of memory layout changes: the fixed
+// instances fit in the cache.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "src/solver.h"
+#include "src/solverconf.h"
+#include "src/reducedb.h"
+#include "src/clauseallocator.h"
+#ifdef USE_GAUSS
+#include "src/EGaussian.h"
+#endif
+
+using std::vector;
+using namespace CMSat;
+
+namespace CMSat {
+
+//Declared friend by the classes whose internals are measured
+struct BenchAccess
+{
+    static PropBy propagate(Solver* s)
+    {
+        return s->propagate_any_order_fast();
+    }
+
+    //Returns the size of the learnt clause
+    static size_t analyze(Solver* s, const PropBy confl)
+    {
+        uint32_t btlevel;
+        uint32_t glue;
+        s->analyze_conflict<false>(confl, btlevel, glue);
+        return s->learnt_clause.size();
+    }
+
+    static void mark_top_N(Solver* s, const uint64_t keep_num, const ClauseClean clean_type)
+    {
+        s->reduceDB->mark_top_N_clauses(keep_num, clean_type);
+    }
+
+    #ifdef USE_GAUSS
+    static uint32_t fill_matrix(EGaussian* g)
+    {
+        g->fill_matrix(g->matrix);
+        return g->matrix.num_rows;
+    }
+
+    static void eliminate(EGaussian* g)
+    {
+        g->eliminate(g->matrix);
+    }
+    #endif
+};
+
+}
+
+//////////////////////////
+// Fixture instances
+//////////////////////////
+
+enum class Instance {
+    random_3sat   //uniform random 3-SAT at the threshold
+    , xor_heavy   //random 4-long XORs, CNF-encoded
+    , pigeonhole  //n+1 pigeons, n holes
+};
+
+struct Bench
+{
+    explicit Bench(const Instance inst, const uint32_t size)
+    {
+        init();
+        switch(inst) {
+            case Instance::random_3sat:
+                add_random_ksat(size, (uint32_t)(4.26*size), 3);
+                break;
+            case Instance::xor_heavy:
+                add_random_xors(size, size, 4);
+                break;
+            case Instance::pigeonhole:
+                add_pigeonhole(size);
+                break;
+        }
+    }
+
+    explicit Bench(const std::string& fname)
+    {
+        init();
+        add_dimacs(fname);
+    }
+
+    void init()
+    {
+        conf.verbosity = 0;
+        must_inter.store(false, std::memory_order_relaxed);
+        s.reset(new Solver(&conf, &must_inter));
+    }
+
+    //Plain DIMACS, without XOR clauses
+    void add_dimacs(const std::string& fname)
+    {
+        std::ifstream in(fname);
+        if (!in) {
+            std::cerr << "ERROR: cannot open " << fname << std::endl;
+            std::exit(-1);
+        }
+
+        vector<Lit> cl;
+        std::string tok;
+        while(in >> tok) {
+            if (tok == "c" || tok == "p") {
+                std::getline(in, tok);
+                continue;
+            }
+            const long lit = std::stol(tok);
+            if (lit == 0) {
+                s->add_clause_outer(cl);
+                cl.clear();
+                continue;
+            }
+            const uint32_t var = std::labs(lit)-1;
+            if (var >= s->nVarsOutside()) {
+                s->new_vars(var+1-s->nVarsOutside());
+            }
+            cl.push_back(Lit(var, lit < 0));
+        }
+    }
+
+    void add_random_ksat(const uint32_t nvars, const uint32_t ncls, const uint32_t k)
+    {
+        s->new_vars(nvars);
+        vector<Lit> cl;
+        for(uint32_t i = 0; i < ncls; i++) {
+            cl.clear();
+            while(cl.size() < k) {
+                const Lit l = Lit(rnd() % nvars, rnd() & 1);
+                bool dup = false;
+                for(const Lit l2: cl) {
+                    dup |= (l2.var() == l.var());
+                }
+                if (!dup) {
+                    cl.push_back(l);
+                }
+            }
+            s->add_clause_outer(cl);
+        }
+    }
+
+    //RHS is taken from a random assignment, so the system is consistent
+    void add_random_xors(const uint32_t nvars, const uint32_t nxors, const uint32_t len)
+    {
+        s->new_vars(nvars);
+        vector<bool> sol(nvars);
+        for(uint32_t i = 0; i < nvars; i++) {
+            sol[i] = rnd() & 1;
+        }
+
+        for(uint32_t i = 0; i < nxors; i++) {
+            vector<uint32_t> vars;
+            bool rhs = false;
+            while(vars.size() < len) {
+                const uint32_t v = rnd() % nvars;
+                if (std::find(vars.begin(), vars.end(), v) == vars.end()) {
+                    vars.push_back(v);
+                    rhs ^= sol[v];
+                }
+            }
+            xors.push_back(Xor(vars, rhs));
+            s->add_xor_clause_outer(vars, rhs);
+        }
+    }
+
+    void add_pigeonhole(const uint32_t holes)
+    {
+        const uint32_t pigeons = holes+1;
+        s->new_vars(pigeons*holes);
+        auto var = [&](uint32_t p, uint32_t h) { return p*holes + h; };
+
+        vector<Lit> cl;
+        for(uint32_t p = 0; p < pigeons; p++) {
+            cl.clear();
+            for(uint32_t h = 0; h < holes; h++) {
+                cl.push_back(Lit(var(p, h), false));
+            }
+            s->add_clause_outer(cl);
+        }
+        for(uint32_t h = 0; h < holes; h++) {
+            for(uint32_t p = 0; p < pigeons; p++) {
+                for(uint32_t p2 = p+1; p2 < pigeons; p2++) {
+                    s->add_clause_outer({Lit(var(p, h), true), Lit(var(p2, h), true)});
+                }
+            }
+        }
+    }
+
+    //Decides on the next unassigned literals of a seeded random order and
+    //propagates, until a conflict or until all variables are set
+    PropBy decide_until_conflict()
+    {
+        if (order.empty()) {
+            for(uint32_t v = 0; v < s->nVars(); v++) {
+                order.push_back(Lit(v, rnd() & 1));
+            }
+            std::shuffle(order.begin(), order.end(), rnd);
+        }
+
+        PropBy confl;
+        for(; at < order.size(); at++) {
+            const Lit l = order[at];
+            if (s->value(l) != l_Undef || s->varData[l.var()].removed != Removed::none) {
+                continue;
+            }
+            s->new_decision_level();
+            s->enqueue(l);
+            confl = BenchAccess::propagate(s.get());
+            if (!confl.isNULL()) {
+                at++;
+                break;
+            }
+        }
+        if (at >= order.size()) {
+            at = 0;
+        }
+
+        return confl;
+    }
+
+    SolverConf conf;
+    std::atomic<bool> must_inter;
+    std::unique_ptr<Solver> s;
+    std::mt19937 rnd{42};
+    vector<Xor> xors;
+    vector<Lit> order;
+    size_t at = 0;
+};
+
+//////////////////////////
+// Propagation
+//////////////////////////
+
+static void BM_propagate(benchmark::State& state, const Instance inst)
+{
+    Bench b(inst, state.range(0));
+    int64_t props = 0;
+    for (auto _ : state) {
+        b.decide_until_conflict();
+        props += b.s->trail_size();
+        b.s->cancelUntil(0);
+    }
+    state.counters["props"] = benchmark::Counter(props, benchmark::Counter::kIsRate);
+}
+BENCHMARK_CAPTURE(BM_propagate, random_3sat, Instance::random_3sat)->Arg(20000);
+BENCHMARK_CAPTURE(BM_propagate, xor_heavy, Instance::xor_heavy)->Arg(20000);
+BENCHMARK_CAPTURE(BM_propagate, pigeonhole, Instance::pigeonhole)->Arg(60);
+
+static void BM_propagate_cnf(benchmark::State& state, const std::string& fname)
+{
+    Bench b(fname);
+    int64_t props = 0;
+    for (auto _ : state) {
+        b.decide_until_conflict();
+        props += b.s->trail_size();
+        b.s->cancelUntil(0);
+    }
+    state.counters["props"] = benchmark::Counter(props, benchmark::Counter::kIsRate);
+    state.counters["cl_mem_MB"] = b.s->cl_alloc.mem_used()/(1024.0*1024.0);
+    state.counters["cl_header_B"] = sizeof(Clause);
+}
+
+//////////////////////////
+// Conflict analysis
+//////////////////////////
+
+static void BM_analyze_conflict(benchmark::State& state, const Instance inst)
+{
+    Bench b(inst, state.range(0));
+    int64_t lits = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        PropBy confl = b.decide_until_conflict();
+        state.ResumeTiming();
+
+        if (!confl.isNULL()) {
+            lits += BenchAccess::analyze(b.s.get(), confl);
+        }
+
+        state.PauseTiming();
+        b.s->cancelUntil(0);
+        state.ResumeTiming();
+    }
+    state.counters["learnt_lits"] = benchmark::Counter(lits, benchmark::Counter::kAvgIterations);
+}
+//Reaching a conflict is not timed but is much slower than analysing it, so
+//the number of iterations is fixed instead of derived from the timed part
+BENCHMARK_CAPTURE(BM_analyze_conflict, random_3sat, Instance::random_3sat)->Arg(5000)->Iterations(20000);
+BENCHMARK_CAPTURE(BM_analyze_conflict, xor_heavy, Instance::xor_heavy)->Arg(5000)->Iterations(20000);
+BENCHMARK_CAPTURE(BM_analyze_conflict, pigeonhole, Instance::pigeonhole)->Arg(60)->Iterations(20000);
+
+//////////////////////////
+// Clause allocator
+//////////////////////////
+
+static void BM_consolidate(benchmark::State& state, const Instance inst)
+{
+    Bench b(inst, state.range(0));
+    for (auto _ : state) {
+        b.s->cl_alloc.consolidate(b.s.get(), true, true);
+    }
+    state.SetBytesProcessed(state.iterations() * b.s->cl_alloc.mem_used());
+}
+BENCHMARK_CAPTURE(BM_consolidate, random_3sat, Instance::random_3sat)->Arg(100000);
+BENCHMARK_CAPTURE(BM_consolidate, xor_heavy, Instance::xor_heavy)->Arg(100000);
+
+//////////////////////////
+// Clause database cleaning
+//////////////////////////
+
+//Selection of the lev2 redundant clauses to keep, as done by
+//ReduceDB::handle_lev2()
+static void BM_reducedb_mark(benchmark::State& state, const ClauseClean clean_type)
+{
+    Bench b(Instance::random_3sat, 5000);
+    b.s->conf.max_confl = state.range(0);
+    b.s->conf.do_simplify_problem = false;
+    b.s->solve_with_assumptions(NULL, false);
+
+    const vector<ClOffset>& lev2 = b.s->longRedCls[2];
+    for (auto _ : state) {
+        state.PauseTiming();
+        for(const ClOffset offs: lev2) {
+            b.s->cl_alloc.stats(b.s->cl_alloc.ptr(offs)).marked_clause = false;
+        }
+        state.ResumeTiming();
+
+        BenchAccess::mark_top_N(b.s.get(), lev2.size()/2, clean_type);
+    }
+    state.SetItemsProcessed(state.iterations() * lev2.size());
+}
+BENCHMARK_CAPTURE(BM_reducedb_mark, glue, ClauseClean::glue)->Arg(30000);
+BENCHMARK_CAPTURE(BM_reducedb_mark, activity, ClauseClean::activity)->Arg(30000);
+
+//////////////////////////
+// Gaussian elimination
+//////////////////////////
+
+#ifdef USE_GAUSS
+static void BM_gauss_eliminate(benchmark::State& state)
+{
+    Bench b(Instance::xor_heavy, state.range(0));
+    EGaussian g(b.s.get(), b.conf.gaussconf, 0, b.xors);
+    for (auto _ : state) {
+        state.PauseTiming();
+        const uint32_t rows = BenchAccess::fill_matrix(&g);
+        state.ResumeTiming();
+
+        if (rows > 0) {
+            BenchAccess::eliminate(&g);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * b.xors.size());
+}
+BENCHMARK(BM_gauss_eliminate)->Arg(1000)->Arg(4000);
+#endif
+
+int main(int argc, char** argv)
+{
+    const char* cnf = std::getenv("CMSAT_BENCH_CNF");
+    if (cnf != NULL) {
+        benchmark::RegisterBenchmark("BM_propagate/cnf", BM_propagate_cnf, std::string(cnf));
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}